@@ -4,6 +4,7 @@
  * Written for testing MARL cache partitioning
  */
 #include <string>
+#include <functional>
 #include <fstream>
 #include <sstream>
 #include <vector>
@@ -20,11 +21,14 @@
 
 #include <boost/lexical_cast.hpp>
 
+#ifdef HAVE_MYSQL
+#include "ns3/ndnSIM/utils/tracers/ndn-mysql-trace-sink.h"
 #include "mysql_connection.h"
 #include <cppconn/driver.h>
 #include <cppconn/exception.h>
 #include <cppconn/statement.h>
 #include <cppconn/resultset.h>
+#endif
 
 using namespace ns3;
 using namespace std;
@@ -63,6 +67,7 @@ double timein_ProbCache = 10;
 
 string IP = "";
 string DB = "";
+string TraceDir = "./Trace"; // Traces are written here when no Database is given
 
 uint32_t TopoChoice = 0;
 uint32_t iterationTimes = 5;
@@ -78,6 +83,14 @@ string roundtime = "15000s"; //Time period for each iteration
 string totaltime = "55000s";//triggertime + roundtime;
 uint32_t Seed = 1;
 
+// Parameter sweep, e.g. --Sweep="Zipf_alpha=0.6,0.8;CachePercentage=0.05,0.1"
+string Sweep = "";
+uint32_t SweepJobs = 0; // 0: one run per core
+string SweepDir = "./Sweep";
+// Runs forked from one warm-up, varying options used after TriggerTime only,
+// e.g. --Snapshot="IterationTimes=5,10"
+string Snapshot = "";
+
 void CalculateCacheSize(string, string, uint32_t, uint32_t, double, double);
 void InstallProtocol(ndn::StackHelper&, ndn::StackHelper&,
 					 NodeContainer&, NodeContainer&);
@@ -85,47 +98,51 @@ void InstallConsumers(ndn::StackHelper&, ndn::AppHelper&, NodeContainer&);
 NodeContainer CreateConsumerNodes(NodeContainer& EdgeNodes, uint32_t TotalUsers);
 
 void SetupLastmileLink(Ptr<Node> a, Ptr<Node> b);
+void TakeSnapshot(ndn::SweepHelper* snapshot, Ptr<ndn::TraceSink> sink, ndn::DASHeuristicHelper* alghelper);
 
-void DatabaseIndex(sql::Statement* stmt)
+Ptr<ndn::TraceSink> CreateTraceSink()
 {
-	try{
-
-		stmt->execute(std::string("CREATE TABLE IF NOT EXISTS SimIndex(")
-					+"ExpID SMALLINT,"
-					+"CachePer DECIMAL(3,2),"
-					+"CacheRatio DECIMAL(4,2),"
-					+"Zipf DECIMAL(4,2),"
-					+"TotalFile SMALLINT,"
-					+"User SMALLINT,"
-					+"CacheMethod VARCHAR(13),"
-					+"Topology SMALLINT,"
-					+"RewardParam DECIMAL(6,2),"
-					+"DesignChoice SMALLINT,"
-					+"Run SMALLINT);");
-		ostringstream ss;
-
-		ss << "INSERT INTO SimIndex VALUES(" << ExpID  << ","
-							<< CachePercentage << ","
-							<< CacheRatio << ","
-							<< Zipf   << ","
-							<< TotalFile << ","
-							<< TotalUser << ",'"
-							<< ((CacheMethod == "CE2" && Replace == "Lru") ? "CE2(LRU)" : CacheMethod) << "',"
-							<< TopoChoice << ","
-							<< rewardParam << ","
-							<< rewardDesign << ","
-							<< Seed <<");";
-		stmt->execute(ss.str());
-	}
-	catch (sql::SQLException &e) {
-		cout << "# ERR: SQLException in " << __FILE__;
-		cout << "(" << __FUNCTION__ << ") on line "
-		     << __LINE__ << endl;
-		cout << "# ERR: " << e.what();
-		cout << " (MySQL error code: " << e.getErrorCode();
-		cout << ", SQLState: " << e.getSQLState() << " )" << endl;
+#ifdef HAVE_MYSQL
+	if(!DB.empty())
+	{
+		int dbport = (IP == "127.0.0.1") ? 9001 : 3306;
+		return Create<ndn::MySqlTraceSink>(get_driver_instance(), IP, dbport, DB, MySQLUsername, MySqlPwd);
 	}
+#else
+	if(!DB.empty())
+		std::cout << "Built without MySQL, --Database is ignored: traces go to " << TraceDir << std::endl;
+#endif
+	// The runs forked from a snapshot copy its traces to their own directory
+	return Create<ndn::FileTraceSink>(TraceDir + "/exp" + boost::lexical_cast<std::string>(ExpID)
+									  + (Snapshot.empty() ? "" : ".snapshot"));
+}
 
+void DatabaseIndex(Ptr<ndn::TraceSink> sink)
+{
+	sink->CreateTable("SimIndex", {{"ExpID", "SMALLINT"},
+								   {"CachePer", "DECIMAL(3,2)"},
+								   {"CacheRatio", "DECIMAL(4,2)"},
+								   {"Zipf", "DECIMAL(4,2)"},
+								   {"TotalFile", "SMALLINT"},
+								   {"User", "SMALLINT"},
+								   {"CacheMethod", "VARCHAR(13)"},
+								   {"Topology", "SMALLINT"},
+								   {"RewardParam", "DECIMAL(6,2)"},
+								   {"DesignChoice", "SMALLINT"},
+								   {"Run", "SMALLINT"}});
+	ndn::TraceRow row;
+	row.Add(ExpID)
+	   .Add(CachePercentage)
+	   .Add(CacheRatio)
+	   .Add(std::stod(Zipf))
+	   .Add(std::stoi(TotalFile))
+	   .Add(TotalUser)
+	   .AddText((CacheMethod == "CE2" && Replace == "Lru") ? "CE2(LRU)" : CacheMethod)
+	   .Add(TopoChoice)
+	   .Add(rewardParam)
+	   .Add(rewardDesign)
+	   .Add(Seed);
+	sink->Append("SimIndex", row);
 }
 
 int main (int argc, char *argv[])
@@ -184,9 +201,26 @@ int main (int argc, char *argv[])
 	cmd.AddValue("Pwd", "", MySqlPwd);
 	cmd.AddValue("IP", "MySQL IP Address", IP);
 	cmd.AddValue("Database", "Database Name", DB);
+	cmd.AddValue("TraceDir", "Directory for the traces of runs without Database", TraceDir);
+
+	cmd.AddValue("Sweep", "Parameter grid to run, one process per point (Name=v1,v2;Name=v1,...). "
+				 "Run i gets --ExpID=<ExpID+i> and, unless RngRun is in the grid, --RngRun=<ExpID+i>; "
+				 "the traces of all runs are merged into <SweepDir>/traces", Sweep);
+	cmd.AddValue("Jobs", "Number of sweep runs in parallel (0: one per core)", SweepJobs);
+	cmd.AddValue("SweepDir", "Directory for the output of sweep runs", SweepDir);
+	cmd.AddValue("Snapshot", "Grid of options used after the warm-up, every run forked from one warm-up (Name=v1,v2;...)", Snapshot);
 
 	cmd.Parse (argc, argv);
 
+	if(!Sweep.empty() && !Snapshot.empty())
+	{
+		std::cout << "Sweep and Snapshot cannot be combined" << std::endl;
+		return 1;
+	}
+	if(!Sweep.empty())
+		return ndn::SweepHelper::RunFromCommandLine(argc, argv, Sweep, ExpID, SweepJobs, SweepDir,
+													DB.empty() ? TraceDir : "");
+
 	ns3::RngSeedManager::SetSeed(std::pow(Seed, 4));
 
 	AnnotatedTopologyReader topologyReader("");
@@ -290,8 +324,7 @@ int main (int argc, char *argv[])
 	if(CacheMethod == "StreamCache")
 		consumerHelper.SetAttribute("NoCachePartition", BooleanValue(false));
 
-	sql::Driver* driver = nullptr;
-	driver = get_driver_instance();
+	Ptr<ndn::TraceSink> sink = CreateTraceSink();
 
 	NodeContainer ConsumerNodes = CreateConsumerNodes(EdgeNodes, TotalUser);
 	InstallProtocol(nosection_e, nosection_i, EdgeNodes, IntmNodes);
@@ -300,44 +333,29 @@ int main (int argc, char *argv[])
 	InstallConsumers(Noncachedndnhelper, consumerHelper, ConsumerNodes);
 
 	ndn::DASHeuristicHelper AlgHelper(CacheMethod, myprefix, EdgeNodes, IntmNodes, roundtime, iterationTimes);
+
+	ndn::SweepHelper snapshot(argv[0]);
+	if(!Snapshot.empty())
+	{
+		if(!snapshot.AddGrid(Snapshot) || !snapshot.CheckParameters({"IterationTimes"}))
+			return 1;
+		snapshot.SetFirstExpID(ExpID);
+		snapshot.SetJobs(SweepJobs);
+		snapshot.SetOutputDir(SweepDir);
+		// Scheduled first: taken before the cache partition runs at TriggerTime
+		Simulator::Schedule(Time(triggertime), &TakeSnapshot, &snapshot, sink, &AlgHelper);
+	}
 	Simulator::Schedule (Time(triggertime), &ndn::DASHeuristicHelper::Run, &AlgHelper);
 
 	ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
 	ndnGlobalRoutingHelper.InstallAll ();
 	ndnGlobalRoutingHelper.AddOrigin(myprefix, ServerNode);
-	ndnGlobalRoutingHelper.CalculateRoutes();
-
-
-	sql::Connection* con = nullptr;
-	sql::Statement* stmt = nullptr;
-	sql::ConnectOptionsMap properties;
-	properties["hostName"] = "tcp://" + IP;
-	properties["userName"] = MySQLUsername;
-	properties["password"] = MySqlPwd;
-	int dbport = (IP == "127.0.0.1") ? 9001 : 3306;
-	properties["port"] = dbport;
-	properties["schema"] = DB;
-	properties["OPT_RECONNECT"] = true;
-
-	try{
-		con = driver->connect(properties);
-		//con->setSchema(DB);
-		stmt = con->createStatement();
-	}
-	catch (sql::SQLException &e) {
-		cout << "# ERR: SQLException in " << __FILE__;
-		cout << "(" << __FUNCTION__ << ") on line "
-		     << __LINE__ << endl;
-		cout << "# ERR: " << e.what();
-		cout << " (MySQL error code: " << e.getErrorCode();
-		cout << ", SQLState: " << e.getSQLState() << " )" << endl;
-	}
+	ndn::GlobalRoutingHelper::CalculateRoutesParallel();
+
 
-	ndn::VideoTracer::InstallAllSql(driver, IP, dbport, DB, "UserRequest", "BRSwitch", "", MySQLUsername, MySqlPwd,
-									ExpID);
-	DatabaseIndex(stmt);
-	delete stmt;
-	stmt = nullptr;
+	ndn::VideoTracer::InstallAll(sink, "UserRequest", "BRSwitch", "", ExpID);
+	if(Snapshot.empty())
+		DatabaseIndex(sink);
 
 	if(CacheMethod != "StreamCache")
 		Simulator::Stop (Time(totaltime));
@@ -345,8 +363,8 @@ int main (int argc, char *argv[])
 	Simulator::Run ();
 	Simulator::Destroy ();
 
-	delete con;
-	con = nullptr;
+	ndn::VideoTracer::Destroy ();
+	sink->Close ();
 	return 0;
 }
 
@@ -419,3 +437,18 @@ void SetupLastmileLink(Ptr<Node> a, Ptr<Node> b)
 	p2p.SetDeviceAttribute("Mtu", UintegerValue(1e8));
 	p2p.Install(a, b);
 }
+
+// Runs forked from the snapshot get their ExpID from the sweep, and the options they vary in TakeSnapshot
+void RestoreSnapshot(Ptr<ndn::TraceSink> sink, ndn::DASHeuristicHelper* alghelper)
+{
+	DatabaseIndex(sink);
+
+	alghelper->SetIterationLimit(iterationTimes);
+}
+
+void TakeSnapshot(ndn::SweepHelper* snapshot, Ptr<ndn::TraceSink> sink, ndn::DASHeuristicHelper* alghelper)
+{
+	CommandLine cmd;
+	cmd.AddValue("IterationTimes", "", iterationTimes);
+	snapshot->RunFromSnapshot(sink, TraceDir, cmd, ExpID, std::bind(&RestoreSnapshot, sink, alghelper));
+}
@@ -4,6 +4,7 @@
  * Written for testing MARL cache partitioning
  */
 #include <string>
+#include <functional>
 #include <fstream>
 #include <sstream>
 #include <vector>
@@ -19,11 +20,14 @@
 
 #include <boost/lexical_cast.hpp>
 
+#ifdef HAVE_MYSQL
+#include "ns3/ndnSIM/utils/tracers/ndn-mysql-trace-sink.h"
 #include "mysql_connection.h"
 #include <cppconn/driver.h>
 #include <cppconn/exception.h>
 #include <cppconn/statement.h>
 #include <cppconn/resultset.h>
+#endif
 
 using namespace ns3;
 using namespace std;
@@ -61,9 +65,11 @@ string Replace = "Lfu";
 
 string IP = "";
 string DB = "";
+string TraceDir = "./Trace"; // Traces are written here when no Database is given
 
 uint32_t TopoChoice = 0;
 uint32_t iterationTimes = 5;
+string PartitionSolver = ""; // Gurobi if available, Greedy otherwise
 
 double rewardParam = 1;
 uint32_t rewardDesign = 1;//Default = 1(Legacy design since ICNP)
@@ -75,6 +81,14 @@ string triggertime = "40000s";
 string roundtime = "15000s"; //Time period for each iteration
 uint32_t Seed = 1;
 
+// Parameter sweep, e.g. --Sweep="Zipf_alpha=0.6,0.8;CachePercentage=0.05,0.1"
+string Sweep = "";
+uint32_t SweepJobs = 0; // 0: one run per core
+string SweepDir = "./Sweep";
+// Runs forked from one warm-up, varying options used after TriggerTime only,
+// e.g. --Snapshot="Solver=Gurobi,Greedy"
+string Snapshot = "";
+
 void CalculateCacheSize(string, string, uint32_t, uint32_t, double, double);
 void InstallProtocol(ndn::StackHelper&, ndn::StackHelper&,
 					 NodeContainer&, NodeContainer&);
@@ -82,47 +96,51 @@ void InstallConsumers(ndn::StackHelper&, ndn::AppHelper&, NodeContainer&);
 NodeContainer CreateConsumerNodes(NodeContainer& EdgeNodes, uint32_t TotalUsers);
 
 void SetupLastmileLink(Ptr<Node> a, Ptr<Node> b);
+void TakeSnapshot(ndn::SweepHelper* snapshot, Ptr<ndn::TraceSink> sink, ndn::PartitionHelper* cachepartition);
 
-void DatabaseIndex(sql::Statement* stmt)
+Ptr<ndn::TraceSink> CreateTraceSink()
 {
-	try{
-
-		stmt->execute(std::string("CREATE TABLE IF NOT EXISTS SimIndex(")
-					+"ExpID SMALLINT,"
-					+"CachePer DECIMAL(3,2),"
-					+"CacheRatio DECIMAL(4,2),"
-					+"Zipf DECIMAL(4,2),"
-					+"TotalFile SMALLINT,"
-					+"User SMALLINT,"
-					+"CacheMethod VARCHAR(13),"
-					+"Topology SMALLINT,"
-					+"RewardParam DECIMAL(6,2),"
-					+"DesignChoice SMALLINT,"
-					+"Run SMALLINT);");
-		ostringstream ss;
-
-		ss << "INSERT INTO SimIndex VALUES(" << ExpID  << ","
-												<< CachePercentage << ","
-												<< CacheRatio << ","
-												<< Zipf   << ","
-												<< TotalFile << ","
-												<< TotalUser << ",'"
-												<< "RippleOpt" << "',"
-												<< TopoChoice << ","
-												<< rewardParam << ","
-												<< rewardDesign << ","
-												<< Seed <<");";
-		stmt->execute(ss.str());
-	}
-	catch (sql::SQLException &e) {
-		cout << "# ERR: SQLException in " << __FILE__;
-		cout << "(" << __FUNCTION__ << ") on line "
-		     << __LINE__ << endl;
-		cout << "# ERR: " << e.what();
-		cout << " (MySQL error code: " << e.getErrorCode();
-		cout << ", SQLState: " << e.getSQLState() << " )" << endl;
+#ifdef HAVE_MYSQL
+	if(!DB.empty())
+	{
+		int dbport = (IP == "127.0.0.1") ? 9001 : 3306;
+		return Create<ndn::MySqlTraceSink>(get_driver_instance(), IP, dbport, DB, MySQLUsername, MySqlPwd);
 	}
+#else
+	if(!DB.empty())
+		std::cout << "Built without MySQL, --Database is ignored: traces go to " << TraceDir << std::endl;
+#endif
+	// The runs forked from a snapshot copy its traces to their own directory
+	return Create<ndn::FileTraceSink>(TraceDir + "/exp" + boost::lexical_cast<std::string>(ExpID)
+									  + (Snapshot.empty() ? "" : ".snapshot"));
+}
 
+void DatabaseIndex(Ptr<ndn::TraceSink> sink)
+{
+	sink->CreateTable("SimIndex", {{"ExpID", "SMALLINT"},
+								   {"CachePer", "DECIMAL(3,2)"},
+								   {"CacheRatio", "DECIMAL(4,2)"},
+								   {"Zipf", "DECIMAL(4,2)"},
+								   {"TotalFile", "SMALLINT"},
+								   {"User", "SMALLINT"},
+								   {"CacheMethod", "VARCHAR(13)"},
+								   {"Topology", "SMALLINT"},
+								   {"RewardParam", "DECIMAL(6,2)"},
+								   {"DesignChoice", "SMALLINT"},
+								   {"Run", "SMALLINT"}});
+	ndn::TraceRow row;
+	row.Add(ExpID)
+	   .Add(CachePercentage)
+	   .Add(CacheRatio)
+	   .Add(std::stod(Zipf))
+	   .Add(std::stoi(TotalFile))
+	   .Add(TotalUser)
+	   .AddText("RippleOpt")
+	   .Add(TopoChoice)
+	   .Add(rewardParam)
+	   .Add(rewardDesign)
+	   .Add(Seed);
+	sink->Append("SimIndex", row);
 }
 NS_LOG_COMPONENT_DEFINE ("script.GlobalPartition");
 
@@ -173,15 +191,33 @@ int main (int argc, char *argv[])
 	cmd.AddValue("RewardParam", "Parameter used to adjust reward value", rewardParam);
 	cmd.AddValue("DesignChoice", "Reward Design Pattern", rewardDesign);
 	cmd.AddValue("IterationTimes", "The number of times of executing iterations (CPVB)", iterationTimes);
+	cmd.AddValue("Solver", "Cache partition solver: Gurobi or Greedy", PartitionSolver);
 
 	cmd.AddValue("ExpID", "", ExpID);
 	cmd.AddValue("Username", "", MySQLUsername);
 	cmd.AddValue("Pwd", "", MySqlPwd);
 	cmd.AddValue("IP", "MySQL IP Address", IP);
 	cmd.AddValue("Database", "Database Name", DB);
+	cmd.AddValue("TraceDir", "Directory for the traces of runs without Database", TraceDir);
+
+	cmd.AddValue("Sweep", "Parameter grid to run, one process per point (Name=v1,v2;Name=v1,...). "
+				 "Run i gets --ExpID=<ExpID+i> and, unless RngRun is in the grid, --RngRun=<ExpID+i>; "
+				 "the traces of all runs are merged into <SweepDir>/traces", Sweep);
+	cmd.AddValue("Jobs", "Number of sweep runs in parallel (0: one per core)", SweepJobs);
+	cmd.AddValue("SweepDir", "Directory for the output of sweep runs", SweepDir);
+	cmd.AddValue("Snapshot", "Grid of options used after the warm-up, every run forked from one warm-up (Name=v1,v2;...)", Snapshot);
 
 	cmd.Parse (argc, argv);
 
+	if(!Sweep.empty() && !Snapshot.empty())
+	{
+		std::cout << "Sweep and Snapshot cannot be combined" << std::endl;
+		return 1;
+	}
+	if(!Sweep.empty())
+		return ndn::SweepHelper::RunFromCommandLine(argc, argv, Sweep, ExpID, SweepJobs, SweepDir,
+													DB.empty() ? TraceDir : "");
+
 	ns3::RngSeedManager::SetSeed(std::pow(Seed, 4));
 
 	AnnotatedTopologyReader topologyReader("");
@@ -229,16 +265,15 @@ int main (int argc, char *argv[])
 			"RewardDesign", boost::lexical_cast<std::string>(rewardDesign));
 	Noncachedndnhelper.Install(ServerNode, m_bitratename, TotalBitrate);
 
-	sql::Driver* driver = nullptr;
-	driver = get_driver_instance();
-	int dbport = (IP == "127.0.0.1") ? 9001 : 3306;
+	Ptr<ndn::TraceSink> sink = CreateTraceSink();
 	std::string logpath;
 	//logpath = "./Log/" + boost::lexical_cast<std::string>(ExpID) + ".txt";
 	//std::cout << logpath << std::endl;
 	ndn::PartitionHelper cachepartition (std::stoi(TotalFile), std::stoi(TotalChunk), TotalBitrate, TotalNode,
 										m_bitratename, EdgeCacheSize, nonEdgeCacheSize, myprefix, roundtime, rewardParam, ExpID, rewardDesign, iterationTimes, logpath,
-										driver, DB, MySQLUsername, MySqlPwd, IP, dbport);
+										sink);
 	cachepartition.SetTopologicalOrder(ServerNode, EdgeNodes);
+	cachepartition.SetSolver(PartitionSolver);
 
 
 	ndn::AppHelper producerHelper ("ns3::ndn::VideoProducer");
@@ -269,47 +304,32 @@ int main (int argc, char *argv[])
 	ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
 	ndnGlobalRoutingHelper.InstallAll ();
 	ndnGlobalRoutingHelper.AddOrigin(myprefix, ServerNode);
-	ndnGlobalRoutingHelper.CalculateRoutes();
-
-
-	sql::Connection* con = nullptr;
-	sql::Statement* stmt = nullptr;
-	sql::ConnectOptionsMap properties;
-	properties["hostName"] = "tcp://" + IP;
-	properties["userName"] = MySQLUsername;
-	properties["password"] = MySqlPwd;
-	properties["port"] = dbport;
-	properties["schema"] = DB;
-	properties["OPT_RECONNECT"] = true;
-
-	try{
-		con = driver->connect(properties);
-		//con->setSchema(DB);
-		stmt = con->createStatement();
-	}
-	catch (sql::SQLException &e) {
-		cout << "# ERR: SQLException in " << __FILE__;
-		cout << "(" << __FUNCTION__ << ") on line "
-		     << __LINE__ << endl;
-		cout << "# ERR: " << e.what();
-		cout << " (MySQL error code: " << e.getErrorCode();
-		cout << ", SQLState: " << e.getSQLState() << " )" << endl;
-	}
+	ndn::GlobalRoutingHelper::CalculateRoutesParallel();
 
-	ndn::VideoTracer::InstallAllSql(driver, IP, dbport, DB, "UserRequest", "BRSwitch", "", MySQLUsername, MySqlPwd,
-									ExpID);
-	DatabaseIndex(stmt);
-	delete stmt;
-	stmt = nullptr;
 
+	ndn::VideoTracer::InstallAll(sink, "UserRequest", "BRSwitch", "", ExpID);
+	if(Snapshot.empty())
+		DatabaseIndex(sink);
 
+
+	ndn::SweepHelper snapshot(argv[0]);
+	if(!Snapshot.empty())
+	{
+		if(!snapshot.AddGrid(Snapshot) || !snapshot.CheckParameters({"IterationTimes", "Solver"}))
+			return 1;
+		snapshot.SetFirstExpID(ExpID);
+		snapshot.SetJobs(SweepJobs);
+		snapshot.SetOutputDir(SweepDir);
+		// Scheduled first: taken before the cache partition runs at TriggerTime
+		Simulator::Schedule(Time(triggertime), &TakeSnapshot, &snapshot, sink, &cachepartition);
+	}
 	Simulator::Schedule(Time(triggertime), &ndn::PartitionHelper::IterativeRun, &cachepartition);
 
 	Simulator::Run ();
 	Simulator::Destroy ();
 
-	delete con;
-	con = nullptr;
+	ndn::VideoTracer::Destroy ();
+	sink->Close ();
 	return 0;
 }
 
@@ -376,3 +396,20 @@ void SetupLastmileLink(Ptr<Node> a, Ptr<Node> b)
 	p2p.SetDeviceAttribute("Mtu", UintegerValue(1e8));
 	p2p.Install(a, b);
 }
+
+// Runs forked from the snapshot get their ExpID from the sweep, and the options they vary in TakeSnapshot
+void RestoreSnapshot(Ptr<ndn::TraceSink> sink, ndn::PartitionHelper* cachepartition)
+{
+	DatabaseIndex(sink);
+
+	cachepartition->SetIterationTimes(iterationTimes);
+	cachepartition->SetSolver(PartitionSolver);
+}
+
+void TakeSnapshot(ndn::SweepHelper* snapshot, Ptr<ndn::TraceSink> sink, ndn::PartitionHelper* cachepartition)
+{
+	CommandLine cmd;
+	cmd.AddValue("IterationTimes", "", iterationTimes);
+	cmd.AddValue("Solver", "", PartitionSolver);
+	snapshot->RunFromSnapshot(sink, TraceDir, cmd, ExpID, std::bind(&RestoreSnapshot, sink, cachepartition));
+}
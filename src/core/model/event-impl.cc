@@ -20,11 +20,188 @@
 
 #include "event-impl.h"
 #include "log.h"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
 namespace ns3 {
 
+namespace {
+
+const size_t EVENT_GRANULE = 16;
+const size_t EVENT_CLASSES = 16;
+const size_t EVENT_CHUNK = 64 * 1024;
+
+struct FreeEvent
+{
+  FreeEvent *m_next;
+};
+
+struct EventPool;
+
+// Bytes of the chunks held by every pool
+std::atomic<size_t> g_poolSize (0);
+
+// Placed before every pooled event: the thread that frees an event gives it
+// back to the pool it was allocated from.
+union EventHeader
+{
+  EventPool *m_owner;
+  FreeEvent m_free;
+  std::max_align_t m_align;
+};
+
+/**
+ * Free lists of the events allocated by one thread, one per size class.
+ * Only the owner thread allocates from m_free. Events freed by other
+ * threads are pushed on m_remote, which the owner takes over when m_free
+ * runs out.
+ */
+struct EventPool
+{
+  EventPool ()
+  {
+    for (size_t i = 0; i < EVENT_CLASSES; i++)
+      {
+        m_free[i] = 0;
+        m_remote[i].store (0);
+        m_blocks[i] = 0;
+      }
+  }
+
+  FreeEvent *Carve (size_t sizeClass)
+  {
+    size_t blockSize = (sizeClass + 1) * EVENT_GRANULE;
+    char *chunk = static_cast<char *> (::operator new (EVENT_CHUNK));
+    m_chunks[sizeClass].push_back (chunk);
+    g_poolSize.fetch_add (EVENT_CHUNK, std::memory_order_relaxed);
+
+    FreeEvent *event = 0;
+    for (size_t offset = 0; offset + blockSize <= EVENT_CHUNK; offset += blockSize)
+      {
+        FreeEvent *block = reinterpret_cast<FreeEvent *> (chunk + offset);
+        block->m_next = event;
+        event = block;
+        m_blocks[sizeClass]++;
+      }
+    return event;
+  }
+
+  // Free the chunks of the size classes whose events are all back in the
+  // pool; returns true if the pool holds no memory anymore.
+  bool Release ()
+  {
+    bool empty = true;
+    for (size_t i = 0; i < EVENT_CLASSES; i++)
+      {
+        if (m_chunks[i].empty ())
+          {
+            continue;
+          }
+        FreeEvent *remote = m_remote[i].exchange (0, std::memory_order_acquire);
+        while (remote != 0)
+          {
+            FreeEvent *next = remote->m_next;
+            remote->m_next = m_free[i];
+            m_free[i] = remote;
+            remote = next;
+          }
+        size_t count = 0;
+        for (FreeEvent *event = m_free[i]; event != 0; event = event->m_next)
+          {
+            count++;
+          }
+        if (count != m_blocks[i])
+          {
+            empty = false;
+            continue;
+          }
+        for (std::vector<char *>::iterator chunk = m_chunks[i].begin (); chunk != m_chunks[i].end (); chunk++)
+          {
+            ::operator delete (*chunk);
+          }
+        g_poolSize.fetch_sub (m_chunks[i].size () * EVENT_CHUNK, std::memory_order_relaxed);
+        m_chunks[i].clear ();
+        m_free[i] = 0;
+        m_blocks[i] = 0;
+      }
+    return empty;
+  }
+
+  FreeEvent *m_free[EVENT_CLASSES];
+  std::atomic<FreeEvent *> m_remote[EVENT_CLASSES];
+  size_t m_blocks[EVENT_CLASSES];
+  std::vector<char *> m_chunks[EVENT_CLASSES];
+};
+
+std::mutex &
+GetPoolMutex (void)
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Pools of the threads that exited, adopted by the next threads
+std::vector<EventPool *> &
+GetAbandonedPools (void)
+{
+  static std::vector<EventPool *> pools;
+  return pools;
+}
+
+/**
+ * Pool of the calling thread, created on its first allocation. Events may
+ * outlive their thread, so its pool is not freed when the thread exits but
+ * handed over to the next thread that allocates events.
+ */
+class ThreadPool
+{
+public:
+  ThreadPool ()
+    : m_pool (0)
+  {
+  }
+
+  ~ThreadPool ()
+  {
+    if (m_pool != 0)
+      {
+        std::lock_guard<std::mutex> lock (GetPoolMutex ());
+        GetAbandonedPools ().push_back (m_pool);
+        m_pool = 0;
+      }
+  }
+
+  EventPool *Get (void)
+  {
+    if (m_pool == 0)
+      {
+        std::lock_guard<std::mutex> lock (GetPoolMutex ());
+        std::vector<EventPool *> &abandoned = GetAbandonedPools ();
+        if (abandoned.empty ())
+          {
+            m_pool = new EventPool ();
+          }
+        else
+          {
+            m_pool = abandoned.back ();
+            abandoned.pop_back ();
+          }
+      }
+    return m_pool;
+  }
+
+  EventPool *m_pool;
+};
+
+thread_local ThreadPool g_threadPool;
+
+} // anonymous namespace
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -60,4 +237,88 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+void *
+EventImpl::operator new (size_t size)
+{
+  size_t sizeClass = (size + sizeof (EventHeader) - 1) / EVENT_GRANULE;
+  if (sizeClass >= EVENT_CLASSES)
+    {
+      return ::operator new (size);
+    }
+
+  EventPool *pool = g_threadPool.Get ();
+  FreeEvent *event = pool->m_free[sizeClass];
+  if (event == 0)
+    {
+      event = pool->m_remote[sizeClass].exchange (0, std::memory_order_acquire);
+    }
+  if (event == 0)
+    {
+      event = pool->Carve (sizeClass);
+    }
+  pool->m_free[sizeClass] = event->m_next;
+
+  EventHeader *header = reinterpret_cast<EventHeader *> (event);
+  header->m_owner = pool;
+  return header + 1;
+}
+
+void
+EventImpl::operator delete (void *p, size_t size)
+{
+  size_t sizeClass = (size + sizeof (EventHeader) - 1) / EVENT_GRANULE;
+  if (sizeClass >= EVENT_CLASSES)
+    {
+      ::operator delete (p);
+      return;
+    }
+
+  EventHeader *header = static_cast<EventHeader *> (p) - 1;
+  EventPool *owner = header->m_owner;
+  FreeEvent *event = &header->m_free;
+  if (owner == g_threadPool.m_pool)
+    {
+      event->m_next = owner->m_free[sizeClass];
+      owner->m_free[sizeClass] = event;
+      return;
+    }
+
+  // allocated by another thread
+  event->m_next = owner->m_remote[sizeClass].load (std::memory_order_relaxed);
+  while (!owner->m_remote[sizeClass].compare_exchange_weak (event->m_next, event,
+                                                            std::memory_order_release,
+                                                            std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+EventImpl::ReleaseMemory (void)
+{
+  std::lock_guard<std::mutex> lock (GetPoolMutex ());
+  if (g_threadPool.m_pool != 0)
+    {
+      g_threadPool.m_pool->Release ();
+    }
+  std::vector<EventPool *> &abandoned = GetAbandonedPools ();
+  for (std::vector<EventPool *>::iterator pool = abandoned.begin (); pool != abandoned.end (); )
+    {
+      if ((*pool)->Release ())
+        {
+          delete *pool;
+          pool = abandoned.erase (pool);
+        }
+      else
+        {
+          pool++;
+        }
+    }
+}
+
+size_t
+EventImpl::GetPoolSize (void)
+{
+  return g_poolSize.load (std::memory_order_relaxed);
+}
+
 } // namespace ns3
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include "simple-ref-count.h"
 
 namespace ns3 {
@@ -58,6 +59,27 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Events are allocated from per-thread free lists, one per size class
+   * of 16 bytes up to 256 bytes. The memory is kept for the next events,
+   * so that a running simulation does not call the global allocator.
+   * An event freed by another thread goes back to the lists of the thread
+   * that allocated it.
+   */
+  static void *operator new (size_t size);
+  static void operator delete (void *p, size_t size);
+
+  /**
+   * Give back to the system the memory of the free lists whose events are
+   * all freed. Called by Simulator::Destroy.
+   */
+  static void ReleaseMemory (void);
+  /**
+   * \returns the bytes of the chunks held by the pools of every thread,
+   * whether their events are in use or free.
+   */
+  static size_t GetPoolSize (void);
+
 protected:
   virtual void Notify (void) = 0;
 
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Event scheduler recording the operations of another one
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Date: 2026-10-17
+ */
+
+#include "recording-scheduler.h"
+#include "map-scheduler.h"
+#include "object-factory.h"
+#include "string.h"
+#include "fatal-error.h"
+#include "assert.h"
+#include "log.h"
+
+NS_LOG_COMPONENT_DEFINE ("RecordingScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (RecordingScheduler);
+
+TypeId
+RecordingScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RecordingScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<RecordingScheduler> ()
+    .AddAttribute ("Scheduler", "The scheduler doing the work",
+                   TypeIdValue (MapScheduler::GetTypeId ()),
+                   MakeTypeIdAccessor (&RecordingScheduler::m_schedulerType),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("FileName", "The file the operations are written to",
+                   StringValue ("scheduler-trace.txt"),
+                   MakeStringAccessor (&RecordingScheduler::m_fileName),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+RecordingScheduler::RecordingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+RecordingScheduler::~RecordingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+RecordingScheduler::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+  Scheduler::NotifyConstructionCompleted ();
+
+  ObjectFactory factory;
+  factory.SetTypeId (m_schedulerType);
+  m_scheduler = factory.Create<Scheduler> ();
+  m_file.open (m_fileName.c_str ());
+  if (!m_file.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open " << m_fileName);
+    }
+}
+
+void
+RecordingScheduler::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.close ();
+  m_scheduler = 0;
+  Scheduler::DoDispose ();
+}
+
+void
+RecordingScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  m_file << "i " << ev.key.m_ts << ' ' << ev.key.m_uid << ' ' << ev.key.m_context << '\n';
+  m_scheduler->Insert (ev);
+}
+
+bool
+RecordingScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_scheduler->IsEmpty ();
+}
+
+Scheduler::Event
+RecordingScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_scheduler->PeekNext ();
+}
+
+Scheduler::Event
+RecordingScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  Event ev = m_scheduler->RemoveNext ();
+  m_file << "r " << ev.key.m_ts << ' ' << ev.key.m_uid << '\n';
+  return ev;
+}
+
+void
+RecordingScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  m_file << "x " << ev.key.m_ts << ' ' << ev.key.m_uid << '\n';
+  m_scheduler->Remove (ev);
+}
+
+} // namespace ns3
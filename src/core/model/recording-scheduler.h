@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Event scheduler recording the operations of another one
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef RECORDING_SCHEDULER_H
+#define RECORDING_SCHEDULER_H
+
+#include "scheduler.h"
+#include "ptr.h"
+#include "type-id.h"
+#include <stdint.h>
+#include <fstream>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a scheduler writing down the operations made on another one
+ *
+ * Every operation is forwarded to a scheduler of type "Scheduler" and
+ * written to "FileName", one per line:
+ *  - "i <ts> <uid> <context>" for Insert,
+ *  - "r <ts> <uid>" for RemoveNext, with the event removed,
+ *  - "x <ts> <uid>" for Remove.
+ *
+ * Run a scenario with --SchedulerType=ns3::RecordingScheduler to get a
+ * trace for utils/bench-scheduler.
+ */
+class RecordingScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  RecordingScheduler ();
+  virtual ~RecordingScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+protected:
+  virtual void NotifyConstructionCompleted (void);
+  virtual void DoDispose (void);
+
+private:
+  TypeId m_schedulerType;
+  std::string m_fileName;
+
+  Ptr<Scheduler> m_scheduler;
+  std::ofstream m_file;
+};
+
+} // namespace ns3
+
+#endif /* RECORDING_SCHEDULER_H */
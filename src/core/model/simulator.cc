@@ -137,6 +137,7 @@ Simulator::Destroy (void)
   (*pimpl)->Destroy ();
   (*pimpl)->Unref ();
   *pimpl = 0;
+  EventImpl::ReleaseMemory ();
 }
 
 void
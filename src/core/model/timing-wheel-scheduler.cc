@@ -0,0 +1,320 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Hierarchical timing wheel event scheduler
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Date: 2026-10-17
+ */
+
+#include "timing-wheel-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include <string.h>
+
+NS_LOG_COMPONENT_DEFINE ("TimingWheelScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (TimingWheelScheduler);
+
+TypeId
+TimingWheelScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TimingWheelScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<TimingWheelScheduler> ()
+  ;
+  return tid;
+}
+
+TimingWheelScheduler::TimingWheelScheduler ()
+  : m_cursor (0),
+    m_size (0),
+    m_free (0)
+{
+  NS_LOG_FUNCTION (this);
+  memset (m_slots, 0, sizeof (m_slots));
+  memset (m_busy, 0, sizeof (m_busy));
+}
+
+TimingWheelScheduler::~TimingWheelScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Node *>::iterator i = m_chunks.begin (); i != m_chunks.end (); i++)
+    {
+      delete [] *i;
+    }
+}
+
+bool
+TimingWheelScheduler::IsBefore (const EventKey &a, const EventKey &b)
+{
+  return a.m_ts < b.m_ts || (a.m_ts == b.m_ts && a.m_uid < b.m_uid);
+}
+
+uint32_t
+TimingWheelScheduler::GetSlot (uint64_t ts, uint32_t level)
+{
+  return (ts >> (level * SLOT_BITS)) & (SLOTS - 1);
+}
+
+uint32_t
+TimingWheelScheduler::GetLevel (uint64_t ts) const
+{
+  uint64_t diff = ts ^ m_cursor;
+  if (diff == 0)
+    {
+      return 0;
+    }
+  return (63 - __builtin_clzll (diff)) / SLOT_BITS;
+}
+
+uint32_t
+TimingWheelScheduler::FindSlot (uint32_t level, uint32_t from) const
+{
+  for (uint32_t word = from / 64; word < WORDS; word++)
+    {
+      uint64_t bits = m_busy[level][word];
+      if (word == from / 64)
+        {
+          bits &= ~uint64_t (0) << (from % 64);
+        }
+      if (bits != 0)
+        {
+          return word * 64 + __builtin_ctzll (bits);
+        }
+    }
+  return SLOTS;
+}
+
+bool
+TimingWheelScheduler::FindFirst (uint32_t &level, uint32_t &slot) const
+{
+  for (level = 0; level < LEVELS; level++)
+    {
+      // levels above 0 only hold slots after the one of the cursor
+      slot = FindSlot (level, GetSlot (m_cursor, level));
+      if (slot != SLOTS)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+TimingWheelScheduler::Link (Node *node)
+{
+  uint32_t level = GetLevel (node->m_ev.key.m_ts);
+  uint32_t slot = GetSlot (node->m_ev.key.m_ts, level);
+  Slot &s = m_slots[level][slot];
+
+  // level 0 slots hold one timestamp: keep them in uid order. Events come
+  // in uid order, so this almost never walks.
+  Node *after = s.m_tail;
+  if (level == 0)
+    {
+      while (after != 0 && after->m_ev.key.m_uid > node->m_ev.key.m_uid)
+        {
+          after = after->m_prev;
+        }
+    }
+
+  node->m_prev = after;
+  node->m_next = after != 0 ? after->m_next : s.m_head;
+  if (node->m_prev != 0)
+    {
+      node->m_prev->m_next = node;
+    }
+  else
+    {
+      s.m_head = node;
+    }
+  if (node->m_next != 0)
+    {
+      node->m_next->m_prev = node;
+    }
+  else
+    {
+      s.m_tail = node;
+    }
+  m_busy[level][slot / 64] |= uint64_t (1) << (slot % 64);
+}
+
+void
+TimingWheelScheduler::Unlink (Node *node, uint32_t level, uint32_t slot)
+{
+  Slot &s = m_slots[level][slot];
+  if (node->m_prev != 0)
+    {
+      node->m_prev->m_next = node->m_next;
+    }
+  else
+    {
+      s.m_head = node->m_next;
+    }
+  if (node->m_next != 0)
+    {
+      node->m_next->m_prev = node->m_prev;
+    }
+  else
+    {
+      s.m_tail = node->m_prev;
+    }
+  if (s.m_head == 0)
+    {
+      m_busy[level][slot / 64] &= ~(uint64_t (1) << (slot % 64));
+    }
+}
+
+void
+TimingWheelScheduler::Cascade (uint32_t level, uint32_t slot)
+{
+  NS_LOG_FUNCTION (this << level << slot);
+  Slot &s = m_slots[level][slot];
+  Node *node = s.m_head;
+  s.m_head = 0;
+  s.m_tail = 0;
+  m_busy[level][slot / 64] &= ~(uint64_t (1) << (slot % 64));
+
+  Node *first = node;
+  for (Node *i = node; i != 0; i = i->m_next)
+    {
+      if (IsBefore (i->m_ev.key, first->m_ev.key))
+        {
+          first = i;
+        }
+    }
+  // the events of the slot share all the bytes from 'level' up, so all
+  // of them land below it
+  m_cursor = first->m_ev.key.m_ts;
+  while (node != 0)
+    {
+      Node *next = node->m_next;
+      Link (node);
+      node = next;
+    }
+}
+
+TimingWheelScheduler::Node *
+TimingWheelScheduler::Allocate (void)
+{
+  if (m_free == 0)
+    {
+      Node *chunk = new Node[CHUNK];
+      m_chunks.push_back (chunk);
+      for (uint32_t i = 0; i < CHUNK; i++)
+        {
+          chunk[i].m_next = m_free;
+          m_free = &chunk[i];
+        }
+    }
+  Node *node = m_free;
+  m_free = node->m_next;
+  return node;
+}
+
+void
+TimingWheelScheduler::Release (Node *node)
+{
+  node->m_next = m_free;
+  m_free = node;
+}
+
+void
+TimingWheelScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (ev.key.m_ts >= m_cursor);
+  Node *node = Allocate ();
+  node->m_ev = ev;
+  Link (node);
+  m_size++;
+}
+
+bool
+TimingWheelScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_size == 0;
+}
+
+Scheduler::Event
+TimingWheelScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t level, slot;
+  bool found = FindFirst (level, slot);
+  NS_ASSERT (found);
+
+  const Node *first = m_slots[level][slot].m_head;
+  if (level > 0)
+    {
+      for (const Node *i = first->m_next; i != 0; i = i->m_next)
+        {
+          if (IsBefore (i->m_ev.key, first->m_ev.key))
+            {
+              first = i;
+            }
+        }
+    }
+  NS_LOG_DEBUG (this << first->m_ev.impl << first->m_ev.key.m_ts << first->m_ev.key.m_uid);
+  return first->m_ev;
+}
+
+Scheduler::Event
+TimingWheelScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t level, slot;
+  bool found = FindFirst (level, slot);
+  NS_ASSERT (found);
+  if (level > 0)
+    {
+      Cascade (level, slot);
+      level = 0;
+      slot = GetSlot (m_cursor, 0);
+    }
+
+  Node *node = m_slots[level][slot].m_head;
+  Unlink (node, level, slot);
+  m_cursor = node->m_ev.key.m_ts;
+  m_size--;
+
+  Event ev = node->m_ev;
+  Release (node);
+  NS_LOG_DEBUG (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  return ev;
+}
+
+void
+TimingWheelScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint32_t level = GetLevel (ev.key.m_ts);
+  uint32_t slot = GetSlot (ev.key.m_ts, level);
+  Node *node = m_slots[level][slot].m_head;
+  while (node != 0 && node->m_ev.key.m_uid != ev.key.m_uid)
+    {
+      node = node->m_next;
+    }
+  NS_ASSERT (node != 0 && node->m_ev.impl == ev.impl);
+  Unlink (node, level, slot);
+  m_size--;
+  Release (node);
+}
+
+} // namespace ns3
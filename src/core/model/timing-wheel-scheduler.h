@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Hierarchical timing wheel event scheduler
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef TIMING_WHEEL_SCHEDULER_H
+#define TIMING_WHEEL_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a hierarchical timing wheel event scheduler
+ *
+ * The timestamps are split in 8 bytes, and the wheel has one level of 256
+ * slots per byte. An event is kept at the level of the highest byte in
+ * which its timestamp differs from the one of the last event removed, in
+ * the slot given by the value of that byte; a slot of level 0 thus holds
+ * the events of a single timestamp, in uid order. When level 0 runs out,
+ * the first busy slot of the lowest busy level is spread over the levels
+ * below it, so an event moves at most 7 times: Insert and RemoveNext are
+ * O(1) amortized, whatever the spread of the timestamps. Remove searches
+ * the slot of the event.
+ *
+ * The list nodes come from a pool which only grows, so that once the
+ * event population reached its peak, no allocation happens.
+ */
+class TimingWheelScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TimingWheelScheduler ();
+  virtual ~TimingWheelScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  enum
+  {
+    LEVELS = 8,
+    SLOT_BITS = 8,
+    SLOTS = 1 << SLOT_BITS,
+    WORDS = SLOTS / 64,
+    CHUNK = 1024
+  };
+
+  struct Node
+  {
+    Event m_ev;
+    Node *m_prev;
+    Node *m_next;
+  };
+
+  struct Slot
+  {
+    Node *m_head;
+    Node *m_tail;
+  };
+
+  static bool IsBefore (const EventKey &a, const EventKey &b);
+  static uint32_t GetSlot (uint64_t ts, uint32_t level);
+  uint32_t GetLevel (uint64_t ts) const;
+  /* first busy slot of level from slot 'from' on, SLOTS if none */
+  uint32_t FindSlot (uint32_t level, uint32_t from) const;
+  /* lowest busy level and its first busy slot; false if empty */
+  bool FindFirst (uint32_t &level, uint32_t &slot) const;
+
+  void Link (Node *node);
+  void Unlink (Node *node, uint32_t level, uint32_t slot);
+  /* spread the slot over the lower levels; the earliest event ends at level 0 */
+  void Cascade (uint32_t level, uint32_t slot);
+
+  Node *Allocate (void);
+  void Release (Node *node);
+
+  Slot m_slots[LEVELS][SLOTS];
+  uint64_t m_busy[LEVELS][WORDS];
+  uint64_t m_cursor;
+  uint32_t m_size;
+
+  Node *m_free;
+  std::vector<Node *> m_chunks;
+};
+
+} // namespace ns3
+
+#endif /* TIMING_WHEEL_SCHEDULER_H */
@@ -26,6 +26,7 @@
 #include "ns3/config.h"
 #include "ns3/string.h"
 #include "ns3/system-thread.h"
+#include "ns3/event-impl.h"
 
 #include <ctime>
 #include <list>
@@ -225,6 +226,94 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * Events scheduled from other threads are freed by the simulation thread:
+ * they must go back to the pools of the threads that allocated them, the
+ * next threads must reuse those pools, and Simulator::Destroy must give
+ * their memory back.
+ */
+class ThreadedEventPoolTestCase : public TestCase
+{
+public:
+  ThreadedEventPoolTestCase ();
+  void Count (unsigned int threadno);
+  static void SchedulingThread (std::pair<ThreadedEventPoolTestCase *, unsigned int> context);
+  void Round (void);
+  unsigned int m_events;
+
+private:
+  virtual void DoRun (void);
+};
+
+// Enough events per thread to need several chunks of the event pools
+static const unsigned int POOL_THREADS = 4;
+static const unsigned int POOL_EVENTS = 5000;
+
+ThreadedEventPoolTestCase::ThreadedEventPoolTestCase ()
+  : TestCase ("Check that events freed by the simulation thread go back to the pools of their threads")
+{
+}
+
+void
+ThreadedEventPoolTestCase::Count (unsigned int threadno)
+{
+  ++m_events;
+}
+
+void
+ThreadedEventPoolTestCase::SchedulingThread (std::pair<ThreadedEventPoolTestCase *, unsigned int> context)
+{
+  for (unsigned int i = 0; i < POOL_EVENTS; ++i)
+    {
+      Simulator::ScheduleWithContext (context.second, MicroSeconds (i),
+                                      &ThreadedEventPoolTestCase::Count, context.first, context.second);
+    }
+}
+
+void
+ThreadedEventPoolTestCase::Round (void)
+{
+  std::list<Ptr<SystemThread> > threads;
+  for (unsigned int i = 0; i < POOL_THREADS; ++i)
+    {
+      threads.push_back (
+        Create<SystemThread> (MakeBoundCallback (
+            &ThreadedEventPoolTestCase::SchedulingThread,
+                std::pair<ThreadedEventPoolTestCase *, unsigned int> (this, i) )) );
+    }
+  for (std::list<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Start ();
+    }
+  for (std::list<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Join ();
+    }
+  Simulator::Run ();
+}
+
+void
+ThreadedEventPoolTestCase::DoRun (void)
+{
+  m_events = 0;
+  size_t initial = EventImpl::GetPoolSize ();
+  // Create the simulator in this thread, so that it is the simulation thread
+  Simulator::Now ();
+
+  Round ();
+  NS_TEST_EXPECT_MSG_EQ (m_events, POOL_THREADS * POOL_EVENTS, "Events of the first threads lost");
+  size_t first = EventImpl::GetPoolSize ();
+  NS_TEST_EXPECT_MSG_GT (first, initial, "Events of the threads not pooled");
+
+  // The events of the first threads are all free: the next threads take over their pools
+  Round ();
+  NS_TEST_EXPECT_MSG_EQ (m_events, 2 * POOL_THREADS * POOL_EVENTS, "Events of the next threads lost");
+  NS_TEST_EXPECT_MSG_EQ (EventImpl::GetPoolSize (), first, "Pools of the first threads not reused");
+
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ ((EventImpl::GetPoolSize () <= initial), true, "Pools not released by Simulator::Destroy");
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -241,7 +330,8 @@ public:
       "ns3::ListScheduler",
       "ns3::HeapScheduler",
       "ns3::MapScheduler",
-      "ns3::CalendarScheduler"
+      "ns3::CalendarScheduler",
+      "ns3::TimingWheelScheduler"
     };
     unsigned int threadcounts[] = {
       0,
@@ -262,5 +352,6 @@ public:
               }
           }
       }
+    AddTestCase (new ThreadedEventPoolTestCase (), TestCase::QUICK);
   }
 } g_threadedSimulatorTestSuite;
@@ -65,6 +65,11 @@ ConsumerZipfMandelbrot::GetTypeId (void)
                    StringValue ("0.7"),
                    MakeDoubleAccessor (&ConsumerZipfMandelbrot::SetS, &ConsumerZipfMandelbrot::GetS),
                    MakeDoubleChecker<double> ())
+
+    .AddAttribute ("Sampler", "Sampling method: BinarySearch (O(log N), same sequence as the cumulative scan) or Alias (O(1))",
+                   StringValue ("BinarySearch"),
+                   MakeStringAccessor (&ConsumerZipfMandelbrot::SetSampler, &ConsumerZipfMandelbrot::GetSampler),
+                   MakeStringChecker ())
     ;
 
   return tid;
@@ -75,6 +80,7 @@ ConsumerZipfMandelbrot::ConsumerZipfMandelbrot()
   : m_N (100) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
   , m_q (0)
   , m_s (0.7)
+  , m_method (ZipfSampler::BINARY_SEARCH)
   , m_SeqRng (0.0, 1.0)
 {
   // SetNumberOfContents is called by NS-3 object system during the initialization
@@ -91,19 +97,8 @@ ConsumerZipfMandelbrot::SetNumberOfContents (uint32_t numOfContents)
 
   NS_LOG_DEBUG (m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double> (m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      m_Pcum[i] = m_Pcum[i-1] + 1.0 / std::pow(i+m_q, m_s);
-    }
-
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-      NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  // The attributes are set one by one: the table is only built when the first sequence is drawn
+  m_sampler = 0;
 }
 
 uint32_t
@@ -138,6 +133,20 @@ ConsumerZipfMandelbrot::GetS () const
   return m_s;
 }
 
+void
+ConsumerZipfMandelbrot::SetSampler (const std::string &method)
+{
+  if (!ZipfSampler::ParseMethod (method, m_method))
+    NS_FATAL_ERROR ("Unknown Zipf sampler " << method << " (BinarySearch or Alias)");
+  m_sampler = 0;
+}
+
+std::string
+ConsumerZipfMandelbrot::GetSampler () const
+{
+  return (m_method == ZipfSampler::ALIAS) ? "Alias" : "BinarySearch";
+}
+
 void
 ConsumerZipfMandelbrot::SendPacket() {
   if (!m_active) return;
@@ -217,8 +226,8 @@ ConsumerZipfMandelbrot::SendPacket() {
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (m_sampler == 0)
+    m_sampler = ZipfSampler::Get (m_N, m_q, m_s, m_method);
 
   double p_random = m_SeqRng.GetValue();
   while (p_random == 0)
@@ -227,16 +236,7 @@ ConsumerZipfMandelbrot::GetNextSeq()
     }
   //if (p_random == 0)
   NS_LOG_LOGIC("p_random="<<p_random);
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      p_sum = m_Pcum[i];   //m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
-      if (p_random <= p_sum)
-        {
-          content_index = i;
-          break;
-        } //if
-    } //for
-  //content_index = 1;
+  uint32_t content_index = m_sampler->Sample (p_random); //[1, m_N]
   NS_LOG_DEBUG("RandomNumber="<<content_index);
   return content_index;
 }
@@ -23,6 +23,7 @@
 #define NDN_CONSUMER_ZIPF_MANDELBROT_H_
 
 #include "ndn-consumer-cbr.h"
+#include "ns3/ndn-zipf-sampler.h"
 #include <vector>
 
 namespace ns3 {
@@ -74,11 +75,18 @@ private:
   double
   GetS () const;
 
+  void
+  SetSampler (const std::string &method);
+
+  std::string
+  GetSampler () const;
+
 private:
   uint32_t m_N;  //number of the contents
   double m_q;  //q in (k+q)^s
   double m_s;  //s in (k+q)^s
-  std::vector<double> m_Pcum;  //cumulative probability
+  ZipfSampler::Method m_method;
+  Ptr<const ZipfSampler> m_sampler;  //shared table, built on the first request
 
   UniformVariable m_SeqRng; //RNG
 };
@@ -131,7 +131,7 @@ VideoProducer::OnInterest (Ptr<const Interest> interest)
 
   if (!m_active) return;
   //The Payload of packet is counted as Byte!!!!
-  Ptr<Data> data = Create<Data> (Create<Packet> (m_node->GetObject<NDNBitRate>()->GetChunkSize(ExtractBitrate(interest->GetName()))
+  Ptr<Data> data = Create<Data> (Create<Packet> (m_node->GetObject<NDNBitRate>()->GetChunkSizeFromRank(interest->GetBitRateRank())
 		  * 1e3));
   data->SetName (Create<Name> (interest->GetName ()));
   data->SetAccumulatedReward(GetReward(interest));
@@ -157,20 +157,6 @@ VideoProducer::OnInterest (Ptr<const Interest> interest)
   m_transmittedDatas (data, this, m_face);
 }
 
-std::string VideoProducer::ExtractBitrate(const Name& n)
-{
-	std::string name = n.toUri();
-	std::size_t found = name.find("br");
-	std::string r = name;
-	if (found != std::string::npos)
-	{
-		std::size_t format = name.find("/",found + 2);
-		if(format != std::string::npos)
-			r = name.substr(found + 2, format - found - 2);
-	}
-	return r;
-}
-
 double
 VideoProducer::GetReward(Ptr<const Interest> interest)
 {
@@ -178,7 +164,7 @@ VideoProducer::GetReward(Ptr<const Interest> interest)
 	uint32_t BD = static_cast<uint8_t>(bd) & 0x0f;
 	Ptr<NDNBitRate> m_BRinfo = m_node->GetObject<NDNBitRate>();
 
-	uint32_t actualBR = m_BRinfo->GetRankFromBR(ExtractBitrate(interest->GetName()));
+	uint32_t actualBR = interest->GetBitRateRank();
 
 	double r = 0;
 	if(BD == 0)
@@ -46,7 +46,6 @@ protected:
   StopApplication ();     // Called at time specified by Stop
 
 private:
-  std::string ExtractBitrate(const Name&);
   double 	  GetReward(Ptr<const Interest> interest);
 
   Name m_prefix;
@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Benchmark of the content store replacement policies on a Zipf request trace
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-zipf-sampler.h"
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.h"
+#include "ns3/ndnSIM/utils/trie/lru-policy.h"
+#include "ns3/ndnSIM/utils/trie/lfu-policy.h"
+#include "ns3/ndnSIM/utils/trie/lfu-da-policy.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::ndn::ndnSIM;
+
+#define LOG(x)   std::cout << x << std::endl
+
+struct CachedItem : public SimpleRefCount<CachedItem>
+{
+};
+
+struct Request
+{
+  uint32_t content;
+  uint32_t size;
+};
+
+struct Result
+{
+  double seconds;
+  uint64_t hits;
+  uint64_t hitBytes;
+};
+
+/*
+ * Every request asks a chunk of a Zipf-distributed content. The contents are
+ * spread over the bitrates, and a chunk has the size of its bitrate. Every
+ * 'shift' requests, the popularity ranks move by a third of the catalog.
+ */
+std::vector<Request>
+MakeTrace (uint32_t contents, double q, double s, const std::vector<uint32_t> &sizes,
+           uint64_t total, uint64_t shift)
+{
+  Ptr<const ndn::ZipfSampler> zipf = ndn::ZipfSampler::Get (contents, q, s, ndn::ZipfSampler::ALIAS);
+  UniformVariable uniform (0.0, 1.0);
+  std::vector<Request> trace (total);
+  uint32_t offset = 0;
+  for (uint64_t i = 0; i < total; i++)
+    {
+      if (shift != 0 && i > 0 && i % shift == 0)
+        {
+          offset += contents / 3;
+        }
+      trace[i].content = (zipf->Sample (uniform.GetValue ()) - 1 + offset) % contents;
+      trace[i].size = sizes[trace[i].content % sizes.size ()];
+    }
+  return trace;
+}
+
+template<class Policy>
+Result
+Run (const std::vector<ndn::Name> &names, const std::vector<Request> &trace, uint32_t capacity)
+{
+  typedef trie_with_policy<ndn::Name, smart_pointer_payload_traits<CachedItem>, Policy> Cache;
+  Cache cache;
+  cache.getPolicy ().set_max_size (capacity);
+  Ptr<CachedItem> payload = Create<CachedItem> ();
+
+  Result result = { 0, 0, 0 };
+  SystemWallClockMs time;
+  time.Start ();
+  for (std::vector<Request>::const_iterator r = trace.begin (); r != trace.end (); r++)
+    {
+      typename Cache::iterator item = cache.deepest_prefix_match (names[r->content]);
+      if (item != cache.end ())
+        {
+          result.hits++;
+          result.hitBytes += r->size;
+        }
+      else
+        {
+          cache.insert (names[r->content], payload, r->size);
+        }
+    }
+  result.seconds = time.End () / 1000.0;
+  return result;
+}
+
+void
+Report (const std::string &policy, const Result &result, const std::vector<Request> &trace, uint64_t bytes)
+{
+  LOG (std::left << std::setw (12) << policy
+                 << std::setw (12) << result.seconds
+                 << std::setw (12) << (result.seconds * 1e9 / trace.size ())
+                 << std::setw (12) << (static_cast<double> (result.hits) / trace.size ())
+                 << std::setw (12) << (static_cast<double> (result.hitBytes) / bytes));
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t contents = 100000;
+  double q = 0.0;
+  double s = 0.8;
+  std::string sizeList = "500,1000,2000,4000";
+  uint32_t capacity = 2000000;
+  uint64_t total = 5000000;
+  uint64_t shift = 0;
+  uint32_t runs = 3;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the content store replacement policies.\n"
+             "\n"
+             "Replays the same Zipf-Mandelbrot request trace on an Lru, Lfu and\n"
+             "LfuDA cache of a byte capacity, and reports the time per request,\n"
+             "the hit ratio and the byte hit ratio. The contents are spread over\n"
+             "bitrates of different chunk sizes; with --shift, the popularity\n"
+             "moves over time.");
+  cmd.AddValue ("contents", "number of contents", contents);
+  cmd.AddValue ("q", "q of the Zipf-Mandelbrot distribution", q);
+  cmd.AddValue ("s", "s of the Zipf-Mandelbrot distribution", s);
+  cmd.AddValue ("sizes", "comma separated chunk sizes (KB) of the bitrates", sizeList);
+  cmd.AddValue ("capacity", "cache capacity (KB)", capacity);
+  cmd.AddValue ("total", "number of requests", total);
+  cmd.AddValue ("shift", "number of requests between popularity shifts, 0 for none", shift);
+  cmd.AddValue ("runs", "number of runs per policy", runs);
+  cmd.Parse (argc, argv);
+
+  std::vector<uint32_t> sizes;
+  std::istringstream is (sizeList);
+  std::string size;
+  while (std::getline (is, size, ','))
+    {
+      sizes.push_back (std::atoi (size.c_str ()));
+    }
+  NS_ABORT_MSG_IF (sizes.empty (), "No chunk size");
+
+  std::vector<ndn::Name> names (contents);
+  for (uint32_t i = 0; i < contents; i++)
+    {
+      std::ostringstream os;
+      os << "/video/" << sizes[i % sizes.size ()] << "/" << i;
+      names[i] = ndn::Name (os.str ());
+    }
+
+  std::vector<Request> trace = MakeTrace (contents, q, s, sizes, total, shift);
+  uint64_t bytes = 0;
+  for (std::vector<Request>::const_iterator r = trace.begin (); r != trace.end (); r++)
+    {
+      bytes += r->size;
+    }
+  LOG (contents << " contents, " << total << " requests, capacity " << capacity << " KB");
+
+  LOG (std::left << std::setw (12) << "Policy" << std::setw (12) << "Time (s)"
+                 << std::setw (12) << "Per (ns)" << std::setw (12) << "Hit ratio"
+                 << std::setw (12) << "Byte hit");
+  for (uint32_t run = 0; run < runs; run++)
+    {
+      Report ("Lru", Run<lru_policy_traits> (names, trace, capacity), trace, bytes);
+      Report ("Lfu", Run<lfu_policy_traits> (names, trace, capacity), trace, bytes);
+      Report ("LfuDA", Run<lfu_da_policy_traits> (names, trace, capacity), trace, bytes);
+    }
+  return 0;
+}
@@ -59,6 +59,7 @@
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 
 #include "boost-graph-ndn-global-routing-helper.h"
+#include "ndn-global-routing-tables.h"
 
 #include <math.h>
 
@@ -463,6 +464,49 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes (bool invalidatedRoutes/* = true
         }
     }
 }
+static GlobalRoutingTables *g_routingTables = 0;
+
+static void
+DestroyRoutingTables ()
+{
+  delete g_routingTables;
+  g_routingTables = 0;
+}
+
+// The tables hold routers and faces of the simulation: they go away with it
+static GlobalRoutingTables &
+GetRoutingTables ()
+{
+  if (g_routingTables == 0)
+    {
+      g_routingTables = new GlobalRoutingTables ();
+      Simulator::ScheduleDestroy (&DestroyRoutingTables);
+    }
+  return *g_routingTables;
+}
+
+void
+GlobalRoutingHelper::CalculateRoutesParallel (uint32_t threads/* = 0*/)
+{
+  GetRoutingTables ().CalculateAll (threads, false);
+}
+
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutesParallel (uint32_t threads/* = 0*/)
+{
+  GetRoutingTables ().CalculateAll (threads, true);
+}
+
+void
+GlobalRoutingHelper::UpdateRoutes (uint32_t threads/* = 0*/)
+{
+  if (!GetRoutingTables ().Update (threads))
+    {
+      NS_LOG_INFO ("Topology changed or no routes calculated yet, calculating all routes");
+      GetRoutingTables ().CalculateAll (threads, GetRoutingTables ().IsMultipath ());
+    }
+}
+
 void GlobalRoutingHelper::InstallCachedRoutes()
 {
 	for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
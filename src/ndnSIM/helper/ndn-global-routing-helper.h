@@ -119,6 +119,45 @@ public:
   static void
   CalculateAllPossibleRoutes (bool invalidatedRoutes = true);
 
+  /**
+   * @brief Calculate the same shortest-path routes as CalculateRoutes, with the per-source
+   *        Dijkstra spread over several threads
+   *
+   * The shortest-path trees and the installed next hops are kept until Simulator::Destroy,
+   * so that UpdateRoutes can later recompute only what changed.  Faces that are down (see LinkControlHelper) are not
+   * used.  Among equal-cost paths, the chosen next hop may differ from CalculateRoutes.
+   *
+   * @param threads number of threads, 0 for one per processor
+   */
+  static void
+  CalculateRoutesParallel (uint32_t threads = 0);
+
+  /**
+   * @brief Calculate the same routes as CalculateAllPossibleRoutes (one route per outgoing face),
+   *        with the Dijkstra of every (node, face) pair spread over several threads
+   *
+   * As for CalculateRoutesParallel, the trees are kept for UpdateRoutes and faces that are down are not used.
+   *
+   * @param threads number of threads, 0 for one per processor
+   */
+  static void
+  CalculateAllPossibleRoutesParallel (uint32_t threads = 0);
+
+  /**
+   * @brief Update the routes after links (face up/down, metric) or origins changed
+   *
+   * Only the shortest-path trees affected by the changed links are recomputed, and only the
+   * next hops that differ from the installed ones are applied to the FIBs, in the mode (shortest path
+   * or all possible routes) of the last calculation.  Falls back to a full calculation if nodes or links
+   * were added, or to CalculateRoutesParallel if no calculation was done yet.
+   *
+   * Example: LinkControlHelper::FailLink (n1, n2); GlobalRoutingHelper::UpdateRoutes ();
+   *
+   * @param threads number of threads, 0 for one per processor
+   */
+  static void
+  UpdateRoutes (uint32_t threads = 0);
+
   void
   InstallCachedRoutes();
 
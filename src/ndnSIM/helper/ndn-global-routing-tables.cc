@@ -0,0 +1,390 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Shortest-path trees kept between two route calculations of GlobalRoutingHelper
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-global-routing-tables.h"
+
+#include "../model/ndn-global-router.h"
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-fib-entry.h"
+#include "ns3/ndn-limits.h"
+
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/nstime.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingTables");
+
+namespace ns3 {
+namespace ndn {
+
+// Bound to const references (std::vector::assign)
+const uint32_t GlobalRoutingTables::Unreachable;
+const uint32_t GlobalRoutingTables::NoEdge;
+
+GlobalRoutingTables::GlobalRoutingTables ()
+  : m_multipath (false)
+{
+}
+
+bool
+GlobalRoutingTables::TakeSnapshot (std::vector<uint32_t> &changedEdges, bool &prefixesChanged)
+{
+  // Same vertices, in the same order, as NdnGlobalRouterGraph
+  std::vector< Ptr<GlobalRouter> > vertices;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        vertices.push_back (gr);
+    }
+  for (ChannelList::Iterator channel = ChannelList::Begin (); channel != ChannelList::End (); channel++)
+    {
+      Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        vertices.push_back (gr);
+    }
+
+  std::unordered_map<uint32_t, uint32_t> index;
+  for (uint32_t v = 0; v < vertices.size (); v++)
+    index[vertices[v]->GetId ()] = v;
+
+  std::vector<uint32_t> edgeBegin (1, 0);
+  std::vector<Edge> edges;
+  std::vector< std::vector< Ptr<const Name> > > prefixes (vertices.size ());
+  for (uint32_t v = 0; v < vertices.size (); v++)
+    {
+      GlobalRouter::IncidencyList &incidencies = vertices[v]->GetIncidencies ();
+      for (GlobalRouter::IncidencyList::iterator i = incidencies.begin (); i != incidencies.end (); i++)
+        {
+          Edge edge;
+          edge.m_target = index[i->get<2> ()->GetId ()];
+          edge.m_face = i->get<1> ();
+          edge.m_metric = 0;
+          edge.m_delay = 0.0;
+          if (edge.m_face != 0)
+            {
+              // Unlike CalculateRoutes, links failed by LinkControlHelper are not used
+              edge.m_metric = edge.m_face->IsUp () ? edge.m_face->GetMetric () : Unreachable;
+              Ptr<Limits> limits = edge.m_face->GetObject<Limits> ();
+              if (limits != 0)
+                edge.m_delay = limits->GetLinkDelay ();
+            }
+          edges.push_back (edge);
+        }
+      edgeBegin.push_back (edges.size ());
+
+      const GlobalRouter::LocalPrefixList &local = vertices[v]->GetLocalPrefixes ();
+      prefixes[v].assign (local.begin (), local.end ());
+    }
+
+  bool same = (vertices == m_vertices && edgeBegin == m_edgeBegin);
+  changedEdges.clear ();
+  prefixesChanged = !same || prefixes != m_prefixes;
+  for (uint32_t e = 0; same && e < edges.size (); e++)
+    {
+      if (edges[e].m_target != m_edges[e].m_target || edges[e].m_face != m_edges[e].m_face)
+        same = false;
+      else if (edges[e].m_metric != m_edges[e].m_metric || edges[e].m_delay != m_edges[e].m_delay)
+        changedEdges.push_back (e);
+    }
+
+  m_vertices.swap (vertices);
+  m_edgeBegin.swap (edgeBegin);
+  m_edges.swap (edges);
+  m_prefixes.swap (prefixes);
+
+  m_sources.clear ();
+  for (uint32_t v = 0; v < m_vertices.size (); v++)
+    {
+      if (m_vertices[v]->GetObject<Fib> () != 0)
+        m_sources.push_back (v);
+    }
+  return same;
+}
+
+void
+GlobalRoutingTables::Dijkstra (uint32_t source, Tree &tree) const
+{
+  uint32_t size = m_vertices.size ();
+  tree.m_dist.assign (size, Unreachable);
+  tree.m_pred.assign (size, NoEdge);
+  tree.m_hop.assign (size, NoEdge);
+  tree.m_delay.assign (size, 0.0);
+
+  typedef std::pair<uint32_t, uint32_t> Item; // (distance, vertex)
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item> > queue;
+  tree.m_dist[source] = 0;
+  queue.push (Item (0, source));
+
+  while (!queue.empty ())
+    {
+      Item item = queue.top ();
+      queue.pop ();
+      uint32_t u = item.second;
+      if (item.first > tree.m_dist[u])
+        continue;
+
+      for (uint32_t e = m_edgeBegin[u]; e < m_edgeBegin[u + 1]; e++)
+        {
+          const Edge &edge = m_edges[e];
+          if (edge.m_metric == Unreachable)
+            continue;
+          if (u == source && tree.m_first != NoEdge && e != tree.m_first)
+            continue;
+          uint32_t dist = item.first + edge.m_metric;
+          uint32_t v = edge.m_target;
+          if (dist < tree.m_dist[v])
+            {
+              tree.m_dist[v] = dist;
+              tree.m_pred[v] = e;
+              tree.m_hop[v] = (u == source) ? e : tree.m_hop[u];
+              tree.m_delay[v] = tree.m_delay[u] + edge.m_delay;
+              queue.push (Item (dist, v));
+            }
+        }
+    }
+}
+
+bool
+GlobalRoutingTables::IsAffected (uint32_t source, const Tree &tree, const std::vector<uint32_t> &changedEdges) const
+{
+  // A tree changes if a changed edge is on it, or if it now offers a shorter path
+  for (uint32_t c = 0; c < changedEdges.size (); c++)
+    {
+      uint32_t e = changedEdges[c];
+      const Edge &edge = m_edges[e];
+      uint32_t u = std::upper_bound (m_edgeBegin.begin (), m_edgeBegin.end (), e) - m_edgeBegin.begin () - 1;
+      if (u == source && tree.m_first != NoEdge && e != tree.m_first)
+        continue;
+      if (tree.m_pred[edge.m_target] == e
+          || (edge.m_metric != Unreachable && tree.m_dist[u] != Unreachable
+              && tree.m_dist[u] + edge.m_metric < tree.m_dist[edge.m_target]))
+        return true;
+    }
+  return false;
+}
+
+void
+GlobalRoutingTables::ComputeTrees (const Jobs &jobs, uint32_t threads)
+{
+  if (threads == 0)
+    threads = std::max (1u, std::thread::hardware_concurrency ());
+  threads = std::min<uint32_t> (threads, jobs.size ());
+
+  std::atomic<uint32_t> next (0);
+  auto worker = [this, &jobs, &next] ()
+    {
+      for (uint32_t i = next++; i < jobs.size (); i = next++)
+        Dijkstra (jobs[i].first, *jobs[i].second);
+    };
+
+  std::vector<std::thread> pool;
+  for (uint32_t i = 1; i < threads; i++)
+    pool.push_back (std::thread (worker));
+  worker ();
+  for (uint32_t i = 0; i < pool.size (); i++)
+    pool[i].join ();
+
+  NS_LOG_INFO (jobs.size () << " shortest-path trees computed on " << std::max (threads, 1u) << " thread(s)");
+}
+
+void
+GlobalRoutingTables::CollectRoutes (uint32_t source, RouteMap &routes) const
+{
+  const std::vector<Tree> &trees = m_trees.find (source)->second;
+  for (uint32_t t = 0; t < trees.size (); t++)
+    {
+      const Tree &tree = trees[t];
+      for (uint32_t v = 0; v < m_vertices.size (); v++)
+        {
+          if (v == source || tree.m_hop[v] == NoEdge || m_prefixes[v].empty ())
+            continue;
+
+          Ptr<Face> face = m_edges[tree.m_hop[v]].m_face;
+          for (uint32_t p = 0; p < m_prefixes[v].size (); p++)
+            {
+              std::map<Ptr<Face>, Route> &faces = routes[*m_prefixes[v][p]];
+              std::map<Ptr<Face>, Route>::iterator route = faces.find (face);
+              // Several origins reached through the same face: the FIB keeps the lowest metric
+              if (route == faces.end () || route->second.m_metric > tree.m_dist[v])
+                faces[face] = Route {tree.m_dist[v], tree.m_delay[v]};
+            }
+        }
+    }
+}
+
+void
+GlobalRoutingTables::ApplyRoutes (uint32_t source, const RouteMap &routes, bool fresh)
+{
+  Ptr<Fib> fib = m_vertices[source]->GetObject<Fib> ();
+  NS_ASSERT (fib != 0);
+
+  RouteMap &installed = m_installed[source];
+  if (fresh)
+    {
+      fib->InvalidateAll ();
+      installed.clear ();
+    }
+
+  uint32_t added = 0, removed = 0;
+  for (RouteMap::const_iterator prefix = routes.begin (); prefix != routes.end (); prefix++)
+    {
+      RouteMap::iterator old = installed.find (prefix->first);
+      for (std::map<Ptr<Face>, Route>::const_iterator route = prefix->second.begin ();
+           route != prefix->second.end (); route++)
+        {
+          if (old != installed.end ())
+            {
+              std::map<Ptr<Face>, Route>::iterator oldRoute = old->second.find (route->first);
+              if (oldRoute != old->second.end ())
+                {
+                  if (oldRoute->second.m_metric == route->second.m_metric
+                      && oldRoute->second.m_delay == route->second.m_delay)
+                    continue;
+                  // Fib::Add never raises the metric of a next hop, unless it is invalid
+                  Ptr<fib::Entry> entry = fib->Find (prefix->first);
+                  if (entry != 0)
+                    entry->UpdateStatus (route->first, fib::FaceMetric::NDN_FIB_RED);
+                }
+            }
+
+          Ptr<fib::Entry> entry = fib->Add (prefix->first, route->first, route->second.m_metric);
+          entry->SetRealDelayToProducer (route->first, Seconds (route->second.m_delay));
+
+          Ptr<Limits> faceLimits = route->first->GetObject<Limits> ();
+          Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+          if (fibLimits != 0)
+            {
+              // if it was created by the forwarding strategy via DidAddFibEntry event
+              fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * route->second.m_delay /*exact RTT*/);
+            }
+          added++;
+        }
+    }
+
+  // Next hops not used any more. Entries are never removed, since PIT entries may refer to them
+  for (RouteMap::iterator prefix = installed.begin (); prefix != installed.end (); prefix++)
+    {
+      RouteMap::const_iterator current = routes.find (prefix->first);
+      for (std::map<Ptr<Face>, Route>::iterator route = prefix->second.begin ();
+           route != prefix->second.end (); route++)
+        {
+          if (current != routes.end () && current->second.find (route->first) != current->second.end ())
+            continue;
+
+          Ptr<fib::Entry> entry = fib->Find (prefix->first);
+          if (entry == 0)
+            continue;
+          if (entry->GetFaces ().size () > 1)
+            entry->RemoveFace (route->first);
+          else
+            entry->Invalidate ();
+          removed++;
+        }
+    }
+
+  installed = routes;
+  NS_LOG_DEBUG ("Node " << m_vertices[source]->GetObject<Node> ()->GetId () << ": "
+                << added << " next hop(s) set, " << removed << " withdrawn");
+}
+
+void
+GlobalRoutingTables::CalculateAll (uint32_t threads, bool multipath)
+{
+  std::vector<uint32_t> changedEdges;
+  bool prefixesChanged;
+  TakeSnapshot (changedEdges, prefixesChanged);
+
+  m_multipath = multipath;
+  m_trees.clear ();
+  m_installed.clear ();
+
+  // Trees are created here, so the workers never modify m_trees itself
+  Jobs jobs;
+  for (uint32_t i = 0; i < m_sources.size (); i++)
+    {
+      uint32_t source = m_sources[i];
+      std::vector<Tree> &trees = m_trees[source];
+      if (m_multipath)
+        {
+          trees.resize (m_edgeBegin[source + 1] - m_edgeBegin[source]);
+          for (uint32_t t = 0; t < trees.size (); t++)
+            trees[t].m_first = m_edgeBegin[source] + t;
+        }
+      else
+        {
+          trees.resize (1);
+          trees[0].m_first = NoEdge;
+        }
+      for (uint32_t t = 0; t < trees.size (); t++)
+        jobs.push_back (std::make_pair (source, &trees[t]));
+    }
+  ComputeTrees (jobs, threads);
+
+  for (uint32_t i = 0; i < m_sources.size (); i++)
+    {
+      RouteMap routes;
+      CollectRoutes (m_sources[i], routes);
+      ApplyRoutes (m_sources[i], routes, true);
+    }
+}
+
+bool
+GlobalRoutingTables::Update (uint32_t threads)
+{
+  if (m_vertices.empty ())
+    return false;
+
+  std::vector<uint32_t> changedEdges;
+  bool prefixesChanged;
+  if (!TakeSnapshot (changedEdges, prefixesChanged))
+    return false;
+
+  Jobs jobs;
+  std::vector<uint32_t> affected;
+  for (uint32_t i = 0; i < m_sources.size (); i++)
+    {
+      std::vector<Tree> &trees = m_trees[m_sources[i]];
+      for (uint32_t t = 0; t < trees.size (); t++)
+        {
+          if (IsAffected (m_sources[i], trees[t], changedEdges))
+            jobs.push_back (std::make_pair (m_sources[i], &trees[t]));
+        }
+      if (!jobs.empty () && jobs.back ().first == m_sources[i])
+        affected.push_back (m_sources[i]);
+    }
+
+  NS_LOG_INFO (changedEdges.size () << " link(s) changed, " << jobs.size () << " tree(s) of "
+               << affected.size () << " of " << m_sources.size () << " source(s) affected"
+               << (prefixesChanged ? ", origins changed" : ""));
+
+  ComputeTrees (jobs, threads);
+
+  const std::vector<uint32_t> &targets = prefixesChanged ? m_sources : affected;
+  for (uint32_t i = 0; i < targets.size (); i++)
+    {
+      RouteMap routes;
+      CollectRoutes (targets[i], routes);
+      ApplyRoutes (targets[i], routes, false);
+    }
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Shortest-path trees kept between two route calculations of GlobalRoutingHelper
+ *
+ * The GlobalRouter graph is copied into flat arrays (one snapshot per calculation),
+ * and one Dijkstra per source runs on the snapshot, so the trees can be computed
+ * on several threads. The trees and the next hops installed in every FIB are kept:
+ * after a link or origin change only the affected trees are recomputed and only
+ * the next hops that differ are applied.
+ *
+ * In multipath mode every source has one tree per outgoing face, computed with the
+ * other faces of the source disabled, as CalculateAllPossibleRoutes does.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_GLOBAL_ROUTING_TABLES_H
+#define NDN_GLOBAL_ROUTING_TABLES_H
+
+#include "ns3/ptr.h"
+#include "ns3/ndn-name.h"
+
+#include <vector>
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+class Face;
+
+class GlobalRoutingTables
+{
+public:
+  GlobalRoutingTables ();
+
+  /**
+   * @brief Compute the trees of all sources and install all the routes
+   * @param threads number of threads running Dijkstra, 0: one per processor
+   * @param multipath one route per outgoing face instead of the shortest path only
+   */
+  void
+  CalculateAll (uint32_t threads, bool multipath);
+
+  /**
+   * @brief Recompute the trees affected by the changes since the last calculation
+   *        and apply the next hops that changed
+   *
+   * Return false (and do nothing) if nodes or links were added or removed since
+   * the last calculation; CalculateAll is needed then.
+   */
+  bool
+  Update (uint32_t threads);
+
+  bool
+  IsEmpty () const
+  {
+    return m_vertices.empty ();
+  }
+
+  bool
+  IsMultipath () const
+  {
+    return m_multipath;
+  }
+
+private:
+  static const uint32_t Unreachable = 0xFFFFFFFF;
+  static const uint32_t NoEdge = 0xFFFFFFFF;
+
+  struct Edge
+  {
+    uint32_t   m_target;
+    Ptr<Face>  m_face;      // 0 for the edges leaving a multi-access channel
+    uint32_t   m_metric;    // Unreachable if the face is down
+    double     m_delay;
+  };
+
+  struct Tree
+  {
+    uint32_t              m_first;  // Only edge used out of the source, NoEdge for all of them
+    std::vector<uint32_t> m_dist;
+    std::vector<uint32_t> m_pred;   // Edge reaching the vertex
+    std::vector<uint32_t> m_hop;    // First edge out of the source
+    std::vector<double>   m_delay;
+  };
+
+  struct Route
+  {
+    uint32_t m_metric;
+    double   m_delay;
+  };
+
+  typedef std::map<Name, std::map<Ptr<Face>, Route> > RouteMap;
+  typedef std::vector<std::pair<uint32_t, Tree*> > Jobs;  // (source vertex, tree to compute)
+
+  /**
+   * Copy the graph. Return false if the structure (vertices and edges) differs from
+   * the current snapshot, in which case the snapshot is replaced anyway.
+   */
+  bool
+  TakeSnapshot (std::vector<uint32_t> &changedEdges, bool &prefixesChanged);
+
+  void
+  ComputeTrees (const Jobs &jobs, uint32_t threads);
+
+  void
+  Dijkstra (uint32_t source, Tree &tree) const;
+
+  bool
+  IsAffected (uint32_t source, const Tree &tree, const std::vector<uint32_t> &changedEdges) const;
+
+  void
+  CollectRoutes (uint32_t source, RouteMap &routes) const;
+
+  void
+  ApplyRoutes (uint32_t source, const RouteMap &routes, bool fresh);
+
+  std::vector< Ptr<GlobalRouter> >    m_vertices;
+  std::vector<uint32_t>               m_edgeBegin;   // Edges of vertex v: [m_edgeBegin[v], m_edgeBegin[v + 1])
+  std::vector<Edge>                   m_edges;
+  std::vector< std::vector< Ptr<const Name> > > m_prefixes;
+
+  bool                    m_multipath;
+  std::vector<uint32_t>   m_sources;     // Vertices of nodes with a FIB
+  std::map<uint32_t, std::vector<Tree> > m_trees;  // Source vertex -> trees, one per outgoing face in multipath mode
+  std::map<uint32_t, RouteMap> m_installed;   // Source vertex -> next hops installed in its FIB
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTING_TABLES_H
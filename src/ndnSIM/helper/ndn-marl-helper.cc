@@ -24,6 +24,7 @@
 #include "ns3/string.h"
 
 #include <cmath>
+#include <cstdio>
 #include <sstream>
 
 
@@ -330,6 +331,8 @@ MARLHelper::BeforeTransition()
 			}
 			rlptr->ResetToInit();
 		}
+		if(m_binaryQ && m_checkpoint > 0 && m_currepisode % m_checkpoint == 0)
+			OutputBinaryQTable(true);
 		Simulator::Schedule (m_episode_gap, &MARLHelper::StartRL, this);
 	}
 	else
@@ -417,6 +420,7 @@ MARLHelper::GapForReplacement()
 	}
 }
 
+#ifdef HAVE_MYSQL
 void
 MARLHelper::PrepareSqlUpdate(sql::Connection* c, const std::string& tn,
 		  const std::string& cn, const std::string& kn,
@@ -429,10 +433,17 @@ MARLHelper::PrepareSqlUpdate(sql::Connection* c, const std::string& tn,
 	m_databaseName = name;
 	key = kv;
 }
+#endif
 
 void
 MARLHelper::InputQTable()
 {
+	if(QTableReader::IsQTableFile(m_qTablePath) || QTableReader::IsQTableFile(m_qTablePath + ".delta"))
+	{
+		InputBinaryQTable();
+		return;
+	}
+
 	std::string line;
 	for(auto i = m_topo_order_ptr.begin(); i != m_topo_order_ptr.end(); i++)
 	{
@@ -458,6 +469,12 @@ MARLHelper::InputQTable()
 
 void MARLHelper::OutputQTable()
 {
+	if(m_binaryQ)
+	{
+		OutputBinaryQTable(false);
+		return;
+	}
+
 	if(m_qrecorder == nullptr)
 		m_qrecorder = new std::fstream;
 	m_qrecorder->open(m_qTablePath.c_str(), std::ios::out | std::ios::trunc);
@@ -479,6 +496,55 @@ void MARLHelper::OutputQTable()
 	}
 }
 
+void
+MARLHelper::InputBinaryQTable()
+{
+	if(m_qrecorder != nullptr)
+		m_qrecorder->close();
+
+	// The snapshot first, then the checkpoints taken after it
+	std::string paths[2] = {m_qTablePath, m_qTablePath + ".delta"};
+	for(uint32_t p = 0; p < 2; p++)
+	{
+		QTableReader reader;
+		if(!reader.Open(paths[p]))
+			continue;
+		for(auto i = m_topo_order_ptr.begin(); i != m_topo_order_ptr.end(); i++)
+		{
+			Ptr<MARLnfa> rlptr = (*i)->GetObject<MARLnfa>();
+			if(rlptr != 0)
+				rlptr->InputQStatus(reader);
+		}
+		std::cout << "Read QTable " << paths[p] << ": " << reader.GetNumSegments() << " segment(s)" << std::endl;
+	}
+}
+
+void
+MARLHelper::OutputBinaryQTable(bool incremental)
+{
+	QTableWriter writer(incremental);
+	for(auto i = m_topo_order_ptr.begin(); i != m_topo_order_ptr.end(); i++)
+	{
+		Ptr<MARLnfa> rlptr = (*i)->GetObject<MARLnfa>();
+		if(rlptr != 0)
+			rlptr->OutputQStatus(writer, incremental);
+	}
+
+	if(incremental)
+	{
+		if(!writer.Save(m_qTablePath + ".delta"))
+			std::cout << "Write QTable Checkpoint Failure!" << std::endl;
+		return;
+	}
+
+	// Drop the checkpoints before the new snapshot replaces the old one:
+	// the checkpoints must never be applied on top of a newer snapshot
+	std::string deltapath = m_qTablePath + ".delta";
+	std::remove(deltapath.c_str());
+	if(!writer.Save(m_qTablePath))
+		std::cout << "Write QTable Failure!" << std::endl;
+}
+
 
 }
 }
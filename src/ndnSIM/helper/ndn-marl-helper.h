@@ -22,11 +22,12 @@
 #include <string>
 #include <fstream>
 
-
+#ifdef HAVE_MYSQL
 #include "mysql_connection.h"
 #include <cppconn/driver.h>
 #include <cppconn/exception.h>
 #include <cppconn/statement.h>
+#endif
 
 namespace ns3{
 namespace ndn{
@@ -52,6 +53,25 @@ public:
 	void SetLogPath (const std::string & logpath,
 					 const std::string & qpath);
 
+	/*
+	 * Save the Q-table in the binary format (ndn-marl-qtable-file.h) instead of text.
+	 * Binary tables are recognized when loaded whatever this setting.
+	 */
+	inline void SetBinaryQTable(bool binary)
+	{
+		m_binaryQ = binary;
+	}
+
+	/*
+	 * Every 'episodes' episodes, append the entries updated since the previous
+	 * checkpoint to <qpath>.delta (binary format only, 0: disabled). The deltas
+	 * are applied when the table is loaded and dropped by the final full dump.
+	 */
+	inline void SetCheckpointInterval(uint32_t episodes)
+	{
+		m_checkpoint = episodes;
+	}
+
 	void
 	InstallAll();
 
@@ -63,9 +83,11 @@ public:
 	StartRL();
 
 public:
+#ifdef HAVE_MYSQL
 	void PrepareSqlUpdate(sql::Connection*, const std::string&,
 						  const std::string&, const std::string&,
 						  uint32_t, const std::string& name = "Sigcomm17");
+#endif
 
 	void GapForReplacement();
 
@@ -82,6 +104,8 @@ private:
 
 	void InputQTable();
 	void OutputQTable();
+	void InputBinaryQTable();
+	void OutputBinaryQTable(bool incremental);
 
 private:
 	//bool 			m_measurement = false;	// m_measurement is set to be true when the simulator start tracers
@@ -106,16 +130,20 @@ private:
 	UniformVariable m_SeqRng; //RNG
 
 private:
+#ifdef HAVE_MYSQL
 	sql::Connection* con;
+#endif
 	std::string		m_TableName;
 	std::string 	m_ColumnName;
 	std::string		m_KeyName;
 	std::string		m_databaseName;
 	uint32_t		key;
 
-	std::ofstream* 	m_log;
-	std::fstream*	m_qrecorder;
+	std::ofstream* 	m_log = nullptr;
+	std::fstream*	m_qrecorder = nullptr;
 	std::string		m_qTablePath;
+	bool			m_binaryQ = false;
+	uint32_t		m_checkpoint = 0;	// Episodes between two incremental checkpoints
 
 };
 
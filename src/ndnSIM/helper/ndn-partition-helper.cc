@@ -9,6 +9,9 @@
 #include "ns3/simulator.h"
 #include "ns3/nstime.h"
 #include "ns3/ndn-content-store.h"
+#ifdef HAVE_MYSQL
+#include "ns3/ndn-mysql-trace-sink.h"
+#endif
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
@@ -21,6 +24,7 @@ NS_LOG_COMPONENT_DEFINE ("ndn.CachePartition");
 namespace ns3{
 namespace ndn{
 
+#ifdef HAVE_MYSQL
 PartitionHelper::PartitionHelper(uint32_t NumF, uint32_t NumC, uint32_t NumB, uint32_t NumNodes,
 								 const std::string ArrB[], uint32_t EdgeSize, uint32_t IntmSize,
 								 const std::string& prefix,
@@ -34,15 +38,23 @@ PartitionHelper::PartitionHelper(uint32_t NumF, uint32_t NumC, uint32_t NumB, ui
 								 const std::string& password,
 								 const std::string& ip,
 								 int port)
+	:PartitionHelper(NumF, NumC, NumB, NumNodes, ArrB, EdgeSize, IntmSize, prefix, roundtime,
+					 alpha, id, designchoice, iterations, logpath,
+					 Create<MySqlTraceSink> (driver, ip, port, DatabaseName, user, password))
+{
+
+}
+#endif
+
+PartitionHelper::PartitionHelper(uint32_t NumF, uint32_t NumC, uint32_t NumB, uint32_t NumNodes,
+								 const std::string ArrB[], uint32_t EdgeSize, uint32_t IntmSize,
+								 const std::string& prefix,
+								 const std::string& roundtime,
+								 double alpha, uint32_t id, uint32_t designchoice,
+								 uint32_t iterations,
+								 const std::string& logpath,
+								 Ptr<TraceSink> sink)
 {
-	try{
-		env = new GRBEnv();
-	}
-	catch (GRBException& e)
-	{
-		std::cout << e.getMessage() << std::endl;
-	}
-	model = nullptr;
 	m_totalreq = 0;
 
 	m_NumOfChunks = NumC;
@@ -62,8 +74,12 @@ PartitionHelper::PartitionHelper(uint32_t NumF, uint32_t NumC, uint32_t NumB, ui
 	m_expid = id;
 
 	m_BRnames = new std::string [NumB + 1];
+	m_BRranks = new uint32_t [NumB + 1];
 	for(uint32_t i = 1; i <= NumB; i++)
+	{
 		m_BRnames[i] = "br" + ArrB[i - 1];
+		m_BRranks[i] = NDNBitRate::InternBitRate(ArrB[i - 1]);
+	}
 
 	m_log = new std::ofstream;
 	m_log->open(logpath.c_str(), std::ofstream::out | std::ofstream::trunc);
@@ -74,38 +90,17 @@ PartitionHelper::PartitionHelper(uint32_t NumF, uint32_t NumC, uint32_t NumB, ui
 		m_log = nullptr;
 	}
 
-	try{
-		sql::ConnectOptionsMap properties;
-		properties["hostName"] = "tcp://" + ip;
-		properties["userName"] = user;
-		properties["password"] = password;
-		properties["port"] = port;
-		properties["schema"] = DatabaseName;
-		properties["OPT_RECONNECT"] = true;
-
-		m_con = driver->connect(properties);
-		m_stmt = m_con->createStatement();
-
-		m_stmt->execute("CREATE TABLE IF NOT EXISTS CacheStatus (ExpID SMALLINT, Transition SMALLINT, NodeID SMALLINT, `BitRate(Kbps)` VARCHAR(4), Size INT);");
-
-	}
-	catch (sql::SQLException &e) {
-		std::cout << "# ERR: SQLException in " << __FILE__;
-		std::cout << "(" << __FUNCTION__ << ") on line "
-		     << __LINE__ << std::endl;
-		std::cout << "# ERR: " << e.what();
-		std::cout << " (MySQL error code: " << e.getErrorCode();
-		std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-	}
+	m_sink = sink;
+	m_sink->CreateTable("CacheStatus", {{"ExpID", "SMALLINT"}, {"Transition", "SMALLINT"}, {"NodeID", "SMALLINT"},
+										{"BitRate(Kbps)", "VARCHAR(4)"}, {"Size", "INT"}});
 }
 
 PartitionHelper::~PartitionHelper()
 {
-	delete env;
-	env = nullptr;
-
 	delete [] m_BRnames;
 	m_BRnames = nullptr;
+	delete [] m_BRranks;
+	m_BRranks = nullptr;
 
 	if(m_log != nullptr){
 		m_log->flush();
@@ -115,10 +110,7 @@ PartitionHelper::~PartitionHelper()
 		m_log = nullptr;
 	}
 
-	delete m_stmt;
-	m_stmt = nullptr;
-	delete m_con;
-	m_con = nullptr;
+	m_sink->Flush();
 }
 
 bool
@@ -168,44 +160,35 @@ PartitionHelper::Solver()
 {
 	OutputCacheStatus(m_itercounter);
 
-	int status = SolveIntegerPro();
+	PartitionSolver::Status status = SolveIntegerPro();
 	//VerifyMARLDesign();
 
-	if(model->get(GRB_DoubleAttr_MIPGap) > 4e-2)
+	if(m_solver->GetGap() > 4e-2)
 		std::cout << "Target Gap is not reached! [ExpID]: " << m_expid
 				  << "\tIteration: " << m_itercounter
-				  << "\tGap: "<< model->get(GRB_DoubleAttr_MIPGap)
+				  << "\tGap: "<< m_solver->GetGap()
 				  << std::endl;
-	if(status == GRB_OPTIMAL)
-		NS_LOG_INFO("SUCCEED TO FIND AN OPTIMAL Value: "<< model->get(GRB_DoubleAttr_ObjVal));
-	else if(status == GRB_INF_OR_UNBD)
+	if(status == PartitionSolver::OPTIMAL)
+		NS_LOG_INFO("SUCCEED TO FIND AN OPTIMAL Value: "<< PartitionSolver::Evaluate(m_problem, m_placement));
+	else if(status == PartitionSolver::HEURISTIC)
+		NS_LOG_INFO("HEURISTIC PLACEMENT Value: "<< PartitionSolver::Evaluate(m_problem, m_placement));
+	else if(status == PartitionSolver::INFEASIBLE)
 		NS_FATAL_ERROR("Infeasible!!!!");
-	else if(status == GRB_TIME_LIMIT)
+	else if(status == PartitionSolver::TIME_LIMIT)
 		NS_LOG_INFO("CANNOT SOLVE IP IN TIME LIMIT");
 	else
 		NS_FATAL_ERROR("Unexpected error occurs!");
 
-	// Get Optimized Result from GUROBI and Update Content Store(CS)
+	// Get Optimized Result from the solver and Update Content Store(CS)
 	std::unordered_map<uint32_t, std::vector<Name> > optresult;
-	auto iter = m_varDict.begin();
-	for(; iter != m_varDict.end(); iter++)
+	for(auto iter = m_placement.begin(); iter != m_placement.end(); iter++)
 	{
-		if(iter->second.get(GRB_DoubleAttr_X) > 0)
-		{
-			uint32_t nodeid = iter->first.m_id;
-			auto nodecs = optresult.find(nodeid);
-			if(nodecs == optresult.end())
-			{
-				std::vector<Name> newcs;
-				optresult[nodeid] = newcs;
-				nodecs = optresult.find(nodeid);
-			}
-			Ptr<Name> nameWithSequence = Create<ns3::ndn::Name>(m_prefix);
-			nameWithSequence->append(iter->first.m_vi.m_bitrate);
-			nameWithSequence->appendNumber(iter->first.m_vi.m_file);
-			nameWithSequence->appendNumber(iter->first.m_vi.m_chunk);
-			nodecs->second.push_back(*nameWithSequence);
-		}
+		const VideoIndex& vi = m_problem.m_items[iter->second].m_vi;
+		Ptr<Name> nameWithSequence = Create<ns3::ndn::Name>(m_prefix);
+		nameWithSequence->append(vi.GetBitRateComponent());
+		nameWithSequence->appendNumber(vi.m_file);
+		nameWithSequence->appendNumber(vi.m_chunk);
+		optresult[iter->first].push_back(*nameWithSequence);
 	}
 	//VerifyOptResult(optresult);
 	NS_LOG_DEBUG("SEE Iteration: " << m_itercounter);
@@ -266,31 +249,20 @@ PartitionHelper::OutputCacheStatus(uint32_t count)
 
 			}
 
-			std::ostringstream ss;
 			std::string tail = "kbps";
 			uint32_t safety = 0;
-			try{
-				for(auto entry = cssize.begin(); entry != cssize.end(); entry++)
-				{
-					std::size_t found = entry->first.find(tail);
-					safety += entry->second;
-
-					ss << "INSERT INTO CacheStatus VALUES(" << m_expid << ","
-															<< count << ","
-															<< (*iter)->GetId() << ","
-															<< entry->first.substr(0, found) << ","
-															<< entry->second << ");";
-					m_stmt->execute(ss.str());
-					ss.str("");
-				}
-			}
-			catch (sql::SQLException &e) {
-				std::cout << "# ERR: SQLException in " << __FILE__;
-				std::cout << "(" << __FUNCTION__ << ") on line "
-				     << __LINE__ << std::endl;
-				std::cout << "# ERR: " << e.what();
-				std::cout << " (MySQL error code: " << e.getErrorCode();
-				std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
+			for(auto entry = cssize.begin(); entry != cssize.end(); entry++)
+			{
+				std::size_t found = entry->first.find(tail);
+				safety += entry->second;
+
+				TraceRow row;
+				row.Add(m_expid)
+				   .Add(count)
+				   .Add((*iter)->GetId())
+				   .Add(std::stoi(entry->first.substr(0, found)))
+				   .Add(entry->second);
+				m_sink->Append("CacheStatus", row);
 			}
 			safety =  safety * 1e3;
 
@@ -318,150 +290,75 @@ PartitionHelper::IterativeRun()
 			BaseAppPtr->IncreaseTransition();
 		}
 	}
+	if(m_solver == 0)
+		m_solver = PartitionSolver::Create(m_solverName);
 	Solver();
 
 }
 
 void
-PartitionHelper::GRBModelInit()
+PartitionHelper::SetSolver(Ptr<PartitionSolver> solver)
 {
-	if(model != nullptr)
-	{
-		delete model;
-		model = nullptr;
-
-		m_varDict.clear();
-		m_pathvarDict.clear();
-	}
-	m_totalreq = 0;
-
-	model = new GRBModel(*env);
-
-	model->set(GRB_IntAttr_ModelSense, GRB_MAXIMIZE); //Optimize Objective
-	model->set(GRB_IntParam_MIPFocus, 3);	  //Try reducing the gap as much as possible
-	model->set(GRB_IntParam_Method, 3);	  //User concurrent solver
-	model->set(GRB_IntParam_LogToConsole, 1);//Print the solving procedure on screen
-	//model->set("LogFile", "/home/wenjie/ClionProjects/ndnSIM_ICC/ns-3/partition");
+	m_solver = solver;
+	m_placement.clear();
+}
 
-	model->set(GRB_DoubleParam_MIPGap,4e-2);		//Set gap distance (accuracy of result)
-	model->set(GRB_IntParam_Threads, 16);
-	model->set(GRB_DoubleParam_TimeLimit, 4800.0);	//Set time limit for solving optimization
+void
+PartitionHelper::SetSolver(const std::string& name)
+{
+	m_solver = 0;
+	m_solverName = name;
+	m_placement.clear();
 }
 
-int
+PartitionSolver::Status
 PartitionHelper::SolveIntegerPro()
 {
-	//Reset and Start a new Gurobi model
-	GRBModelInit();
+	m_totalreq = 0;
 
 	//Aggregate video requests statistics
 	UpdateRequestStat();
 
-	//Declare variables and add into Gurobi model
-	AddOptVar();
-
-	//Set Optimization Objective
-	SetOptimizationObj();
-
-	//Set Optimization Constraints
-	SetOptimizationConstr();
+	//The structure is built on the first iteration, later ones only refresh the data
+	if(m_problem.m_items.empty())
+		BuildProblem(m_problem);
+	UpdateProblem(m_problem);
 
-	model->update();
-	model->optimize();
-	return model->get(GRB_IntAttr_Status);
+	//Items are numbered the same way every iteration: the last placement is a warm start
+	PartitionPlacement placement;
+	PartitionSolver::Status status = m_solver->Solve(m_problem, m_placement.empty() ? nullptr : &m_placement, placement);
+	m_placement.swap(placement);
+	return status;
 }
 
 void
-PartitionHelper::AddOptVar()
+PartitionHelper::BuildProblem(PartitionProblem& problem)
 {
-	//model->addVar(0.0, 1.0, 0.0, GRB_BINARY);
+	Ptr<NDNBitRate> BRinfoPtr= (*(m_edgenodes.Begin()))->GetObject<NDNBitRate>();
 
-	//Add Binary Variable for Cache Placement Decision
+	//Cache Placement Decision X_j(f, k, b)
+	problem.m_bitrates = m_NumofBitRates;
+	problem.m_items.clear();
+	m_itemIndex.clear();
 	for(uint32_t f = 1; f <= m_NumOfFiles; f++)
 	{
 		for(uint32_t k = 1; k <= m_NumOfChunks; k++)
 		{
 			for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 			{
-				for(uint32_t n = 1; n < m_NumofNodes; n++)
-				{
-					m_varDict[VarIndex{n, VideoIndex{m_BRnames[b], f, k}}] = model->addVar(0.0, 1.0, 0.0, GRB_BINARY);
-				}
-				for(auto iter = m_forwardingpath.begin();
-						 iter != m_forwardingpath.end();
-						 iter++)
-				{
-					for(auto pathiter = iter->second.rbegin();
-							 pathiter != iter->second.rend();
-							 pathiter++)
-					{
-						// Add another constraint on \alpha_j(L(m), f, k, b), if j == L(m) since edgeid is included
-						m_pathvarDict[PathVarIndex{
-							iter->first, (*pathiter)->GetId(), VideoIndex{m_BRnames[b], f, k}}] = model->addVar(0.0, 1.0, 0.0, GRB_BINARY);
-					}
-				}
+				VideoIndex vi {m_BRranks[b], f, k};
+				m_itemIndex[vi] = problem.m_items.size();
+				problem.m_items.push_back(PartitionProblem::Item {vi, b,
+					static_cast<double>(BRinfoPtr->GetChunkSizeFromRank(m_BRranks[b]))});
 			}
 		}
 	}
-}
 
-void
-PartitionHelper::SetOptimizationObj()
-{
-	GRBLinExpr obj;
-
-	for(uint32_t b = 1; b <= m_NumofBitRates; b++)
-	{
-		for(auto iter = m_forwardingpath.begin();
-				 iter != m_forwardingpath.end();
-				 iter++)
-		{
-			Ptr<Node> EdgeNodePtr = *(iter->second.rbegin());
-			Ptr<VideoStatistics> vstats = EdgeNodePtr->GetObject<VideoStatistics>();
-			uint64_t ConcentricRing = SetBRBoundary(EdgeNodePtr, m_BRnames[b]);
-			uint64_t bd = ConcentricRing;
-			for(auto pathiter = iter->second.rbegin();
-					 pathiter != iter->second.rend();
-					 pathiter++)
-			{
-				double reward = CalReward(bd, b, EdgeNodePtr);
-				for(uint32_t f = 1; f <= m_NumOfFiles; f++)
-				{
-					for(uint32_t k = 1; k <= m_NumOfChunks; k++)
-					{
-						double popularity = (vstats->GetHitNum(VideoIndex{m_BRnames[b], f, k}) * 1e4) / static_cast<double>(m_totalreq);
-						if(pathiter == iter->second.rbegin())
-						{
-							auto GRBVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, (*pathiter)->GetId(), VideoIndex{m_BRnames[b], f, k}});
-							if(GRBVarPtr != m_pathvarDict.end())
-								obj += popularity * reward * GRBVarPtr->second;
-							else
-								NS_FATAL_ERROR("GRBVar Not Found!");
-						}
-						else
-						{
-							auto GRBVarPtr1 = m_pathvarDict.find(PathVarIndex{iter->first, (*pathiter)->GetId(), VideoIndex{m_BRnames[b], f, k}});
-							auto GRBVarPtr2 = m_pathvarDict.find(PathVarIndex{iter->first, (*(pathiter - 1))->GetId(), VideoIndex{m_BRnames[b], f, k}});
-							if(GRBVarPtr1 != m_pathvarDict.end() && GRBVarPtr2 != m_pathvarDict.end())
-								obj += popularity * reward * (GRBVarPtr1->second - GRBVarPtr2->second);
-							else
-								NS_FATAL_ERROR("GRBVar Not Found!!");
-						}
-					}
-				}
-			}
-		}
-	}
-	model->setObjective(obj);
-}
-
-void
-PartitionHelper::SetOptimizationConstr()
-{
-	//Cache Capacity Constraints
+	//Cache Capacity
+	problem.m_nodes.clear();
+	problem.m_capacity.assign(m_NumofNodes, 0);
 	for(uint32_t n = 1; n < m_NumofNodes; n++)
 	{
-		GRBLinExpr cache_constr;
 		bool isEdge = false;
 		for(NodeContainer::Iterator iter = m_edgenodes.Begin();
 									iter != m_edgenodes.End();
@@ -470,171 +367,70 @@ PartitionHelper::SetOptimizationConstr()
 			if((*iter)->GetId() == n)
 				isEdge = true;
 		}
-		uint32_t cachesize = isEdge ? m_edgesize : m_intmsize;
-		Ptr<NDNBitRate> BRinfoPtr= (*(m_edgenodes.Begin()))->GetObject<NDNBitRate>();
-		for(uint32_t b = 1; b <= m_NumofBitRates; b++)
-		{
-			uint32_t coeff = BRinfoPtr->GetChunkSize(m_BRnames[b].substr(2));
-			for(uint32_t f = 1; f <= m_NumOfFiles; f++)
-			{
-				for(uint32_t k = 1; k <= m_NumOfChunks; k++)
-				{
-					auto XVarPtr = m_varDict.find(VarIndex{n, VideoIndex{m_BRnames[b], f, k}});
-					if(XVarPtr != m_varDict.end())
-						cache_constr += coeff * (XVarPtr->second);
-					else
-						NS_FATAL_ERROR("GRBVar Not Found!!!");
-				}
-			}
-		}
-		model->addConstr(cache_constr, GRB_LESS_EQUAL, cachesize);
-	}
-
-	//Relationship Between \alpha and X
-	for(uint32_t f = 1; f <= m_NumOfFiles; f++)
-	{
-		for(uint32_t k = 1; k <= m_NumOfChunks; k++)
-		{
-			for(uint32_t b = 1; b <= m_NumofBitRates; b++)
-			{
-				for(auto iter = m_forwardingpath.begin();
-						 iter != m_forwardingpath.end();
-						 iter++)
-				{
-					std::deque<Ptr<Node> >::reverse_iterator pathiter = (iter->second.rbegin()) + 1;
-					for(; pathiter != iter->second.rend(); pathiter++)
-					{
-						if((*pathiter)->GetId() != (*(iter->second.begin()))->GetId())//Not the Video Producer
-						{
-							uint32_t currentid = (*pathiter)->GetId();
-							uint32_t previd = (*(pathiter - 1))->GetId();
-
-							auto currentVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, currentid, VideoIndex{m_BRnames[b], f, k}});
-							auto prevVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, previd, VideoIndex{m_BRnames[b], f, k}});
-							auto XVarPtr = m_varDict.find(VarIndex{currentid, VideoIndex{m_BRnames[b], f, k}});
-
-							model->addConstr(currentVarPtr->second, GRB_GREATER_EQUAL, prevVarPtr->second);
-							model->addConstr(currentVarPtr->second, GRB_GREATER_EQUAL, XVarPtr->second);
-							model->addConstr(currentVarPtr->second, GRB_LESS_EQUAL, prevVarPtr->second + XVarPtr->second);
-
-						}
-					}
-				}
-			}
-		}
+		problem.m_nodes.push_back(n);
+		problem.m_capacity[n] = isEdge ? m_edgesize : m_intmsize;
 	}
 
-	//Rate Adaptation Among Chunks (Avoid BitRate Oscillation)
-	/*
+	//Paths
+	problem.m_paths.clear();
 	for(auto iter = m_forwardingpath.begin();
 			 iter != m_forwardingpath.end();
 			 iter++)
 	{
-		std::deque<Ptr<Node> >::iterator rootptr = iter->second.begin();
-		uint32_t gateid = (*(++rootptr))->GetId();
+		problem.m_paths.push_back(PartitionProblem::Path());
+		PartitionProblem::Path& path = problem.m_paths.back();
+		path.m_edge = iter->first;
+		for(auto pathiter = iter->second.rbegin(); pathiter != iter->second.rend(); pathiter++)
+			path.m_nodes.push_back((*pathiter)->GetId());
+	}
+}
+
+void
+PartitionHelper::UpdateProblem(PartitionProblem& problem)
+{
+	//Reward and popularity on every path, in the order of m_forwardingpath
+	auto iter = m_forwardingpath.begin();
+	for(auto pathiter = problem.m_paths.begin(); pathiter != problem.m_paths.end(); pathiter++, iter++)
+	{
+		PartitionProblem::Path& path = *pathiter;
 		Ptr<Node> EdgeNodePtr = *(iter->second.rbegin());
-		uint64_t ConcentricRing = SetBRBoundary(EdgeNodePtr);
-		ConcentricRing = ConcentricRing >> (4 * (m_longestRoutingHop > 1 ? (m_longestRoutingHop - 1): 0));
-		uint8_t ProducerRing = static_cast<uint8_t>(ConcentricRing) & 0x0f;
-		for(uint32_t f = 1; f <= m_NumOfFiles; f++)
+		path.m_reward.assign(m_NumofBitRates + 1, std::vector<double>(path.m_nodes.size(), 0));
+		for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 		{
-			for(uint32_t k = 2; k <= m_NumOfChunks; k++)
-			{
-				for(uint32_t b = 1; b <= m_NumofBitRates; b++)
-				{
-					if(b > static_cast<uint32_t>(ProducerRing))
-					{
-						auto currentVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, gateid, VideoIndex{m_BRnames[b], f, k}});
-						auto prevVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, gateid, VideoIndex{m_BRnames[b], f, k - 1}});
-						if(b > 1)
-						{
-							auto prevVarPtr_l = m_pathvarDict.find(PathVarIndex{iter->first, gateid, VideoIndex{m_BRnames[b - 1], f, k - 1}});
-							if(b == m_NumofBitRates)
-								model->addConstr(prevVarPtr->second + prevVarPtr_l->second, GRB_GREATER_EQUAL, currentVarPtr->second);
-							else
-							{
-								auto prevVarPtr_h = m_pathvarDict.find(PathVarIndex{iter->first, gateid, VideoIndex{m_BRnames[b + 1], f, k - 1}});
-								model->addConstr(prevVarPtr->second + prevVarPtr_l->second + prevVarPtr_h->second, GRB_GREATER_EQUAL, currentVarPtr->second);
-							}
-						}
-						else
-						{
-							auto prevVarPtr_h = m_pathvarDict.find(PathVarIndex{iter->first, gateid, VideoIndex{m_BRnames[b + 1], f, k - 1}});
-							model->addConstr(prevVarPtr->second + prevVarPtr_h->second, GRB_GREATER_EQUAL, currentVarPtr->second);
-						}
-					}
-				}
-			}
+			uint64_t bd = SetBRBoundary(EdgeNodePtr, m_BRnames[b]);
+			for(uint32_t pos = 0; pos < path.m_nodes.size(); pos++)
+				path.m_reward[b][pos] = CalReward(bd, b, EdgeNodePtr);
 		}
-	}
-	*/
 
-	//Artificial Constraints
-	for(uint32_t b = 1; b <= m_NumofBitRates; b++)
-	{
-		for(uint32_t f = 1; f <= m_NumOfFiles; f++)
+		path.m_popularity.assign(problem.m_items.size(), 0);
+		path.m_order.assign(m_NumofBitRates + 1, std::vector<uint32_t>());
+		Ptr<VideoStatistics> vstats = EdgeNodePtr->GetObject<VideoStatistics>();
+		if(vstats == 0)
+			continue;
+		const std::unordered_map<VideoIndex, uint64_t>& table = vstats->GetTable();
+		for(auto entry = table.begin(); entry != table.end(); entry++)
 		{
-			for(uint32_t k = 1; k <= m_NumOfChunks; k++)
-			{
-				//
-				for(auto iter = m_forwardingpath.begin();
-						 iter != m_forwardingpath.end();
-						 iter++)
-				{
-					uint32_t rootid = (*(iter->second.begin()))->GetId();
-					auto GRBVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, rootid, VideoIndex{m_BRnames[b], f, k}});
-					model->addConstr(GRBVarPtr->second, GRB_EQUAL, 1);
-
-					uint32_t edgeid = (*(iter->second.rbegin()))->GetId();
-					GRBVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, edgeid, VideoIndex{m_BRnames[b], f, k}});
-					auto XVarPtr = m_varDict.find(VarIndex{iter->first, VideoIndex{m_BRnames[b], f, k}});
-					model->addConstr(GRBVarPtr->second, GRB_EQUAL, XVarPtr->second);
-				}
-			}
+			auto item = m_itemIndex.find(entry->first);
+			if(item != m_itemIndex.end())
+				path.m_popularity[item->second] = (entry->second * 1e4) / static_cast<double>(m_totalreq);
 		}
-	}
 
-	double M = 1e5;
-	for(NodeContainer::Iterator nodeiter = m_edgenodes.Begin();
-								nodeiter != m_edgenodes.End();
-								nodeiter++)
-	{
-		auto iter = m_forwardingpath.find((*nodeiter)->GetId());
+		//Popularity order, for the edge routers only
+		bool isEdge = false;
+		for(NodeContainer::Iterator nodeiter = m_edgenodes.Begin(); nodeiter != m_edgenodes.End(); nodeiter++)
+			if((*nodeiter)->GetId() == iter->first)
+				isEdge = true;
+		if(!isEdge)
+			continue;
 		PopularityTable pt;
-		Ptr<VideoStatistics> stats = (*nodeiter)->GetObject<VideoStatistics>();
-		OrderPopTable(stats, pt);
-
-		std::deque<Ptr<Node> >::iterator gateptr = iter->second.begin() + 1;
-		uint32_t gateid = (*gateptr)->GetId();
-		uint32_t producerid = (*(iter->second.begin()))->GetId();
-
-		for(auto pathiter = iter->second.rbegin();
-				 pathiter != iter->second.rend();
-				 pathiter++)
+		OrderPopTable(vstats, pt);
+		for(auto popiter = pt.begin(); popiter != pt.end(); popiter++)
 		{
-			if((*pathiter)->GetId() != gateid && (*pathiter)->GetId() != producerid)
+			for(uint32_t vidx = 0; vidx < popiter->second.size(); vidx++)
 			{
-				for(auto popiter = pt.begin(); popiter != pt.end(); popiter++)
-				{
-					for(uint32_t vidx = 1; vidx < popiter->second.size(); vidx++)
-					{
-						std::pair<VideoIndex, uint64_t> entry = (popiter->second)[vidx];
-						if(entry.second >= 1)
-						{
-							GRBLinExpr lhs_constr;
-							auto currentVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, (*pathiter)->GetId(), entry.first});
-							GRBLinExpr rhs_constr = M - M * currentVarPtr->second;
-							for(uint32_t previdx = 0; previdx < vidx; previdx++)
-							{
-								std::pair<VideoIndex, uint64_t> preentry = (popiter->second)[previdx];
-								auto prevGateVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, gateid, preentry.first});
-								auto prevVarPtr = m_pathvarDict.find(PathVarIndex{iter->first, (*pathiter)->GetId(), preentry.first});
-								lhs_constr += prevGateVarPtr->second - prevVarPtr->second;
-							}
-							model->addConstr(lhs_constr, GRB_LESS_EQUAL, rhs_constr);
-						}
-					}
-				}
+				auto item = m_itemIndex.find(popiter->second[vidx].first);
+				if(popiter->second[vidx].second >= 1 && item != m_itemIndex.end())
+					path.m_order[problem.m_items[item->second].m_bitrate].push_back(item->second);
 			}
 		}
 	}
@@ -645,7 +441,7 @@ bool cmp_by_value_video(const std::pair<ns3::ndn::VideoIndex, uint64_t>& lhs,
 { return (lhs.second > rhs.second)
 		 || (lhs.second == rhs.second && lhs.first.m_file < rhs.first.m_file)
 		 || (lhs.second == rhs.second && lhs.first.m_file == rhs.first.m_file && lhs.first.m_chunk < rhs.first.m_chunk)
-		 || (lhs.second == rhs.second && lhs.first.m_file == rhs.first.m_file && lhs.first.m_chunk == rhs.first.m_chunk && lhs.first.m_bitrate < rhs.first.m_bitrate);
+		 || (lhs.second == rhs.second && lhs.first.m_file == rhs.first.m_file && lhs.first.m_chunk == rhs.first.m_chunk && lhs.first.m_rank < rhs.first.m_rank);
 }
 
 void
@@ -655,8 +451,7 @@ PartitionHelper::OrderPopTable(Ptr<VideoStatistics> vstat, PopularityTable& vtab
 	auto vtableend = vstat->GetTable().end();
 	for(; vtableptr != vtableend; vtableptr++)
 	{
-		std::string br  = vtableptr->first.m_bitrate;
-		vtable[br].push_back(std::make_pair(vtableptr->first, vtableptr->second));
+		vtable[vtableptr->first.m_rank].push_back(std::make_pair(vtableptr->first, vtableptr->second));
 	}
 	for(auto iter = vtable.begin(); iter != vtable.end(); iter++)
 		std::sort(iter->second.begin(), iter->second.end(), ns3::ndn::cmp_by_value_video);
@@ -716,7 +511,7 @@ PartitionHelper::UpdateRequestStat()
 						totaldelay += record.second;
 					}
 				}
-				m_delaytable[DelayTableKey{m_BRnames[b].substr(2), hop, (*iter)->GetId()}]=
+				m_delaytable[DelayTableKey{m_BRranks[b], hop, (*iter)->GetId()}]=
 											(num != 0) ? (totaldelay / num) : (*iter)->GetObject<NDNBitRate>()->GetPlaybackTime() * 2000;
 			}
 		}
@@ -739,6 +534,10 @@ PartitionHelper::SetTopologicalOrder(Ptr<Node> ServerNode, NodeContainer edges)
 			m_longestRoutingHop = iter->second.size();
 	}
 	m_edgenodes = edges;
+
+	//Paths changed: the problem is rebuilt on the next iteration
+	m_problem = PartitionProblem();
+	m_placement.clear();
 }
 
 void
@@ -787,7 +586,7 @@ PartitionHelper::SetBRBoundary(Ptr<Node> edge)
 		double accumulatedDelay = 0;
 		for(uint32_t hop = 1; hop <= routelen; hop++)
 		{
-			auto iter = m_delaytable.find(DelayTableKey{BRinfoPtr->GetBRFromRank(i), hop, edge->GetId()});
+			auto iter = m_delaytable.find(DelayTableKey{i, hop, edge->GetId()});
 			if(iter != m_delaytable.end())
 			{
 				accumulatedDelay += (iter->second / 1000); //convert from MS to S
@@ -822,7 +621,7 @@ PartitionHelper::SetBRBoundary(Ptr<Node> edge, const std::string& reqbr)
 		double supersize = BRinfoPtr->GetChunkSize(BRinfoPtr->GetBRFromRank(superrank));
 		for(uint32_t hop = 1; hop <= routelen; hop++)
 		{
-			auto iter = m_delaytable.find(DelayTableKey{reqbr.substr(2), hop, edge->GetId()});
+			auto iter = m_delaytable.find(DelayTableKey{baserank, hop, edge->GetId()});
 			if(iter != m_delaytable.end())
 			{
 				if(accumulatedDelay + (iter->second / 1000) <= (limit * basesize / supersize) && hop > currentbd)
@@ -840,7 +639,7 @@ PartitionHelper::SetBRBoundary(Ptr<Node> edge, const std::string& reqbr)
 	}
 	for(uint32_t hop = currentbd + 1; hop <= routelen; hop++)
 	{
-		auto iter = m_delaytable.find(DelayTableKey{reqbr.substr(2), hop, edge->GetId()});
+		auto iter = m_delaytable.find(DelayTableKey{baserank, hop, edge->GetId()});
 		if(iter != m_delaytable.end())
 		{
 			if(accumulatedDelay + (iter->second / 1000) <= limit && hop > currentbd)
@@ -861,7 +660,7 @@ PartitionHelper::SetBRBoundary(Ptr<Node> edge, const std::string& reqbr)
 			double lowersize = BRinfoPtr->GetChunkSize(BRinfoPtr->GetBRFromRank(lowerrank));
 			for(uint32_t hop = currentbd + 1; hop <= routelen; hop++)
 			{
-				auto iter = m_delaytable.find(DelayTableKey{reqbr.substr(2), hop, edge->GetId()});
+				auto iter = m_delaytable.find(DelayTableKey{baserank, hop, edge->GetId()});
 				if(iter != m_delaytable.end())
 				{
 					if(accumulatedDelay + (iter->second / 1000) <= (limit * basesize / lowersize) && hop > currentbd)
@@ -1002,7 +801,7 @@ PartitionHelper::VerifyOptResult(const std::unordered_map<uint32_t, std::vector<
 			sizecheck[gateiter->second[i].get(-3).toUri()]++;
 
 			uint32_t fileid = static_cast<uint32_t>(gateiter->second[i].get(-2).toNumber());
-			uint32_t num = stats->GetHitNum(VideoIndex{gateiter->second[i].get(-3).toUri(),
+			uint32_t num = stats->GetHitNum(VideoIndex{NDNBitRate::LookupRank(gateiter->second[i].get(-3)),
 										fileid,
 										static_cast<uint32_t>(gateiter->second[i].get(-1).toNumber())});
 
@@ -1037,7 +836,7 @@ PartitionHelper::VerifyOptResult(const std::unordered_map<uint32_t, std::vector<
 			sizecheck[gateiter2->second[i].get(-3).toUri()]++;
 
 			uint32_t fileid = static_cast<uint32_t>(gateiter2->second[i].get(-2).toNumber());
-			uint32_t num = stats->GetHitNum(VideoIndex{gateiter2->second[i].get(-3).toUri(),
+			uint32_t num = stats->GetHitNum(VideoIndex{NDNBitRate::LookupRank(gateiter2->second[i].get(-3)),
 										fileid,
 										static_cast<uint32_t>(gateiter2->second[i].get(-1).toNumber())});
 
@@ -1098,11 +897,11 @@ PartitionHelper::VerifyOptResult(const std::unordered_map<uint32_t, std::vector<
 				uint32_t f = 5;
 				for(uint32_t k = 9; k <= 12; k++)
 				{
-					double popularity = (vstats->GetHitNum(VideoIndex{m_BRnames[b], f, k}) * 1e4) / static_cast<double>(m_totalreq);
+					double popularity = (vstats->GetHitNum(VideoIndex{m_BRranks[b], f, k}) * 1e4) / static_cast<double>(m_totalreq);
 					if((*pathiter)->GetId() == 1 || (*pathiter)->GetId() == 0)
 					{
-						auto GRBVarPtr1 = m_pathvarDict.find(PathVarIndex{iter->first, (*pathiter)->GetId(), VideoIndex{m_BRnames[b], f, k}});
-						auto GRBVarPtr2 = m_pathvarDict.find(PathVarIndex{iter->first, (*(pathiter - 1))->GetId(), VideoIndex{m_BRnames[b], f, k}});
+						auto GRBVarPtr1 = m_pathvarDict.find(PathVarIndex{iter->first, (*pathiter)->GetId(), VideoIndex{m_BRranks[b], f, k}});
+						auto GRBVarPtr2 = m_pathvarDict.find(PathVarIndex{iter->first, (*(pathiter - 1))->GetId(), VideoIndex{m_BRranks[b], f, k}});
 						*m_log << "[EdgeID: " << iter->first << "; Node: " << (*pathiter)->GetId() <<"; D: " << (*(pathiter - 1))->GetId() <<"] "
 							   << "{K " << k << "; BR " << m_BRnames[b] << "} "
 							   << "{NodeX: " << GRBVarPtr1->second.get(GRB_DoubleAttr_X) << "; DX: " << GRBVarPtr2->second.get(GRB_DoubleAttr_X) <<"} "
@@ -1137,7 +936,7 @@ PartitionHelper::VerifyMARLDesign()
 		{
 			std::string br = (*csiter).get(-3).toUri();
 			double s = brinfo->GetChunkSize(br.substr(2));
-			sizemap[DelayTableKey{(*csiter).get(-3).toUri(),0,(*iter)->GetId()}]+=s;
+			sizemap[DelayTableKey{NDNBitRate::LookupRank((*csiter).get(-3)),0,(*iter)->GetId()}]+=s;
 		}
 
 		Ptr<VideoStatistics> vstats = (*iter)->GetObject<VideoStatistics>();
@@ -1149,8 +948,8 @@ PartitionHelper::VerifyMARLDesign()
 				{
 					for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 					{
-						double reqnum = vstats->GetHitNum(VideoIndex{m_BRnames[b], f, k});
-						requestmap[DelayTableKey{m_BRnames[b],0,(*iter)->GetId()}] += reqnum;
+						double reqnum = vstats->GetHitNum(VideoIndex{m_BRranks[b], f, k});
+						requestmap[DelayTableKey{m_BRranks[b],0,(*iter)->GetId()}] += reqnum;
 					}
 				}
 			}
@@ -1172,23 +971,22 @@ PartitionHelper::VerifyMARLDesign()
 			{
 				auto tmp = pathiter + 1;
 				if((*pathiter)->GetId() != (*(iter->second.begin()))->GetId())
-					requestmap[DelayTableKey{m_BRnames[b],0,(*tmp)->GetId()}]
-								  += requestmap[DelayTableKey{m_BRnames[b],0,(*pathiter)->GetId()}];
+					requestmap[DelayTableKey{m_BRranks[b],0,(*tmp)->GetId()}]
+								  += requestmap[DelayTableKey{m_BRranks[b],0,(*pathiter)->GetId()}];
 				double reward = CalReward(bd, b, EdgeNodePtr);
 				Ptr<ContentStore> currentNodeCS = (*pathiter)->GetObject<ContentStore>();
 				std::vector<Name>::iterator csiter = currentNodeCS->inCacheRun.begin();
 				for(; csiter != currentNodeCS->inCacheRun.end(); csiter++)
 				{
-					std::string CSbr = (*csiter).get(-3).toUri();
-					if(CSbr == m_BRnames[b])
+					if(NDNBitRate::LookupRank((*csiter).get(-3)) == m_BRranks[b])
 					{
 						uint32_t f = (*csiter).get(-2).toNumber();
 						uint32_t k = (*csiter).get(-1).toNumber();
-						double popularity = vstats->GetHitNum(VideoIndex{m_BRnames[b], f, k});
-						cachehitmap[DelayTableKey{m_BRnames[b],iter->first,(*pathiter)->GetId()}] += popularity;
+						double popularity = vstats->GetHitNum(VideoIndex{m_BRranks[b], f, k});
+						cachehitmap[DelayTableKey{m_BRranks[b],iter->first,(*pathiter)->GetId()}] += popularity;
 						rewardmap[std::make_pair(iter->first,(*pathiter)->GetId())] += popularity * reward;
-						requestmap[DelayTableKey{m_BRnames[b],0,(*tmp)->GetId()}] -= popularity;
-						vstats->ResetHitNum(VideoIndex{m_BRnames[b], f, k});
+						requestmap[DelayTableKey{m_BRranks[b],0,(*tmp)->GetId()}] -= popularity;
+						vstats->ResetHitNum(VideoIndex{m_BRranks[b], f, k});
 					}
 				}
 				if((*pathiter)->GetId() == (*(iter->second.begin()))->GetId())
@@ -1197,8 +995,8 @@ PartitionHelper::VerifyMARLDesign()
 					{
 						for(uint32_t k = 1; k <= m_NumOfChunks; k++)
 						{
-							double popularity = vstats->GetHitNum(VideoIndex{m_BRnames[b], f, k});
-							cachehitmap[DelayTableKey{m_BRnames[b],iter->first,(*pathiter)->GetId()}] += 0;
+							double popularity = vstats->GetHitNum(VideoIndex{m_BRranks[b], f, k});
+							cachehitmap[DelayTableKey{m_BRranks[b],iter->first,(*pathiter)->GetId()}] += 0;
 							rewardmap[std::make_pair(iter->first,(*pathiter)->GetId())] += popularity * reward;
 						}
 					}
@@ -1222,8 +1020,8 @@ PartitionHelper::VerifyMARLDesign()
 				{
 					rewardmap[std::make_pair(0,(*pathiter)->GetId())]
 							  += rewardmap[std::make_pair(iter->first,(*moveiter)->GetId())];
-					cachehitmap[DelayTableKey{m_BRnames[b],0,(*pathiter)->GetId()}]
-								+= cachehitmap[DelayTableKey{m_BRnames[b],iter->first,(*moveiter)->GetId()}];
+					cachehitmap[DelayTableKey{m_BRranks[b],0,(*pathiter)->GetId()}]
+								+= cachehitmap[DelayTableKey{m_BRranks[b],iter->first,(*moveiter)->GetId()}];
 				}
 			}
 		}
@@ -1241,13 +1039,13 @@ PartitionHelper::VerifyMARLDesign()
 			double totalsize = 0;
 			for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 			{
-				auto sizeiter = sizemap.find(DelayTableKey{m_BRnames[b],0,(*iter)->GetId()});
+				auto sizeiter = sizemap.find(DelayTableKey{m_BRranks[b],0,(*iter)->GetId()});
 				if(sizeiter != sizemap.end())
 					totalsize += sizeiter->second;
 			}
 			for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 			{
-				auto sizeiter = sizemap.find(DelayTableKey{m_BRnames[b],0,(*iter)->GetId()});
+				auto sizeiter = sizemap.find(DelayTableKey{m_BRranks[b],0,(*iter)->GetId()});
 				if(m_log != nullptr)
 					*m_log << m_BRnames[b]<<": " <<std::fixed<< std::setprecision(3)
 						<< ((sizeiter != sizemap.end()) ? (sizeiter->second/totalsize) : 0) <<"; ";
@@ -1267,11 +1065,11 @@ PartitionHelper::VerifyMARLDesign()
 			double mtotalreq = 0;
 			for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 			{
-				mtotalreq += requestmap[DelayTableKey{m_BRnames[b],0,(*iter)->GetId()}];
+				mtotalreq += requestmap[DelayTableKey{m_BRranks[b],0,(*iter)->GetId()}];
 			}
 			for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 			{
-				auto reqiter = requestmap.find(DelayTableKey{m_BRnames[b],0,(*iter)->GetId()});
+				auto reqiter = requestmap.find(DelayTableKey{m_BRranks[b],0,(*iter)->GetId()});
 				if(m_log != nullptr)
 					*m_log << m_BRnames[b]<<": " << std::fixed << std::setprecision(0) << ((reqiter != requestmap.end()) ? (reqiter->second) : 0) <<"("
 						   << std::fixed << std::setprecision(3)
@@ -1291,8 +1089,8 @@ PartitionHelper::VerifyMARLDesign()
 				*m_log << "Node: " << std::left<< std::setw(6) <<(*iter)->GetId();
 			for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 			{
-				double r = requestmap[DelayTableKey{m_BRnames[b],0,(*iter)->GetId()}];
-				double d = cachehitmap[DelayTableKey{m_BRnames[b],0,(*iter)->GetId()}];
+				double r = requestmap[DelayTableKey{m_BRranks[b],0,(*iter)->GetId()}];
+				double d = cachehitmap[DelayTableKey{m_BRranks[b],0,(*iter)->GetId()}];
 				if(m_log != nullptr)
 					*m_log << m_BRnames[b]<<": " << std::fixed << std::setprecision(0) << d << "("
 						   << std::fixed<< std::setprecision(3)
@@ -1313,7 +1111,7 @@ PartitionHelper::VerifyMARLDesign()
 			double mtotalreq = 0;
 			for(uint32_t b = 1; b <= m_NumofBitRates; b++)
 			{
-				mtotalreq += requestmap[DelayTableKey{m_BRnames[b],0,(*iter)->GetId()}];
+				mtotalreq += requestmap[DelayTableKey{m_BRranks[b],0,(*iter)->GetId()}];
 			}
 			if(m_log != nullptr)
 				*m_log << "Reward: " << std::fixed<< std::setprecision(3)
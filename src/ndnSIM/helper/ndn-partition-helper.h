@@ -1,7 +1,7 @@
 /*
  * Author: Wenjie Li
  * Date: 2017-02-23
- * Global Optimization for Cache Capacity Partition (Using Gurobi)
+ * Global Optimization for Cache Capacity Partition (Gurobi or built-in PartitionSolver)
  */
 
 // Change GCC Version to 5.2
@@ -13,15 +13,12 @@
 #include "ns3/nstime.h"
 #include "ns3/node.h"
 #include "ns3/node-container.h"
-#include "gurobi_c++.h"
 
 #include "ns3/ndn-videocontent.h"
 #include "ns3/ndn-videostat.h"
 
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/exception.h>
-#include <cppconn/statement.h>
+#include "ns3/ndn-trace-sink.h"
+#include "ns3/ndn-partition-solver.h"
 
 #include <tuple>
 #include <unordered_map>
@@ -30,20 +27,25 @@
 #include <utility>
 #include <fstream>
 
+#ifdef HAVE_MYSQL
+namespace sql {
+class Driver;
+}
+#endif
+
 namespace ns3{
 namespace ndn{
 
-class VarIndex; // X_j(f, k, b) Variable Index
-class PathVarIndex; // \alpha_j(L(m), f, k, b) Path Variable Index
 class DelayTableKey;
 
 class PartitionHelper
 {
 	using NodesOnPathList = std::map<uint32_t, std::deque<Ptr<Node> > >;
-	// Tuple: Bitrate(String), Hop(uint32_t), EdgeNodeID(uint32_t)
+	// Tuple: Bitrate Rank(uint32_t), Hop(uint32_t), EdgeNodeID(uint32_t)
 	using DelayTable = std::unordered_map<DelayTableKey, double>;
-	using PopularityTable = std::map<std::string, std::vector<std::pair<VideoIndex,uint64_t> > >;
+	using PopularityTable = std::map<uint32_t, std::vector<std::pair<VideoIndex,uint64_t> > >;
 public:
+#ifdef HAVE_MYSQL
 	PartitionHelper(uint32_t NumF, uint32_t NumC, uint32_t NumB, uint32_t NumNodes,
 					const std::string ArrB[],
 					uint32_t EdgeSize, uint32_t IntmSize,
@@ -58,6 +60,20 @@ public:
 					const std::string& password,
 					const std::string& ip,
 					int port);
+#endif
+
+	/*
+	 * CacheStatus is written to 'sink'
+	 */
+	PartitionHelper(uint32_t NumF, uint32_t NumC, uint32_t NumB, uint32_t NumNodes,
+					const std::string ArrB[],
+					uint32_t EdgeSize, uint32_t IntmSize,
+					const std::string& prefix,
+					const std::string& roundtime,
+					double alpha, uint32_t id, uint32_t designchoice,
+					uint32_t iterations,
+					const std::string& logpath,
+					Ptr<TraceSink> sink);
 
 	~PartitionHelper();
 
@@ -67,16 +83,33 @@ public:
 	void
 	SetTopologicalOrder(Ptr<Node> ServerNode, NodeContainer edges);
 
+	/*
+	 * Solver of the partition problem (PartitionSolver::Create() by default)
+	 */
+	void
+	SetSolver(Ptr<PartitionSolver> solver);
+
+	/*
+	 * Solver by name (see PartitionSolver::Create), created at the first IterativeRun.
+	 * A Gurobi environment (license, threads) cannot be shared by the processes forked
+	 * from a snapshot (SweepHelper::RunFromSnapshot): taken before the first
+	 * iteration, the snapshot holds no solver and every run creates its own.
+	 */
+	void
+	SetSolver(const std::string& name);
+
+	inline void
+	SetIterationTimes(uint32_t iterations) {m_iterationTimes = iterations;}
+
 private:
-	int SolveIntegerPro();
-	/* Related to Gruobi Optimization */
+	PartitionSolver::Status SolveIntegerPro();
 
-	void GRBModelInit();
-	void AddOptVar();
 	// Each Edge router should aggregate class VideoStatistics
 	void UpdateRequestStat();
-	void SetOptimizationObj();
-	void SetOptimizationConstr();
+	// Items, routers, capacities and paths: built once, they do not change between iterations
+	void BuildProblem(PartitionProblem& problem);
+	// Reward, popularity and popularity order on every path, from the latest statistics
+	void UpdateProblem(PartitionProblem& problem);
 
 private:
 	/* Related to processing topology */
@@ -109,14 +142,18 @@ private:
 	void OutputCacheStatus(uint32_t);
 
 private:
-	GRBEnv* env;
-	GRBModel* model;
+	Ptr<PartitionSolver>	m_solver;		// Created from m_solverName at the first iteration if not set
+	std::string				m_solverName;
+	PartitionProblem		m_problem;
+	PartitionPlacement		m_placement;	// Result of the last iteration
+	std::unordered_map<VideoIndex, uint32_t> m_itemIndex;	// Item of m_problem
 
 	uint32_t 		m_NumOfChunks;
 	uint32_t		m_NumOfFiles;
 	uint32_t		m_NumofBitRates;
 	uint32_t		m_NumofNodes;
 	std::string*	m_BRnames;
+	uint32_t*		m_BRranks;		// Interned rank of each entry in m_BRnames
 
 	uint32_t		m_edgesize;
 	uint32_t 		m_intmsize;
@@ -125,8 +162,6 @@ private:
 	std::string		m_prefix;
 	std::string		m_roundtime;
 
-	std::unordered_map<VarIndex, GRBVar> 		m_varDict;
-	std::unordered_map<PathVarIndex, GRBVar>	m_pathvarDict;
 	DelayTable									m_delaytable;
 
 	NodesOnPathList m_forwardingpath;		//The Array of NodeID on the forwarding path starting from a certain edge router
@@ -144,8 +179,7 @@ private:
 	std::ofstream* 	m_log;
 	std::list<double> m_condition;
 
-	sql::Connection*				m_con;
-	sql::Statement*					m_stmt;
+	Ptr<TraceSink>					m_sink;
 };
 
 bool cmp_by_value_video(const std::pair<ns3::ndn::VideoIndex, uint64_t>& lhs,
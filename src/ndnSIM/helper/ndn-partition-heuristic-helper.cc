@@ -1,5 +1,6 @@
 #include "ndn-partition-heuristic-helper.h"
 #include "ndn-partition-helper.h"
+#include "ndn-task-graph.h"
 #include "ns3/net-device.h"
 #include "ns3/node-list.h"
 #include "ns3/point-to-point-net-device.h"
@@ -10,6 +11,9 @@
 #include "ns3/log.h"
 #include "ns3/nstime.h"
 #include "ns3/ndn-content-store.h"
+#ifdef HAVE_MYSQL
+#include "ns3/ndn-mysql-trace-sink.h"
+#endif
 
 #include "ns3/ndn-bitrate.h"
 #include "ns3/ndn-popularity.h"
@@ -24,9 +28,21 @@
 
 NS_LOG_COMPONENT_DEFINE ("ndn.CachePartition.Heuristic");
 
+// NS_LOG_DEBUG from a task: the line goes to the diagnostics of the task
+#define TASK_LOG_DEBUG(diagnostics, msg)				\
+	do {												\
+		if(g_log.IsEnabled(ns3::LOG_DEBUG))				\
+		{												\
+			std::ostringstream os;						\
+			os << msg;									\
+			(diagnostics).m_debug.push_back(os.str());	\
+		}												\
+	} while(false)
+
 namespace ns3{
 namespace ndn{
 
+#ifdef HAVE_MYSQL
 HeuPartitionHelper::HeuPartitionHelper(const std::string& prefix,
 		   	   	   	   	   	   	   	   const std::string& roundtime,
 									   double rewardparam,
@@ -40,6 +56,21 @@ HeuPartitionHelper::HeuPartitionHelper(const std::string& prefix,
 									   const std::string& ip,
 									   int port,
 									   uint32_t expid)
+	:HeuPartitionHelper(prefix, roundtime, rewardparam, B, iterationTimes, mode,
+						Create<MySqlTraceSink> (driver, ip, port, DatabaseName, user, password), expid)
+{
+
+}
+#endif
+
+HeuPartitionHelper::HeuPartitionHelper(const std::string& prefix,
+		   	   	   	   	   	   	   	   const std::string& roundtime,
+									   double rewardparam,
+		   	   	   	   	   	   	   	   uint32_t B,
+									   uint32_t iterationTimes,
+									   uint32_t mode,
+									   Ptr<TraceSink> sink,
+									   uint32_t expid)
 {
 	m_prefix = prefix;
 	m_roundtime = roundtime;
@@ -48,41 +79,25 @@ HeuPartitionHelper::HeuPartitionHelper(const std::string& prefix,
 
 	m_iterationTimes = iterationTimes;
 	m_itercounter = 0;
+	m_threads = 1;
 
 	m_alpha = rewardparam;
 	m_design = mode;
 
-	try{
-		sql::ConnectOptionsMap properties;
-		properties["hostName"] = "tcp://" + ip;
-		properties["userName"] = user;
-		properties["password"] = password;
-		properties["port"] = port;
-		properties["schema"] = DatabaseName;
-		properties["OPT_RECONNECT"] = true;
-
-		m_con = driver->connect(properties);
-		m_stmt = m_con->createStatement();
-
-		m_stmt->execute("CREATE TABLE IF NOT EXISTS CacheStatus (ExpID SMALLINT, Transition SMALLINT, NodeID SMALLINT, `BitRate(Kbps)` VARCHAR(4), Size INT);");
-
-	}
-	catch (sql::SQLException &e) {
-		std::cout << "# ERR: SQLException in " << __FILE__;
-		std::cout << "(" << __FUNCTION__ << ") on line "
-		     << __LINE__ << std::endl;
-		std::cout << "# ERR: " << e.what();
-		std::cout << " (MySQL error code: " << e.getErrorCode();
-		std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-	}
+	m_sink = sink;
+	m_sink->CreateTable("CacheStatus", {{"ExpID", "SMALLINT"}, {"Transition", "SMALLINT"}, {"NodeID", "SMALLINT"},
+										{"BitRate(Kbps)", "VARCHAR(4)"}, {"Size", "INT"}});
 }
 
 HeuPartitionHelper::~HeuPartitionHelper()
 {
-	delete m_stmt;
-	m_stmt = nullptr;
-	delete m_con;
-	m_con = nullptr;
+	m_sink->Flush();
+}
+
+void
+HeuPartitionHelper::SetThreads(uint32_t threads)
+{
+	m_threads = threads;
 }
 
 void
@@ -434,29 +449,17 @@ HeuPartitionHelper::OutputCacheStatus(uint32_t count)
 
 			}
 
-			std::ostringstream ss;
 			std::string tail = "kbps";
-			try{
-				for(auto entry = cssize.begin(); entry != cssize.end(); entry++)
-				{
-					std::size_t found = entry->first.find(tail);
-
-					ss << "INSERT INTO CacheStatus VALUES(" << m_expid << ","
-															<< count << ","
-															<< (*iter)->GetId() << ","
-															<< entry->first.substr(0, found) << ","
-															<< entry->second << ");";
-					m_stmt->execute(ss.str());
-					ss.str("");
-				}
-			}
-			catch (sql::SQLException &e) {
-				std::cout << "# ERR: SQLException in " << __FILE__;
-				std::cout << "(" << __FUNCTION__ << ") on line "
-				     << __LINE__ << std::endl;
-				std::cout << "# ERR: " << e.what();
-				std::cout << " (MySQL error code: " << e.getErrorCode();
-				std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
+			for(auto entry = cssize.begin(); entry != cssize.end(); entry++)
+			{
+				std::size_t found = entry->first.find(tail);
+				TraceRow row;
+				row.Add(m_expid)
+				   .Add(count)
+				   .Add((*iter)->GetId())
+				   .Add(std::stoi(entry->first.substr(0, found)))
+				   .Add(entry->second);
+				m_sink->Append("CacheStatus", row);
 			}
 
 			//safety check
@@ -638,7 +641,7 @@ HeuPartitionHelper::Solver()
 					 item++)
 			{
 				Ptr<Name> nameWithSequence = Create<ns3::ndn::Name>(m_prefix);
-				nameWithSequence->append(item->m_bitrate);
+				nameWithSequence->append(item->GetBitRateComponent());
 				nameWithSequence->appendNumber(item->m_file);
 				nameWithSequence->appendNumber(item->m_chunk);
 				newcs.push_back(*nameWithSequence);
@@ -665,9 +668,90 @@ HeuPartitionHelper::Solver()
 	}
 }
 
+void
+HeuPartitionHelper::GatherRouterInfo()
+{
+	m_routerinfo.clear();
+	std::list<Ptr<Node> > nodes = m_topo_order_ptr;
+	nodes.insert(nodes.end(), m_edgenode_ptr.begin(), m_edgenode_ptr.end());
+	for(auto nodeiter = nodes.begin();
+			 nodeiter != nodes.end();
+			 nodeiter++)
+	{
+		if(m_routerinfo.find((*nodeiter)->GetId()) != m_routerinfo.end())
+			continue;
+		Ptr<NDNBitRate> BRinfo = (*nodeiter)->GetObject<NDNBitRate>();
+		Ptr<VideoStatistics> stats = (*nodeiter)->GetObject<VideoStatistics>();
+
+		RouterInfo& router = m_routerinfo[(*nodeiter)->GetId()];
+		router.m_id = (*nodeiter)->GetId();
+		router.m_capacity = (*nodeiter)->GetObject<ContentStore>()->GetCapacity();
+		//Ranks out of the table get the size of the first/last bitrate, as in NDNBitRate
+		for(uint32_t rank = 0; rank <= std::max(NumB, BRinfo->GetTableSize()) + 1; rank++)
+		{
+			router.m_chunksize.push_back(BRinfo->GetChunkSizeFromRank(rank));
+			router.m_reward.push_back(BRinfo->GetRewardFromRank(rank));
+		}
+		router.m_table = (stats != 0) ? &stats->GetTable() : 0;
+	}
+}
+
 void
 HeuPartitionHelper::PathCacheByPop()
 {
+	GatherRouterInfo();
+
+	//Router N depends on the router below it on every routing path through N:
+	//MergeCacheStack reads their decisions, and AdjustStackSize updates the capacity of
+	//the paths at the position of N only. Routers of disjoint subtrees run in parallel.
+	std::vector<const RouterInfo*> routers;
+	std::unordered_map<uint32_t, uint32_t> taskid;
+	for(auto nodeiter = m_topo_order_ptr.rbegin();
+			 nodeiter != m_topo_order_ptr.rend();
+			 nodeiter++)
+	{
+		NS_ASSERT_MSG(taskid.find((*nodeiter)->GetId()) == taskid.end(), "Router twice in the topological order");
+		taskid[(*nodeiter)->GetId()] = routers.size();
+		routers.push_back(&m_routerinfo[(*nodeiter)->GetId()]);
+	}
+
+	std::vector<uint8_t> conditions(routers.size());
+	std::vector<std::unordered_map<VideoIndex,double> > popTables(routers.size());
+	std::vector<CandidateTable> candidates(routers.size());
+	std::vector<StackDiagnostics> diagnostics(routers.size());
+	TaskGraph tasks;
+	std::set<std::pair<uint32_t, uint32_t> > dependencies;
+	for(uint32_t idx = 0; idx < routers.size(); idx++)
+	{
+		tasks.AddTask([this, idx, &routers, &conditions, &popTables, &candidates, &diagnostics] ()
+		{
+			MergeCacheStack(*routers[idx], popTables[idx], candidates[idx]);
+			conditions[idx] = AdjustStackSize(*routers[idx], popTables[idx], candidates[idx], diagnostics[idx]);
+			popTables[idx].clear();
+			candidates[idx].clear();
+		});
+	}
+	for(auto nodeiter = m_edgenode_ptr.begin();
+			 nodeiter != m_edgenode_ptr.end();
+			 nodeiter++)
+	{
+		auto upnode = m_UpstreamSet.find((*nodeiter)->GetId());
+		if(upnode == m_UpstreamSet.end())
+			continue;
+		uint32_t lower = (*nodeiter)->GetId();
+		for(auto upiter = upnode->second.rbegin();
+				 upiter != upnode->second.rend();
+				 upiter++)
+		{
+			auto before = taskid.find(lower);
+			auto after = taskid.find((*upiter)->GetId());
+			if(before != taskid.end() && after != taskid.end() &&
+			   dependencies.insert(std::make_pair(before->second, after->second)).second)
+				tasks.AddDependency(before->second, after->second);
+			lower = (*upiter)->GetId();
+		}
+	}
+
 	bool stopsign;
 	do{
 		m_cachestack.clear();
@@ -675,28 +759,37 @@ HeuPartitionHelper::PathCacheByPop()
 
 		DeriveCacheStackByPath();
 
-		stopsign = true;
-
-		for(auto nodeiter = m_topo_order_ptr.rbegin();
-				 nodeiter != m_topo_order_ptr.rend();
-				 nodeiter++)
-		{
-			std::unordered_map<VideoIndex,double> popTable;
-			CandidateTable candidate;
+		//Every router has its entry beforehand: the tasks never insert into m_decision
+		for(uint32_t idx = 0; idx < routers.size(); idx++)
+			m_decision[routers[idx]->m_id];
 
-			MergeCacheStack(*nodeiter, popTable, candidate);
+		tasks.Run(m_threads);
 
-			stopsign = stopsign & AdjustStackSize(*nodeiter, popTable, candidate);
+		//Same output in the same order for any number of threads
+		for(uint32_t idx = 0; idx < routers.size(); idx++)
+		{
+			for(auto line = diagnostics[idx].m_debug.begin();
+					 line != diagnostics[idx].m_debug.end();
+					 line++)
+				NS_LOG_DEBUG(*line);
+			for(uint32_t i = 0; i < diagnostics[idx].m_impossible; i++)
+				std::cout << "Impossible!\n";
+			diagnostics[idx] = StackDiagnostics();
 		}
 
+		stopsign = true;
+		for(uint32_t idx = 0; idx < routers.size(); idx++)
+			stopsign = stopsign & conditions[idx];
+
 	}while(!stopsign);
 }
 
 
 bool
-HeuPartitionHelper::AdjustStackSize(Ptr<Node> nodeptr,
+HeuPartitionHelper::AdjustStackSize(const RouterInfo& router,
 									std::unordered_map<VideoIndex,double>& popTable,
-									CandidateTable& candidate)
+									CandidateTable& candidate,
+									StackDiagnostics& diagnostics)
 {
 	//Key: edge router ID where routing path is transmit through nodeptr,
 	//Value: the updated cache capacity
@@ -711,10 +804,7 @@ HeuPartitionHelper::AdjustStackSize(Ptr<Node> nodeptr,
 	}
 	std::sort(orderedTable.begin(), orderedTable.end(), ns3::ndn::cmp_by_value_video);
 
-	Ptr<ContentStore> csptr = nodeptr->GetObject<ContentStore>();
-	Ptr<NDNBitRate> BRinfo = nodeptr->GetObject<NDNBitRate>();
-
-	uint32_t limit = csptr->GetCapacity();
+	uint32_t limit = router.m_capacity;
 	uint32_t acccapacity = 0;
 	std::set<VideoIndex> cachedcontent;
 
@@ -722,8 +812,7 @@ HeuPartitionHelper::AdjustStackSize(Ptr<Node> nodeptr,
 			 entry != orderedTable.end();
 			 entry++)
 	{
-		std::string br = entry->first.m_bitrate.substr(2);
-		uint32_t chunksize = static_cast<uint32_t>(BRinfo->GetChunkSize(br)) * 1e3;
+		uint32_t chunksize = static_cast<uint32_t>(router.GetChunkSize(entry->first.m_rank)) * 1e3;
 		if(acccapacity + chunksize > limit)
 			break;
 		else
@@ -747,19 +836,20 @@ HeuPartitionHelper::AdjustStackSize(Ptr<Node> nodeptr,
 			}
 		}
 	}
-	m_decision.insert(std::make_pair(nodeptr->GetId(), std::move(cachedcontent)));
+	//The entry exists already (PathCacheByPop); find() is safe along with the other tasks
+	m_decision.find(router.m_id)->second = std::move(cachedcontent);
 
-	NS_LOG_DEBUG("Working on Node: " << nodeptr->GetId());
+	TASK_LOG_DEBUG(diagnostics, "Working on Node: " << router.m_id);
 	bool condition = true;
 	//Update the available cache capacity for each path
 	for(auto nodeiter = m_edgenode_ptr.begin();
 			 nodeiter != m_edgenode_ptr.end();
 			 nodeiter++)
 	{
-		if((*nodeiter)->GetId() == nodeptr->GetId())// No need to update if this current node is an edge router
+		if((*nodeiter)->GetId() == router.m_id)// No need to update if this current node is an edge router
 		{
-			NS_LOG_DEBUG("This Node is an edge router");
-			NS_LOG_DEBUG("Previous: " << m_availcapacity[(*nodeiter)->GetId()][0]
+			TASK_LOG_DEBUG(diagnostics, "This Node is an edge router");
+			TASK_LOG_DEBUG(diagnostics, "Previous: " << m_availcapacity.at((*nodeiter)->GetId())[0]
 					  << "\tCurrent: " << acccapacity);
 		}
 		else
@@ -772,23 +862,23 @@ HeuPartitionHelper::AdjustStackSize(Ptr<Node> nodeptr,
 						 upiter != upnodes->second.rend();
 						 upiter++)
 				{
-					if((*upiter)->GetId() == nodeptr->GetId())
+					if((*upiter)->GetId() == router.m_id)
 					{
-						uint32_t previous = m_availcapacity[(*nodeiter)->GetId()][idx];
+						uint32_t previous = m_availcapacity.at((*nodeiter)->GetId())[idx];
 						uint32_t current = updatesize[(*nodeiter)->GetId()];
 
-						NS_LOG_DEBUG("Source: " << (*nodeiter)->GetId()
+						TASK_LOG_DEBUG(diagnostics, "Source: " << (*nodeiter)->GetId()
 								  << "\tPrevious: " << previous 
 								  << "\tAfter: " << current);
 
 						if(current < previous)
 						{
 							condition = false;
-							m_availcapacity[(*nodeiter)->GetId()][idx] = current;
+							m_availcapacity.at((*nodeiter)->GetId())[idx] = current;
 						}
 						else if(current > previous)
 						{
-							std::cout << "Impossible!\n";
+							diagnostics.m_impossible++;
 						}
 					}
 					idx++;
@@ -801,12 +891,10 @@ HeuPartitionHelper::AdjustStackSize(Ptr<Node> nodeptr,
 }
 
 void
-HeuPartitionHelper::MergeCacheStack(Ptr<Node> nodeptr,
+HeuPartitionHelper::MergeCacheStack(const RouterInfo& router,
 									std::unordered_map<VideoIndex,double>& popTable,
 									CandidateTable& candidate)
 {
-	Ptr<NDNBitRate> BRinfo = nodeptr->GetObject<NDNBitRate>();
-
 	for(auto nodeiter = m_edgenode_ptr.begin();
 			 nodeiter != m_edgenode_ptr.end();
 			 nodeiter++)
@@ -815,7 +903,7 @@ HeuPartitionHelper::MergeCacheStack(Ptr<Node> nodeptr,
 		bool found = false;
 		uint32_t len = 0;
 
-		if(upnode->first == nodeptr->GetId())
+		if(upnode->first == router.m_id)
 			found = true;
 		else
 		{
@@ -824,7 +912,7 @@ HeuPartitionHelper::MergeCacheStack(Ptr<Node> nodeptr,
 					 upiter++)
 			{
 				len++;
-				if((*upiter)->GetId() == nodeptr->GetId())
+				if((*upiter)->GetId() == router.m_id)
 				{
 					found = true;
 					break;
@@ -859,18 +947,18 @@ HeuPartitionHelper::MergeCacheStack(Ptr<Node> nodeptr,
 				}
 			}
 
-			auto entry = m_cachestack[(*nodeiter)->GetId()].begin();
+			const std::list<std::pair<VideoIndex, double> >& cachestack = m_cachestack.at((*nodeiter)->GetId());
+			auto entry = cachestack.begin();
 			std::set<VideoIndex> localdecision;
 			for(uint32_t i = 0; i <= len; i++)
 			{
 				uint32_t acccapacity = 0;
-				uint32_t limit = m_availcapacity[(*nodeiter)->GetId()][i];
+				uint32_t limit = m_availcapacity.at((*nodeiter)->GetId())[i];
 				for(;
-					entry != m_cachestack[(*nodeiter)->GetId()].end();
+					entry != cachestack.end();
 					entry++)
 				{
-					std::string br = entry->first.m_bitrate.substr(2);
-					uint32_t chunksize = static_cast<uint32_t>(BRinfo->GetChunkSize(br)) * 1e3;
+					uint32_t chunksize = static_cast<uint32_t>(router.GetChunkSize(entry->first.m_rank)) * 1e3;
 
 					if(acccapacity + chunksize > limit)
 						break;
@@ -906,60 +994,74 @@ HeuPartitionHelper::MergeCacheStack(Ptr<Node> nodeptr,
 void
 HeuPartitionHelper::DeriveCacheStackByPath()
 {
+	//Routing paths are independent: every task fills the stack of one path
+	std::vector<std::list<std::pair<VideoIndex, double> > > stacks(m_edgenode_ptr.size());
+	TaskGraph tasks;
+	uint32_t idx = 0;
 	for(auto nodeiter = m_edgenode_ptr.begin();
 			 nodeiter != m_edgenode_ptr.end();
-			 nodeiter++) // Work on each routing path
+			 nodeiter++, idx++) // Work on each routing path
 	{
-		if(m_design == 1)
-		{
-			uint32_t totalsize = 0;
+		const RouterInfo* router = &m_routerinfo.at((*nodeiter)->GetId());
+		std::list<std::pair<VideoIndex, double> >* stack = &stacks[idx];
+		tasks.AddTask([this, router, stack] () {DeriveCacheStack(*router, *stack);});
+	}
+	tasks.Run(m_threads);
 
-			auto sizeiter = m_availcapacity.find((*nodeiter)->GetId());
+	if(m_design > 1)
+		return;
+	idx = 0;
+	for(auto nodeiter = m_edgenode_ptr.begin();
+			 nodeiter != m_edgenode_ptr.end();
+			 nodeiter++, idx++)
+		m_cachestack.insert(std::make_pair((*nodeiter)->GetId(), std::move(stacks[idx])));
+}
 
-			for(uint32_t i = 0 ; i < sizeiter->second.size(); i++)
-				totalsize += sizeiter->second[i];
+void
+HeuPartitionHelper::DeriveCacheStack(const RouterInfo& router,
+									 std::list<std::pair<VideoIndex, double> >& summary)
+{
+	if(m_design == 1)
+	{
+		uint32_t totalsize = 0;
 
-			std::list<std::pair<VideoIndex, double> > placelist;
+		auto sizeiter = m_availcapacity.find(router.m_id);
+
+		for(uint32_t i = 0 ; i < sizeiter->second.size(); i++)
+			totalsize += sizeiter->second[i];
 
-			AssignCacheStack(*nodeiter, totalsize, placelist);
-			m_cachestack.insert(std::make_pair((*nodeiter)->GetId(), std::move(placelist)));
+		AssignCacheStack(router, totalsize, summary);
+	}
+	else if (m_design == 0)
+	{
+		std::map<uint32_t, std::list<std::pair<VideoIndex, double> > > localdecision;
+		for(uint32_t brrank = NumB; brrank >= 1; brrank--)
+		{
+			std::list<std::pair<VideoIndex, double> > placelist;
+			AdjustCacheStack(router, brrank, placelist, localdecision);
+			localdecision.insert(std::make_pair(brrank, std::move(placelist)));
 		}
-		else if (m_design == 0)
+		for(uint32_t brrank = NumB; brrank >= 1; brrank--)
 		{
-			std::map<uint32_t, std::list<std::pair<VideoIndex, double> > > localdecision;
-			for(uint32_t brrank = NumB; brrank >= 1; brrank--)
-			{
-				std::list<std::pair<VideoIndex, double> > placelist;
-				AdjustCacheStack(*nodeiter, brrank, placelist, localdecision);
-				localdecision.insert(std::make_pair(brrank, std::move(placelist)));
-			}
-			std::list<std::pair<VideoIndex, double> > summary;
-			for(uint32_t brrank = NumB; brrank >= 1; brrank--)
+			auto deciter = localdecision.find(brrank);
+			if(deciter != localdecision.end())
 			{
-				auto deciter = localdecision.find(brrank);
-				if(deciter != localdecision.end())
-				{
-					for(auto item = deciter->second.begin();
-							 item != deciter->second.end();
-							 item++)
-						summary.push_back((*item));
-				}
+				for(auto item = deciter->second.begin();
+						 item != deciter->second.end();
+						 item++)
+					summary.push_back((*item));
 			}
-			m_cachestack.insert(std::make_pair((*nodeiter)->GetId(), std::move(summary)));
-
 		}
-
 	}
 }
 
 bool
-HeuPartitionHelper::AllowCacheMore(Ptr<NDNBitRate> BRinfo,
-								   uint32_t edgeid,
+HeuPartitionHelper::AllowCacheMore(const RouterInfo& router,
 								   uint32_t workingsize,
 								   uint32_t workinglistnum,
 								   const std::map<uint32_t, std::list<std::pair<VideoIndex, double> > >& localdecision)
 {
-	auto sizeiter = m_availcapacity.find(edgeid);
+	auto sizeiter = m_availcapacity.find(router.m_id);
 	uint32_t waitrank = NumB;
 	uint32_t waitnum = 0;
 	auto waititer = localdecision.find(waitrank);
@@ -981,8 +1083,7 @@ HeuPartitionHelper::AllowCacheMore(Ptr<NDNBitRate> BRinfo,
 					waitnum = waititer->second.size();
 				continue;
 			}
-			std::string br = waititer->second.front().first.m_bitrate.substr(2);
-			uint32_t chunksize = BRinfo->GetChunkSize(br) * 1e3;
+			uint32_t chunksize = router.GetChunkSize(waititer->second.front().first.m_rank) * 1e3;
 			uint32_t num = leftover / chunksize;
 			if(num < waitnum)
 			{
@@ -1012,23 +1113,21 @@ HeuPartitionHelper::AllowCacheMore(Ptr<NDNBitRate> BRinfo,
 }
 
 void
-HeuPartitionHelper::AdjustCacheStack(Ptr<Node> nodeptr,
+HeuPartitionHelper::AdjustCacheStack(const RouterInfo& router,
 									 uint32_t brrank,
 									 std::list<std::pair<VideoIndex, double> >& placelist,
 									 std::map<uint32_t, std::list<std::pair<VideoIndex, double> > >& localdecision)
 {
-	Ptr<VideoStatistics> stats = nodeptr->GetObject<VideoStatistics>();
-	Ptr<NDNBitRate> BRinfo = nodeptr->GetObject<NDNBitRate>();
-	uint32_t insertsize = static_cast<uint32_t>(BRinfo->GetChunkSize(BRinfo->GetBRFromRank(brrank))) * 1e3;
-	double normalcost = BRinfo->GetRewardFromRank(brrank);
+	uint32_t insertsize = static_cast<uint32_t>(router.GetChunkSize(brrank)) * 1e3;
+	double normalcost = router.GetReward(brrank);
 
 	std::vector<std::pair<VideoIndex,double> > orderedTable;
 
-	for(auto entry = stats->GetTable().begin();
-			 entry != stats->GetTable().end();
+	for(auto entry = router.m_table->begin();
+			 entry != router.m_table->end();
 			 entry++)
 	{
-		if(entry->first.m_bitrate.substr(2) == BRinfo->GetBRFromRank(brrank))
+		if(entry->first.m_rank == brrank)
 		{
 			double v = entry->second * normalcost;
 			orderedTable.push_back(std::make_pair(entry->first, v));
@@ -1040,7 +1139,7 @@ HeuPartitionHelper::AdjustCacheStack(Ptr<Node> nodeptr,
 	uint32_t idx = 0;
 	while(idx < orderedTable.size())
 	{
-		if(AllowCacheMore(BRinfo, nodeptr->GetId(), insertsize, placelist.size(), localdecision))
+		if(AllowCacheMore(router, insertsize, placelist.size(), localdecision))
 		{
 			placelist.push_back(orderedTable[idx]);
 			idx++;
@@ -1072,7 +1171,7 @@ HeuPartitionHelper::AdjustCacheStack(Ptr<Node> nodeptr,
 		{
 			eliminateiter->second.pop_back();
 			while(idx < orderedTable.size()
-					&& AllowCacheMore(BRinfo, nodeptr->GetId(), insertsize, placelist.size(), localdecision))
+					&& AllowCacheMore(router, insertsize, placelist.size(), localdecision))
 			{
 				placelist.push_back(orderedTable[idx]);
 				idx++;
@@ -1084,17 +1183,14 @@ HeuPartitionHelper::AdjustCacheStack(Ptr<Node> nodeptr,
 }
 
 void
-HeuPartitionHelper::AssignCacheStack(Ptr<Node> nodeptr,
+HeuPartitionHelper::AssignCacheStack(const RouterInfo& router,
 								     uint32_t totalsize,
 									 std::list<std::pair<VideoIndex, double> >& placelist)
 {
-	Ptr<VideoStatistics> stats = nodeptr->GetObject<VideoStatistics>();
-	Ptr<NDNBitRate> BRinfo = nodeptr->GetObject<NDNBitRate>();
-
 	std::vector<std::pair<VideoIndex,double> > orderedTable;
 
-	for(auto entry = stats->GetTable().begin();
-			 entry != stats->GetTable().end();
+	for(auto entry = router.m_table->begin();
+			 entry != router.m_table->end();
 			 entry++)
 	{
 		orderedTable.push_back(std::make_pair(entry->first, entry->second));
@@ -1105,13 +1201,11 @@ HeuPartitionHelper::AssignCacheStack(Ptr<Node> nodeptr,
 	if(totalsize > 0)
 	{
 		uint32_t idx = 0;
-		std::string br = "";
 		uint32_t chunksize = 0;
 
 		while(idx < orderedTable.size())
 		{
-			br = orderedTable[idx].first.m_bitrate.substr(2);
-			chunksize = static_cast<uint32_t>(BRinfo->GetChunkSize(br)) * 1e3;
+			chunksize = static_cast<uint32_t>(router.GetChunkSize(orderedTable[idx].first.m_rank)) * 1e3;
 
 			if(totalsize >= chunksize)
 			{
@@ -1204,13 +1298,13 @@ HeuPartitionHelper::CalPopScore(Ptr<Node> edgeptr,
 	// Get Total Number of Video Requests Received by All Edge Routers
 	Ptr<VideoStatistics> stats = edgeptr->GetObject<VideoStatistics>();
 	Ptr<NDNBitRate> BRinfo = edgeptr->GetObject<NDNBitRate>();
-	std::map<std::string, double> ripple;
+	std::map<uint32_t, double> ripple;
 
 	for(uint32_t rank = 1; rank <= NumB; rank++)
 	{
 		std::string br = BRinfo->GetBRFromRank(rank);
 		uint64_t BRarr = SetBRBoundary(edgeptr, br);
-		ripple.insert(std::make_pair(br, RippleRatio(rank, hop, BRarr)));
+		ripple.insert(std::make_pair(rank, RippleRatio(rank, hop, BRarr)));
 	}
 
 
@@ -1224,13 +1318,13 @@ HeuPartitionHelper::CalPopScore(Ptr<Node> edgeptr,
 
 		auto statiter = statTable.find(tableptr->first);
 		double v = 0;
-		uint32_t brorder = BRinfo->GetRankFromBR(tableptr->first.m_bitrate.substr(2));
+		uint32_t brorder = tableptr->first.m_rank;
 		if(m_design == 2) // Pure Popularity Statistics
 			v = tableptr->second;
 		else if(m_design == 3)// Popularity Score \times Ripple Decaying Ratio
-			v = tableptr->second * ripple[tableptr->first.m_bitrate.substr(2)];
+			v = tableptr->second * ripple[brorder];
 		else if(m_design == 4)// Popularity Score \times Ripple Mask \times NormalizedDeliveryCost
-			v = tableptr->second * ripple[tableptr->first.m_bitrate.substr(2)] * BRinfo->GetRewardFromRank(brorder);
+			v = tableptr->second * ripple[brorder] * BRinfo->GetRewardFromRank(brorder);
 		else if(m_design == 5)// Popularity Score \times NormalizedDeliveryCost
 			v = tableptr->second * BRinfo->GetRewardFromRank(brorder);
 		if(statiter != statTable.end())
@@ -1308,7 +1402,7 @@ HeuPartitionHelper::FindInitCachePartition(Ptr<Node> nodeptr,
 
 	for(auto entry = popTable.begin(); entry != popTable.end(); entry++)
 	{
-		brsize = BRinfo->GetChunkSize(entry->first.m_bitrate.substr(2)) * 1e3;
+		brsize = BRinfo->GetChunkSizeFromRank(entry->first.m_rank) * 1e3;
 		if(cssize >= brsize && entry->second > 0)
 		{
 			cssize -= brsize;
@@ -1353,7 +1447,7 @@ HeuPartitionHelper::UpdateRequestStat()
 						totaldelay += record.second;
 					}
 				}
-				m_delaytable[DelayTableKey{br, hop, (*pathiter)->GetId()}]=
+				m_delaytable[DelayTableKey{b, hop, (*pathiter)->GetId()}]=
 											(num != 0) ? (totaldelay / num) : BRinfo->GetPlaybackTime() * 2000;
 			}
 		}
@@ -1380,7 +1474,7 @@ HeuPartitionHelper::SetBRBoundary(Ptr<Node> edge, const std::string& reqbr)
 		double supersize = BRinfoPtr->GetChunkSize(BRinfoPtr->GetBRFromRank(superrank));
 		for(uint32_t hop = 1; hop <= routelen; hop++)
 		{
-			auto iter = m_delaytable.find(DelayTableKey{reqbr, hop, edge->GetId()});
+			auto iter = m_delaytable.find(DelayTableKey{baserank, hop, edge->GetId()});
 			if(iter != m_delaytable.end())
 			{
 				if(accumulatedDelay + (iter->second / 1000) <= (limit * basesize / supersize) && hop > currentbd)
@@ -1398,7 +1492,7 @@ HeuPartitionHelper::SetBRBoundary(Ptr<Node> edge, const std::string& reqbr)
 	}
 	for(uint32_t hop = currentbd + 1; hop <= routelen; hop++)
 	{
-		auto iter = m_delaytable.find(DelayTableKey{reqbr, hop, edge->GetId()});
+		auto iter = m_delaytable.find(DelayTableKey{baserank, hop, edge->GetId()});
 		if(iter != m_delaytable.end())
 		{
 			if(accumulatedDelay + (iter->second / 1000) <= limit && hop > currentbd)
@@ -1419,7 +1513,7 @@ HeuPartitionHelper::SetBRBoundary(Ptr<Node> edge, const std::string& reqbr)
 			double lowersize = BRinfoPtr->GetChunkSize(BRinfoPtr->GetBRFromRank(lowerrank));
 			for(uint32_t hop = currentbd + 1; hop <= routelen; hop++)
 			{
-				auto iter = m_delaytable.find(DelayTableKey{reqbr, hop, edge->GetId()});
+				auto iter = m_delaytable.find(DelayTableKey{baserank, hop, edge->GetId()});
 				if(iter != m_delaytable.end())
 				{
 					if(accumulatedDelay + (iter->second / 1000) <= (limit * basesize / lowersize) && hop > currentbd)
@@ -19,10 +19,7 @@
 #include "ns3/ndn-videostat.h"
 #include "ns3/ndn-bitrate.h"
 
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/exception.h>
-#include <cppconn/statement.h>
+#include "ns3/ndn-trace-sink.h"
 
 #include <tuple>
 #include <unordered_map>
@@ -32,9 +29,16 @@
 #include <set>
 #include <utility>
 #include <fstream>
+#include <algorithm>
 
 #include <boost/lexical_cast.hpp>
 
+#ifdef HAVE_MYSQL
+namespace sql {
+class Driver;
+}
+#endif
+
 namespace ns3{
 namespace ndn{
 
@@ -45,6 +49,7 @@ class HeuPartitionHelper
 	using CandidateTable = std::map<uint32_t, std::set<VideoIndex> >;
 	using DelayTable = std::unordered_map<DelayTableKey, double>;
 public:
+#ifdef HAVE_MYSQL
 	HeuPartitionHelper(const std::string& prefix,
 					   const std::string& roundtime,
 					   double rewardparam,
@@ -58,6 +63,19 @@ public:
 					   const std::string& ip,
 					   int port,
 					   uint32_t expid);
+#endif
+
+	/*
+	 * CacheStatus is written to 'sink'
+	 */
+	HeuPartitionHelper(const std::string& prefix,
+					   const std::string& roundtime,
+					   double rewardparam,
+	   	   	   	   	   uint32_t B,
+					   uint32_t iterationTimes,
+					   uint32_t mode,
+					   Ptr<TraceSink> sink,
+					   uint32_t expid);
 
 	~HeuPartitionHelper();
 
@@ -70,6 +88,16 @@ public:
 	void
 	IterativeRun();
 
+	/*
+	 * Threads running the cache stack of independent routing paths and subtrees
+	 * (0: one per processor); the decisions are the same for any number of threads
+	 */
+	void
+	SetThreads(uint32_t threads);
+
+	inline void
+	SetIterationTimes(uint32_t iterations) {m_iterationTimes = iterations;}
+
 
 private:
 	// Topology Search AND Discover Dependency Set (Coordination Graph) for Each Node
@@ -77,35 +105,66 @@ private:
 	void DepthFirstSearch(Ptr<Node>, std::deque<Ptr<Node> >&);
 
 private:
+	/*
+	 * What the cache stack passes read from a router, gathered on the main thread:
+	 * the passes then run on other threads without touching the ns-3 objects
+	 */
+	struct RouterInfo
+	{
+		uint32_t 			m_id;
+		uint32_t 			m_capacity;
+		std::vector<double> m_chunksize;	// [bitrate rank]
+		std::vector<double> m_reward;		// [bitrate rank]
+		const std::unordered_map<VideoIndex, uint64_t>* m_table;	// Video statistics, edge routers only
+
+		inline double GetChunkSize(uint32_t rank) const {return m_chunksize[std::min<uint32_t>(rank, m_chunksize.size() - 1)];}
+		inline double GetReward(uint32_t rank) const {return m_reward[std::min<uint32_t>(rank, m_reward.size() - 1)];}
+	};
+
+	void GatherRouterInfo();
+
+	/*
+	 * What AdjustStackSize would print for one router: it runs on other threads,
+	 * so PathCacheByPop prints it once all the routers are done, in their order
+	 */
+	struct StackDiagnostics
+	{
+		std::vector<std::string>	m_debug;		// NS_LOG_DEBUG lines
+		uint32_t					m_impossible;	// Paths whose capacity grew
+
+		StackDiagnostics() :m_impossible(0) {}
+	};
+
 	/*
 	 * Push Content into Cache Stack when there is available capacity
 	 */
-	void AssignCacheStack(Ptr<Node>,
+	void AssignCacheStack(const RouterInfo&,
 						  uint32_t,
 						  std::list<std::pair<VideoIndex, double> >&);
 
-	void AdjustCacheStack(Ptr<Node>,
+	void AdjustCacheStack(const RouterInfo&,
 					  	  uint32_t,
 						  std::list<std::pair<VideoIndex, double> >&,
 						  std::map<uint32_t, std::list<std::pair<VideoIndex, double> > >&);
 
-	bool AllowCacheMore(Ptr<NDNBitRate>,
-						uint32_t,
+	bool AllowCacheMore(const RouterInfo&,
 						uint32_t,
 						uint32_t,
 			  	  	  	const std::map<uint32_t, std::list<std::pair<VideoIndex, double> > >&);
 
 	// Maintain the Cache Stack
 	void DeriveCacheStackByPath();
+	void DeriveCacheStack(const RouterInfo&, std::list<std::pair<VideoIndex, double> >&);
 
 private:
-	void MergeCacheStack(Ptr<Node>,
+	void MergeCacheStack(const RouterInfo&,
 						 std::unordered_map<VideoIndex,double>&,
 						 CandidateTable&);
 
-	bool AdjustStackSize(Ptr<Node>,
+	bool AdjustStackSize(const RouterInfo&,
 						 std::unordered_map<VideoIndex,double>&,
-						 CandidateTable&);
+						 CandidateTable&,
+						 StackDiagnostics&);
 
 	void
 	Solver();
@@ -153,12 +212,12 @@ private:
 
 	uint32_t						m_iterationTimes;
 	uint32_t						m_itercounter;
+	uint32_t						m_threads;
 
 	double							m_alpha;
 	uint32_t						m_design;
 
-	sql::Connection*				m_con;
-	sql::Statement*					m_stmt;
+	Ptr<TraceSink>					m_sink;
 
 	//Key: each edge router; Value: cache stack viewed from each routing path
 	std::unordered_map<uint32_t, std::list<std::pair<VideoIndex, double> > > 	m_cachestack;
@@ -169,6 +228,8 @@ private:
 
 	DelayTable											m_delaytable;
 
+	std::unordered_map<uint32_t, RouterInfo>			m_routerinfo;
+
 	//std::unordered_map<uint32_t, std::map<std::string, double> >	m_partition;
 	//std::unordered_map<uint32_t, std::map<std::string, double> >	m_lastpartition;
 	std::list<double> m_condition;
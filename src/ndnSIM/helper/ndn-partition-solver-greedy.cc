@@ -0,0 +1,233 @@
+/*
+ * Cache capacity partition solved greedily, without external solver
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-partition-solver-greedy.h"
+
+#include "ns3/log.h"
+
+#include <queue>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GreedyPartitionSolver");
+
+namespace ns3{
+namespace ndn{
+
+void
+GreedyPartitionSolver::Init(const PartitionProblem& problem)
+{
+	m_problem = &problem;
+	uint32_t items = problem.m_items.size();
+
+	m_free.assign(problem.m_capacity.size(), 0);
+	m_onPaths.assign(problem.m_capacity.size(), std::vector<std::pair<uint32_t, uint32_t> >());
+	for(auto node = problem.m_nodes.begin(); node != problem.m_nodes.end(); node++)
+		m_free[*node] = problem.m_capacity[*node];
+
+	m_nearest.resize(problem.m_paths.size());
+	m_rank.resize(problem.m_paths.size());
+	m_gateway.resize(problem.m_paths.size());
+	m_maxFound.resize(problem.m_paths.size());
+	for(uint32_t m = 0; m < problem.m_paths.size(); m++)
+	{
+		const PartitionProblem::Path& path = problem.m_paths[m];
+		uint32_t last = path.m_nodes.size() - 1;
+
+		/* The producer is not a candidate: everything is found there anyway */
+		for(uint32_t pos = 0; pos < last; pos++)
+			if(m_free[path.m_nodes[pos]] > 0)
+				m_onPaths[path.m_nodes[pos]].push_back(std::make_pair(m, pos));
+
+		m_nearest[m].assign(items, last);
+		m_rank[m].assign(items, -1);
+		for(auto order = path.m_order.begin(); order != path.m_order.end(); order++)
+			for(uint32_t idx = 0; idx < order->size(); idx++)
+				m_rank[m][(*order)[idx]] = idx;
+		m_gateway[m].assign(problem.m_bitrates + 1, std::set<int32_t>());
+		m_maxFound[m].assign(path.GetGateway(), std::vector<int32_t>(problem.m_bitrates + 1, -1));
+	}
+}
+
+double
+GreedyPartitionSolver::Gain(uint32_t node, uint32_t item) const
+{
+	const PartitionProblem::Item& info = m_problem->m_items[item];
+	double gain = 0;
+	for(auto onPath = m_onPaths[node].begin(); onPath != m_onPaths[node].end(); onPath++)
+	{
+		const PartitionProblem::Path& path = m_problem->m_paths[onPath->first];
+		uint32_t pos = onPath->second;
+		uint32_t nearest = m_nearest[onPath->first][item];
+		if(pos >= nearest || path.m_popularity[item] == 0)
+			continue;
+		const std::vector<double>& reward = path.m_reward[info.m_bitrate];
+		gain += path.m_popularity[item] * (reward[pos] - reward[nearest]);
+	}
+	return gain;
+}
+
+bool
+GreedyPartitionSolver::IsOrdered(uint32_t node, uint32_t item) const
+{
+	/*
+	 * Below the gateway, the ranks found up to a router are a prefix of the ranks found
+	 * up to the gateway. The highest rank found grows towards the producer, so only the
+	 * routers next to the change need checking.
+	 */
+	uint32_t bitrate = m_problem->m_items[item].m_bitrate;
+	for(auto onPath = m_onPaths[node].begin(); onPath != m_onPaths[node].end(); onPath++)
+	{
+		uint32_t m = onPath->first;
+		uint32_t pos = onPath->second;
+		int32_t rank = m_rank[m][item];
+		uint32_t nearest = m_nearest[m][item];
+		if(rank < 0 || pos >= nearest)
+			continue;
+		uint32_t gateway = m_problem->m_paths[m].GetGateway();
+
+		/* Newly found at the gateway: it must rank after everything found below node */
+		uint32_t below = std::min(pos, gateway);
+		if(nearest > gateway && below > 0 && rank < m_maxFound[m][below - 1][bitrate])
+			return false;
+
+		/* Newly found from node on: nothing more popular may be missing there */
+		if(pos < std::min(nearest, gateway))
+		{
+			const std::set<int32_t>& found = m_gateway[m][bitrate];
+			auto next = found.upper_bound(m_maxFound[m][pos][bitrate]);
+			if(next != found.end() && *next == rank)
+				next++;
+			if(next != found.end() && *next < rank)
+				return false;
+		}
+	}
+	return true;
+}
+
+void
+GreedyPartitionSolver::Place(uint32_t node, uint32_t item, PartitionPlacement& placement)
+{
+	uint32_t bitrate = m_problem->m_items[item].m_bitrate;
+	for(auto onPath = m_onPaths[node].begin(); onPath != m_onPaths[node].end(); onPath++)
+	{
+		uint32_t m = onPath->first;
+		uint32_t pos = onPath->second;
+		uint32_t nearest = m_nearest[m][item];
+		if(pos >= nearest)
+			continue;
+
+		int32_t rank = m_rank[m][item];
+		if(rank >= 0)
+		{
+			uint32_t gateway = m_problem->m_paths[m].GetGateway();
+			if(nearest > gateway)
+				m_gateway[m][bitrate].insert(rank);
+			for(uint32_t j = pos; j < std::min(nearest, gateway); j++)
+				m_maxFound[m][j][bitrate] = std::max(m_maxFound[m][j][bitrate], rank);
+		}
+		m_nearest[m][item] = pos;
+	}
+	m_free[node] -= m_problem->m_items[item].m_size;
+	placement.push_back(std::make_pair(node, item));
+}
+
+PartitionSolver::Status
+GreedyPartitionSolver::Solve(const PartitionProblem& problem, const PartitionPlacement* start, PartitionPlacement& placement)
+{
+	Init(problem);
+	placement.clear();
+
+	/* Warm start: replay the previous placement, best first, where it still pays */
+	if(start != nullptr)
+	{
+		std::vector<Candidate> previous;
+		for(auto entry = start->begin(); entry != start->end(); entry++)
+		{
+			if(entry->first >= m_free.size() || entry->second >= problem.m_items.size())
+				continue;
+			double gain = Gain(entry->first, entry->second);
+			if(gain > 0)
+				previous.push_back(Candidate {gain / problem.m_items[entry->second].m_size, entry->first, entry->second});
+		}
+		std::sort(previous.begin(), previous.end());
+		for(auto c = previous.rbegin(); c != previous.rend(); c++)
+		{
+			if(problem.m_items[c->m_item].m_size <= m_free[c->m_node] &&
+			   Gain(c->m_node, c->m_item) > 0 && IsOrdered(c->m_node, c->m_item))
+				Place(c->m_node, c->m_item, placement);
+		}
+	}
+
+	/* Candidates: the items requested on some path through each router */
+	std::priority_queue<Candidate> heap;
+	std::vector<uint32_t> seen(problem.m_items.size(), 0);
+	uint32_t stamp = 0;
+	for(auto node = problem.m_nodes.begin(); node != problem.m_nodes.end(); node++)
+	{
+		stamp++;
+		for(auto onPath = m_onPaths[*node].begin(); onPath != m_onPaths[*node].end(); onPath++)
+		{
+			const PartitionProblem::Path& path = problem.m_paths[onPath->first];
+			for(auto order = path.m_order.begin(); order != path.m_order.end(); order++)
+			{
+				for(auto item = order->begin(); item != order->end(); item++)
+				{
+					if(seen[*item] == stamp)
+						continue;
+					seen[*item] = stamp;
+					double gain = Gain(*node, *item);
+					if(gain > 0)
+						heap.push(Candidate {gain / problem.m_items[*item].m_size, *node, *item});
+				}
+			}
+		}
+	}
+
+	/* Candidates out of order now may fit once more popular items are placed */
+	std::vector<Candidate> deferred;
+	bool progress = false;
+	while(!heap.empty())
+	{
+		Candidate c = heap.top();
+		heap.pop();
+
+		double size = problem.m_items[c.m_item].m_size;
+		if(size <= m_free[c.m_node])
+		{
+			double gain = Gain(c.m_node, c.m_item);
+			if(gain > 0)
+			{
+				double density = gain / size;
+				if(!heap.empty() && density < heap.top().m_density)
+				{
+					c.m_density = density;
+					heap.push(c);
+				}
+				else if(IsOrdered(c.m_node, c.m_item))
+				{
+					Place(c.m_node, c.m_item, placement);
+					progress = true;
+				}
+				else
+					deferred.push_back(c);
+			}
+		}
+
+		if(heap.empty() && progress)
+		{
+			for(auto d = deferred.begin(); d != deferred.end(); d++)
+				heap.push(*d);
+			deferred.clear();
+			progress = false;
+		}
+	}
+
+	NS_LOG_INFO("Greedy placement: " << placement.size() << " chunks, value " << Evaluate(problem, placement));
+	return HEURISTIC;
+}
+
+}
+}
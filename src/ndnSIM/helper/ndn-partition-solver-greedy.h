@@ -0,0 +1,72 @@
+/*
+ * Cache capacity partition solved greedily, without external solver
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_PARTITION_SOLVER_GREEDY_H
+#define NDN_PARTITION_SOLVER_GREEDY_H
+
+#include "ndn-partition-solver.h"
+
+#include <set>
+
+namespace ns3{
+namespace ndn{
+
+/*
+ * Lazy greedy knapsack on all the routers at once: the (router, item) with the
+ * highest gain of reward per byte is placed first, as long as it fits and keeps the
+ * popularity order of every path through the router. Gains only change for the item
+ * just placed, so candidates are re-evaluated when they reach the top of the heap.
+ * A warm-start placement is replayed first, so placements stay stable across
+ * iterations when the statistics barely change.
+ */
+class GreedyPartitionSolver : public PartitionSolver
+{
+public:
+	virtual Status
+	Solve(const PartitionProblem& problem, const PartitionPlacement* start, PartitionPlacement& placement);
+
+private:
+	struct Candidate
+	{
+		double 		m_density;
+		uint32_t 	m_node;
+		uint32_t 	m_item;
+
+		bool operator<(const Candidate& other) const
+		{
+			return (m_density < other.m_density) ||
+					(m_density == other.m_density && m_node > other.m_node) ||
+					(m_density == other.m_density && m_node == other.m_node && m_item > other.m_item);
+		}
+	};
+
+	void Init(const PartitionProblem& problem);
+
+	/*
+	 * Reward gained by caching item on node
+	 */
+	double Gain(uint32_t node, uint32_t item) const;
+
+	/*
+	 * Whether caching item on node keeps the order constraints
+	 */
+	bool IsOrdered(uint32_t node, uint32_t item) const;
+
+	void Place(uint32_t node, uint32_t item, PartitionPlacement& placement);
+
+	const PartitionProblem* 	m_problem;
+	std::vector<double> 		m_free;			// [node]: capacity left
+	std::vector<std::vector<std::pair<uint32_t, uint32_t> > > m_onPaths;	// [node]: (path, position)
+	std::vector<std::vector<uint32_t> > m_nearest;	// [path][item]: position of the first router holding it
+	std::vector<std::vector<int32_t> > 	m_rank;		// [path][item]: index in the order of its bitrate, -1: none
+	std::vector<std::vector<std::set<int32_t> > > m_gateway;	// [path][bitrate]: ranks found up to the gateway
+	std::vector<std::vector<std::vector<int32_t> > > m_maxFound;	// [path][position][bitrate]: highest rank found up to there
+};
+
+}
+}
+
+#endif
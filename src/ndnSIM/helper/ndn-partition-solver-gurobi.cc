@@ -0,0 +1,287 @@
+/*
+ * Cache capacity partition solved as a MIP by Gurobi
+ *
+ * Date: 2026-10-17
+ */
+
+#ifdef HAVE_GUROBI_CPP
+
+#include "ndn-partition-solver-gurobi.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <iostream>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GurobiPartitionSolver");
+
+namespace ns3{
+namespace ndn{
+
+GurobiPartitionSolver::GurobiPartitionSolver()
+	:m_env(nullptr)
+	,m_model(nullptr)
+	,m_gap(-1)
+{
+	try{
+		m_env = new GRBEnv();
+	}
+	catch (GRBException& e)
+	{
+		std::cout << e.getMessage() << std::endl;
+	}
+}
+
+GurobiPartitionSolver::~GurobiPartitionSolver()
+{
+	delete m_model;
+	m_model = nullptr;
+	delete m_env;
+	m_env = nullptr;
+}
+
+void
+GurobiPartitionSolver::ModelInit()
+{
+	delete m_model;
+	m_model = new GRBModel(*m_env);
+
+	m_model->set(GRB_IntAttr_ModelSense, GRB_MAXIMIZE); //Optimize Objective
+	m_model->set(GRB_IntParam_MIPFocus, 3);	  //Try reducing the gap as much as possible
+	m_model->set(GRB_IntParam_Method, 3);	  //User concurrent solver
+	m_model->set(GRB_IntParam_LogToConsole, 1);//Print the solving procedure on screen
+
+	m_model->set(GRB_DoubleParam_MIPGap,4e-2);		//Set gap distance (accuracy of result)
+	m_model->set(GRB_IntParam_Threads, 16);
+	m_model->set(GRB_DoubleParam_TimeLimit, 4800.0);	//Set time limit for solving optimization
+}
+
+bool
+GurobiPartitionSolver::IsSameStructure(const PartitionProblem& problem) const
+{
+	if(m_model == nullptr || problem.m_nodes != m_nodes || problem.m_capacity != m_capacity ||
+	   problem.m_items.size() != m_sizes.size() || problem.m_paths.size() != m_paths.size())
+		return false;
+	for(uint32_t v = 0; v < m_sizes.size(); v++)
+		if(problem.m_items[v].m_size != m_sizes[v])
+			return false;
+	for(uint32_t m = 0; m < m_paths.size(); m++)
+		if(problem.m_paths[m].m_nodes != m_paths[m])
+			return false;
+	return true;
+}
+
+void
+GurobiPartitionSolver::BuildModel(const PartitionProblem& problem)
+{
+	const uint32_t items = problem.m_items.size();
+	ModelInit();
+	m_orderConstrs.clear();
+
+	m_nodes = problem.m_nodes;
+	m_capacity = problem.m_capacity;
+	m_sizes.clear();
+	for(uint32_t v = 0; v < items; v++)
+		m_sizes.push_back(problem.m_items[v].m_size);
+	m_paths.clear();
+	for(auto path = problem.m_paths.begin(); path != problem.m_paths.end(); path++)
+		m_paths.push_back(path->m_nodes);
+
+	/* X_j(f, k, b) */
+	m_x.assign(problem.m_capacity.size(), std::vector<GRBVar>());
+	for(auto node = problem.m_nodes.begin(); node != problem.m_nodes.end(); node++)
+	{
+		m_x[*node].reserve(items);
+		for(uint32_t v = 0; v < items; v++)
+			m_x[*node].push_back(m_model->addVar(0.0, 1.0, 0.0, GRB_BINARY));
+	}
+
+	/* \alpha_j(L(m), f, k, b): item found on the path of m up to the router at position j */
+	m_alpha.assign(problem.m_paths.size(), std::vector<std::vector<GRBVar> >());
+	for(uint32_t m = 0; m < problem.m_paths.size(); m++)
+	{
+		const PartitionProblem::Path& path = problem.m_paths[m];
+		NS_ASSERT_MSG(!m_x[path.m_nodes[0]].empty(), "Edge router " << path.m_edge << " cannot cache");
+		m_alpha[m].resize(path.m_nodes.size());
+		for(uint32_t pos = 0; pos < path.m_nodes.size(); pos++)
+		{
+			m_alpha[m][pos].reserve(items);
+			for(uint32_t v = 0; v < items; v++)
+				m_alpha[m][pos].push_back(m_model->addVar(0.0, 1.0, 0.0, GRB_BINARY));
+		}
+	}
+
+	//Cache Capacity Constraints
+	for(auto node = problem.m_nodes.begin(); node != problem.m_nodes.end(); node++)
+	{
+		GRBLinExpr cache_constr;
+		for(uint32_t v = 0; v < items; v++)
+			cache_constr += problem.m_items[v].m_size * m_x[*node][v];
+		m_model->addConstr(cache_constr, GRB_LESS_EQUAL, problem.m_capacity[*node]);
+	}
+
+	for(uint32_t m = 0; m < problem.m_paths.size(); m++)
+	{
+		const PartitionProblem::Path& path = problem.m_paths[m];
+		uint32_t last = path.m_nodes.size() - 1;
+		for(uint32_t v = 0; v < items; v++)
+		{
+			//Relationship Between \alpha and X
+			for(uint32_t pos = 1; pos < last; pos++)
+			{
+				const std::vector<GRBVar>& xnode = m_x[path.m_nodes[pos]];
+				NS_ASSERT_MSG(!xnode.empty(), "Router " << path.m_nodes[pos] << " cannot cache");
+				m_model->addConstr(m_alpha[m][pos][v], GRB_GREATER_EQUAL, m_alpha[m][pos - 1][v]);
+				m_model->addConstr(m_alpha[m][pos][v], GRB_GREATER_EQUAL, xnode[v]);
+				m_model->addConstr(m_alpha[m][pos][v], GRB_LESS_EQUAL, m_alpha[m][pos - 1][v] + xnode[v]);
+			}
+
+			//Artificial Constraints
+			m_model->addConstr(m_alpha[m][last][v], GRB_EQUAL, 1);
+			m_model->addConstr(m_alpha[m][0][v], GRB_EQUAL, m_x[path.m_nodes[0]][v]);
+		}
+	}
+	m_model->update();
+}
+
+void
+GurobiPartitionSolver::SetObjective(const PartitionProblem& problem)
+{
+	/* Reward of the first router holding the item: r_j * (\alpha_j - \alpha_{j-1}) summed over j */
+	const uint32_t items = problem.m_items.size();
+	std::vector<double> coeff(items);
+	for(uint32_t m = 0; m < problem.m_paths.size(); m++)
+	{
+		const PartitionProblem::Path& path = problem.m_paths[m];
+		uint32_t last = path.m_nodes.size() - 1;
+		for(uint32_t pos = 0; pos <= last; pos++)
+		{
+			for(uint32_t v = 0; v < items; v++)
+			{
+				const std::vector<double>& reward = path.m_reward[problem.m_items[v].m_bitrate];
+				coeff[v] = path.m_popularity[v] * (pos < last ? reward[pos] - reward[pos + 1] : reward[last]);
+			}
+			m_model->set(GRB_DoubleAttr_Obj, m_alpha[m][pos].data(), coeff.data(), items);
+		}
+	}
+}
+
+void
+GurobiPartitionSolver::SetOrderConstraints(const PartitionProblem& problem)
+{
+	for(auto constr = m_orderConstrs.begin(); constr != m_orderConstrs.end(); constr++)
+		m_model->remove(*constr);
+	m_orderConstrs.clear();
+
+	//Popularity order below the gateway
+	double M = 1e5;
+	for(uint32_t m = 0; m < problem.m_paths.size(); m++)
+	{
+		const PartitionProblem::Path& path = problem.m_paths[m];
+		uint32_t last = path.m_nodes.size() - 1;
+		uint32_t gateway = path.GetGateway();
+		for(uint32_t pos = 0; pos < last; pos++)
+		{
+			if(pos == gateway)
+				continue;
+			for(auto order = path.m_order.begin(); order != path.m_order.end(); order++)
+			{
+				GRBLinExpr lhs_constr;
+				for(uint32_t idx = 1; idx < order->size(); idx++)
+				{
+					uint32_t prev = (*order)[idx - 1];
+					lhs_constr += m_alpha[m][gateway][prev] - m_alpha[m][pos][prev];
+					m_orderConstrs.push_back(
+						m_model->addConstr(lhs_constr, GRB_LESS_EQUAL, M - M * m_alpha[m][pos][(*order)[idx]]));
+				}
+			}
+		}
+	}
+}
+
+void
+GurobiPartitionSolver::SetStart(const PartitionProblem& problem, const PartitionPlacement& start)
+{
+	/* Complete start: X from the placement, \alpha derived from X */
+	const uint32_t items = problem.m_items.size();
+	std::vector<std::vector<double> > x(problem.m_capacity.size());
+	for(auto node = problem.m_nodes.begin(); node != problem.m_nodes.end(); node++)
+		x[*node].assign(items, 0.0);
+	for(auto entry = start.begin(); entry != start.end(); entry++)
+		if(entry->first < x.size() && !x[entry->first].empty() && entry->second < items)
+			x[entry->first][entry->second] = 1.0;
+
+	for(auto node = problem.m_nodes.begin(); node != problem.m_nodes.end(); node++)
+		m_model->set(GRB_DoubleAttr_Start, m_x[*node].data(), x[*node].data(), items);
+
+	std::vector<double> alpha(items);
+	for(uint32_t m = 0; m < problem.m_paths.size(); m++)
+	{
+		const PartitionProblem::Path& path = problem.m_paths[m];
+		uint32_t last = path.m_nodes.size() - 1;
+		std::fill(alpha.begin(), alpha.end(), 0.0);
+		for(uint32_t pos = 0; pos <= last; pos++)
+		{
+			if(pos == last)
+				std::fill(alpha.begin(), alpha.end(), 1.0);
+			else
+				for(uint32_t v = 0; v < items; v++)
+					alpha[v] = std::max(alpha[v], x[path.m_nodes[pos]][v]);
+			m_model->set(GRB_DoubleAttr_Start, m_alpha[m][pos].data(), alpha.data(), items);
+		}
+	}
+}
+
+PartitionSolver::Status
+GurobiPartitionSolver::Solve(const PartitionProblem& problem, const PartitionPlacement* start, PartitionPlacement& placement)
+{
+	const uint32_t items = problem.m_items.size();
+	placement.clear();
+	m_gap = -1;
+	try{
+		if(!IsSameStructure(problem))
+		{
+			NS_LOG_INFO("Build the partition model");
+			BuildModel(problem);
+		}
+
+		SetObjective(problem);
+		SetOrderConstraints(problem);
+		m_model->update();
+		if(start != nullptr)
+			SetStart(problem, *start);
+		m_model->optimize();
+
+		int status = m_model->get(GRB_IntAttr_Status);
+		if(status == GRB_INF_OR_UNBD)
+			return INFEASIBLE;
+		if(status != GRB_OPTIMAL && status != GRB_TIME_LIMIT)
+			return ERROR;
+
+		m_gap = m_model->get(GRB_DoubleAttr_MIPGap);
+		for(auto node = problem.m_nodes.begin(); node != problem.m_nodes.end(); node++)
+			for(uint32_t v = 0; v < items; v++)
+				if(m_x[*node][v].get(GRB_DoubleAttr_X) > 0.5)
+					placement.push_back(std::make_pair(*node, v));
+		return status == GRB_OPTIMAL ? OPTIMAL : TIME_LIMIT;
+	}
+	catch (GRBException& e)
+	{
+		NS_LOG_ERROR("Gurobi: " << e.getMessage());
+		delete m_model;
+		m_model = nullptr;
+		return ERROR;
+	}
+}
+
+double
+GurobiPartitionSolver::GetGap() const
+{
+	return m_gap;
+}
+
+}
+}
+
+#endif // HAVE_GUROBI_CPP
@@ -0,0 +1,64 @@
+/*
+ * Cache capacity partition solved as a MIP by Gurobi
+ *
+ * The model is kept between two Solve calls on problems with the same routers, paths
+ * and items: only the objective coefficients and the popularity-order constraints,
+ * which follow the request statistics, are replaced, and the previous placement is
+ * given as a complete MIP start.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_PARTITION_SOLVER_GUROBI_H
+#define NDN_PARTITION_SOLVER_GUROBI_H
+
+#include "ndn-partition-solver.h"
+
+#include "gurobi_c++.h"
+
+namespace ns3{
+namespace ndn{
+
+class GurobiPartitionSolver : public PartitionSolver
+{
+public:
+	GurobiPartitionSolver();
+	virtual ~GurobiPartitionSolver();
+
+	virtual Status
+	Solve(const PartitionProblem& problem, const PartitionPlacement* start, PartitionPlacement& placement);
+
+	virtual double
+	GetGap() const;
+
+private:
+	void ModelInit();
+
+	bool IsSameStructure(const PartitionProblem& problem) const;
+
+	/* Variables, capacity and \alpha-X constraints */
+	void BuildModel(const PartitionProblem& problem);
+
+	void SetObjective(const PartitionProblem& problem);
+	void SetOrderConstraints(const PartitionProblem& problem);
+	void SetStart(const PartitionProblem& problem, const PartitionPlacement& start);
+
+	GRBEnv* 	m_env;
+	GRBModel* 	m_model;
+	double 		m_gap;
+
+	std::vector<std::vector<GRBVar> > 	m_x;		// [node][item]: X_j(f, k, b)
+	std::vector<std::vector<std::vector<GRBVar> > > m_alpha;	// [path][position][item]
+	std::vector<GRBConstr> 				m_orderConstrs;
+
+	/* Structure of the problem the model was built for */
+	std::vector<uint32_t> 	m_nodes;
+	std::vector<double> 	m_capacity;
+	std::vector<double> 	m_sizes;
+	std::vector<std::vector<uint32_t> > m_paths;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Cache capacity partition problem of PartitionHelper, and the solvers of it
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-partition-solver.h"
+#include "ndn-partition-solver-greedy.h"
+#ifdef HAVE_GUROBI_CPP
+#include "ndn-partition-solver-gurobi.h"
+#endif
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PartitionSolver");
+
+namespace ns3{
+namespace ndn{
+
+Ptr<PartitionSolver>
+PartitionSolver::Create(const std::string& name)
+{
+#ifdef HAVE_GUROBI_CPP
+	if(name == "Gurobi" || name.empty())
+		return ns3::Create<GurobiPartitionSolver>();
+#endif
+	if(name == "Greedy" || name.empty())
+		return ns3::Create<GreedyPartitionSolver>();
+
+	NS_FATAL_ERROR("Unknown cache partition solver: " << name);
+	return 0;
+}
+
+double
+PartitionSolver::Evaluate(const PartitionProblem& problem, const PartitionPlacement& placement)
+{
+	std::vector<std::vector<uint8_t> > cached(problem.m_capacity.size());
+	for(auto entry = placement.begin(); entry != placement.end(); entry++)
+	{
+		if(cached[entry->first].empty())
+			cached[entry->first].assign(problem.m_items.size(), 0);
+		cached[entry->first][entry->second] = 1;
+	}
+
+	double value = 0;
+	for(auto path = problem.m_paths.begin(); path != problem.m_paths.end(); path++)
+	{
+		for(uint32_t v = 0; v < problem.m_items.size(); v++)
+		{
+			if(path->m_popularity[v] == 0)
+				continue;
+			uint32_t pos = 0;
+			while(pos + 1 < path->m_nodes.size() &&
+				  (cached[path->m_nodes[pos]].empty() || !cached[path->m_nodes[pos]][v]))
+				pos++;
+			value += path->m_popularity[v] * path->m_reward[problem.m_items[v].m_bitrate][pos];
+		}
+	}
+	return value;
+}
+
+}
+}
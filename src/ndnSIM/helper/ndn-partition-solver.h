@@ -0,0 +1,109 @@
+/*
+ * Cache capacity partition problem of PartitionHelper, and the solvers of it
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_PARTITION_SOLVER_H
+#define NDN_PARTITION_SOLVER_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/ndn-videocontent.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace ns3{
+namespace ndn{
+
+/*
+ * Which video chunks every router caches.
+ *
+ * X_j(v): router j caches item v, with sum_v size(v) X_j(v) <= capacity(j).
+ * On the path from an edge router m to the producer, a request for v is served by
+ * the first router caching it (the producer otherwise), which earns
+ * popularity_m(v) * reward_m(bitrate(v), position of that router). The objective is
+ * the sum of the rewards over all edges and items.
+ *
+ * Order constraint: on the path of m, below the gateway (the router next to the
+ * producer), the items of one bitrate found before router j must be the most
+ * popular (at m) of the items found before the gateway.
+ */
+struct PartitionProblem
+{
+	struct Item
+	{
+		VideoIndex 	m_vi;
+		uint32_t 	m_bitrate;		// Index in Path::m_reward, from 1
+		double 		m_size;
+	};
+
+	struct Path
+	{
+		uint32_t 					m_edge;
+		std::vector<uint32_t> 		m_nodes;		// Node IDs, from the edge (position 0) to the producer
+		std::vector<std::vector<double> > m_reward;	// [bitrate][position]
+		std::vector<double> 		m_popularity;	// [item]
+		std::vector<std::vector<uint32_t> > m_order;	// [bitrate]: items requested at the edge, most popular first
+
+		inline uint32_t GetGateway() const {return m_nodes.size() >= 2 ? m_nodes.size() - 2 : 0;}
+	};
+
+	std::vector<Item> 		m_items;
+	std::vector<uint32_t> 	m_nodes;		// IDs of the routers that may cache
+	std::vector<double> 	m_capacity;		// [node ID]
+	std::vector<Path> 		m_paths;
+	uint32_t 				m_bitrates;
+};
+
+/*
+ * (node ID, item)
+ */
+using PartitionPlacement = std::vector<std::pair<uint32_t, uint32_t> >;
+
+class PartitionSolver : public SimpleRefCount<PartitionSolver>
+{
+public:
+	enum Status
+	{
+		OPTIMAL,		// Optimal within the solver tolerance
+		TIME_LIMIT,		// Best placement found in the time limit
+		HEURISTIC,		// Feasible placement, no optimality bound
+		INFEASIBLE,
+		ERROR
+	};
+
+	virtual ~PartitionSolver() {}
+
+	/*
+	 * Solve problem into placement. start, if not null, is the placement of the
+	 * previous iteration, used as a warm start.
+	 */
+	virtual Status
+	Solve(const PartitionProblem& problem, const PartitionPlacement* start, PartitionPlacement& placement) = 0;
+
+	/*
+	 * Relative gap to the optimum of the last Solve, negative if unknown
+	 */
+	virtual double
+	GetGap() const {return -1;}
+
+	/*
+	 * "Gurobi" (if built with it) or "Greedy"; empty: Gurobi if available
+	 */
+	static Ptr<PartitionSolver>
+	Create(const std::string& name = "");
+
+	/*
+	 * Objective value of placement
+	 */
+	static double
+	Evaluate(const PartitionProblem& problem, const PartitionPlacement& placement);
+};
+
+}
+}
+
+#endif
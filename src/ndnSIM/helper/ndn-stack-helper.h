@@ -218,12 +218,14 @@ public:
    * installed on it
    *
    * \param node The node on which to install the stack.
+   * \param brArray Video bitrates of the content store sections (none by default)
+   * \param size Number of bitrates in brArray
    *
    * \returns list of installed faces in the form of a smart pointer
    * to FaceContainer object
    */
   Ptr<FaceContainer>
-  Install (Ptr<Node> node, const std::string brArray[], uint32_t size, bool needstats = true);
+  Install (Ptr<Node> node, const std::string brArray[] = 0, uint32_t size = 0, bool needstats = true);
 
   void
   SetRatio(Ptr<Node> node, double r[], const std::string brArray[], uint32_t size);
@@ -0,0 +1,392 @@
+/*
+ * Parameter sweep driver for the video caching scenarios
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-sweep-helper.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/command-line.h"
+#include "ns3/ndn-trace-sink.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.SweepHelper");
+
+namespace ns3{
+
+namespace ndn{
+
+SweepHelper::SweepHelper(const std::string& program)
+	:m_program(program)
+	,m_jobs(0)
+	,m_firstExpID(0)
+	,m_outdir("./Sweep")
+{
+
+}
+
+SweepHelper::~SweepHelper()
+{
+
+}
+
+void
+SweepHelper::AddParameter(const std::string& name, const std::vector<std::string>& values)
+{
+	NS_ASSERT_MSG(!values.empty(), "Parameter " << name << " has no value to sweep");
+	m_grid.push_back(Parameter {name, values});
+}
+
+bool
+SweepHelper::AddGrid(const std::string& spec)
+{
+	std::vector<std::string> dims;
+	boost::split(dims, spec, boost::is_any_of(";"), boost::token_compress_on);
+	for(auto iter = dims.begin(); iter != dims.end(); iter++)
+	{
+		if(iter->empty())
+			continue;
+		std::size_t eq = iter->find('=');
+		if(eq == std::string::npos || eq == 0 || eq + 1 == iter->size())
+		{
+			NS_LOG_ERROR("Malformed sweep dimension: " << *iter);
+			return false;
+		}
+		std::vector<std::string> values;
+		std::string valuelist = iter->substr(eq + 1);
+		boost::split(values, valuelist, boost::is_any_of(","), boost::token_compress_on);
+		AddParameter(iter->substr(0, eq), values);
+	}
+	return true;
+}
+
+void
+SweepHelper::AddFixedArgument(const std::string& arg)
+{
+	m_fixed.push_back(arg);
+}
+
+uint32_t
+SweepHelper::GetNumRuns() const
+{
+	uint32_t num = 1;
+	for(uint32_t i = 0; i < m_grid.size(); i++)
+		num *= m_grid[i].m_values.size();
+	return num;
+}
+
+bool
+SweepHelper::CheckParameters(const std::vector<std::string>& allowed) const
+{
+	for(uint32_t i = 0; i < m_grid.size(); i++)
+	{
+		if(std::find(allowed.begin(), allowed.end(), m_grid[i].m_name) == allowed.end())
+		{
+			NS_LOG_ERROR(m_grid[i].m_name << " cannot be varied here, only: "
+						 << boost::algorithm::join(allowed, " "));
+			return false;
+		}
+	}
+	return true;
+}
+
+std::vector<uint32_t>
+SweepHelper::GetPoint(uint32_t run) const
+{
+	std::vector<uint32_t> point(m_grid.size(), 0);
+	for(uint32_t i = m_grid.size(); i > 0; i--)
+	{
+		uint32_t radix = m_grid[i - 1].m_values.size();
+		point[i - 1] = run % radix;
+		run /= radix;
+	}
+	return point;
+}
+
+std::vector<std::string>
+SweepHelper::GetArguments(uint32_t run) const
+{
+	std::vector<std::string> args(m_fixed);
+	std::vector<uint32_t> point = GetPoint(run);
+	for(uint32_t i = 0; i < m_grid.size(); i++)
+		args.push_back("--" + m_grid[i].m_name + "=" + m_grid[i].m_values[point[i]]);
+
+	std::string id = boost::lexical_cast<std::string>(m_firstExpID + run);
+	args.push_back("--ExpID=" + id);
+	bool rngrun = false;
+	for(uint32_t i = 0; i < m_grid.size(); i++)
+		rngrun = rngrun || m_grid[i].m_name == "RngRun";
+	if(!m_restore && !rngrun)
+		args.push_back("--RngRun=" + id);
+	return args;
+}
+
+int
+SweepHelper::Launch(uint32_t run) const
+{
+	std::vector<std::string> args = GetArguments(run);
+	std::string logpath = m_outdir + "/exp" + boost::lexical_cast<std::string>(m_firstExpID + run) + ".log";
+
+	std::cout.flush();
+	std::cerr.flush();
+	pid_t pid = fork();
+	if(pid != 0)
+		return pid;
+
+	// Child: give the run its own output sink and replace the process image
+	int fd = open(logpath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(fd >= 0)
+	{
+		dup2(fd, STDOUT_FILENO);
+		dup2(fd, STDERR_FILENO);
+		close(fd);
+	}
+
+	// ... or go on from the snapshot
+	if(m_restore)
+	{
+		m_restore(args);
+		return 0;
+	}
+
+	std::vector<char*> argv;
+	argv.push_back(const_cast<char*>(m_program.c_str()));
+	for(uint32_t i = 0; i < args.size(); i++)
+		argv.push_back(const_cast<char*>(args[i].c_str()));
+	argv.push_back(0);
+
+	// argv[0] may be relative to a directory the scenario left, or a bare name found
+	// in PATH: run the binary of this process, as long as /proc is there
+	execv("/proc/self/exe", argv.data());
+	execvp(m_program.c_str(), argv.data());
+	std::fprintf(stderr, "Cannot execute %s: %s\n", m_program.c_str(), std::strerror(errno));
+	_exit(127);
+}
+
+uint32_t
+SweepHelper::Run()
+{
+	bool child = false;
+	m_restore = nullptr;
+	return Execute(child);
+}
+
+void
+SweepHelper::RunFromSnapshot(const std::function<void(const std::vector<std::string>&)>& restore)
+{
+	bool child = false;
+	m_restore = restore;
+	uint32_t failed = Execute(child);
+	if(child)
+	{
+		m_restore = nullptr;
+		return;
+	}
+
+	// The parent holds the snapshot only: it must not go on with the simulation
+	std::cout.flush();
+	std::cerr.flush();
+	_exit(failed == 0 ? 0 : 1);
+}
+
+void
+SweepHelper::RunFromSnapshot(Ptr<TraceSink> sink, const std::string& traceDir, CommandLine& cmd,
+							 uint32_t& expID, const std::function<void()>& restore)
+{
+	sink->Detach();
+	if(DynamicCast<FileTraceSink>(sink) != 0)
+		SetTraceDir(traceDir);
+	RunFromSnapshot([&](const std::vector<std::string>& args)
+	{
+		cmd.AddValue("ExpID", "", expID);
+		Parse(cmd, args);
+
+		sink->SetExpID(expID);
+		Ptr<FileTraceSink> filesink = DynamicCast<FileTraceSink>(sink);
+		if(filesink != 0)
+			filesink->Relocate(traceDir + "/exp" + boost::lexical_cast<std::string>(expID));
+		restore();
+	});
+}
+
+int
+SweepHelper::RunFromCommandLine(int argc, char* argv[], const std::string& grid,
+								uint32_t firstExpID, uint32_t jobs, const std::string& outdir,
+								const std::string& traceDir)
+{
+	SweepHelper sweep(argv[0]);
+	if(!sweep.AddGrid(grid))
+		return 1;
+
+	// Every run gets its own ExpID and RngRun from the sweep
+	const std::vector<std::string> drop = {"Sweep", "Jobs", "SweepDir", "ExpID", "RngRun"};
+	std::vector<std::string> args = FilterArguments(argc, argv, drop);
+	for(auto iter = args.begin(); iter != args.end(); iter++)
+		sweep.AddFixedArgument(*iter);
+
+	sweep.SetFirstExpID(firstExpID);
+	sweep.SetJobs(jobs);
+	sweep.SetOutputDir(outdir);
+	sweep.SetTraceDir(traceDir);
+	return (sweep.Run() == 0) ? 0 : 1;
+}
+
+void
+SweepHelper::Parse(CommandLine& cmd, const std::vector<std::string>& args)
+{
+	std::vector<char*> argv;
+	std::string program("snapshot");
+	argv.push_back(const_cast<char*>(program.c_str()));
+	for(uint32_t i = 0; i < args.size(); i++)
+		argv.push_back(const_cast<char*>(args[i].c_str()));
+	argv.push_back(0);
+	cmd.Parse(argv.size() - 1, argv.data());
+}
+
+uint32_t
+SweepHelper::Execute(bool& child)
+{
+	uint32_t total = GetNumRuns();
+	uint32_t jobs = m_jobs;
+	if(jobs == 0)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		jobs = (online > 0) ? static_cast<uint32_t>(online) : 1;
+	}
+
+	if(mkdir(m_outdir.c_str(), 0755) != 0 && errno != EEXIST)
+		NS_FATAL_ERROR("Cannot create sweep output directory " << m_outdir << ": " << std::strerror(errno));
+
+	std::cout << "[Sweep] " << total << " runs, " << jobs << " in parallel, output in " << m_outdir << std::endl;
+
+	std::vector<int> status(total, -1);
+	std::map<pid_t, uint32_t> running;
+	uint32_t next = 0;
+	uint32_t failed = 0;
+
+	while(next < total || !running.empty())
+	{
+		while(next < total && running.size() < jobs)
+		{
+			int pid = Launch(next);
+			if(pid == 0)
+			{
+				child = true;
+				return 0;
+			}
+			if(pid < 0)
+			{
+				NS_LOG_ERROR("fork() failed for ExpID " << m_firstExpID + next << ": " << std::strerror(errno));
+				failed++;
+			}
+			else
+				running[pid] = next;
+			next++;
+		}
+
+		int wstatus = 0;
+		pid_t done = waitpid(-1, &wstatus, 0);
+		if(done < 0)
+		{
+			if(errno == EINTR)
+				continue;
+			break;
+		}
+		auto iter = running.find(done);
+		if(iter == running.end())
+			continue;
+
+		uint32_t run = iter->second;
+		running.erase(iter);
+		status[run] = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : 128 + WTERMSIG(wstatus);
+		if(status[run] != 0)
+			failed++;
+		std::cout << "[Sweep] ExpID " << m_firstExpID + run << " finished with status " << status[run] << std::endl;
+	}
+
+	WriteIndex(status);
+	MergeTraces(status);
+	return failed;
+}
+
+void
+SweepHelper::WriteIndex(const std::vector<int>& status) const
+{
+	std::ofstream index((m_outdir + "/sweep.csv").c_str());
+	index << "ExpID";
+	for(uint32_t i = 0; i < m_grid.size(); i++)
+		index << "," << m_grid[i].m_name;
+	index << ",Status,Log\n";
+
+	for(uint32_t run = 0; run < status.size(); run++)
+	{
+		std::vector<uint32_t> point = GetPoint(run);
+		index << m_firstExpID + run;
+		for(uint32_t i = 0; i < m_grid.size(); i++)
+			index << "," << m_grid[i].m_values[point[i]];
+		index << "," << status[run] << ",exp" << m_firstExpID + run << ".log\n";
+	}
+}
+
+void
+SweepHelper::MergeTraces(const std::vector<int>& status) const
+{
+	if(m_tracedir.empty())
+		return;
+
+	std::vector<std::pair<uint32_t, std::string> > runs;
+	for(uint32_t run = 0; run < status.size(); run++)
+	{
+		if(status[run] == 0)
+			runs.push_back(std::make_pair(m_firstExpID + run,
+										  m_tracedir + "/exp" + boost::lexical_cast<std::string>(m_firstExpID + run)));
+	}
+	uint32_t tables = FileTraceSink::Merge(runs, m_outdir + "/traces");
+	if(tables != 0)
+		std::cout << "[Sweep] " << tables << " tables of " << runs.size() << " runs merged into "
+				  << m_outdir << "/traces" << std::endl;
+}
+
+std::vector<std::string>
+SweepHelper::FilterArguments(int argc, char* argv[], const std::vector<std::string>& drop)
+{
+	std::vector<std::string> args;
+	for(int i = 1; i < argc; i++)
+	{
+		std::string arg(argv[i]);
+		bool keep = true;
+		for(uint32_t j = 0; j < drop.size(); j++)
+		{
+			std::string opt = "--" + drop[j];
+			if(arg == opt || arg.compare(0, opt.size() + 1, opt + "=") == 0)
+			{
+				keep = false;
+				break;
+			}
+		}
+		if(keep)
+			args.push_back(arg);
+	}
+	return args;
+}
+
+}
+}
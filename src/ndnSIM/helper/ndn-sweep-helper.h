@@ -0,0 +1,200 @@
+/*
+ * Parameter sweep driver for the video caching scenarios
+ * (scratch/DASBenchmark, GlobalPartition, HeuristicPartition)
+ *
+ * ns-3 keeps one global simulator per process, so every grid point is run by
+ * re-executing the scenario binary in its own process. At most 'Jobs' runs are
+ * alive at the same time.
+ *
+ * Grid points that only differ after the warm-up can instead be forked from one
+ * warmed-up simulation (RunFromSnapshot): every child process starts with a copy of
+ * the whole simulation state, pending events included, at the time of the snapshot.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_SWEEP_HELPER_H
+#define NDN_SWEEP_HELPER_H
+
+#include "ns3/ptr.h"
+
+#include <vector>
+#include <string>
+#include <functional>
+
+namespace ns3{
+
+class CommandLine;
+
+namespace ndn{
+
+class TraceSink;
+
+class SweepHelper
+{
+public:
+	/*
+	 * program: argv[0] of every run, normally argv[0] of the scenario. The runs execute
+	 * the binary of the current process (/proc/self/exe), or 'program' looked up in
+	 * PATH where there is no /proc.
+	 */
+	SweepHelper(const std::string& program);
+	~SweepHelper();
+
+	/*
+	 * Add one dimension of the grid. 'name' is the CommandLine option of the scenario
+	 * (without "--"), e.g. AddParameter("Zipf_alpha", {"0.6", "0.8"})
+	 */
+	void AddParameter(const std::string& name, const std::vector<std::string>& values);
+
+	/*
+	 * Parse a grid of the form "Zipf_alpha=0.6,0.8;CachePercentage=0.05,0.1"
+	 * Return false if the specification is malformed
+	 */
+	bool AddGrid(const std::string& spec);
+
+	/*
+	 * Argument forwarded untouched to every run, e.g. "--TopologyChoice=2"
+	 */
+	void AddFixedArgument(const std::string& arg);
+
+	inline void SetJobs(uint32_t jobs)
+	{
+		m_jobs = jobs;
+	}
+
+	inline void SetFirstExpID(uint32_t id)
+	{
+		m_firstExpID = id;
+	}
+
+	inline void SetOutputDir(const std::string& dir)
+	{
+		m_outdir = dir;
+	}
+
+	/*
+	 * Directory of the FileTraceSink traces of the runs, <dir>/exp<ExpID>. When set, the
+	 * traces of the runs that succeeded are merged into <OutputDir>/traces after the sweep
+	 * (see FileTraceSink::Merge), every row tagged with the ExpID of its run.
+	 */
+	inline void SetTraceDir(const std::string& dir)
+	{
+		m_tracedir = dir;
+	}
+
+	uint32_t GetNumRuns() const;
+
+	/*
+	 * Return false, with a message, if the grid varies an option out of 'allowed'
+	 */
+	bool CheckParameters(const std::vector<std::string>& allowed) const;
+
+	/*
+	 * Full argument list of one run: fixed arguments, then the grid point, then
+	 * --ExpID and --RngRun. Run number 'run' gets ExpID = first ExpID + run and the
+	 * same value as ns-3 RngRun, so every run draws from its own random stream, unless
+	 * RngRun is a dimension of the grid. Runs forked from a snapshot get no --RngRun:
+	 * they share the random streams.
+	 */
+	std::vector<std::string> GetArguments(uint32_t run) const;
+
+	/*
+	 * Execute all runs. Output (stdout and stderr) of each run goes to
+	 * <OutputDir>/exp<ExpID>.log and an index of all runs, tagged by ExpID,
+	 * is written to <OutputDir>/sweep.csv. The traces are merged (see SetTraceDir).
+	 *
+	 * Return the number of runs that did not exit with status 0
+	 */
+	uint32_t Run();
+
+	/*
+	 * Fork one process per run from the current state of the simulation, e.g. from an
+	 * event scheduled at the end of the warm-up. In every child, whose output goes to
+	 * <OutputDir>/exp<ExpID>.log, 'restore' gets the arguments of the run (grid point
+	 * and --ExpID) and the function returns: the child goes on with the simulation.
+	 * The parent waits for all runs, writes <OutputDir>/sweep.csv and exits with
+	 * status 0 if all of them succeeded, 1 otherwise.
+	 *
+	 * Threads do not survive fork(): trace sinks must be detached before
+	 * (TraceSink::Detach), and no other thread may be running.
+	 */
+	void RunFromSnapshot(const std::function<void(const std::vector<std::string>&)>& restore);
+
+	/*
+	 * RunFromSnapshot for a scenario writing its traces to 'sink', which is detached
+	 * before the fork. In every child, 'cmd' parses the arguments of the run, with an
+	 * ExpID option bound to 'expID'; the sink then writes with the new ExpID, a
+	 * FileTraceSink into <traceDir>/exp<ExpID> (merged after the sweep, see SetTraceDir),
+	 * and 'restore' applies the other options.
+	 * 'cmd' holds the options the grid may vary (see CheckParameters).
+	 */
+	void RunFromSnapshot(Ptr<TraceSink> sink, const std::string& traceDir, CommandLine& cmd,
+						 uint32_t& expID, const std::function<void()>& restore);
+
+	/*
+	 * Run the grid 'grid' of a scenario started with argc/argv (see AddGrid), as for its
+	 * --Sweep option. Every run gets the options of argv, except Sweep, Jobs and SweepDir,
+	 * and its own ExpID (from firstExpID) and RngRun (see GetArguments). The traces the
+	 * runs write to 'traceDir' (if not empty) are merged into <outdir>/traces.
+	 *
+	 * Return 0 if all runs succeeded, 1 otherwise or if the grid is malformed
+	 */
+	static int RunFromCommandLine(int argc, char* argv[], const std::string& grid,
+								  uint32_t firstExpID, uint32_t jobs, const std::string& outdir,
+								  const std::string& traceDir = "");
+
+	/*
+	 * Parse 'args' (options only, no program name) with 'cmd'
+	 */
+	static void Parse(CommandLine& cmd, const std::vector<std::string>& args);
+
+	/*
+	 * Copy argv[1..argc) except the options listed in 'drop' (given without "--")
+	 * Used by scenarios to forward their own command line to every run.
+	 */
+	static std::vector<std::string> FilterArguments(int argc, char* argv[],
+													const std::vector<std::string>& drop);
+
+private:
+	struct Parameter
+	{
+		std::string					m_name;
+		std::vector<std::string>	m_values;
+	};
+
+	/*
+	 * Index of the value of every parameter used in run 'run' (mixed radix, last parameter varies fastest)
+	 */
+	std::vector<uint32_t> GetPoint(uint32_t run) const;
+
+	/*
+	 * Start run 'run': returns the pid in the parent, 0 in a child forked from a snapshot
+	 */
+	int  Launch(uint32_t run) const;
+
+	/*
+	 * Keep at most m_jobs runs alive until all are done; return the number of failed
+	 * runs, or set 'child' in a child forked from a snapshot
+	 */
+	uint32_t Execute(bool& child);
+	void WriteIndex(const std::vector<int>& status) const;
+	void MergeTraces(const std::vector<int>& status) const;
+
+	std::string					m_program;
+	std::vector<Parameter>		m_grid;
+	std::vector<std::string>	m_fixed;
+
+	uint32_t		m_jobs;			// 0: one per online processor
+	uint32_t		m_firstExpID;
+	std::string		m_outdir;
+	std::string		m_tracedir;		// Empty: traces are not merged
+
+	std::function<void(const std::vector<std::string>&)>	m_restore;	// Set for runs forked from a snapshot
+};
+
+
+}
+}
+
+#endif
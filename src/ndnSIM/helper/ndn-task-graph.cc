@@ -0,0 +1,129 @@
+/*
+ * Runs a graph of dependent tasks on a work-stealing pool of threads
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-task-graph.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.TaskGraph");
+
+namespace ns3{
+namespace ndn{
+
+namespace {
+
+/* Ready tasks of one worker: it takes the newest, the others steal the oldest */
+struct WorkQueue
+{
+	std::mutex 				m_mutex;
+	std::deque<uint32_t> 	m_tasks;
+
+	void Push(uint32_t task)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks.push_back(task);
+	}
+
+	bool Pop(uint32_t& task)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(m_tasks.empty())
+			return false;
+		task = m_tasks.back();
+		m_tasks.pop_back();
+		return true;
+	}
+
+	bool Steal(uint32_t& task)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(m_tasks.empty())
+			return false;
+		task = m_tasks.front();
+		m_tasks.pop_front();
+		return true;
+	}
+};
+
+}
+
+uint32_t
+TaskGraph::AddTask(const std::function<void()>& task)
+{
+	m_tasks.push_back(Task {task, std::vector<uint32_t>(), 0});
+	return m_tasks.size() - 1;
+}
+
+void
+TaskGraph::AddDependency(uint32_t before, uint32_t after)
+{
+	NS_ASSERT(before < m_tasks.size() && after < m_tasks.size() && before != after);
+	m_tasks[before].m_next.push_back(after);
+	m_tasks[after].m_deps++;
+}
+
+void
+TaskGraph::Run(uint32_t threads)
+{
+	const uint32_t size = m_tasks.size();
+	if(threads == 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	threads = std::max(1u, std::min(threads, size));
+
+	std::unique_ptr<std::atomic<uint32_t>[]> pending(new std::atomic<uint32_t>[size]);
+	std::unique_ptr<WorkQueue[]> queues(new WorkQueue[threads]);
+	uint32_t ready = 0;
+	for(uint32_t t = 0; t < size; t++)
+	{
+		pending[t] = m_tasks[t].m_deps;
+		if(m_tasks[t].m_deps == 0)
+			queues[ready++ % threads].m_tasks.push_back(t);
+	}
+	NS_ASSERT_MSG(size == 0 || ready > 0, "Cyclic task graph");
+
+	std::atomic<uint32_t> left(size);
+	auto worker = [this, threads, &pending, &queues, &left] (uint32_t self)
+	{
+		while(left.load() > 0)
+		{
+			uint32_t task = 0;
+			bool found = queues[self].Pop(task);
+			for(uint32_t victim = 1; !found && victim < threads; victim++)
+				found = queues[(self + victim) % threads].Steal(task);
+			if(!found)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			m_tasks[task].m_run();
+			for(auto next = m_tasks[task].m_next.begin(); next != m_tasks[task].m_next.end(); next++)
+				if(pending[*next].fetch_sub(1) == 1)
+					queues[self].Push(*next);
+			left.fetch_sub(1);
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for(uint32_t i = 1; i < threads; i++)
+		pool.push_back(std::thread(worker, i));
+	worker(0);
+	for(uint32_t i = 0; i < pool.size(); i++)
+		pool[i].join();
+
+	NS_LOG_INFO(size << " tasks run on " << threads << " thread(s)");
+}
+
+}
+}
@@ -0,0 +1,59 @@
+/*
+ * Runs a graph of dependent tasks on a work-stealing pool of threads
+ *
+ * A task starts once all the tasks it depends on are done. Tasks write their results
+ * to places of their own, so the results do not depend on the number of threads or
+ * on the order independent tasks happen to run in.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_TASK_GRAPH_H
+#define NDN_TASK_GRAPH_H
+
+#include <functional>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3{
+namespace ndn{
+
+class TaskGraph
+{
+public:
+	/*
+	 * Return the ID of the task
+	 */
+	uint32_t
+	AddTask(const std::function<void()>& task);
+
+	/*
+	 * Task 'after' starts once task 'before' is done
+	 */
+	void
+	AddDependency(uint32_t before, uint32_t after);
+
+	/*
+	 * Run every task once; threads: 0 for one per processor, 1 runs them on the calling thread
+	 */
+	void
+	Run(uint32_t threads);
+
+	inline uint32_t
+	GetSize() const {return m_tasks.size();}
+
+private:
+	struct Task
+	{
+		std::function<void()> 	m_run;
+		std::vector<uint32_t> 	m_next;
+		uint32_t 				m_deps;
+	};
+
+	std::vector<Task> 	m_tasks;
+};
+
+}
+}
+
+#endif
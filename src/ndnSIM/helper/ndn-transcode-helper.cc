@@ -94,26 +94,27 @@ TranscodeHelper::FillByPopularity(Ptr<ContentStore> csptr, Ptr<VideoStatistics>
 
 		uint32_t index = 0;
 		Ptr<NDNBitRate> brinfo = csptr->GetObject<NDNBitRate>();
-		std::string highestbr = brinfo->GetBRFromRank(brinfo->GetTableSize());
+		uint32_t highestrank = brinfo->GetTableSize();
+		std::string highestbr = brinfo->GetBRFromRank(highestrank);
 
-		uint32_t chunksize = brinfo->GetChunkSize(poptable[index].first.m_bitrate.substr(2)) * 1e3;
+		uint32_t chunksize = brinfo->GetChunkSizeFromRank(poptable[index].first.m_rank) * 1e3;
 
 		while(normalsize >= chunksize)
 		{
 			// Create Name and Add to 'assigned'
 			Ptr<Name> popularname = Create<Name>(m_prefix);
-			popularname->append(poptable[index].first.m_bitrate);
+			popularname->append(poptable[index].first.GetBitRateComponent());
 			popularname->appendNumber(poptable[index].first.m_file);
 			popularname->appendNumber(poptable[index].first.m_chunk);
 			assigned.push_back(*popularname);
 
-			if(poptable[index].first.m_bitrate == "br" + highestbr)
+			if(poptable[index].first.m_rank == highestrank)
 				trackitem.insert(ContentIndex{poptable[index].first.m_file, poptable[index].first.m_chunk});
 
 			normalsize -= chunksize;
 			index++;
 
-			chunksize = brinfo->GetChunkSize(poptable[index].first.m_bitrate.substr(2)) * 1e3;
+			chunksize = brinfo->GetChunkSizeFromRank(poptable[index].first.m_rank) * 1e3;
 		}
 
 		chunksize = brinfo->GetChunkSize(highestbr) * 1e3;
@@ -18,7 +18,6 @@
 #include "ns3/ndn-content-store.h"
 #include "ns3/ndn-partition-helper.h"
 
-#include "gurobi_c++.h"
 #include <vector>
 
 namespace ns3{
@@ -35,6 +35,8 @@ public:
 
 	void Run();
 
+	inline void SetIterationLimit(uint32_t limit) {m_limit = limit;}
+
 private:
 	void PrintCache();
 
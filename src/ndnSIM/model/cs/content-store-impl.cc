@@ -24,6 +24,7 @@
 #include "../../utils/trie/lru-policy.h"
 #include "../../utils/trie/fifo-policy.h"
 #include "../../utils/trie/lfu-policy.h"
+#include "../../utils/trie/lfu-da-policy.h"
 #include "../../utils/trie/fixed-policy.h"
 #include "../../utils/trie/multi-policy.h"
 #include "../../utils/trie/aggregate-stats-policy.h"
@@ -65,6 +66,11 @@ template class ContentStoreImpl<fifo_policy_traits>;
  **/
 template class ContentStoreImpl<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with O(1) LFU cache replacement policy with dynamic aging
+ **/
+template class ContentStoreImpl<lfu_da_policy_traits>;
+
 /*
  * By Wenjie Li
  * Cache Configuration determined by ILP solver
@@ -75,6 +81,7 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_da_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fixed_policy_traits);
 
 
@@ -124,6 +131,11 @@ class Random : public ContentStoreImpl<random_policy_traits> { };
  * \brief Content Store implementing Least Frequently Used cache replacement policy
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> { };
+
+/**
+ * \brief Content Store implementing LFU cache replacement policy with dynamic aging, in O(1)
+ */
+class LfuDA : public ContentStoreImpl<lfu_da_policy_traits> { };
 #endif
 
 
@@ -115,8 +115,6 @@ public:
 
 	virtual inline bool
 	AddByMDP(Ptr<Name> name);
-
-	virtual uint32_t GetCurrentSize() const;
 	*/
 
 	virtual inline void
@@ -125,6 +123,9 @@ public:
 	virtual uint32_t
 	GetSize() const;
 
+	virtual uint32_t
+	GetCurrentSize() const;
+
 	virtual Ptr<Entry>
 	Begin();
 
@@ -246,8 +247,7 @@ Ptr<Data> ContentStoreImpl<Policy>::Lookup(Ptr<const Interest> interest) {
 		//NS_LOG_DEBUG("Cache Hit at: "<<this->GetNodeID()<<" Seq: "<<interest->GetName());
 		this->m_cacheHitsTrace(interest, node->payload()->GetData());
 
-		Ptr<Data> copy = Create<Data>(*node->payload()->GetData());
-		ConstCast<Packet>(copy->GetPayload())->RemoveAllPacketTags();
+		Ptr<Data> copy = node->payload()->GetHitData();
 
 		// Record the local reward only for performance evaluation
 		CalReward(ConstCast<Interest>(interest), true);
@@ -277,8 +277,7 @@ Ptr<Data> ContentStoreImpl<Policy>::Lookup(Ptr<const Interest> interest, double&
 		//NS_LOG_DEBUG("Cache Hit at: "<<this->GetNodeID()<<" Seq: "<<interest->GetName());
 		this->m_cacheHitsTrace(interest, node->payload()->GetData());
 
-		Ptr<Data> copy = Create<Data>(*node->payload()->GetData());
-		ConstCast<Packet>(copy->GetPayload())->RemoveAllPacketTags();
+		Ptr<Data> copy = node->payload()->GetHitData();
 
 		// Record the local reward only for performance evaluation
 		r = CalReward(ConstCast<Interest>(interest), true);
@@ -350,17 +349,19 @@ void ContentStoreImpl<Policy>::ReportPartitionStatus()
 		std::shared_ptr<double> sp(new double [numBitRate],
 					std::default_delete<double[]>());
 		FillinCacheRun();
-		std::string br;
 		double sum = 0;
 		for(uint32_t i = 0; i < numBitRate; i++)
 			sp.get()[i] = 0;
 
 		for(auto iter = inCacheRun.begin(); iter != inCacheRun.end(); iter++)
 		{
-			br = ExtractBitrate(*iter);
-			uint32_t idx = m_BRinfo->GetRankFromBR(br);
-			sp.get()[idx - 1] += m_BRinfo->GetChunkSize(br);
-			sum += m_BRinfo->GetChunkSize(br);
+			uint32_t idx = ExtractBitrateRank(*iter);
+			// Rank 0: not a video chunk, or a bitrate this node does not know
+			if(idx == 0 || idx > numBitRate)
+				continue;
+			double chunksize = m_BRinfo->GetChunkSizeFromRank(idx);
+			sp.get()[idx - 1] += chunksize;
+			sum += chunksize;
 		}
 
 		for(uint32_t i = 0; i < numBitRate; i++)
@@ -375,11 +376,6 @@ void ContentStoreImpl<Policy>::ReportPartitionStatus()
 
 //Added to implement DFA Transition (Deserted)
 /*
-template<class Policy>
-uint32_t ContentStoreImpl<Policy>::GetCurrentSize() const{
-	return this->getPolicy().get_current_size();
-}
-
 template<class Policy>
 bool ContentStoreImpl<Policy>::AddByMDP(Ptr<Name> name)
 {
@@ -437,6 +433,11 @@ uint32_t ContentStoreImpl<Policy>::GetSize() const {
 	return this->getPolicy().size();
 }
 
+template<class Policy>
+uint32_t ContentStoreImpl<Policy>::GetCurrentSize() const {
+	return this->getPolicy().get_current_size();
+}
+
 template<class Policy>
 Ptr<Entry> ContentStoreImpl<Policy>::Begin() {
 	typename super::parent_trie::recursive_iterator item(super::getTrie()), end(
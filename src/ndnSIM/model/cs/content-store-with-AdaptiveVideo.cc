@@ -2,6 +2,7 @@
 #include "../../utils/trie/fixed-policy.h"
 #include "../../utils/trie/lru-policy.h"
 #include "../../utils/trie/lfu-policy.h"
+#include "../../utils/trie/lfu-da-policy.h"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
   static struct X ## type ## templ ## RegistrationClass \
@@ -31,9 +32,12 @@ template class ContentStoreStreaming<lru_policy_traits>;
 
 template class ContentStoreStreaming<lfu_policy_traits>;
 
+template class ContentStoreStreaming<lfu_da_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreStreaming, fixed_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreStreaming, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreStreaming, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreStreaming, lfu_da_policy_traits);
 /*
 typedef multi_policy_traits< boost::mpl::vector2< fixed_policy_traits,
                                                   aggregate_stats_policy_traits > > FixedWithCountsTraits;
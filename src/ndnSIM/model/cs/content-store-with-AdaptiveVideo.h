@@ -100,7 +100,7 @@ void ContentStoreStreaming<Policy>::InstallCacheEntity()
 	Ptr<NDNBitRate> ndnbr = thisnode->GetObject<NDNBitRate> ();
 	for(; iter != (this->inCacheConfig).end(); iter++)
 	{
-		double vsegsize = ndnbr->GetChunkSize(this->ExtractBitrate(*iter));
+		double vsegsize = ndnbr->GetChunkSizeFromRank(this->ExtractBitrateRank(*iter));
 		Ptr<Data> dataPacket =
 				Create< Data >(Create<Packet>(vsegsize * 1e3));
 		dataPacket->SetName(Create<Name>(*iter));
@@ -156,7 +156,7 @@ bool ContentStoreStreaming<Policy>::Add(Ptr<const Data> data) {
 	if (Policy::GetName() == "DASCache") {
 		return true;
 	}
-	else if (Policy::GetName() == "Lru" || Policy::GetName() == "Lfu"){
+	else if (Policy::GetName() == "Lru" || Policy::GetName() == "Lfu" || Policy::GetName() == "LfuDA"){
 		bool go_on = true;
 		if(m_useProbCache)
 		{
@@ -2,6 +2,7 @@
 #include "content-store-with-multisection.h"
 
 #include "../../utils/trie/userdefined-policy.h"
+#include "../../utils/trie/lfu-da-policy.h"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
   static struct X ## type ## templ ## RegistrationClass \
@@ -21,8 +22,11 @@ namespace cs {
 
 template class ContentStoreMulSec<user_defined_policy_traits>;
 
+template class ContentStoreMulSec<lfu_da_policy_traits>;
+
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreMulSec, user_defined_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreMulSec, lfu_da_policy_traits);
 
 
 
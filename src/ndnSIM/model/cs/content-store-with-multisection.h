@@ -86,8 +86,14 @@ public:
 	virtual inline uint32_t
 	GetSize() const
 	{
-		return 0;
-	};//legacy code. For compatibility.
+		return super::size();
+	}
+
+	virtual inline uint32_t
+	GetCurrentSize() const
+	{
+		return super::get_current_size();
+	}
 
 	virtual uint32_t GetCapacity(); // size limit
 
@@ -132,7 +138,7 @@ protected:
 	GetMaxSize() const;
 
 	void
-	AdjustMaintanenceList(const std::string& BR, uint32_t newsize);
+	AdjustMaintanenceList(uint32_t rank, uint32_t newsize);
 
 protected:
 	/// @brief trace of for entry additions (fired every time entry is successfully added to the cache): first parameter is pointer to the CS entry
@@ -149,7 +155,7 @@ private:
 	 */
 	uint32_t 			m_totalsize; 		// Total size of cache regardless of bitrates (in bytes)
 	uint32_t 			m_numBitrates;		// Number of bitrates considered in the caching system
-	std::map<std::string, double> m_BRper; 		// The section percentage for different bitrates
+	std::vector<double> m_BRper; 		// The section percentage for different bitrates, indexed by rank
 
 };
 
@@ -186,7 +192,11 @@ TypeId ContentStoreMulSec<Policy>::GetTypeId() {
 template <typename Policy>
 double ContentStoreMulSec<Policy>::GetSectionRatio(const std::string& BR)
 {
-	return m_BRper.at(BR);
+	// Rank 0: the bitrate was never interned, it has no section
+	uint32_t rank = NDNBitRate::LookupRank(BR);
+	if(rank == 0 || rank >= m_BRper.size())
+		return 0;
+	return m_BRper[rank];
 }
 template<class Policy>
 double ContentStoreMulSec<Policy>::GetReward()
@@ -198,14 +208,16 @@ double ContentStoreMulSec<Policy>::GetReward()
 template<class Policy>
 void ContentStoreMulSec<Policy>::AdjustSectionRatio(const std::string& inc, const std::string& dec, double granularity)
 {
-	m_BRper[inc] += granularity;
-	m_BRper[dec] -= granularity;
+	uint32_t incrank = NDNBitRate::LookupRank(inc);
+	uint32_t decrank = NDNBitRate::LookupRank(dec);
+	m_BRper.at(incrank) += granularity;
+	m_BRper.at(decrank) -= granularity;
 
-	uint32_t s = static_cast<uint32_t>(m_BRper[inc] * m_totalsize);
-	AdjustMaintanenceList(inc, s);
+	uint32_t s = static_cast<uint32_t>(m_BRper[incrank] * m_totalsize);
+	AdjustMaintanenceList(incrank, s);
 
-	s = static_cast<uint32_t>(m_BRper[dec] * m_totalsize);
-	AdjustMaintanenceList(dec, s);
+	s = static_cast<uint32_t>(m_BRper[decrank] * m_totalsize);
+	AdjustMaintanenceList(decrank, s);
 }
 
 
@@ -216,8 +228,11 @@ bool ContentStoreMulSec<Policy>::SetSectionRatio(const std::string BR[], double
 		return false;
 	for(uint32_t i = 0; i < num; i++)
 	{
-		m_BRper[BR[i]] = ratio[i];
-		AdjustMaintanenceList(BR[i], static_cast<uint32_t>(ratio[i] * m_totalsize));
+		uint32_t rank = NDNBitRate::LookupRank(BR[i]);
+		if(rank >= m_BRper.size())
+			m_BRper.resize(rank + 1, 0);
+		m_BRper[rank] = ratio[i];
+		AdjustMaintanenceList(rank, static_cast<uint32_t>(ratio[i] * m_totalsize));
 	}
 	return true;
 }
@@ -227,10 +242,12 @@ bool ContentStoreMulSec<Policy>::SetSectionRatio(double ratio[], size_t num)
 {
 	if(num != m_numBitrates)
 		return false;
+	if(num >= m_BRper.size())
+		m_BRper.resize(num + 1, 0);
 	for(uint32_t i = 0; i < num; i++)
 	{
-		m_BRper[m_BRinfo->GetBRFromRank(i + 1)] = ratio[i];
-		AdjustMaintanenceList(m_BRinfo->GetBRFromRank(i + 1), static_cast<uint32_t>(ratio[i] * m_totalsize));
+		m_BRper[i + 1] = ratio[i];
+		AdjustMaintanenceList(i + 1, static_cast<uint32_t>(ratio[i] * m_totalsize));
 	}
 	return true;
 }
@@ -241,7 +258,10 @@ void ContentStoreMulSec<Policy>::InitContentStore(const std::string BR[], size_t
 {
 	this->m_reward = 0;
 
-	this->initMaintenanceLists(BR, numBitrates);
+	std::vector<uint32_t> ranks(numBitrates);
+	for (uint32_t i = 0; i < numBitrates; i++)
+		ranks[i] = NDNBitRate::InternBitRate(BR[i]);
+	this->initMaintenanceLists(ranks.data(), numBitrates);
 	m_numBitrates = numBitrates;
 	double *initratio = new double [numBitrates];
 	for (uint32_t i = 0; i < numBitrates; i++)
@@ -265,9 +285,9 @@ void ContentStoreMulSec<Policy>::RatioTest()
 	  {
 		  for(uint32_t i = 1; i <= m_BRinfo->GetTableSize(); i++)
 		  {
-			  typename super::policy_container::const_iterator item = this->getPolicy(m_BRinfo->GetBRFromRank(i)).begin();
+			  typename super::policy_container::const_iterator item = this->getPolicy(i).begin();
 			  NS_LOG_INFO("Node: " << m_node->GetId() << "\tBitrate: " << m_BRinfo->GetBRFromRank(i));
-			  for (; item != this->getPolicy(m_BRinfo->GetBRFromRank(i)).end();
+			  for (; item != this->getPolicy(i).end();
 					item++) {
 				  NS_LOG_INFO(item->payload()->GetName());
 			  }
@@ -285,17 +305,19 @@ void ContentStoreMulSec<Policy>::ReportPartitionStatus()
 			std::shared_ptr<double> sp(new double [numBitRate],
 						std::default_delete<double[]>());
 			FillinCacheRun();
-			std::string br;
 			double sum = 0;
 			for(uint32_t i = 0; i < numBitRate; i++)
 				sp.get()[i] = 0;
 
 			for(auto iter = inCacheRun.begin(); iter != inCacheRun.end(); iter++)
 			{
-				br = ExtractBitrate(*iter);
-				uint32_t idx = m_BRinfo->GetRankFromBR(br);
-				sp.get()[idx - 1] += m_BRinfo->GetChunkSize(br);
-				sum += m_BRinfo->GetChunkSize(br);
+				uint32_t idx = ExtractBitrateRank(*iter);
+				// Rank 0: not a video chunk, or a bitrate this node does not know
+				if(idx == 0 || idx > numBitRate)
+					continue;
+				double chunksize = m_BRinfo->GetChunkSizeFromRank(idx);
+				sp.get()[idx - 1] += chunksize;
+				sum += chunksize;
 			}
 
 			for(uint32_t i = 0; i < numBitRate; i++)
@@ -313,9 +335,9 @@ void ContentStoreMulSec<Policy>::ClearCachePartition()
 }
 
 template<class Policy>
-void ContentStoreMulSec<Policy>::AdjustMaintanenceList(const std::string& BR, uint32_t newsize)
+void ContentStoreMulSec<Policy>::AdjustMaintanenceList(uint32_t rank, uint32_t newsize)
 {
-	this->getPolicy(BR).set_max_size(newsize);
+	this->getPolicy(rank).set_max_size(newsize);
 }
 
 template<class Policy>
@@ -331,25 +353,24 @@ Ptr<Data> ContentStoreMulSec<Policy>::Lookup(Ptr<const Interest> interest, doubl
 	NS_LOG_FUNCTION(this << interest->GetName ());
 
 	typename super::const_iterator node;
-	std::string BR = this->ExtractBitrate(interest->GetName());
+	uint32_t rank = interest->GetBitRateRank();
 
 	if (interest->GetExclude() == 0) {
-		node = this->deepest_prefix_match(interest->GetName(), BR);
+		node = this->deepest_prefix_match(interest->GetName(), rank);
 	} else {
 		node = this->deepest_prefix_match_if_next_level(interest->GetName(),
-				isNotExcluded(*interest->GetExclude()), BR);
+				isNotExcluded(*interest->GetExclude()), rank);
 	}
 
 	if (node != this->end()) {
 		NS_LOG_INFO("Cache Hit at: "<<m_node->GetId()<<" Name: "<<interest->GetName().toUri());
 		this->m_cacheHitsTrace(interest, node->payload()->GetData());
 
-		Ptr<Data> copy = Create<Data>(*node->payload()->GetData());
-		ConstCast<Packet>(copy->GetPayload())->RemoveAllPacketTags();
+		Ptr<Data> copy = node->payload()->GetHitData();
 		r = CalReward(ConstCast<Interest>(interest), true);
 
 		NS_LOG_DEBUG("[CS]: Cache Hit at Node" << m_node->GetId()
-				<< " For BR:" << ExtractBitrate(interest->GetName()) << " REWARD: " << static_cast<int>(r));
+				<< " For BR:" << NDNBitRate::GetInternedBitRate(rank) << " REWARD: " << static_cast<int>(r));
 
 		return copy;
 	} else {
@@ -358,7 +379,7 @@ Ptr<Data> ContentStoreMulSec<Policy>::Lookup(Ptr<const Interest> interest, doubl
 		r = CalReward(ConstCast<Interest>(interest), false);
 
 		NS_LOG_DEBUG("[CS]: Cache Miss at Node" << m_node->GetId()
-				<< " For BR:" << ExtractBitrate(interest->GetName()) << " REWARD: " << static_cast<int>(r));
+				<< " For BR:" << NDNBitRate::GetInternedBitRate(rank) << " REWARD: " << static_cast<int>(r));
 
 		return 0;
 	}
@@ -376,7 +397,8 @@ uint32_t ContentStoreMulSec<Policy>::GetCapacity()
 template<class Policy>
 uint32_t ContentStoreMulSec<Policy>::GetCapacity(const string& s)
 {
-	return this->getPolicy(s).get_max_size();
+	typename super::policy_container* policy = this->findPolicy(NDNBitRate::LookupRank(s));
+	return policy != 0 ? policy->get_max_size() : 0;
 }
 
 template<class Policy>
@@ -387,12 +409,12 @@ ContentStoreMulSec<Policy>::Add (Ptr<const Data> data)
   NS_LOG_FUNCTION (this << data->GetName ());
 
   Ptr<entry> newEntry = Create<entry>(this, data);
-  std::string BR = this->ExtractBitrate(data->GetName());
+  uint32_t rank = data->GetBitRateRank();
 
   //if(Simulator::Now() <= m_period)
   //{
 	  std::pair<typename super::iterator, bool> result = super::insert(
-				data->GetName(), newEntry, BR, data->GetPayload()->GetSize());
+				data->GetName(), newEntry, rank, data->GetPayload()->GetSize());
 
 ////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////
@@ -403,9 +425,9 @@ ContentStoreMulSec<Policy>::Add (Ptr<const Data> data)
 		  {
 			for(uint32_t i = 1; i <= m_BRinfo->GetTableSize(); i++)
 			{
-				  typename super::policy_container::const_iterator item = this->getPolicy(m_BRinfo->GetBRFromRank(i)).begin();
+				  typename super::policy_container::const_iterator item = this->getPolicy(i).begin();
 				  NS_LOG_INFO("Node: " << m_node->GetId() << "\tBitrate: " << m_BRinfo->GetBRFromRank(i));
-				  for (; item != this->getPolicy(m_BRinfo->GetBRFromRank(i)).end();
+				  for (; item != this->getPolicy(i).end();
 						item++) {
 					  NS_LOG_INFO(item->payload()->GetName());
 				  }
@@ -429,7 +451,7 @@ ContentStoreMulSec<Policy>::Add (Ptr<const Data> data)
 	NS_LOG_FUNCTION(this << data->GetName ());
 
 	  Ptr<entry> newEntry = Create<entry>(this, data);
-	  std::string BR = this->ExtractBitrate(data->GetName());
+	  uint32_t rank = data->GetBitRateRank();
 
 	//if (Simulator::Now() <= this->m_period)
 	//{
@@ -445,7 +467,7 @@ ContentStoreMulSec<Policy>::Add (Ptr<const Data> data)
 		if(go_on)
 		{
 			  std::pair<typename super::iterator, bool> result = super::insert(
-						data->GetName(), newEntry, BR, data->GetPayload()->GetSize());
+						data->GetName(), newEntry, rank, data->GetPayload()->GetSize());
 			  if (result.first != super::end()) {
 				if (result.second) {
 					newEntry->SetTrie(result.first);
@@ -470,10 +492,10 @@ template<class Policy>
 void ContentStoreMulSec<Policy>::Print(std::ostream &os) const {
 	for(uint32_t i = 1; i <= m_BRinfo->GetTableSize(); i++)
 	{
-		typename super::policy_container::const_iterator item = this->getPolicy(m_BRinfo->GetBRFromRank(i)).begin();
+		typename super::policy_container::const_iterator item = this->getPolicy(i).begin();
 		os << "Node: " << m_node->GetId() << "\tBitrate: " << m_BRinfo->GetBRFromRank(i) <<
-				"\tSize:" << this->getPolicy(m_BRinfo->GetBRFromRank(i)).get_max_size () << std::endl;
-		for (; item != this->getPolicy(m_BRinfo->GetBRFromRank(i)).end();
+				"\tSize:" << this->getPolicy(i).get_max_size () << std::endl;
+		for (; item != this->getPolicy(i).end();
 				item++) {
 			os << item->payload()->GetName() << std::endl;
 		}
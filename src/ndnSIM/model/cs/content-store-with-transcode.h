@@ -113,7 +113,7 @@ void ContentStoreTranscoding<Policy>::InstallCacheEntity()
 	Ptr<NDNBitRate> ndnbr = thisnode->GetObject<NDNBitRate> ();
 	for(; iter != (this->inCacheConfig).end(); iter++)
 	{
-		double vsegsize = ndnbr->GetChunkSize(this->ExtractBitrate(*iter));
+		double vsegsize = ndnbr->GetChunkSizeFromRank(this->ExtractBitrateRank(*iter));
 		Ptr<Data> dataPacket =
 				Create< Data >(Create<Packet>(vsegsize * 1e3));
 		dataPacket->SetName(Create<Name>(*iter));
@@ -205,7 +205,7 @@ Ptr<Data> ContentStoreTranscoding<Policy>::LookForTranscoding (Ptr<Interest> int
 			if(iter != m_transcode_cost.end())
 				delay = (m_weight * iter->second.second) / iter->second.first;
 
-			Ptr<Data> copy = Create<Data>(Create<Packet>(ndnbr->GetChunkSize(this->ExtractBitrate(interest->GetName())) *1e3));
+			Ptr<Data> copy = Create<Data>(Create<Packet>(ndnbr->GetChunkSizeFromRank(interest->GetBitRateRank()) *1e3));
 			copy->SetName(interest->GetName());
 
 			return copy;
@@ -116,6 +116,13 @@ struct freshness_policy_traits
         return true;
       }
 
+      inline bool
+      insert (typename parent_trie::iterator item, uint32_t s)
+      {
+        // sizes are accounted by the policy which enforces the budget
+        return insert (item);
+      }
+
       inline void
       lookup (typename parent_trie::iterator item)
       {
@@ -150,6 +157,12 @@ struct freshness_policy_traits
         return max_size_;
       }
 
+      inline size_t
+      get_current_size () const
+      {
+        return 0;
+      }
+
     private:
       type () : base_(*((Base*)0)) { };
 
@@ -97,6 +97,13 @@ struct lifetime_stats_policy_traits
         return true;
       }
   
+      inline bool
+      insert (typename parent_trie::iterator item, uint32_t s)
+      {
+        // sizes are accounted by the policy which enforces the budget
+        return insert (item);
+      }
+
       inline void
       lookup (typename parent_trie::iterator item)
       {
@@ -134,6 +141,12 @@ struct lifetime_stats_policy_traits
         return max_size_;
       }
 
+      inline size_t
+      get_current_size () const
+      {
+        return 0;
+      }
+
       void
       set_traced_callback (TracedCallback< typename parent_trie::payload_traits::const_base_type, Time > *callback)
       {
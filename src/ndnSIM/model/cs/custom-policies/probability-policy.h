@@ -89,6 +89,13 @@ struct probability_policy_traits
           }
       }
 
+      inline bool
+      insert (typename parent_trie::iterator item, uint32_t s)
+      {
+        // sizes are accounted by the policy which enforces the budget
+        return insert (item);
+      }
+
       inline void
       lookup (typename parent_trie::iterator item)
       {
@@ -119,6 +126,12 @@ struct probability_policy_traits
         return max_size_;
       }
 
+      inline size_t
+      get_current_size () const
+      {
+        return 0;
+      }
+
       inline void
       set_probability (double probability)
       {
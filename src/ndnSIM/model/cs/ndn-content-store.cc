@@ -147,18 +147,14 @@ ContentStore::GetSectionRatio(const std::string& BR)
 	return 0;
 }
 
-std::string ContentStore::ExtractBitrate(const Name& n)
+const std::string& ContentStore::ExtractBitrate(const Name& n)
 {
-	std::string name = n.toUri();
-	std::size_t found = name.find("br");
-	std::string r = name;
-	if (found != std::string::npos)
-	{
-		std::size_t format = name.find("/",found + 2);
-		if(format != std::string::npos)
-			r = name.substr(found + 2, format - found - 2);
-	}
-	return r;
+	return NDNBitRate::GetInternedBitRate(ExtractBitrateRank(n));
+}
+
+uint32_t ContentStore::ExtractBitrateRank(const Name& n)
+{
+	return NDNBitRate::ExtractRank(n);
 }
 
 Ptr<Data>
@@ -182,7 +178,7 @@ ContentStore::CalReward(Ptr<Interest> interest, bool cachehit)
 	bd = bd >> 4;
 	interest->SetBRBoundary(bd);
 
-	uint32_t actualBR = m_BRinfo->GetRankFromBR(ExtractBitrate(interest->GetName()));
+	uint32_t actualBR = interest->GetBitRateRank();
 	//double p = 1 / static_cast<double>(actualBR);
 	//if(interest->GetWindow() == 1)
 		//p = 0;
@@ -192,7 +188,7 @@ ContentStore::CalReward(Ptr<Interest> interest, bool cachehit)
 	if((Simulator::Now().Compare(m_period) >= 0 && m_noCachePartition)
 		|| m_enableRecord)
 	{
-		this->m_rewardTrace(m_transition, ExtractBitrate(interest->GetName()), r);
+		this->m_rewardTrace(m_transition, NDNBitRate::GetInternedBitRate(actualBR), r);
 	}
 	return r;
 }
@@ -303,6 +299,18 @@ Entry::GetData () const
   return m_data;
 }
 
+Ptr<Data>
+Entry::GetHitData () const
+{
+  if (m_hitPayload == 0)
+    {
+      Ptr<Packet> payload = m_data->GetPayload ()->Copy ();
+      payload->RemoveAllPacketTags ();
+      m_hitPayload = payload;
+    }
+  return Create<Data> (*m_data, m_hitPayload);
+}
+
 Ptr<ContentStore>
 Entry::GetContentStore ()
 {
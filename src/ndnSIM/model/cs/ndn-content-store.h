@@ -87,6 +87,15 @@ public:
   Ptr<const Data>
   GetData () const;
 
+  /**
+   * \brief Data answering an Interest from this entry
+   *
+   * The per-hop fields are copied; the name and the payload (without packet tags)
+   * are shared with the stored Data, see Data::AddPayloadTag
+   */
+  Ptr<Data>
+  GetHitData () const;
+
   inline
   uint32_t GetSize()
   {
@@ -102,6 +111,7 @@ public:
 private:
   Ptr<ContentStore> m_cs; ///< \brief content store to which entry is added
   Ptr<const Data> m_data; ///< \brief non-modifiable Data
+  mutable Ptr<const Packet> m_hitPayload; ///< \brief payload of m_data without packet tags, made on the first hit
 };
 
 } // namespace cs
@@ -257,6 +267,9 @@ public:
 
   //Added to implement DFA Transition (Deserted)
 public:
+    /**
+     * @brief Get number of bytes of the entries in content store
+     */
     virtual uint32_t GetCurrentSize() const;
     virtual inline bool RemoveByMDP(Ptr<Name> name)
     {
@@ -304,9 +317,13 @@ public:
 	virtual double
 	GetSectionRatio(const std::string&);
 
-	std::string
+	const std::string&
 	ExtractBitrate(const Name& n);
 
+	// Bitrate rank of a video name (0 if unknown). Prefer Interest/Data::GetBitRateRank on packets.
+	uint32_t
+	ExtractBitrateRank(const Name& n);
+
 	inline void EnableRecord() { m_enableRecord = true; };
 
 	virtual void ReportPartitionStatus();
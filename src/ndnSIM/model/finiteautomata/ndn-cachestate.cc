@@ -25,8 +25,8 @@ MDPState::AddContent(const VideoIndex& vc)
 		newfile = true;
 	else
 	{
-		auto j = fileiter->second.m_start.find(vc.m_bitrate);
-		auto k = fileiter->second.m_end.find(vc.m_bitrate);
+		auto j = fileiter->second.m_start.find(vc.m_rank);
+		auto k = fileiter->second.m_end.find(vc.m_rank);
 		if(j == fileiter->second.m_start.end())
 			newitem = true;
 		else if(k->second < m_filemaxlen + 1 && vc.m_chunk == k->second)
@@ -43,8 +43,8 @@ MDPState::AddContent(const VideoIndex& vc)
 	if(newfile)
 	{
 		Block spf;
-		spf.m_start[vc.m_bitrate] = 1;
-		spf.m_end[vc.m_bitrate] = 2;
+		spf.m_start[vc.m_rank] = 1;
+		spf.m_end[vc.m_rank] = 2;
 		m_status.m_filedict[vc.m_file] = std::move(spf);
 		if(vc.m_chunk != 1)
 			NS_LOG_WARN("MDPState:AddContent; Adding video segment ID error");
@@ -52,8 +52,8 @@ MDPState::AddContent(const VideoIndex& vc)
 	}
 	if(newitem)
 	{
-		m_status.m_filedict[vc.m_file].m_start[vc.m_bitrate] = 1;
-		m_status.m_filedict[vc.m_file].m_end[vc.m_bitrate] = 2;
+		m_status.m_filedict[vc.m_file].m_start[vc.m_rank] = 1;
+		m_status.m_filedict[vc.m_file].m_end[vc.m_rank] = 2;
 		if(vc.m_chunk != 1)
 			NS_LOG_WARN("MDPState:AddContent; Adding video segment ID error");
 		action=true;
@@ -61,7 +61,7 @@ MDPState::AddContent(const VideoIndex& vc)
 	if(action)
 	{
 		m_size++;
-		m_size_perrate[vc.m_bitrate] += 1;
+		m_size_perrate[vc.m_rank] += 1;
 	}
 	return action;
 
@@ -79,28 +79,28 @@ MDPState::RemoveContent(const VideoIndex& vc)
 	auto iter = m_status.m_filedict.find(vc.m_file);
 	if(iter == m_status.m_filedict.end())
 		normal = false;
-	if(normal && iter->second.m_start.find(vc.m_bitrate) == iter->second.m_start.end())
+	if(normal && iter->second.m_start.find(vc.m_rank) == iter->second.m_start.end())
 		normal = false;
-	if(normal && iter->second.m_end[vc.m_bitrate] > iter->second.m_start[vc.m_bitrate] + 1)
+	if(normal && iter->second.m_end[vc.m_rank] > iter->second.m_start[vc.m_rank] + 1)
 	{
-		if(vc.m_chunk == iter->second.m_end[vc.m_bitrate] - 1)
+		if(vc.m_chunk == iter->second.m_end[vc.m_rank] - 1)
 		{
 			action = true;
-			iter->second.m_end[vc.m_bitrate]--;
+			iter->second.m_end[vc.m_rank]--;
 		}
-		if(vc.m_chunk == iter->second.m_start[vc.m_bitrate])
+		if(vc.m_chunk == iter->second.m_start[vc.m_rank])
 		{
 			action = true;
-			iter->second.m_start[vc.m_bitrate]++;
+			iter->second.m_start[vc.m_rank]++;
 		}
 	}
 	else if(normal)
 	{
-		if(vc.m_chunk == iter->second.m_start[vc.m_bitrate])
+		if(vc.m_chunk == iter->second.m_start[vc.m_rank])
 		{
 			action = true;
-			iter->second.m_start.erase(vc.m_bitrate);
-			iter->second.m_end.erase(vc.m_bitrate);
+			iter->second.m_start.erase(vc.m_rank);
+			iter->second.m_end.erase(vc.m_rank);
 		}
 	}
 	if(!normal)
@@ -108,20 +108,20 @@ MDPState::RemoveContent(const VideoIndex& vc)
 	if(action)
 	{
 		m_size--;
-		m_size_perrate[vc.m_bitrate] -= 1;
+		m_size_perrate[vc.m_rank] -= 1;
 	}
 	return action;
 }
 
 MDPState::BlockRange
-MDPState::GetChunkRange(const std::string& bitrate, uint32_t fileID) const
+MDPState::GetChunkRange(uint32_t rank, uint32_t fileID) const
 {
 	BlockRange range = std::make_pair(0, 0);
 	auto iter = m_status.m_filedict.find(fileID);
 	if(iter != m_status.m_filedict.end())
 	{
-		auto j = iter->second.m_start.find(bitrate);
-		auto k = iter->second.m_end.find(bitrate);
+		auto j = iter->second.m_start.find(rank);
+		auto k = iter->second.m_end.find(rank);
 		if(j != iter->second.m_start.end())
 		{
 			range.first = j->second;
@@ -147,8 +147,8 @@ MDPState::SatisfyBaseLaw(const VideoIndex& vi) const
 	auto fileiter = m_status.m_filedict.find(vi.m_file);
 	if(fileiter != m_status.m_filedict.end())
 	{
-		auto j = fileiter->second.m_start.find(vi.m_bitrate);
-		auto k = fileiter->second.m_end.find(vi.m_bitrate);
+		auto j = fileiter->second.m_start.find(vi.m_rank);
+		auto k = fileiter->second.m_end.find(vi.m_rank);
 		if(j != fileiter->second.m_start.end())
 		{
 			if(j->second == vi.m_chunk || (k->second - 1) == vi.m_chunk)
@@ -165,8 +165,8 @@ MDPState::SatisfyGeneralLaw(const VideoIndex& vi) const
 	auto fileiter = m_status.m_filedict.find(vi.m_file);
 	if(fileiter != m_status.m_filedict.end())
 	{
-		auto j = fileiter->second.m_start.find(vi.m_bitrate);
-		auto k = fileiter->second.m_end.find(vi.m_bitrate);
+		auto j = fileiter->second.m_start.find(vi.m_rank);
+		auto k = fileiter->second.m_end.find(vi.m_rank);
 		if(j != fileiter->second.m_start.end())
 		{
 			if(j->second <= vi.m_chunk && k->second > vi.m_chunk)
@@ -26,8 +26,8 @@ public:
 	/*
 	 * m_start and m_end marks the starting and ending ID of a continuous video block
 	 */
-	std::map<std::string, uint32_t> m_start; //starting from ChunkID 1 to maxLen
-	std::map<std::string, uint32_t> m_end;
+	std::map<uint32_t, uint32_t> m_start; //Key: bitrate rank; starting from ChunkID 1 to maxLen
+	std::map<uint32_t, uint32_t> m_end;
 };
 
 
@@ -73,12 +73,12 @@ public:
 	bool RemoveContent (const VideoIndex&);
 
 	bool operator==(const MDPState& s) const;
-	BlockRange GetChunkRange(const std::string& bitrate, uint32_t fileID) const;
+	BlockRange GetChunkRange(uint32_t rank, uint32_t fileID) const;
 
 	bool SatisfyBaseLaw(const VideoIndex&) const;
 	bool SatisfyGeneralLaw(const VideoIndex&) const;
 
-	std::map<std::string, uint32_t> 	m_size_perrate;
+	std::map<uint32_t, uint32_t> 	m_size_perrate;
 
 private:
 	uint32_t 			m_stateid = 0;	//ID assigned by the DFA environment
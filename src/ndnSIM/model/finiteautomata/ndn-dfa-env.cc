@@ -94,24 +94,12 @@ DPdfa::NotifyNewAggregate()
 uint32_t
 DPdfa::ZipfFileSelect()
 {
-	uint32_t content_index = 1; //[1, m_N]
-	double p_sum = 0;
-
 	double p_random = m_SeqRng.GetValue();
 	while (p_random == 0)
 	{
 		p_random = m_SeqRng.GetValue();
 	}
-	for (uint32_t i=1; i<=DFAFile; i++)
-	{
-		p_sum = m_Pcum[i];   //m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
-		if (p_random <= p_sum)
-		{
-			content_index = i;
-			break;
-		} //if
-	} //for
-	  //content_index = 1;
+	uint32_t content_index = m_sampler->Sample(p_random); //[1, DFAFile]
 	NS_LOG_DEBUG("RandomNumber="<<content_index);
 	return content_index;
 }
@@ -120,17 +108,7 @@ DPdfa::ZipfFileSelect()
 void
 DPdfa::PrepareTransProb ()
 {
-	m_Pcum = std::vector<double> (DFAFile + 1);
-	m_Pcum[0] = 0.0;
-	for (uint32_t i=1; i <= DFAFile; i++)
-    {
-		m_Pcum[i] = m_Pcum[i-1] + 1.0 / std::pow(i, Skewness);
-    }
-	for (uint32_t i=1; i<=DFAFile; i++)
-    {
-      m_Pcum[i] = m_Pcum[i] / m_Pcum[DFAFile];
-      NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-    }
+	m_sampler = ZipfSampler::Get(DFAFile, 0, Skewness);
 }
 
 void
@@ -185,8 +163,8 @@ DPdfa::Transition()
 	 */
 	uint32_t fileID = ZipfFileSelect();
 
-	VideoIndex nextseg(current_action.second, fileID, 0);
-	MDPState::BlockRange range = m_current_iter->GetChunkRange(nextseg.m_bitrate, nextseg.m_file);
+	VideoIndex nextseg(NDNBitRate::LookupRank(current_action.second), fileID, 0);
+	MDPState::BlockRange range = m_current_iter->GetChunkRange(nextseg.m_rank, nextseg.m_file);
 
 	if(range.first != 0)
 	{
@@ -235,7 +213,7 @@ DPdfa::Transition()
 			{
 				NeedToDelete->push_back(*checkptr);
 				newstate.RemoveContent(*checkptr);
-				available_space += (m_bitinfo->GetChunkSize(checkptr->m_bitrate.substr(2))) * 1e3;
+				available_space += (m_bitinfo->GetChunkSizeFromRank(checkptr->m_rank)) * 1e3;
 				checkptr++;
 			}
 		}
@@ -276,7 +254,7 @@ Ptr<Name>
 DPdfa::VideoIndexToName(const VideoIndex& vi)
 {
 	Ptr<Name> nameinCS = Create<Name>(m_prefix);
-	nameinCS->append(vi.m_bitrate);
+	nameinCS->append(vi.GetBitRateComponent());
 	nameinCS->appendNumber(vi.m_file);
 	nameinCS->appendNumber(vi.m_chunk);
 	return nameinCS;
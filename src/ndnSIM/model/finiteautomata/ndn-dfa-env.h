@@ -12,6 +12,7 @@
 #include "ns3/nstime.h"
 #include "ns3/random-variable.h"
 #include "ns3/ndn-cachestate.h"
+#include "ns3/ndn-zipf-sampler.h"
 
 #include "boost/functional/hash.hpp"
 
@@ -155,7 +156,7 @@ private:
    */
   void 		PrepareTransProb ();
 
-  std::vector<double> 	m_Pcum;  //cumulative probability
+  Ptr<const ZipfSampler>	m_sampler;  //shared Zipf table
   UniformVariable 		m_SeqRng;
 };
 
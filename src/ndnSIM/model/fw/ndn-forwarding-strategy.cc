@@ -186,9 +186,7 @@ void ForwardingStrategy::AddStatistics(Ptr<const Interest> interest)
 {
 	if(m_stats != 0)//Only for edge routers
 	{
-		m_stats->Add(VideoIndex {interest->GetName().get(-3).toUri(),
-								 static_cast<uint32_t>(interest->GetName().get(-2).toNumber()),
-								 static_cast<uint32_t>(interest->GetName().get(-1).toNumber())});
+		m_stats->Add(VideoIndex {interest->GetName()});
 	}
 }
 
@@ -245,7 +243,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
 		FwHopCountTag hopCountTag;
 		if (interest->GetPayload ()->PeekPacketTag (hopCountTag))
 		{
-			contentObject->GetPayload ()->AddPacketTag (hopCountTag);
+			contentObject->AddPayloadTag (hopCountTag);
 		}
 
 		pitEntry->AddIncoming (inFace/*, Seconds (1.0)*/, reqreward);
@@ -301,7 +299,6 @@ void ForwardingStrategy::RecordHopDelay(Ptr<Face> inFace, Ptr<const Data> data,
 {
 	if(m_stat_summary != 0 || m_tran != 0)
 	{
-		std::map<uint32_t, Time> records;
 	/*
 		Ptr<NetDeviceFace> netface = DynamicCast<ndn::NetDeviceFace> (inFace);
 		if(netface == 0) // Consumer receives data packet; no need to record
@@ -323,25 +320,10 @@ void ForwardingStrategy::RecordHopDelay(Ptr<Face> inFace, Ptr<const Data> data,
 			sourcenode = onedevice->GetNode();
 		}
 	*/
-		const ns3::ndn::pit::Entry::in_container pitfaces = pitEntry->GetIncoming();
-		for(auto iter = pitfaces.begin(); iter != pitfaces.end(); iter++)
-		{
-
-			if(records.find(iter->m_face->GetId()) != records.end())
-			{
-				if(records[iter->m_face->GetId()] < iter->m_arrivalTime)
-					records[iter->m_face->GetId()] = iter->m_arrivalTime;
-				//NS_LOG_DEBUG("Same faceID; different arrival time");
-			}
-			else
-				records[iter->m_face->GetId()] = iter->m_arrivalTime;
-		}
-		Time firstcome = records.begin()->second;
-		for(auto iter = records.begin(); iter!= records.end(); iter++)
-		{
-			if(iter->second < firstcome)
-				firstcome = iter->second;
-		}
+		if(pitEntry->GetIncoming().empty())
+			return;
+		// one record per face: the earliest arrival over the records
+		Time firstcome = pitEntry->GetFirstArrival();
 		if(m_stat_summary != 0)
 		{
 			m_stat_summary->UpdateDelay(pitEntry->GetPrefix(), Simulator::Now() - firstcome);
@@ -359,9 +341,10 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
 {
   NS_LOG_FUNCTION (inFace << data->GetName ());
   //if(m_node->GetId() == 1)
+  // names shorter than /file/chunk (not video data) are logged with file 0
   NS_LOG_INFO ("[FW] DATA for" << data->GetName() <<"\tFile: "
-		  << static_cast<uint32_t>(data->GetName().get(-2).toNumber())
-		  << " Chunk: " << static_cast<uint32_t>(data->GetName().get(-1).toNumber()));
+		  << (data->GetName().size() < 2 ? 0 : static_cast<uint32_t>(data->GetName().get(-2).toNumber()))
+		  << " Chunk: " << (data->GetName().size() < 1 ? 0 : static_cast<uint32_t>(data->GetName().get(-1).toNumber())));
   m_inData (data, inFace);
 
   // Lookup PIT entry
@@ -22,6 +22,7 @@
 #include "ndn-data.h"
 
 #include "ns3/log.h"
+#include "ns3/ndn-bitrate.h"
 
 #include <boost/foreach.hpp>
 
@@ -34,11 +35,13 @@ Data::Data (Ptr<Packet> payload/* = Create<Packet> ()*/)
   : m_name (Create<Name> ())
   , m_signature (0)
   , m_payload (payload)
+  , m_sharedPayload (false)
   , m_keyLocator (0)
   //, m_ProducerFlag (0)
   , m_hops(0)
   , m_reward (0)
   , m_mostRecentDelay(0)
+  , m_brRank (UNRESOLVED_RANK)
   , m_wire (0)
 {
   if (m_payload == 0) // just in case
@@ -55,6 +58,7 @@ Data::Data (const Data &other)
   , m_timestamp (other.GetTimestamp ())
   , m_signature (other.GetSignature ())
   , m_payload (other.GetPayload ()->Copy ())
+  , m_sharedPayload (false)
   , m_TSI (other.m_TSI)
   , m_TSB (other.m_TSB)
   //, m_ProducerFlag (0)
@@ -62,6 +66,7 @@ Data::Data (const Data &other)
   , m_reward (0)
   , ProbeCache_ACC (other.ProbeCache_ACC)
   , m_mostRecentDelay(other.m_mostRecentDelay)
+  , m_brRank (other.m_brRank)
   , m_wire (0)
 {
   if (other.GetKeyLocator ())
@@ -78,10 +83,37 @@ Data::Data (const Data &other)
   }
 }
 
+Data::Data (const Data &other, Ptr<const Packet> payload)
+  : m_name (other.m_name)
+  , m_freshness (other.m_freshness)
+  , m_timestamp (other.m_timestamp)
+  , m_signature (other.m_signature)
+  , m_payload (ConstCast<Packet> (payload))
+  , m_sharedPayload (true)
+  , m_keyLocator (other.m_keyLocator)
+  , m_TSI (other.m_TSI)
+  , m_TSB (other.m_TSB)
+  , m_hops (other.m_hops)
+  , m_reward (0)
+  , ProbeCache_ACC (other.ProbeCache_ACC)
+  , m_mostRecentDelay (other.m_mostRecentDelay)
+  , m_brRank (other.m_brRank)
+  , m_wire (0)
+{
+  for(uint8_t i = 0; i < MaxHop; i++)
+  {
+	  if(i < m_hops)
+		  m_delays[i] = other.m_delays[i];
+	  else
+		  m_delays[i] = 0;
+  }
+}
+
 void
 Data::SetName (Ptr<Name> name)
 {
   m_name = name;
+  m_brRank = UNRESOLVED_RANK;
   m_wire = 0;
 }
 
@@ -89,6 +121,7 @@ void
 Data::SetName (const Name &name)
 {
   m_name = Create<Name> (name);
+  m_brRank = UNRESOLVED_RANK;
   m_wire = 0;
 }
 
@@ -105,6 +138,14 @@ Data::GetNamePtr () const
   return m_name;
 }
 
+uint32_t
+Data::GetBitRateRank () const
+{
+  if (m_brRank == UNRESOLVED_RANK)
+    m_brRank = (m_name == 0) ? 0 : NDNBitRate::ExtractRank (*m_name);
+  return m_brRank;
+}
+
 
 void
 Data::SetTimestamp (const Time &timestamp)
@@ -169,6 +210,7 @@ void
 Data::SetPayload (Ptr<Packet> payload)
 {
   m_payload = payload;
+  m_sharedPayload = false;
   m_wire = 0;
 }
 
@@ -178,5 +220,17 @@ Data::GetPayload () const
   return m_payload;
 }
 
+void
+Data::AddPayloadTag (const Tag &tag)
+{
+  if (m_sharedPayload)
+    {
+      m_payload = m_payload->Copy ();
+      m_sharedPayload = false;
+    }
+  m_payload->AddPacketTag (tag);
+  m_wire = 0;
+}
+
 } // namespace ndn
 } // namespace ns3
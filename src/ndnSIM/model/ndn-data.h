@@ -50,6 +50,15 @@ public:
    * @brief Copy constructor
    */
   Data (const Data &other);
+
+  /**
+   * @brief Copy of the per-hop fields of other, sharing the rest
+   *
+   * The name and key locator of other are shared (they are never modified in place),
+   * and payload is shared read-only until AddPayloadTag. Used to answer from the
+   * content store without copying the cached object.
+   */
+  Data (const Data &other, Ptr<const Packet> payload);
   /**
    * \brief Set content object name
    *
@@ -152,7 +161,24 @@ public:
    */
   Ptr<const Packet>
   GetPayload () const;
+
+  /**
+   * @brief Add a packet tag to the payload, copying it first if it is shared
+   *
+   * The payload of a Data made by the sharing constructor may be held by a content
+   * store: add tags through this, not through GetPayload
+   */
+  void
+  AddPayloadTag (const Tag &tag);
   
+  /**
+   * @brief Get rank of the video bitrate in the name (0 if it is not a video name)
+   *
+   * The rank is resolved from the name once and cached with the packet
+   */
+  uint32_t
+  GetBitRateRank () const;
+
   /**
    * @brief Get wire formatted packet
    *
@@ -291,6 +317,7 @@ private:
   Time 			m_timestamp;
   uint32_t 		m_signature; // 0, means no signature, any other value application dependent (not a real signature)
   Ptr<Packet> 	m_payload;
+  bool 			m_sharedPayload;	// m_payload belongs to someone else: copy before writing
   Ptr<Name> 	m_keyLocator;
 
 
@@ -307,7 +334,10 @@ public:
 private:
   uint32_t		m_delays[MaxHop];		//Delay by Each hop
 
+  mutable uint32_t m_brRank;	// Cached bitrate rank of m_name, UNRESOLVED_RANK if not yet looked up
   mutable Ptr<const Packet> m_wire;
+
+  enum { UNRESOLVED_RANK = 0xFFFFFFFF };
 };
 
 inline std::ostream &
@@ -36,6 +36,7 @@
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
 
 #include "ns3/ndn-wire.h"
+#include "ns3/ndnSIM/model/wire/pass-through.h"
 
 #include <boost/ref.hpp>
 
@@ -68,6 +69,7 @@ Face::GetTypeId ()
  */
 Face::Face (Ptr<Node> node)
   : m_node (node)
+  , m_passThrough (false)
   , m_upstreamInterestHandler (MakeNullCallback< void, Ptr<Face>, Ptr<Interest> > ())
   , m_upstreamDataHandler (MakeNullCallback< void, Ptr<Face>, Ptr<Data> > ())
   , m_ifup (false)
@@ -129,6 +131,9 @@ Face::SendInterest (Ptr<const Interest> interest)
       return false;
     }
 
+  if (m_passThrough)
+    return Send (wire::passThrough::Interest::ToWire (interest));
+
   return Send (Wire::FromInterest (interest));
 }
 
@@ -142,6 +147,9 @@ Face::SendData (Ptr<const Data> data)
       return false;
     }
 
+  if (m_passThrough)
+    return Send (wire::passThrough::Data::ToWire (data));
+
   return Send (Wire::FromData (data));
 }
 
@@ -171,6 +179,22 @@ Face::Receive (Ptr<const Packet> p)
     }
 
   Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
+
+  wire::passThrough::Tag tag;
+  if (m_passThrough && packet->PeekPacketTag (tag))
+    {
+      if (tag.GetType () == wire::passThrough::Tag::INTEREST)
+        {
+          Ptr<Interest> interest = wire::passThrough::Interest::FromWire (packet, tag);
+          return interest != 0 && ReceiveInterest (interest);
+        }
+      else
+        {
+          Ptr<Data> data = wire::passThrough::Data::FromWire (packet, tag);
+          return data != 0 && ReceiveData (data);
+        }
+    }
+
   try
     {
       HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (packet);
@@ -267,6 +267,7 @@ private:
 
 protected:
   Ptr<Node> m_node; ///< \brief Smart pointer to Node
+  bool m_passThrough; ///< @brief Interest/Data sent by reference (see model/wire/pass-through.h)
 
 private:
   InterestHandler m_upstreamInterestHandler;
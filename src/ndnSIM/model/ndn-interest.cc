@@ -23,6 +23,7 @@
 #include "ns3/log.h"
 #include "ns3/unused.h"
 #include "ns3/packet.h"
+#include "ns3/ndn-bitrate.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.Interest");
 
@@ -40,6 +41,7 @@ Interest::Interest (Ptr<Packet> payload/* = Create<Packet> ()*/)
 //  , m_producerRank(0)
   , m_exclude (0)
   , m_payload (payload)
+  , m_brRank (UNRESOLVED_RANK)
   , m_wire (0)
 {
   if (m_payload == 0) // just in case
@@ -61,6 +63,7 @@ Interest::Interest (const Interest &interest)
 //  , m_producerRank	   (interest.m_producerRank)
   , m_exclude          (interest.m_exclude ? Create<Exclude> (*interest.GetExclude ()) : 0)
   , m_payload          (interest.GetPayload ()->Copy ())
+  , m_brRank           (interest.m_brRank)
   , m_wire             (0)
 {
   NS_LOG_FUNCTION ("correct copy constructor");
@@ -70,6 +73,7 @@ void
 Interest::SetName (Ptr<Name> name)
 {
   m_name = name;
+  m_brRank = UNRESOLVED_RANK;
   m_wire = 0;
 }
 
@@ -77,6 +81,7 @@ void
 Interest::SetName (const Name &name)
 {
   m_name = Create<Name> (name);
+  m_brRank = UNRESOLVED_RANK;
   m_wire = 0;
 }
 
@@ -93,6 +98,14 @@ Interest::GetNamePtr () const
   return m_name;
 }
 
+uint32_t
+Interest::GetBitRateRank () const
+{
+  if (m_brRank == UNRESOLVED_RANK)
+    m_brRank = (m_name == 0) ? 0 : NDNBitRate::ExtractRank (*m_name);
+  return m_brRank;
+}
+
 void
 Interest::SetScope (int8_t scope)
 {
@@ -209,6 +209,14 @@ public:
   Ptr<const Packet>
   GetPayload () const;
   
+  /**
+   * @brief Get rank of the video bitrate in the name (0 if it is not a video name)
+   *
+   * The rank is resolved from the name once and cached with the packet
+   */
+  uint32_t
+  GetBitRateRank () const;
+
   /**
    * @brief Get wire formatted packet
    *
@@ -325,7 +333,10 @@ private:
   Ptr<Exclude> 	m_exclude;   ///< @brief Exclude filter
   Ptr<Packet> 	m_payload;    ///< @brief virtual payload
 
+  mutable uint32_t m_brRank;    ///< @brief Cached bitrate rank of m_name, UNRESOLVED_RANK if not yet looked up
   mutable Ptr<const Packet> m_wire;
+
+  enum { UNRESOLVED_RANK = 0xFFFFFFFF };
 };
 
 inline std::ostream &
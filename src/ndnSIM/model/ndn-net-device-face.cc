@@ -21,6 +21,7 @@
 
 #include "ndn-net-device-face.h"
 #include "ndn-l3-protocol.h"
+#include "ns3/ndnSIM/model/wire/pass-through.h"
 
 #include "ns3/net-device.h"
 #include "ns3/log.h"
@@ -62,6 +63,9 @@ NetDeviceFace::NetDeviceFace (Ptr<Node> node, const Ptr<NetDevice> &netDevice)
 
   SetMetric (1); // default metric
 
+  // Only a point-to-point link guarantees a single receiver for the object
+  m_passThrough = wire::passThrough::IsEnabled () && DynamicCast<PointToPointNetDevice> (netDevice) != 0;
+
   NS_ASSERT_MSG (m_netDevice != 0, "NetDeviceFace needs to be assigned a valid NetDevice");
 }
 
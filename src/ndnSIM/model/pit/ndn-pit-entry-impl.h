@@ -21,6 +21,8 @@
 #ifndef _NDN_PIT_ENTRY_IMPL_H_
 #define	_NDN_PIT_ENTRY_IMPL_H_
 
+#include "../../utils/trie/detail/node-arena.h"
+
 namespace ns3 {
 namespace ndn {
 
@@ -46,39 +48,47 @@ public:
                 Ptr<const Interest> header,
                 Ptr<fib::Entry> fibEntry)
   : Entry (pit, header, fibEntry)
+  , wheel_tick_ (0)
   , item_ (0)
   {
-    CONTAINER.i_time.insert (*this);
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.AddExpiration (*this);
   }
   
   virtual ~EntryImpl ()
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
-    
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.RemoveExpiration (*this);
   }
 
   virtual void
   UpdateLifetime (const Time &offsetTime)
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
+    CONTAINER.RemoveExpiration (*this);
     super::UpdateLifetime (offsetTime);
-    CONTAINER.i_time.insert (*this);
-
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.AddExpiration (*this);
   }
 
   virtual void
   OffsetLifetime (const Time &offsetTime)
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
+    CONTAINER.RemoveExpiration (*this);
     super::OffsetLifetime (offsetTime);
-    CONTAINER.i_time.insert (*this);
-
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.AddExpiration (*this);
   }
   
+  // entries come from an arena shared by the PITs of this type
+  static void *
+  operator new (size_t size)
+  {
+    NS_ASSERT (size == sizeof (EntryImpl));
+    return GetArena ().allocate ();
+  }
+
+  static void
+  operator delete (void *p)
+  {
+    GetArena ().deallocate (p);
+  }
+
   // to make sure policies work
   void
   SetTrie (typename Pit::super::iterator item) { item_ = item; }
@@ -88,8 +98,20 @@ public:
 
 public:
   boost::intrusive::set_member_hook<> time_hook_;
+
+  // timing wheel slot and tick, when the PIT expires entries on ticks
+  boost::intrusive::list_member_hook<> wheel_hook_;
+  int64_t wheel_tick_;
   
 private:
+  static ndnSIM::detail::node_arena<EntryImpl> &
+  GetArena ()
+  {
+    // never destroyed, entries may be released during static destruction
+    static ndnSIM::detail::node_arena<EntryImpl> *arena = new ndnSIM::detail::node_arena<EntryImpl> ();
+    return *arena;
+  }
+
   typename Pit::super::iterator item_;
 };
 
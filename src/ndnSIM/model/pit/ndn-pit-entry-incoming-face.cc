@@ -26,9 +26,10 @@ namespace ns3 {
 namespace ndn {
 namespace pit {
 
-IncomingFace::IncomingFace (Ptr<Face> face)
+IncomingFace::IncomingFace (Ptr<Face> face, double reward)
   : m_face (face)
   , m_arrivalTime (Simulator::Now ())
+  , m_reward (reward)
   // , m_nonce (nonce)
 {
 }
@@ -36,6 +37,7 @@ IncomingFace::IncomingFace (Ptr<Face> face)
 IncomingFace::IncomingFace ()
   : m_face (0)
   , m_arrivalTime (0)
+  , m_reward (0)
 {
 }
 
@@ -47,6 +49,7 @@ IncomingFace::operator = (const IncomingFace &other)
 {
   m_face = other.m_face;
   m_arrivalTime = other.m_arrivalTime;
+  m_reward = other.m_reward;
   return *this;
 }
 
@@ -38,14 +38,15 @@ struct IncomingFace
 {
   Ptr< Face > m_face; ///< \brief face of the incoming Interest
   Time m_arrivalTime;   ///< \brief arrival time of the incoming Interest
+  double m_reward;      ///< \brief reward carried by the incoming Interest (summed over aggregated Interests)
 
 public:
   /**
    * \brief Constructor
    * \param face face of the incoming interest
-   * \param lifetime lifetime of the incoming interest
+   * \param reward reward carried by the incoming interest
    */
-  IncomingFace (Ptr<Face> face);
+  IncomingFace (Ptr<Face> face, double reward = 0);
 
   /**
    * @brief Default constructor, necessary for Python bindings, but should not be used anywhere else.
@@ -123,18 +123,15 @@ Entry::in_iterator
 Entry::AddIncoming (Ptr<Face> face, double r)
 {
   std::pair<in_iterator,bool> ret =
-    m_incoming.insert (IncomingFace (face));
+    m_incoming.insert (IncomingFace (face, r));
 
   // NS_ASSERT_MSG (ret.second, "Something is wrong");
 
-  reward_dict::iterator iter = m_pitreward.find(face->GetId());
-  if(iter != m_pitreward.end())
+  if(!ret.second)
   {
-	  iter->second += r;
+	  const_cast<IncomingFace&>(*ret.first).m_reward += r;
 	  NS_LOG_WARN("[PIT]: Duplicate entries when recording reward! Check Interest Aggregation!!!");
   }
-  else
-	  m_pitreward[face->GetId()] = r;
 
   return ret.first;
 }
@@ -142,25 +139,34 @@ Entry::AddIncoming (Ptr<Face> face, double r)
 double
 Entry::GetReward(uint32_t id)
 {
-	reward_dict::iterator iter = m_pitreward.find(id);
-	if(iter != m_pitreward.end())
-		return iter->second;
-	else
-		return 0;
+	for(in_iterator iter = m_incoming.begin(); iter != m_incoming.end(); iter++)
+		if(iter->m_face->GetId() == id)
+			return iter->m_reward;
+	return 0;
+}
+
+Time
+Entry::GetFirstArrival () const
+{
+  if (m_incoming.empty ())
+    return m_entryCreatedTime;
+
+  Time first = m_incoming.begin ()->m_arrivalTime;
+  for (in_iterator iter = m_incoming.begin (); iter != m_incoming.end (); iter++)
+    first = std::min (first, iter->m_arrivalTime);
+  return first;
 }
 
 void
 Entry::RemoveIncoming (Ptr<Face> face)
 {
   m_incoming.erase (face);
-  m_pitreward.erase(face->GetId());
 }
 
 void
 Entry::ClearIncoming ()
 {
   m_incoming.clear ();
-  m_pitreward.clear();
 }
 
 Entry::out_iterator
@@ -193,10 +199,6 @@ Entry::RemoveAllReferencesToFace (Ptr<Face> face)
   if (incoming != m_incoming.end ())
     m_incoming.erase (incoming);
 
-  reward_dict::iterator iter = m_pitreward.find(face->GetId());
-  if(iter != m_pitreward.end())
-	  m_pitreward.erase(iter);
-
   out_iterator outgoing =
     m_outgoing.find (face);
 
@@ -28,6 +28,7 @@
 
 #include "ns3/ndn-pit-entry-incoming-face.h"
 #include "ns3/ndn-pit-entry-outgoing-face.h"
+#include "ns3/ndn-pit-face-records.h"
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
@@ -58,21 +59,15 @@ namespace pit {
 class Entry : public SimpleRefCount<Entry>
 {
 public:
-  typedef std::set< IncomingFace > in_container; ///< @brief incoming faces container type
+  typedef FaceRecords< IncomingFace, 3 > in_container; ///< @brief incoming faces container type
   typedef in_container::iterator in_iterator;                ///< @brief iterator to incoming faces
 
   // typedef OutgoingFaceContainer::type out_container; ///< @brief outgoing faces container type
-  typedef std::set< OutgoingFace > out_container; ///< @brief outgoing faces container type
+  typedef FaceRecords< OutgoingFace, 3 > out_container; ///< @brief outgoing faces container type
   typedef out_container::iterator out_iterator;              ///< @brief iterator to outgoing faces
 
   typedef std::set< uint32_t > nonce_container;  ///< @brief nonce container type
 
-  /*
-   * Added by Wenjie Li
-   * Track the reward by each Face
-   */
-  typedef std::map<uint32_t, double> reward_dict;
-
   /**
    * \brief PIT entry constructor
    * \param prefix Prefix of the PIT entry
@@ -275,9 +270,18 @@ public:
   const Time &
   GetTimestamp () const;
 
+  /*
+   * Reward recorded with the Interest from face id (0 if none)
+   */
   double
   GetReward(uint32_t id);
 
+  /*
+   * Earliest arrival time of the incoming Interests (the entry creation time if none)
+   */
+  Time
+  GetFirstArrival () const;
+
 private:
   friend std::ostream& operator<< (std::ostream& os, const Entry &entry);
 
@@ -303,11 +307,6 @@ protected:
    * For DASCache Heuristic Algorithm
    */
   Time 	m_entryCreatedTime;	///Record when this entry is created in the simulation;
-  /*
-   * Added by Wenjie Li
-   * For Recording Reinforcement Learning Reward
-   */
-  reward_dict m_pitreward;
 };
 
 /// @cond include_hidden
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Incoming/outgoing face records of a PIT entry
+ *
+ * The records are kept in an array sorted by face, like the std::set they
+ * replace, with room for N of them inside the entry; only entries with more
+ * faces allocate. Lookups are linear, which beats a tree for a few faces.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef _NDN_PIT_FACE_RECORDS_H_
+#define _NDN_PIT_FACE_RECORDS_H_
+
+#include "ns3/ptr.h"
+#include "ns3/ndn-face.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+/**
+ * @ingroup ndn-pit
+ * @brief Set of face records (IncomingFace or OutgoingFace) ordered by face
+ *
+ * As with std::set, the records are reached through const iterators (fields that
+ * are not the key may be changed through a const_cast). Inserting or erasing
+ * invalidates the iterators.
+ */
+template<class Record, size_t N>
+class FaceRecords
+{
+public:
+  typedef Record value_type;
+  typedef const Record *iterator;
+  typedef const Record *const_iterator;
+
+  FaceRecords ()
+    : m_data (Inline ())
+    , m_size (0)
+    , m_capacity (N)
+  {
+  }
+
+  FaceRecords (const FaceRecords &other)
+    : m_data (Inline ())
+    , m_size (0)
+    , m_capacity (N)
+  {
+    *this = other;
+  }
+
+  FaceRecords &
+  operator= (const FaceRecords &other)
+  {
+    if (this != &other)
+      {
+        clear ();
+        Reserve (other.m_size);
+        std::uninitialized_copy (other.begin (), other.end (), m_data);
+        m_size = other.m_size;
+      }
+    return *this;
+  }
+
+  ~FaceRecords ()
+  {
+    clear ();
+    if (m_data != Inline ())
+      ::operator delete (m_data);
+  }
+
+  const_iterator
+  begin () const { return m_data; }
+
+  const_iterator
+  end () const { return m_data + m_size; }
+
+  size_t
+  size () const { return m_size; }
+
+  bool
+  empty () const { return m_size == 0; }
+
+  const_iterator
+  find (Ptr<Face> face) const
+  {
+    for (const_iterator record = begin (); record != end (); record++)
+      if (*record->m_face == *face)
+        return record;
+    return end ();
+  }
+
+  /**
+   * @brief Insert record, unless there is already one for its face
+   * @returns the record of the face, and whether it was inserted
+   */
+  std::pair<iterator, bool>
+  insert (const Record &record)
+  {
+    size_t pos = std::lower_bound (begin (), end (), record) - begin ();
+    if (pos < m_size && !(record < m_data[pos]))
+      return std::make_pair (m_data + pos, false);
+
+    Reserve (m_size + 1);
+    new (m_data + m_size) Record (record);
+    std::rotate (m_data + pos, m_data + m_size, m_data + m_size + 1);
+    m_size++;
+    return std::make_pair (m_data + pos, true);
+  }
+
+  void
+  erase (const_iterator record)
+  {
+    Record *pos = m_data + (record - m_data);
+    std::copy (pos + 1, m_data + m_size, pos);
+    m_size--;
+    m_data[m_size].~Record ();
+  }
+
+  size_t
+  erase (Ptr<Face> face)
+  {
+    const_iterator record = find (face);
+    if (record == end ())
+      return 0;
+    erase (record);
+    return 1;
+  }
+
+  void
+  clear ()
+  {
+    for (size_t i = 0; i < m_size; i++)
+      m_data[i].~Record ();
+    m_size = 0;
+  }
+
+private:
+  Record *
+  Inline () { return reinterpret_cast<Record *> (&m_inline); }
+
+  void
+  Reserve (size_t size)
+  {
+    if (size <= m_capacity)
+      return;
+
+    size_t capacity = std::max (size, 2 * m_capacity);
+    Record *data = static_cast<Record *> (::operator new (capacity * sizeof (Record)));
+    std::uninitialized_copy (m_data, m_data + m_size, data);
+    for (size_t i = 0; i < m_size; i++)
+      m_data[i].~Record ();
+    if (m_data != Inline ())
+      ::operator delete (m_data);
+
+    m_data = data;
+    m_capacity = capacity;
+  }
+
+  typename std::aligned_storage<N * sizeof (Record), std::alignment_of<Record>::value>::type m_inline;
+  Record *m_data;
+  size_t m_size;
+  size_t m_capacity;
+};
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_PIT_FACE_RECORDS_H_
@@ -34,6 +34,8 @@
 #include "ns3/ndn-forwarding-strategy.h"
 #include "ns3/ndn-name.h"
 
+#include <boost/intrusive/list.hpp>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -120,6 +122,10 @@ protected:
   void RescheduleCleaning ();
   void CleanExpired ();
 
+  void AddExpiration (entry &item);
+  void RemoveExpiration (entry &item);
+  void Tick ();
+
   // inherited from Object class
   virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
   virtual void DoDispose (); ///< @brief Do cleanup
@@ -151,6 +157,23 @@ private:
                         > time_index;
   time_index i_time;
 
+  // timing wheel, used instead of i_time when m_tick is not zero
+  typedef
+  boost::intrusive::list<entry,
+                         boost::intrusive::member_hook< entry,
+                                                        boost::intrusive::list_member_hook<>,
+                                                        &entry::wheel_hook_>,
+                         boost::intrusive::constant_time_size<false>
+                         > wheel_slot;
+  enum { WHEEL_SLOTS = 512 };
+
+  Time m_tick;
+  std::vector<wheel_slot> m_wheel;   ///< @brief Slot tick % WHEEL_SLOTS holds the entries expiring at that tick (or a later round)
+  int64_t m_nextTick;                ///< @brief Index of the next tick to run
+  uint32_t m_wheelSize;
+  wheel_slot m_expired;              ///< @brief Entries being erased by Tick (wheel_tick_ is -1)
+  EventId m_tickEvent;
+
   friend class EntryImpl< PitImpl >;
 };
 
@@ -182,6 +205,14 @@ PitImpl< Policy >::GetTypeId ()
                    UintegerValue (0),
                    MakeUintegerAccessor (&PitImpl< Policy >::GetCurrentSize),
                    MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("ExpirationTick",
+                   "If not zero, expire PIT entries with a timing wheel ticking at this period: "
+                   "an entry is removed at the first tick not before its expiration time. "
+                   "If zero, every entry is removed at its exact expiration time",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&PitImpl< Policy >::m_tick),
+                   MakeTimeChecker ())
     ;
 
   return tid;
@@ -196,6 +227,8 @@ PitImpl<Policy>::GetCurrentSize () const
 
 template<class Policy>
 PitImpl<Policy>::PitImpl ()
+  : m_nextTick (0)
+  , m_wheelSize (0)
 {
 }
 
@@ -239,6 +272,7 @@ void
 PitImpl<Policy>::DoDispose ()
 {
   super::clear ();
+  Simulator::Cancel (m_tickEvent);
 
   m_forwardingStrategy = 0;
   m_fib = 0;
@@ -298,6 +332,101 @@ PitImpl<Policy>::CleanExpired ()
   RescheduleCleaning ();
 }
 
+template<class Policy>
+void
+PitImpl<Policy>::AddExpiration (entry &item)
+{
+  if (m_tick.IsZero ())
+    {
+      i_time.insert (item);
+      RescheduleCleaning ();
+      return;
+    }
+
+  if (m_wheel.empty ())
+    m_wheel = std::vector<wheel_slot> (WHEEL_SLOTS);
+
+  int64_t tick = m_tick.GetTimeStep ();
+  if (m_wheelSize == 0)
+    {
+      // the wheel stopped: restart it at the current tick
+      m_nextTick = std::max (m_nextTick, (Simulator::Now ().GetTimeStep () + tick - 1) / tick);
+    }
+
+  item.wheel_tick_ = std::max (m_nextTick, (item.GetExpireTime ().GetTimeStep () + tick - 1) / tick);
+  m_wheel[item.wheel_tick_ % WHEEL_SLOTS].push_back (item);
+  m_wheelSize++;
+
+  if (!m_tickEvent.IsRunning ())
+    {
+      m_tickEvent = Simulator::Schedule (TimeStep (m_nextTick * tick) - Simulator::Now (),
+                                         &PitImpl<Policy>::Tick, this);
+    }
+}
+
+template<class Policy>
+void
+PitImpl<Policy>::RemoveExpiration (entry &item)
+{
+  if (m_tick.IsZero ())
+    {
+      i_time.erase (time_index::s_iterator_to (item));
+      RescheduleCleaning ();
+      return;
+    }
+
+  if (!item.wheel_hook_.is_linked ())
+    return;
+
+  if (item.wheel_tick_ < 0)
+    {
+      m_expired.erase (wheel_slot::s_iterator_to (item));
+    }
+  else
+    {
+      m_wheel[item.wheel_tick_ % WHEEL_SLOTS].erase (wheel_slot::s_iterator_to (item));
+      m_wheelSize--;
+    }
+}
+
+template<class Policy>
+void
+PitImpl<Policy>::Tick ()
+{
+  int64_t tick = m_nextTick++;
+  wheel_slot &slot = m_wheel[tick % WHEEL_SLOTS];
+  NS_LOG_LOGIC ("PIT tick " << tick << ". Total: " << m_wheelSize);
+
+  // entries of later rounds stay in the slot
+  for (typename wheel_slot::iterator item = slot.begin (); item != slot.end (); )
+    {
+      if (item->wheel_tick_ <= tick)
+        {
+          entry &stale = *item;
+          item = slot.erase (item);
+          stale.wheel_tick_ = -1;
+          m_expired.push_back (stale);
+          m_wheelSize--;
+        }
+      else
+        item++;
+    }
+
+  while (!m_expired.empty ())
+    {
+      entry &stale = m_expired.front ();
+      m_expired.pop_front ();
+      m_forwardingStrategy->WillEraseTimedOutPendingInterest (stale.to_iterator ()->payload ());
+      super::erase (stale.to_iterator ());
+    }
+
+  if (m_wheelSize > 0 && !m_tickEvent.IsRunning ())
+    {
+      m_tickEvent = Simulator::Schedule (TimeStep (m_nextTick * m_tick.GetTimeStep ()) - Simulator::Now (),
+                                         &PitImpl<Policy>::Tick, this);
+    }
+}
+
 template<class Policy>
 Ptr<Entry>
 PitImpl<Policy>::Lookup (const Data &header)
@@ -15,6 +15,7 @@
 #define NDN_RL_MARL_H
 
 #include "ndn-marl.h"
+#include "ndn-marl-qtable.h"
 #include "ns3/ndn-agent-aggregate.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
@@ -29,7 +30,6 @@
 #include "ns3/string.h"
 #include "ns3/double.h"
 
-#include <unordered_map>
 #include <set>
 #include <algorithm>
 #include <iostream>
@@ -48,7 +48,7 @@ public:
 	static
 	TypeId GetTypeId ();
 
-	MARLnfaImpl(){};
+	MARLnfaImpl():m_epoch(1){};
 
 	virtual
 	~MARLnfaImpl(){};
@@ -85,6 +85,8 @@ public:
 
 	virtual void OutputQStatus(std::fstream* qRecorder);
 	virtual void InputQStatus(std::fstream* qRecorder);
+	virtual void OutputQStatus(QTableWriter& writer, bool incremental);
+	virtual void InputQStatus(const QTableReader& reader);
 private:
 	/*
 	 * Find the Approximate Global Optimum
@@ -93,10 +95,19 @@ private:
 	double ReachOptimum(Ptr<DependentMARLState>);
 	bool UpdateQValue(double optvalue);
 
+	/*
+	 * Fill m_key with the Q-table key of (s, neighbor part of a), return the state length
+	 */
+	uint32_t MakeKey(Ptr<DependentMARLState> s, Ptr<DependentMARLAction> a);
+
 private:
 	double		m_learningrate;
 	double		m_discount;
-	std::unordered_map<QVariable, double, QHasher> m_Qfunc;
+	QTable		m_Qtable;
+	uint32_t	m_epoch;		// Entries updated since the last dump carry this epoch
+
+	std::vector<int8_t>	m_key;			// Scratch buffers, kept to avoid allocations per transition
+	std::vector<int8_t>	m_localaction;
 
 	Ptr<DependentMARLAction>	m_currentaction;
 	Ptr<DependentMARLState>		m_currentstate;
@@ -171,6 +182,8 @@ void MARLnfaImpl<State,Action>::NotifyNewAggregate ()
       m_currentstate = Create<State>(m_node, m_granPlan);
 
       m_csinitpartition = new double [m_node->GetObject<NDNBitRate>()->GetTableSize()];
+      m_Qtable.SetNumBitRates(m_node->GetObject<NDNBitRate>()->GetTableSize());
+      m_localaction.resize(m_node->GetObject<NDNBitRate>()->GetTableSize());
   }
   if (m_cs == 0)
   {
@@ -183,7 +196,7 @@ void MARLnfaImpl<State,Action>::NotifyNewAggregate ()
 template<typename State, typename Action>
 std::size_t MARLnfaImpl<State, Action>::GetQStatus() const
 {
-	return m_Qfunc.size();
+	return m_Qtable.GetSize();
 }
 
 template<typename State, typename Action>
@@ -351,8 +364,17 @@ bool MARLnfaImpl<State,Action>::UpdateCurrentAction(bool exploitation)
 template<typename State, typename Action>
 bool MARLnfaImpl<State,Action>::ManualSetCurrentAction(int up, int down)
 {
-	int8_t* action = new int8_t [m_node->GetObject<NDNBitRate>()->GetTableSize()];
-	for(uint32_t i = 0; i < m_node->GetObject<NDNBitRate>()->GetTableSize(); i++)
+	uint32_t numBR = m_node->GetObject<NDNBitRate>()->GetTableSize();
+	// Moving partition from a bit-rate to itself is not an action of the Q-table
+	if(up >= 0 && down >= 0 && (up == down
+			|| static_cast<uint32_t>(up) >= numBR || static_cast<uint32_t>(down) >= numBR))
+	{
+		NS_LOG_WARN("Invalid manual action: up " << up << ", down " << down);
+		return false;
+	}
+
+	int8_t* action = new int8_t [numBR];
+	for(uint32_t i = 0; i < numBR; i++)
 		action[i] = 0;
 	if(up >= 0 && down >= 0)
 	{
@@ -384,73 +406,44 @@ bool MARLnfaImpl<State,Action>::Transition()
 
 }
 
+template<typename State, typename Action>
+uint32_t MARLnfaImpl<State,Action>::MakeKey(Ptr<DependentMARLState> s, Ptr<DependentMARLAction> a)
+{
+	m_key.clear();
+	QVariable::AppendState(s, m_key);
+	uint32_t stateLen = m_key.size();
+	QVariable::AppendNeighborActions(a, m_key);
+	return stateLen;
+}
+
 template<typename State, typename Action>
 double MARLnfaImpl<State,Action>::ReachOptimum(Ptr<DependentMARLState> probeState)
 {
 	m_lastoptaction->SummarizeNeighborAction(m_experimentalAggregation);
-	uint32_t limit = probeState->GetLocalState()->GetNumBR();
-	int8_t* arr = new int8_t [limit];
-	int8_t* opt_arr = new int8_t [limit];
-	bool entry_in_map = false;
-	double maxvalue;
 
-	for(uint32_t i = 0 ; i< limit; i++)
-	{
-		arr[i] = 0;
-		opt_arr[i] = 0;
-	}
-	m_lastoptaction->SetLocalAction(arr);
-	auto targetQ = m_Qfunc.find(QVariable{m_node, probeState, m_lastoptaction});
-	if(targetQ != m_Qfunc.end())
-	{
-		maxvalue = targetQ->second;
-		entry_in_map = true;
-		for(uint32_t i = 0 ; i< limit; i++)
-			opt_arr[i] = arr[i];
-	}
+	// All the local actions of the state share one row: the argmax is a scan of it.
+	// Ties keep the first action, in the order "keep", then (up i, down j) by i and j.
+	MakeKey(probeState, m_lastoptaction);
+	const QValue* row = m_Qtable.FindRow(m_key.data(), m_key.size());
+	bool entry_in_map = false;
+	double maxvalue = 0;
+	uint32_t opt = 0;
 
-	for(uint32_t i = 0; i < limit; i++)
+	if(row != nullptr)
 	{
-		for(uint32_t j = 0; j < limit; j++)
+		for(uint32_t i = 0; i < m_Qtable.GetNumActions(); i++)
 		{
-			if(i != j)
+			if(QTable::IsSet(row[i]) && (!entry_in_map || row[i].m_value > maxvalue))
 			{
-				arr[i] = 1;
-				arr[j] = -1;
-				m_lastoptaction->SetLocalAction(arr);
-				auto targetQ = m_Qfunc.find(QVariable{m_node, probeState, m_lastoptaction});
-				if(targetQ != m_Qfunc.end())
-				{
-					if(!entry_in_map)
-					{
-						maxvalue = targetQ->second;
-						entry_in_map = true;
-						for(uint32_t k = 0 ; k< limit; k++)
-							opt_arr[k] = arr[k];
-					}
-					else
-					{
-						double instvalue = targetQ->second;
-						if(instvalue > maxvalue)
-						{
-							maxvalue = instvalue;
-							for(uint32_t k = 0 ; k< limit; k++)
-								opt_arr[k] = arr[k];
-						}
-					}
-				}
-				arr[i] = 0;
-				arr[j] = 0;
+				maxvalue = row[i].m_value;
+				opt = i;
+				entry_in_map = true;
 			}
 		}
 	}
-	m_lastoptaction->SetLocalAction(opt_arr);
-	
-	delete [] arr;
-	delete [] opt_arr;
 
-	arr = nullptr;
-	opt_arr = nullptr;
+	m_Qtable.GetAction(opt, m_localaction.data());
+	m_lastoptaction->SetLocalAction(m_localaction.data());
 
 	if(entry_in_map)
 	{
@@ -471,10 +464,12 @@ double MARLnfaImpl<State,Action>::ReachOptimum(Ptr<DependentMARLState> probeStat
 template<typename State, typename Action>
 bool MARLnfaImpl<State,Action>::UpdateQValue(double optvalue)
 {
-	std::unordered_map<QVariable, double, QHasher>::iterator updateQ
-					= m_Qfunc.find(QVariable{m_node, m_currentstate, m_currentaction});
+	uint32_t stateLen = MakeKey(m_currentstate, m_currentaction);
+	int32_t index = m_Qtable.GetActionIndex(m_currentaction->GetLocalAction()->GetChoices());
+	NS_ASSERT_MSG(index >= 0, "Local action is neither keep nor a single up/down move");
+	QValue* row = m_Qtable.FindRow(m_key.data(), m_key.size());
 	bool status;
-	if(updateQ != m_Qfunc.end())
+	if(row != nullptr && QTable::IsSet(row[index]))
 	{
 		/*
 		if(m_node->GetId() == 1)
@@ -484,9 +479,9 @@ bool MARLnfaImpl<State,Action>::UpdateQValue(double optvalue)
 				<< "NextState: " << m_nextstate->GetLocalState()->PrintState() << "\n"
 				<< "NextReqest: " << m_nextstate->GetRequestStatus()->PrintState());
 		*/
-		double Q = updateQ->second;
+		double Q = row[index].m_value;
 		Q = Q + m_learningrate * (m_cs->GetReward() + m_discount * optvalue - Q);
-		updateQ->second = Q;
+		m_Qtable.Set(row[index], Q, m_epoch);
 		status = true;
 		m_visits++;
 	}
@@ -511,8 +506,9 @@ bool MARLnfaImpl<State,Action>::UpdateQValue(double optvalue)
 
 		}
 		*/
-		m_Qfunc[QVariable{m_node, m_currentstate, m_currentaction}] =
-				m_learningrate * (m_cs->GetReward() + m_discount * optvalue);
+		if(row == nullptr)
+			row = m_Qtable.InsertRow(m_key.data(), m_key.size(), stateLen);
+		m_Qtable.Set(row[index], m_learningrate * (m_cs->GetReward() + m_discount * optvalue), m_epoch);
 		status = false;
 	}
 	if(m_log != nullptr)
@@ -523,18 +519,18 @@ bool MARLnfaImpl<State,Action>::UpdateQValue(double optvalue)
 template<typename State, typename Action>
 void MARLnfaImpl<State,Action>::OutputQStatus(std::fstream* qRecorder)
 {
-	auto qPtr = m_Qfunc.begin();
-	for(; qPtr != m_Qfunc.end(); qPtr++)
+	m_Qtable.ForEach([qRecorder](const int8_t* state, uint32_t stateLen,
+								 const int8_t* action, uint32_t actionLen, const QValue& value)
 	{
-		*qRecorder << "S\t" << qPtr->first.m_state_arr.size() << "\t";
-		for(uint32_t i = 0; i < qPtr->first.m_state_arr.size(); i++)
-			*qRecorder << static_cast<int32_t>((qPtr->first.m_state_arr)[i]) << "\t";
-		*qRecorder << "\nA\t" << qPtr->first.m_action_arr.size() << "\t";
-		for(uint32_t i = 0; i < qPtr->first.m_action_arr.size(); i++)
-			*qRecorder << static_cast<int32_t>((qPtr->first.m_action_arr)[i]) << "\t";
+		*qRecorder << "S\t" << stateLen << "\t";
+		for(uint32_t i = 0; i < stateLen; i++)
+			*qRecorder << static_cast<int32_t>(state[i]) << "\t";
+		*qRecorder << "\nA\t" << actionLen << "\t";
+		for(uint32_t i = 0; i < actionLen; i++)
+			*qRecorder << static_cast<int32_t>(action[i]) << "\t";
 		*qRecorder << "\nR\t";
-		*qRecorder << std::fixed << std::setprecision(6) << qPtr->second << std::endl << "!\n";
-	}
+		*qRecorder << std::fixed << std::setprecision(6) << value.m_value << std::endl << "!\n";
+	});
 	*qRecorder << "%\n";
 }
 
@@ -552,7 +548,7 @@ void MARLnfaImpl<State,Action>::InputQStatus(std::fstream* qRecorder)
 		if (line == "%") break;
 		if (line == "!") // Create a QVariable
 		{
-			m_Qfunc[QVariable{state, action}] = reward;
+			m_Qtable.Insert(state.data(), state.size(), action.data(), action.size(), QValue{reward, 0});
 			state.clear();
 			action.clear();
 			reward = 0;
@@ -591,6 +587,41 @@ void MARLnfaImpl<State,Action>::InputQStatus(std::fstream* qRecorder)
 	}
 }
 
+template<typename State, typename Action>
+void MARLnfaImpl<State,Action>::OutputQStatus(QTableWriter& writer, bool incremental)
+{
+	bool begun = false;
+	uint32_t epoch = m_epoch;
+	m_Qtable.ForEach([&](const int8_t* state, uint32_t stateLen,
+						 const int8_t* action, uint32_t actionLen, const QValue& value)
+	{
+		if(incremental && value.m_epoch != epoch)
+			return;
+		// All the keys of the table have the same layout: a single block per node
+		if(!begun)
+		{
+			writer.BeginBlock(m_node->GetId(), stateLen, actionLen);
+			begun = true;
+		}
+		writer.Write(state, action, value.m_value);
+	});
+
+	// Later updates belong to the next checkpoint
+	m_epoch++;
+}
+
+template<typename State, typename Action>
+void MARLnfaImpl<State,Action>::InputQStatus(const QTableReader& reader)
+{
+	const std::vector<QTableReader::Block>& blocks = reader.GetBlocks(m_node->GetId());
+	for(auto block = blocks.begin(); block != blocks.end(); block++)
+	{
+		for(uint64_t i = 0; i < block->m_count; i++)
+			m_Qtable.Insert(block->GetState(i), block->m_stateLen,
+							block->GetAction(i), block->m_actionLen, QValue{block->GetValue(i), 0});
+	}
+}
+
 }
 }
 #endif
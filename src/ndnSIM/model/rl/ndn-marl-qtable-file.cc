@@ -0,0 +1,296 @@
+/*
+ * Binary Q-table file used by MARLHelper
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-marl-qtable-file.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <cerrno>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.rl.marl.QTableFile");
+
+namespace ns3 {
+namespace ndn {
+
+static const char		QTableMagic[8] = {'N', 'D', 'N', 'Q', 'T', 'B', 'L', '\0'};
+static const uint32_t	QTableIncremental = 1;
+
+struct QTableSegmentHeader
+{
+	char		m_magic[8];
+	uint32_t	m_version;
+	uint32_t	m_flags;
+	uint32_t	m_blocks;
+	uint32_t	m_reserved;
+};
+
+struct QTableBlockHeader
+{
+	uint32_t	m_node;
+	uint16_t	m_stateLen;
+	uint16_t	m_actionLen;
+	uint64_t	m_count;
+};
+
+static inline uint32_t
+RecordLength(uint16_t stateLen, uint16_t actionLen)
+{
+	// Keys padded to 8 bytes, so every value is aligned in the mapped file
+	return ((static_cast<uint32_t>(stateLen) + actionLen + 7) & ~7u) + sizeof(double);
+}
+
+static bool
+WriteAll(int fd, const char* data, std::size_t size)
+{
+	while(size > 0)
+	{
+		ssize_t n = write(fd, data, size);
+		if(n < 0)
+		{
+			if(errno == EINTR)
+				continue;
+			return false;
+		}
+		data += n;
+		size -= n;
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+QTableWriter::QTableWriter(bool incremental)
+	:m_buffer(sizeof(QTableSegmentHeader), 0)
+	,m_block(0)
+	,m_recordLen(0)
+	,m_records(0)
+	,m_incremental(incremental)
+{
+	QTableSegmentHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.m_magic, QTableMagic, sizeof(QTableMagic));
+	header.m_version = Version;
+	header.m_flags = incremental ? QTableIncremental : 0;
+	std::memcpy(m_buffer.data(), &header, sizeof(header));
+}
+
+void
+QTableWriter::BeginBlock(uint32_t node, uint16_t stateLen, uint16_t actionLen)
+{
+	QTableBlockHeader block {node, stateLen, actionLen, 0};
+	m_block = m_buffer.size();
+	m_recordLen = RecordLength(stateLen, actionLen);
+	m_buffer.insert(m_buffer.end(), reinterpret_cast<const char*>(&block),
+					reinterpret_cast<const char*>(&block) + sizeof(block));
+
+	QTableSegmentHeader* header = reinterpret_cast<QTableSegmentHeader*>(m_buffer.data());
+	header->m_blocks++;
+}
+
+void
+QTableWriter::Write(const int8_t* state, const int8_t* action, double value)
+{
+	NS_ASSERT_MSG(m_block != 0, "QTableWriter::Write called before BeginBlock");
+
+	QTableBlockHeader* block = reinterpret_cast<QTableBlockHeader*>(m_buffer.data() + m_block);
+	uint16_t stateLen = block->m_stateLen;
+	uint16_t actionLen = block->m_actionLen;
+	block->m_count++;
+	m_records++;
+
+	std::size_t offset = m_buffer.size();
+	m_buffer.resize(offset + m_recordLen, 0);
+	char* record = m_buffer.data() + offset;
+	std::memcpy(record, state, stateLen);
+	std::memcpy(record + stateLen, action, actionLen);
+	std::memcpy(record + m_recordLen - sizeof(double), &value, sizeof(double));
+}
+
+bool
+QTableWriter::Save(const std::string& path) const
+{
+	std::string target = m_incremental ? path : path + ".tmp";
+	int flags = O_WRONLY | O_CREAT | (m_incremental ? O_APPEND : O_TRUNC);
+	int fd = open(target.c_str(), flags, 0644);
+	if(fd < 0)
+	{
+		NS_LOG_ERROR("Q-table " << target << " cannot be opened for writing: " << std::strerror(errno));
+		return false;
+	}
+
+	bool ok = WriteAll(fd, m_buffer.data(), m_buffer.size());
+	ok = (close(fd) == 0) && ok;
+	if(!ok)
+	{
+		NS_LOG_ERROR("Q-table " << target << " cannot be written: " << std::strerror(errno));
+		return false;
+	}
+
+	if(!m_incremental && std::rename(target.c_str(), path.c_str()) != 0)
+	{
+		NS_LOG_ERROR("Q-table " << target << " cannot be renamed to " << path << ": " << std::strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+QTableReader::QTableReader()
+	:m_data(nullptr)
+	,m_size(0)
+	,m_segments(0)
+{
+
+}
+
+QTableReader::~QTableReader()
+{
+	Close();
+}
+
+void
+QTableReader::Close()
+{
+	if(m_data != nullptr)
+		munmap(m_data, m_size);
+	m_data = nullptr;
+	m_size = 0;
+	m_segments = 0;
+	m_blocks.clear();
+}
+
+bool
+QTableReader::Open(const std::string& path)
+{
+	Close();
+
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return false;
+
+	struct stat st;
+	if(fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(QTableSegmentHeader)))
+	{
+		close(fd);
+		return false;
+	}
+
+	m_size = st.st_size;
+	m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(m_data == MAP_FAILED)
+	{
+		NS_LOG_ERROR("Q-table " << path << " cannot be mapped: " << std::strerror(errno));
+		m_data = nullptr;
+		m_size = 0;
+		return false;
+	}
+
+	const char* base = static_cast<const char*>(m_data);
+	std::size_t offset = 0;
+	std::map<uint32_t, std::vector<Block> > blocks;
+
+	while(offset + sizeof(QTableSegmentHeader) <= m_size)
+	{
+		QTableSegmentHeader header;
+		std::memcpy(&header, base + offset, sizeof(header));
+		if(std::memcmp(header.m_magic, QTableMagic, sizeof(QTableMagic)) != 0
+				|| header.m_version != QTableWriter::Version)
+			break;
+
+		// Index the segment aside, so that a truncated one is dropped as a whole
+		std::map<uint32_t, std::vector<Block> > segment;
+		std::size_t pos = offset + sizeof(header);
+		bool complete = true;
+		for(uint32_t i = 0; i < header.m_blocks; i++)
+		{
+			QTableBlockHeader bheader;
+			if(pos + sizeof(bheader) > m_size)
+			{
+				complete = false;
+				break;
+			}
+			std::memcpy(&bheader, base + pos, sizeof(bheader));
+			pos += sizeof(bheader);
+
+			Block block;
+			block.m_node = bheader.m_node;
+			block.m_stateLen = bheader.m_stateLen;
+			block.m_actionLen = bheader.m_actionLen;
+			block.m_count = bheader.m_count;
+			block.m_recordLen = RecordLength(bheader.m_stateLen, bheader.m_actionLen);
+			block.m_records = base + pos;
+
+			if(block.m_count > (m_size - pos) / block.m_recordLen)
+			{
+				complete = false;
+				break;
+			}
+			pos += block.m_count * block.m_recordLen;
+			segment[block.m_node].push_back(block);
+		}
+
+		if(!complete)
+		{
+			NS_LOG_WARN("Q-table " << path << ": truncated segment at byte " << offset << " ignored");
+			break;
+		}
+
+		for(auto iter = segment.begin(); iter != segment.end(); iter++)
+		{
+			std::vector<Block>& target = blocks[iter->first];
+			target.insert(target.end(), iter->second.begin(), iter->second.end());
+		}
+		m_segments++;
+		offset = pos;
+	}
+
+	if(m_segments == 0)
+	{
+		NS_LOG_ERROR("File " << path << " is not a Q-table file");
+		Close();
+		return false;
+	}
+	if(offset != m_size)
+		NS_LOG_WARN("Q-table " << path << ": " << m_size - offset << " trailing bytes ignored");
+
+	m_blocks.swap(blocks);
+	madvise(m_data, m_size, MADV_SEQUENTIAL);
+	return true;
+}
+
+const std::vector<QTableReader::Block>&
+QTableReader::GetBlocks(uint32_t node) const
+{
+	static const std::vector<Block> empty;
+	auto iter = m_blocks.find(node);
+	return (iter == m_blocks.end()) ? empty : iter->second;
+}
+
+bool
+QTableReader::IsQTableFile(const std::string& path)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return false;
+	char magic[sizeof(QTableMagic)];
+	bool match = (read(fd, magic, sizeof(magic)) == static_cast<ssize_t>(sizeof(magic)))
+				&& std::memcmp(magic, QTableMagic, sizeof(magic)) == 0;
+	close(fd);
+	return match;
+}
+
+} // namespace ndn
+} // namespace ns3
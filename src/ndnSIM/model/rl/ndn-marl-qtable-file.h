@@ -0,0 +1,136 @@
+/*
+ * Binary Q-table file used by MARLHelper to save and warm start the MARL agents
+ *
+ * A file is a sequence of segments. The first segment of a snapshot holds the
+ * whole table; checkpoints append segments holding only the entries updated
+ * since the previous dump, and later segments override earlier ones.
+ *
+ * Segment:	"NDNQTBL\0" | uint32 version | uint32 flags | uint32 #blocks | uint32 reserved
+ * Block:	uint32 node | uint16 state length | uint16 action length | uint64 #records
+ * Record:	int8 state[] | int8 action[] | zero padding to 8 bytes | double value
+ *
+ * Records of a block have a fixed width, so the reader maps the file and walks
+ * it without parsing. Integers and doubles are stored in host byte order.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_RL_MARL_QTABLE_FILE_H
+#define NDN_RL_MARL_QTABLE_FILE_H
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+class QTableWriter
+{
+public:
+	static const uint32_t Version = 1;
+
+	/*
+	 * incremental: the segment is a checkpoint to be appended to an existing file
+	 */
+	QTableWriter(bool incremental);
+
+	/*
+	 * Start the records of one node. Every record written until the next call
+	 * has the same state and action lengths.
+	 */
+	void BeginBlock(uint32_t node, uint16_t stateLen, uint16_t actionLen);
+
+	void Write(const int8_t* state, const int8_t* action, double value);
+
+	inline uint64_t GetNumRecords() const
+	{
+		return m_records;
+	}
+
+	/*
+	 * A full table replaces 'path' atomically (written to <path>.tmp, then renamed);
+	 * a checkpoint is appended to it. Return false if the file cannot be written.
+	 */
+	bool Save(const std::string& path) const;
+
+private:
+	std::vector<char>	m_buffer;
+	std::size_t			m_block;		// Offset of the current block header, 0 if none
+	uint32_t			m_recordLen;
+	uint64_t			m_records;
+	bool				m_incremental;
+};
+
+class QTableReader
+{
+public:
+	struct Block
+	{
+		uint32_t		m_node;
+		uint16_t		m_stateLen;
+		uint16_t		m_actionLen;
+		uint64_t		m_count;
+		uint32_t		m_recordLen;
+		const char*		m_records;
+
+		inline const int8_t* GetState(uint64_t i) const
+		{
+			return reinterpret_cast<const int8_t*>(m_records + i * m_recordLen);
+		}
+
+		inline const int8_t* GetAction(uint64_t i) const
+		{
+			return GetState(i) + m_stateLen;
+		}
+
+		inline double GetValue(uint64_t i) const
+		{
+			double value;
+			std::memcpy(&value, m_records + (i + 1) * m_recordLen - sizeof(double), sizeof(double));
+			return value;
+		}
+	};
+
+	QTableReader();
+	~QTableReader();
+
+	/*
+	 * Map the file and index its blocks. A truncated trailing segment (e.g. an
+	 * interrupted checkpoint) is ignored. Return false if the file does not exist
+	 * or is not a Q-table file.
+	 */
+	bool Open(const std::string& path);
+	void Close();
+
+	/*
+	 * Blocks of one node in file order
+	 */
+	const std::vector<Block>& GetBlocks(uint32_t node) const;
+
+	inline uint32_t GetNumSegments() const
+	{
+		return m_segments;
+	}
+
+	/*
+	 * Check the magic of the file, to tell it from the text format
+	 */
+	static bool IsQTableFile(const std::string& path);
+
+private:
+	QTableReader(const QTableReader&);
+	QTableReader& operator=(const QTableReader&);
+
+	void*			m_data;
+	std::size_t		m_size;
+	uint32_t		m_segments;
+	std::map<uint32_t, std::vector<Block> >	m_blocks;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
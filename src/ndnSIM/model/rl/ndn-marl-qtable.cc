@@ -0,0 +1,241 @@
+/*
+ * Q-table of one MARL agent
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-marl-qtable.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <cstring>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.rl.marl.QTable");
+
+namespace ns3 {
+namespace ndn {
+
+static const std::size_t QTableInitialSlots = 64;
+
+QTable::QTable()
+	:m_numBR(0)
+	,m_numActions(1)
+	,m_stateLen(0)
+	,m_keyLen(0)
+	,m_keyWords(0)
+	,m_rows(0)
+	,m_entries(0)
+	,m_mask(0)
+{
+
+}
+
+void
+QTable::SetNumBitRates(uint32_t num)
+{
+	NS_ASSERT_MSG(m_rows == 0, "Number of bit-rates changed on a non-empty Q-table");
+	m_numBR = num;
+	m_numActions = 1 + num * (num - 1);
+}
+
+int32_t
+QTable::GetActionIndex(const int8_t* local) const
+{
+	int32_t up = -1;
+	int32_t down = -1;
+	for(uint32_t i = 0; i < m_numBR; i++)
+	{
+		if(local[i] == 1 && up < 0)
+			up = i;
+		else if(local[i] == -1 && down < 0)
+			down = i;
+		else if(local[i] != 0)
+			return -1;
+	}
+	if(up < 0 && down < 0)
+		return 0;
+	if(up < 0 || down < 0)
+		return -1;
+	return 1 + up * (m_numBR - 1) + (down < up ? down : down - 1);
+}
+
+void
+QTable::GetAction(uint32_t index, int8_t* local) const
+{
+	for(uint32_t i = 0; i < m_numBR; i++)
+		local[i] = 0;
+	if(index == 0)
+		return;
+	uint32_t up = (index - 1) / (m_numBR - 1);
+	uint32_t down = (index - 1) % (m_numBR - 1);
+	local[up] = 1;
+	local[down < up ? down : down + 1] = -1;
+}
+
+uint64_t
+QTable::Pack(const int8_t* key, uint32_t keyLen) const
+{
+	uint32_t words = (keyLen + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+	if(words == 0)
+		words = 1;
+	if(m_probe.size() < words)
+		m_probe.resize(words);
+	m_probe[words - 1] = 0;
+	std::memcpy(m_probe.data(), key, keyLen);
+
+	// Multiply-xorshift mixing of every word, then the 64-bit finalizer of MurmurHash3
+	uint64_t h = keyLen;
+	for(uint32_t i = 0; i < words; i++)
+	{
+		h ^= m_probe[i];
+		h *= 0x9E3779B97F4A7C15ULL;
+		h ^= h >> 29;
+	}
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ULL;
+	h ^= h >> 33;
+
+	return h | 1;	// 0 marks the empty slots
+}
+
+std::size_t
+QTable::Probe(uint64_t tag) const
+{
+	std::size_t slot = tag & m_mask;
+	while(m_tags[slot] != 0)
+	{
+		if(m_tags[slot] == tag
+				&& std::memcmp(&m_keys[slot * m_keyWords], m_probe.data(), m_keyWords * sizeof(uint64_t)) == 0)
+			return slot;
+		slot = (slot + 1) & m_mask;
+	}
+	return slot;
+}
+
+const QValue*
+QTable::FindRow(const int8_t* key, uint32_t keyLen) const
+{
+	if(m_rows == 0 || keyLen != m_keyLen)
+		return nullptr;
+
+	std::size_t slot = Probe(Pack(key, keyLen));
+	return (m_tags[slot] == 0) ? nullptr : &m_values[slot * m_numActions];
+}
+
+QValue*
+QTable::FindRow(const int8_t* key, uint32_t keyLen)
+{
+	return const_cast<QValue*>(static_cast<const QTable*>(this)->FindRow(key, keyLen));
+}
+
+QValue*
+QTable::InsertRow(const int8_t* key, uint32_t keyLen, uint32_t stateLen)
+{
+	NS_ASSERT_MSG(m_numBR > 1, "QTable::SetNumBitRates not called");
+	if(m_rows == 0 && m_tags.empty())
+	{
+		m_stateLen = stateLen;
+		m_keyLen = keyLen;
+		m_keyWords = (keyLen == 0) ? 1 : (keyLen + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+		m_tags.assign(QTableInitialSlots, 0);
+		m_keys.assign(QTableInitialSlots * m_keyWords, 0);
+		m_values.assign(QTableInitialSlots * m_numActions,
+						QValue{std::numeric_limits<double>::quiet_NaN(), 0});
+		m_mask = QTableInitialSlots - 1;
+	}
+	NS_ASSERT_MSG(keyLen == m_keyLen && stateLen == m_stateLen,
+				"Q-table key of " << stateLen << "+" << keyLen - stateLen << " bytes, expected "
+				<< m_stateLen << "+" << m_keyLen - m_stateLen);
+
+	uint64_t tag = Pack(key, keyLen);
+	std::size_t slot = Probe(tag);
+	if(m_tags[slot] != 0)
+		return &m_values[slot * m_numActions];
+
+	// Keep the load factor under 3/4
+	if((m_rows + 1) * 4 > m_tags.size() * 3)
+	{
+		Grow();
+		slot = Probe(tag);
+	}
+
+	m_tags[slot] = tag;
+	std::memcpy(&m_keys[slot * m_keyWords], m_probe.data(), m_keyWords * sizeof(uint64_t));
+	m_rows++;
+	return &m_values[slot * m_numActions];
+}
+
+void
+QTable::Grow()
+{
+	std::size_t slots = m_tags.size() * 2;
+	std::vector<uint64_t> tags(slots, 0);
+	std::vector<uint64_t> keys(slots * m_keyWords, 0);
+	std::vector<QValue> values(slots * m_numActions, QValue{std::numeric_limits<double>::quiet_NaN(), 0});
+	std::size_t mask = slots - 1;
+
+	for(std::size_t old = 0; old < m_tags.size(); old++)
+	{
+		if(m_tags[old] == 0)
+			continue;
+		// Keys are distinct, so no key comparison is needed here
+		std::size_t slot = m_tags[old] & mask;
+		while(tags[slot] != 0)
+			slot = (slot + 1) & mask;
+		tags[slot] = m_tags[old];
+		std::memcpy(&keys[slot * m_keyWords], &m_keys[old * m_keyWords], m_keyWords * sizeof(uint64_t));
+		std::memcpy(&values[slot * m_numActions], &m_values[old * m_numActions], m_numActions * sizeof(QValue));
+	}
+
+	m_tags.swap(tags);
+	m_keys.swap(keys);
+	m_values.swap(values);
+	m_mask = mask;
+}
+
+bool
+QTable::Insert(const int8_t* state, uint32_t stateLen,
+			   const int8_t* action, uint32_t actionLen, const QValue& value)
+{
+	if(actionLen < m_numBR)
+	{
+		NS_LOG_WARN("Q-table entry with a " << actionLen << " byte action dropped");
+		return false;
+	}
+	uint32_t keyLen = stateLen + actionLen - m_numBR;
+	if(m_rows > 0 && (stateLen != m_stateLen || keyLen != m_keyLen))
+	{
+		NS_LOG_WARN("Q-table entry of " << stateLen << "/" << actionLen << " bytes does not fit the table");
+		return false;
+	}
+	int32_t index = GetActionIndex(action);
+	if(index < 0)
+	{
+		NS_LOG_WARN("Q-table entry with an invalid local action dropped");
+		return false;
+	}
+
+	m_key.assign(state, state + stateLen);
+	m_key.insert(m_key.end(), action + m_numBR, action + actionLen);
+	QValue* row = InsertRow(m_key.data(), keyLen, stateLen);
+	Set(row[index], value.m_value, value.m_epoch);
+	return true;
+}
+
+void
+QTable::Clear()
+{
+	m_tags.clear();
+	m_keys.clear();
+	m_values.clear();
+	m_rows = 0;
+	m_entries = 0;
+	m_mask = 0;
+}
+
+} // namespace ndn
+} // namespace ns3
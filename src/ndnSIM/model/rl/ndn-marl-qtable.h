@@ -0,0 +1,161 @@
+/*
+ * Q-table of one MARL agent
+ *
+ * The local action of an agent is either "keep" (all 0) or moves one step of
+ * partition from one bit-rate to another (a single +1/-1 pair), so a state has
+ * 1 + n(n-1) actions for n bit-rates. Everything else in a Q-function key
+ * (state vector and neighbor actions) is packed into fixed-width 64-bit words
+ * and indexes a row holding the values of all the local actions.
+ *
+ * Rows live in an open-addressing table (linear probing, power-of-two size);
+ * tags, keys and rows are stored in flat arrays, so a lookup touches a few
+ * contiguous cache lines and the argmax over the local actions is a scan of
+ * one row.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_RL_MARL_QTABLE_H
+#define NDN_RL_MARL_QTABLE_H
+
+#include "ndn-marl-qvar.h"
+
+#include <stdint.h>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class QTable
+{
+public:
+	QTable();
+
+	/*
+	 * Length of the local action vector; must be set before the first row is added
+	 */
+	void SetNumBitRates(uint32_t num);
+
+	/*
+	 * Number of local actions (entries of a row)
+	 */
+	inline uint32_t GetNumActions() const
+	{
+		return m_numActions;
+	}
+
+	/*
+	 * Number of Q-values set
+	 */
+	inline std::size_t GetSize() const
+	{
+		return m_entries;
+	}
+
+	inline std::size_t GetNumRows() const
+	{
+		return m_rows;
+	}
+
+	/*
+	 * Entry of the row of a local action, -1 if 'local' is not a valid local action
+	 * Entry 0 is "keep"; up i / down j follows in the order (0,1), (0,2) ... (1,0), (1,2) ...
+	 */
+	int32_t GetActionIndex(const int8_t* local) const;
+	void GetAction(uint32_t index, int8_t* local) const;
+
+	/*
+	 * key: state vector followed by the neighbor part of the action vector
+	 * Return the row (GetNumActions() entries) of the key, nullptr if the key is unseen
+	 */
+	const QValue* FindRow(const int8_t* key, uint32_t keyLen) const;
+	QValue* FindRow(const int8_t* key, uint32_t keyLen);
+
+	/*
+	 * Return the row of the key, adding a row of unset entries if the key is unseen.
+	 * The lengths of the first key are kept for all the following ones.
+	 * The pointer is valid until the next row is added.
+	 */
+	QValue* InsertRow(const int8_t* key, uint32_t keyLen, uint32_t stateLen);
+
+	static inline bool IsSet(const QValue& entry)
+	{
+		return !std::isnan(entry.m_value);
+	}
+
+	inline void Set(QValue& entry, double value, uint32_t epoch)
+	{
+		if(!IsSet(entry))
+			m_entries++;
+		entry.m_value = value;
+		entry.m_epoch = epoch;
+	}
+
+	/*
+	 * Set the value of a full (state, action) pair as stored in the Q-table files
+	 * Return false if the lengths or the local action do not fit the table
+	 */
+	bool Insert(const int8_t* state, uint32_t stateLen,
+				const int8_t* action, uint32_t actionLen, const QValue& value);
+
+	/*
+	 * Call f(state, stateLen, action, actionLen, value) on every entry set
+	 */
+	template<typename F>
+	void ForEach(F f) const;
+
+	void Clear();
+
+private:
+	uint64_t Pack(const int8_t* key, uint32_t keyLen) const;	// Fill m_probe, return the tag
+	std::size_t Probe(uint64_t tag) const;						// Slot of m_probe or the empty slot to take
+	void Grow();
+
+	uint32_t		m_numBR;
+	uint32_t		m_numActions;
+
+	uint32_t		m_stateLen;		// Fixed by the first row
+	uint32_t		m_keyLen;
+	uint32_t		m_keyWords;
+
+	std::size_t		m_rows;
+	std::size_t		m_entries;
+	std::size_t		m_mask;			// Number of slots - 1
+
+	std::vector<uint64_t>	m_tags;		// 0: empty slot
+	std::vector<uint64_t>	m_keys;		// m_keyWords per slot
+	std::vector<QValue>		m_values;	// m_numActions per slot
+
+	mutable std::vector<uint64_t>	m_probe;	// Packed key being looked up
+	std::vector<int8_t>				m_key;		// Key assembled by Insert
+};
+
+template<typename F>
+void QTable::ForEach(F f) const
+{
+	std::vector<int8_t> key(m_keyWords * sizeof(uint64_t));
+	std::vector<int8_t> action(m_numBR + m_keyLen - m_stateLen);
+	for(std::size_t slot = 0; slot < m_tags.size(); slot++)
+	{
+		if(m_tags[slot] == 0)
+			continue;
+		std::memcpy(key.data(), &m_keys[slot * m_keyWords], key.size());
+		std::memcpy(action.data() + m_numBR, key.data() + m_stateLen, m_keyLen - m_stateLen);
+
+		const QValue* row = &m_values[slot * m_numActions];
+		for(uint32_t i = 0; i < m_numActions; i++)
+		{
+			if(!IsSet(row[i]))
+				continue;
+			GetAction(i, action.data());
+			f(key.data(), m_stateLen, action.data(), static_cast<uint32_t>(action.size()), row[i]);
+		}
+	}
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
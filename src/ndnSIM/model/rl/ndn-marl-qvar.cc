@@ -9,6 +9,20 @@ namespace ndn {
 
 QVariable::QVariable(Ptr<Node> nodeptr,
 		Ptr<DependentMARLState> s, Ptr<DependentMARLAction> a)
+{
+	AppendState(s, m_state_arr);
+
+	ns3::Ptr<const ns3::ndn::BasicMARLAction> aptr = a->GetLocalAction();
+	const int8_t* aarr = aptr->GetChoices();
+
+	for(uint32_t i = 0; i < aptr->GetNumBR(); i++)
+		m_action_arr.push_back(aarr[i]);
+
+	AppendNeighborActions(a, m_action_arr);
+}
+
+void
+QVariable::AppendState(Ptr<const DependentMARLState> s, std::vector<int8_t>& arr)
 {
 	Ptr<const ns3::ndn::BasicMARLState> sptr;
 	const int* sarr;
@@ -17,14 +31,14 @@ QVariable::QVariable(Ptr<Node> nodeptr,
 	sarr = sptr->GetIntPartition();
 
 	for(uint32_t i = 0; i < sptr->GetNumBR(); i++)
-		m_state_arr.push_back(sarr[i]);
+		arr.push_back(sarr[i]);
 
 
 	sptr = s->GetRequestStatus();
 	sarr = sptr->GetIntPartition();
 
 	for(uint32_t i = 0; i < sptr->GetNumBR(); i++)
-		m_state_arr.push_back(sarr[i]);
+		arr.push_back(sarr[i]);
 
 	auto siter = s->GetNeighborStates().find(s->GetAgentID());
 	if(siter != s->GetNeighborStates().end())
@@ -33,7 +47,7 @@ QVariable::QVariable(Ptr<Node> nodeptr,
 		sarr = sptr->GetIntPartition();
 
 		for(uint32_t i = 0; i < sptr->GetNumBR(); i++)
-			m_state_arr.push_back(sarr[i]);
+			arr.push_back(sarr[i]);
 
 	}
 	else
@@ -44,20 +58,17 @@ QVariable::QVariable(Ptr<Node> nodeptr,
 			sarr = sptr->GetIntPartition();
 
 			for(uint32_t i = 0; i < sptr->GetNumBR(); i++)
-				m_state_arr.push_back(sarr[i]);
+				arr.push_back(sarr[i]);
 		}
 	}
+}
 
+void
+QVariable::AppendNeighborActions(Ptr<const DependentMARLAction> a, std::vector<int8_t>& arr)
+{
 	ns3::Ptr<const ns3::ndn::BasicMARLAction> aptr;
 	const int8_t* aarr;
 
-	aptr = a->GetLocalAction();
-	aarr = aptr->GetChoices();
-
-	for(uint32_t i = 0; i < aptr->GetNumBR(); i++)
-		m_action_arr.push_back(aarr[i]);
-
-
 	auto aiter = a->GetNeighborActions().find(a->GetAgentID());
 	if(aiter != a->GetNeighborActions().end())
 	{
@@ -65,7 +76,7 @@ QVariable::QVariable(Ptr<Node> nodeptr,
 		aarr = aptr->GetChoices();
 
 		for(uint32_t i = 0; i < aptr->GetNumBR(); i++)
-			m_action_arr.push_back(aarr[i]);
+			arr.push_back(aarr[i]);
 
 	}
 	else
@@ -76,7 +87,7 @@ QVariable::QVariable(Ptr<Node> nodeptr,
 			aarr = aptr->GetChoices();
 
 			for(uint32_t i = 0; i < aptr->GetNumBR(); i++)
-				m_action_arr.push_back(aarr[i]);
+				arr.push_back(aarr[i]);
 		}
 	}
 }
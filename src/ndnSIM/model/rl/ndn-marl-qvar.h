@@ -31,6 +31,16 @@ public:
 	~QVariable();
 	bool operator==(const QVariable& index) const;
 
+	/*
+	 * Append the state vector of 's' (local, request, then neighbor states) to 'arr'
+	 */
+	static void AppendState(Ptr<const DependentMARLState> s, std::vector<int8_t>& arr);
+
+	/*
+	 * Append the neighbor part of the action vector of 'a' (what follows the local action) to 'arr'
+	 */
+	static void AppendNeighborActions(Ptr<const DependentMARLAction> a, std::vector<int8_t>& arr);
+
 	std::vector<int8_t> 	m_state_arr;
 	std::vector<int8_t> 	m_action_arr;
 };
@@ -40,6 +50,17 @@ struct QHasher
 	std::size_t operator()(const QVariable& index) const;
 };
 
+/*
+ * Entry of the Q-table. m_epoch tells which checkpoint the entry was last
+ * updated in, so that a checkpoint only dumps the entries changed since the
+ * previous one (0: loaded from a file, never updated).
+ */
+struct QValue
+{
+	double		m_value;
+	uint32_t	m_epoch;
+};
+
 }
 }
 #endif
@@ -5,6 +5,7 @@
  */
 
 #include <ns3/ndn-marl-qvar.h>
+#include "ns3/ndn-marl-qtable-file.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/node.h"
@@ -79,6 +80,20 @@ public:
 
 	}
 
+	/*
+	 * Binary Q-table (see ndn-marl-qtable-file.h)
+	 * incremental: only dump the entries updated since the previous dump
+	 */
+	virtual inline void OutputQStatus(QTableWriter& writer, bool incremental)
+	{
+
+	}
+
+	virtual inline void InputQStatus(const QTableReader& reader)
+	{
+
+	}
+
 protected:
 	bool				m_newstart;
 	bool				m_experimentalAggregation;		// Apply aggressive aggregation
@@ -1,8 +1,12 @@
 #include "ndn-bitrate.h"
 #include "ns3/log.h"
 #include "ns3/double.h"
+#include "ns3/name.h"
+#include "ns3/name-component.h"
+#include "ns3/unused.h"
 
 #include <algorithm>
+#include <cstring>
 
 NS_LOG_COMPONENT_DEFINE("ndn.VideoBitRate");
 
@@ -11,6 +15,21 @@ namespace ndn{
 
 NS_OBJECT_ENSURE_REGISTERED(NDNBitRate);
 
+namespace {
+struct InternedBitRate
+{
+	std::string m_rate;			// "1000kbps"
+	std::string m_component;	// "br1000kbps"
+};
+
+std::vector<InternedBitRate>&
+GetInternTable()
+{
+	static std::vector<InternedBitRate> table;
+	return table;
+}
+}
+
 
 TypeId
 NDNBitRate::GetTypeId()
@@ -63,6 +82,12 @@ NDNBitRate::AddBitRate(const std::string& br)
 	m_size[br] = size;
 	m_totalsize += size;
 	m_bitrates.push_back(br);
+	m_ranksize.push_back(size);
+
+	uint32_t rank = InternBitRate(br);
+	NS_ASSERT_MSG(GetRankFromBR(br) == rank,
+			"Bitrates must be added in the same order on every node (" << br << ")");
+	NS_UNUSED(rank);
 }
 
 double
@@ -149,6 +174,18 @@ NDNBitRate::GetNextLowBitrate(uint32_t rank)
 	return nextbr;
 }
 
+double
+NDNBitRate::GetChunkSizeFromRank(uint32_t rank)
+{
+	// Rank 0 is an unknown bitrate, which has no chunk size (as GetChunkSize)
+	if(rank < 1 || rank > m_ranksize.size())
+	{
+		NS_LOG_ERROR("No chunk size for bitrate rank " << rank);
+		return 0;
+	}
+	return m_ranksize[rank - 1];
+}
+
 double
 NDNBitRate::GetRewardFromRank(uint32_t rank)
 {
@@ -157,6 +194,73 @@ NDNBitRate::GetRewardFromRank(uint32_t rank)
 	return s * 10 / m_totalsize;
 }
 
+uint32_t
+NDNBitRate::InternBitRate(const std::string& br)
+{
+	uint32_t rank = LookupRank(br);
+	if(rank == 0)
+	{
+		std::vector<InternedBitRate>& table = GetInternTable();
+		table.push_back(InternedBitRate {br, "br" + br});
+		rank = table.size();
+	}
+	return rank;
+}
+
+uint32_t
+NDNBitRate::LookupRank(const std::string& br)
+{
+	const std::vector<InternedBitRate>& table = GetInternTable();
+	for(uint32_t i = 0; i < table.size(); i++)
+	{
+		if(table[i].m_rate == br || table[i].m_component == br)
+			return i + 1;
+	}
+	return 0;
+}
+
+uint32_t
+NDNBitRate::LookupRank(const name::Component& comp)
+{
+	/* Compare raw bytes of the component; no string is built on this path */
+	const std::vector<InternedBitRate>& table = GetInternTable();
+	for(uint32_t i = 0; i < table.size(); i++)
+	{
+		const std::string& c = table[i].m_component;
+		if(c.size() == comp.size() && std::memcmp(c.data(), comp.buf(), c.size()) == 0)
+			return i + 1;
+	}
+	return 0;
+}
+
+uint32_t
+NDNBitRate::ExtractRank(const Name& name)
+{
+	/* The bitrate always sits three components from the end of a video name */
+	if(name.size() < 3)
+		return 0;
+	return LookupRank(name.get(-3));
+}
+
+const std::string&
+NDNBitRate::GetInternedBitRate(uint32_t rank)
+{
+	static const std::string unknown;
+	const std::vector<InternedBitRate>& table = GetInternTable();
+	if(rank < 1 || rank > table.size())
+		return unknown;
+	return table[rank - 1].m_rate;
+}
+
+const std::string&
+NDNBitRate::GetInternedComponent(uint32_t rank)
+{
+	static const std::string unknown;
+	const std::vector<InternedBitRate>& table = GetInternTable();
+	if(rank < 1 || rank > table.size())
+		return unknown;
+	return table[rank - 1].m_component;
+}
 
 }
 }
@@ -16,6 +16,10 @@
 namespace ns3{
 namespace ndn{
 
+class Name;
+namespace name {
+class Component;
+}
 
 class NDNBitRate : public Object
 {
@@ -40,6 +44,7 @@ public:
 
 	uint32_t 	GetRankFromBR(std::string br);
 	const std::string&	GetBRFromRank(uint32_t);
+	double		GetChunkSizeFromRank(uint32_t rank);
 
 	std::string	GetNextHighBitrate(uint32_t rank);
 	std::string	GetNextLowBitrate(uint32_t rank);
@@ -47,6 +52,19 @@ public:
 
 	double GetRewardFromRank(uint32_t rank);
 
+	/*
+	 * Bitrates are interned once for the whole simulation when they are added to a node.
+	 * The interned rank (starting from 1) follows the insertion order, so it matches
+	 * GetRankFromBR() on every node sharing the same bitrate table and can be used as a
+	 * compact key (see VideoIndex) instead of the bitrate string. Rank 0 means unknown.
+	 */
+	static uint32_t 			InternBitRate(const std::string& br);
+	static uint32_t 			LookupRank(const std::string& br);		// Accept both "1000kbps" and "br1000kbps"
+	static uint32_t 			LookupRank(const name::Component& comp);	// Name component "br1000kbps"
+	static uint32_t 			ExtractRank(const Name& name);			// Video name /prefix/br<rate>/<file>/<chunk>
+	static const std::string&	GetInternedBitRate(uint32_t rank);		// "1000kbps"
+	static const std::string&	GetInternedComponent(uint32_t rank);	// "br1000kbps"
+
 protected:
   virtual void NotifyNewAggregate ();
   virtual void DoDispose (); ///< @brief Do cleanup
@@ -59,6 +77,7 @@ private:
 
   std::map<std::string, double> m_size; // Unit: K-Byte
   std::vector<std::string>		m_bitrates;
+  std::vector<double>			m_ranksize; // Chunk size indexed by (rank - 1)
 
 private:
   double CalChunkSize(const std::string&);
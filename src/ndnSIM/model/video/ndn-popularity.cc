@@ -83,15 +83,11 @@ void PopularitySummary::NotifyNewAggregate()
 void PopularitySummary::SummarizeToBitrate()
 {
 	try{
-		double sum = 0;
-		for (auto iter_bitrate = m_bitrate_stat.begin(); iter_bitrate != m_bitrate_stat.end(); iter_bitrate++)
+		double sum = m_bitrate_stat.Sum();
+		m_bitrate_stat.ForEach([this, sum](uint32_t rank, uint64_t count)
 		{
-			sum += iter_bitrate->second;
-		}
-		for (auto iter_bitrate = m_bitrate_stat.begin(); iter_bitrate != m_bitrate_stat.end(); iter_bitrate++)
-		{
-			m_bitrate_dis[iter_bitrate->first] = iter_bitrate->second / sum;
-		}
+			m_bitrate_dis[rank] = count / sum;
+		});
 	}
 	catch (std::overflow_error& e)
 	{
@@ -105,15 +101,11 @@ void PopularitySummary::SummarizeToFile()
 {
 	try
 	{
-		double sum = 0;
-		for (auto iter = m_file_stat.begin(); iter != m_file_stat.end(); iter++)
+		double sum = m_file_stat.Sum();
+		m_file_dis.Assign(m_file_stat, [sum](uint64_t count)
 		{
-			sum += iter->second;
-		}
-		for (auto iter = m_file_stat.begin(); iter != m_file_stat.end(); iter++)
-		{
-			m_file_dis[iter->first] = iter->second / sum;
-		}
+			return count / sum;
+		});
 	}
 	catch (std::overflow_error& e)
 	{
@@ -127,7 +119,7 @@ void PopularitySummary::SummarizeToChunk()
 		/* maximum liklihood to estimate the parameter in Geometirc Distribution */
 		uint64_t weightsum = 0;
 		uint64_t start = 1;
-		while (m_chunk_stat.find(start + 1) != m_chunk_stat.end())
+		while (m_chunk_stat.Contains(start + 1))
 		{
 			weightsum += (m_chunk_stat[start] - m_chunk_stat[start + 1]) * start;
 			start++;
@@ -146,6 +138,13 @@ void PopularitySummary::Summarize()
 	if(IsEdge)
 	{
 		NS_LOG_DEBUG("Summarize statistics on edge nodeID:" << m_node->GetId());
+		/* The table holds the top-K chunks only: keep the ids it names, not arrays up to them */
+		if(m_statptr->IsApproximate())
+		{
+			m_file_stat.SetSparse();
+			m_chunk_stat.SetSparse();
+			m_file_dis.SetSparse();
+		}
 		auto iter = m_statptr->GetTable().begin();
 		for(; iter != m_statptr->GetTable().end(); iter++)
 		{
@@ -153,7 +152,7 @@ void PopularitySummary::Summarize()
 			if (iter->first.m_chunk == 1)
 				m_file_stat[iter->first.m_file] += iter->second;
 			m_chunk_stat[iter->first.m_chunk] += iter->second;
-			m_bitrate_stat[iter->first.m_bitrate] += iter->second;
+			m_bitrate_stat[iter->first.m_rank] += iter->second;
 		}
 
 		/* Summarize to Bitrate Distribution */
@@ -173,20 +172,14 @@ PopularitySummary::SenseVideoRequest(uint32_t s, double* ratio)
 	ForMARLonly = true;
 	auto iter = m_statptr->GetTable().begin();
 	for(; iter != m_statptr->GetTable().end(); iter++)
-		m_bitrate_stat[iter->first.m_bitrate] += iter->second;
+		m_bitrate_stat[iter->first.m_rank] += iter->second;
 
 	/* Summarize to Bitrate Distribution */
 	SummarizeToBitrate();
 
-	Ptr<NDNBitRate> BRinfo = m_node->GetObject<NDNBitRate>();
 	for(uint32_t i = 0; i < s; i++)
 	{
-		std::string idx = "br" + BRinfo->GetBRFromRank(i + 1);
-		auto briter = m_bitrate_dis.find(idx);
-		if(briter != m_bitrate_dis.end())
-			ratio[i] = briter->second;
-		else
-			ratio[i] = 0;
+		ratio[i] = m_bitrate_dis.Get(i + 1);
 	}
 	return true;
 }
@@ -194,10 +187,7 @@ PopularitySummary::SenseVideoRequest(uint32_t s, double* ratio)
 void PopularitySummary::AggregateToFile(const PopularitySummary& PS)
 {
 	try{
-		for (auto iter = PS.m_file_stat.begin(); iter != PS.m_file_stat.end(); iter++)
-		{
-			m_file_stat[iter->first] += iter->second;
-		}
+		m_file_stat.Merge(PS.m_file_stat);
 		SummarizeToFile();
 	}
 	catch (std::overflow_error& e)
@@ -209,34 +199,27 @@ void PopularitySummary::AggregateToFile(const PopularitySummary& PS)
 void PopularitySummary::AggregateToBitrate(const PopularitySummary& PS)
 {
 	try{
-		double sum_this = 0;
-		for (auto iter = m_file_stat.begin(); iter != m_file_stat.end(); iter++)
-		{
-			sum_this += iter->second;
-		}
-		double sum_PS = 0;
-		for (auto iter = PS.m_file_stat.begin(); iter != PS.m_file_stat.end(); iter++)
-		{
-			sum_PS += iter->second;
-		}
+		double sum_this = m_file_stat.Sum();
+		double sum_PS = PS.m_file_stat.Sum();
 		double temp = 0;
-		for (auto iter = m_bitrate_dis.begin(); iter != m_bitrate_dis.end(); iter++)
+		m_bitrate_dis.ForEach([&](uint32_t rank, double& prob)
 		{
-			if(PS.m_bitrate_dis.find(iter->first) == PS.m_bitrate_dis.end())
+			if(!PS.m_bitrate_dis.Contains(rank))
 			{
-				iter->second = (sum_this * iter->second) / (sum_this + sum_PS);
-				temp += iter->second;
+				prob = (sum_this * prob) / (sum_this + sum_PS);
+				temp += prob;
 			}
-		}
-		for (auto iter = PS.m_bitrate_dis.begin(); iter != PS.m_bitrate_dis.end(); iter++)
+		});
+		PS.m_bitrate_dis.ForEach([&](uint32_t rank, double prob)
 		{
-			m_bitrate_dis[iter->first] = (m_bitrate_dis[iter->first] * sum_this + iter->second * sum_PS ) / (sum_this + sum_PS);
-			temp += m_bitrate_dis[iter->first];
-		}
-		for (auto iter = m_bitrate_dis.begin(); iter != m_bitrate_dis.end(); iter++)
+			double& merged = m_bitrate_dis[rank];
+			merged = (merged * sum_this + prob * sum_PS ) / (sum_this + sum_PS);
+			temp += merged;
+		});
+		m_bitrate_dis.ForEach([temp](uint32_t rank, double& prob)
 		{
-			iter->second /= temp;
-		}
+			prob /= temp;
+		});
 	}
 	catch (std::overflow_error& e)
 	{
@@ -261,7 +244,7 @@ void PopularitySummary::Aggregate(const PopularitySummary& PS)
 void PopularitySummary::UpdateDelay(const Name& n, const Time& t)
 {
 	try{
-		std::string bitrate = n.get(-3).toUri();
+		uint32_t bitrate = NDNBitRate::LookupRank(n.get(-3));
 		m_delay[bitrate].second = (t.GetMilliSeconds() + m_delay[bitrate].first * m_delay[bitrate].second)
 				/ (m_delay[bitrate].first +1);
 		m_delay[bitrate].first += 1;
@@ -280,32 +263,32 @@ bool Less(const ValuedVideoIndex& s1, const ValuedVideoIndex& s2)
 }
 void PopularitySummary::CalculateUtility()
 {
-	for (auto fileiter = m_file_dis.begin(); fileiter != m_file_dis.end(); fileiter++)
+	m_file_dis.ForEach([&](uint32_t file, double fileProb)
 	{
-		for (auto bititer = m_bitrate_dis.begin(); bititer != m_bitrate_dis.end(); bititer++)
+		m_bitrate_dis.ForEach([&](uint32_t rank, double bitrateProb)
 		{
 			for (uint32_t k = 1; k <= m_maxNumchunk; k++)
 			{
-				NS_LOG_INFO("[Utility]: File " << fileiter->first <<"\t" << fileiter->second << "\n"
+				NS_LOG_INFO("[Utility]: File " << file <<"\t" << fileProb << "\n"
 						"Chunk " << k << "\t" <<pow(m_pro_nextchunk, k - 1)<< "\n"
-						"Bitrate " << bititer->first << "\t" << bititer->second << "\n"
-						"Value " << m_delay[bititer->first].second / m_node->GetObject<NDNBitRate>()->GetChunkSize(RetrieveBitrate(bititer->first)));
+						"Bitrate " << NDNBitRate::GetInternedComponent(rank) << "\t" << bitrateProb << "\n"
+						"Value " << m_delay[rank].second / m_node->GetObject<NDNBitRate>()->GetChunkSizeFromRank(rank));
 				double delay;
 				if(firstRun)
-					delay = m_node->GetObject<NDNBitRate>()->GetChunkSize(RetrieveBitrate(bititer->first)) * 3.2;
-					//delay = m_dict_ratetosize[RetrieveBitrate(bititer->first)] * 3.2;
+					delay = m_node->GetObject<NDNBitRate>()->GetChunkSizeFromRank(rank) * 3.2;
+					//delay = m_dict_ratetosize[RetrieveBitrate(rank)] * 3.2;
 				else
-					delay = m_delay[bititer->first].second;
-				//double v = 1e3 * fileiter->second * bititer->second * pow(m_pro_nextchunk, k - 1) *
-					//	delay / m_dict_ratetosize[RetrieveBitrate(bititer->first)];
-				double v = 1e3 * fileiter->second * bititer->second * pow(m_pro_nextchunk, k - 1) *
-						delay / m_node->GetObject<NDNBitRate>()->GetChunkSize(RetrieveBitrate(bititer->first));
-				m_utilities.push_back(ValuedVideoIndex {fileiter->first, k, bititer->first, v});
+					delay = m_delay[rank].second;
+				//double v = 1e3 * fileProb * bitrateProb * pow(m_pro_nextchunk, k - 1) *
+					//	delay / m_dict_ratetosize[RetrieveBitrate(rank)];
+				double v = 1e3 * fileProb * bitrateProb * pow(m_pro_nextchunk, k - 1) *
+						delay / m_node->GetObject<NDNBitRate>()->GetChunkSizeFromRank(rank);
+				m_utilities.push_back(ValuedVideoIndex {file, k, rank, v});
 			}
-		}
-	}
+		});
+	});
 	firstRun = false;
-	std::sort(m_utilities.begin(), m_utilities.end(), Less);
+	std::stable_sort(m_utilities.begin(), m_utilities.end(), Less);	// Ties keep the order of the ids
 	//Print();
 
 }
@@ -313,16 +296,20 @@ void PopularitySummary::Print()
 {
 	std::cout<<"Statistics on Node:" << m_node->GetId() << std::endl;
 	std::cout<<"File Distribution:" << std::endl;
-	for (auto fileiter = m_file_dis.begin(); fileiter != m_file_dis.end(); fileiter++)
-		std::cout << "FileID: " << fileiter->first << "\tProb:" << fileiter->second << std::endl;
+	m_file_dis.ForEach([](uint32_t file, double prob)
+	{
+		std::cout << "FileID: " << file << "\tProb:" << prob << std::endl;
+	});
 	std::cout << std::endl << "Bitrate Distribution:" << std::endl;
-	for (auto bititer = m_bitrate_dis.begin(); bititer != m_bitrate_dis.end(); bititer++)
-		std::cout << "Bitrate: " << bititer->first << "\tProb:" << bititer->second << std::endl;
+	m_bitrate_dis.ForEach([](uint32_t rank, double prob)
+	{
+		std::cout << "Bitrate: " << NDNBitRate::GetInternedComponent(rank) << "\tProb:" << prob << std::endl;
+	});
 	std::cout << std::endl << "Rank:" << std::endl;
 	std::vector<ValuedVideoIndex>::reverse_iterator iter = m_utilities.rbegin();
 	for (int i = 0; i < 30; i++)
 	{
-		std::cout << "Rank" << i <<"  FileID:" <<iter->m_file << "\tChunkID:" <<iter->m_chunk<<"\tBitrate:" <<iter->m_bitrate
+		std::cout << "Rank" << i <<"  FileID:" <<iter->m_file << "\tChunkID:" <<iter->m_chunk<<"\tBitrate:" <<iter->GetBitRateComponent()
 				<<"\tValue:" << iter->m_cacheutility << std::endl;
 		iter++;
 	}
@@ -333,20 +320,16 @@ std::vector<ValuedVideoIndex>& PopularitySummary::UtilityRank()
 	return m_utilities;
 }
 
-std::string PopularitySummary::RetrieveBitrate(const std::string& s)
-{
-	return s.substr(2);
-}
 void PopularitySummary::Clear()
 {
-	m_bitrate_stat.clear();
-	m_bitrate_dis.clear();
+	m_bitrate_stat.Clear();
+	m_bitrate_dis.Clear();
 
 	if(!ForMARLonly)
 	{
-		m_file_stat.clear();
-		m_chunk_stat.clear();
-		m_file_dis.clear();
+		m_file_stat.Clear();
+		m_chunk_stat.Clear();
+		m_file_dis.Clear();
 		m_delay.clear();
 
 		m_pro_nextchunk = 0;
@@ -11,6 +11,8 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <algorithm>
+#include <stdint.h>
 
 #include "ns3/ptr.h"
 #include "ns3/name.h"
@@ -22,6 +24,211 @@
 namespace ns3{
 class Node;
 namespace ndn{
+
+/*
+ * Values indexed by a small id (file ID, chunk ID or bitrate rank) in contiguous arrays.
+ * Like the keys of a std::map, the ids touched by operator[] are remembered: an id may be
+ * present with a value of 0. Absent ids always hold 0, so sums and merges can run over
+ * the whole arrays.
+ *
+ * A sparse table keeps its ids in a sorted map instead, for the tables that hold a few
+ * ids out of a large range (e.g., the top-K chunks of a sketch): its memory follows the
+ * number of ids, not the largest one. Merging a sparse table makes this one sparse.
+ */
+template<typename T>
+class DenseTable
+{
+public:
+	DenseTable() : m_sparse(false) {}
+
+	inline T& operator[](uint32_t id)
+	{
+		if(m_sparse)
+			return m_map[id];
+		if(id >= m_values.size())
+		{
+			m_values.resize(id + 1, T());
+			m_present.resize(id + 1, 0);
+		}
+		m_present[id] = 1;
+		return m_values[id];
+	}
+
+	inline bool Contains(uint32_t id) const
+	{
+		if(m_sparse)
+			return m_map.count(id) != 0;
+		return id < m_present.size() && m_present[id];
+	}
+
+	/*
+	 * Value of an id, 0 if absent
+	 */
+	inline T Get(uint32_t id) const
+	{
+		if(m_sparse)
+		{
+			typename std::map<uint32_t, T>::const_iterator iter = m_map.find(id);
+			return iter != m_map.end() ? iter->second : T();
+		}
+		return id < m_values.size() ? m_values[id] : T();
+	}
+
+	inline bool IsSparse() const
+	{
+		return m_sparse;
+	}
+
+	/*
+	 * Switch to the sparse storage, keeping the present ids
+	 */
+	void SetSparse()
+	{
+		if(m_sparse)
+			return;
+		for(uint32_t i = 0; i < m_values.size(); i++)
+			if(m_present[i])
+				m_map[i] = m_values[i];
+		std::vector<T>().swap(m_values);
+		std::vector<uint8_t>().swap(m_present);
+		m_sparse = true;
+	}
+
+	/*
+	 * Ids are below GetSize()
+	 */
+	inline uint32_t GetSize() const
+	{
+		if(m_sparse)
+			return m_map.empty() ? 0 : m_map.rbegin()->first + 1;
+		return m_values.size();
+	}
+
+	T Sum() const
+	{
+		T sum = T();
+		if(m_sparse)
+		{
+			for(typename std::map<uint32_t, T>::const_iterator iter = m_map.begin(); iter != m_map.end(); iter++)
+				sum += iter->second;
+			return sum;
+		}
+		for(std::size_t i = 0; i < m_values.size(); i++)
+			sum += m_values[i];
+		return sum;
+	}
+
+	/*
+	 * this[id] += other[id] for every id, ids of other become present
+	 */
+	void Merge(const DenseTable& other)
+	{
+		if(other.m_sparse)
+			SetSparse();
+		if(m_sparse)
+		{
+			other.ForEach([this](uint32_t id, const T& value)
+			{
+				m_map[id] += value;
+			});
+			return;
+		}
+		if(other.m_values.size() > m_values.size())
+		{
+			m_values.resize(other.m_values.size(), T());
+			m_present.resize(other.m_values.size(), 0);
+		}
+		T* values = m_values.data();
+		uint8_t* present = m_present.data();
+		const T* otherValues = other.m_values.data();
+		const uint8_t* otherPresent = other.m_present.data();
+		for(std::size_t i = 0; i < other.m_values.size(); i++)
+		{
+			values[i] += otherValues[i];
+			present[i] |= otherPresent[i];
+		}
+	}
+
+	/*
+	 * this[id] = f(other[id]) for the ids of other, which become the only present ids.
+	 * Branch-free over the whole arrays of dense tables.
+	 */
+	template<typename U, typename F>
+	void Assign(const DenseTable<U>& other, F f)
+	{
+		Clear();
+		if(other.m_sparse)
+			SetSparse();
+		if(m_sparse)
+		{
+			other.ForEach([this, &f](uint32_t id, const U& value)
+			{
+				m_map[id] = f(value);
+			});
+			return;
+		}
+		uint32_t size = other.m_values.size();
+		m_values.resize(size, T());
+		m_present.assign(other.m_present.begin(), other.m_present.end());
+		T* values = m_values.data();
+		const U* otherValues = other.m_values.data();
+		const uint8_t* present = m_present.data();
+		for(uint32_t i = 0; i < size; i++)
+		{
+			values[i] = present[i] ? f(otherValues[i]) : T();
+		}
+	}
+
+	/*
+	 * f(id, value&) on the present ids, in increasing order
+	 */
+	template<typename F>
+	void ForEach(F f)
+	{
+		if(m_sparse)
+		{
+			for(typename std::map<uint32_t, T>::iterator iter = m_map.begin(); iter != m_map.end(); iter++)
+				f(iter->first, iter->second);
+			return;
+		}
+		for(uint32_t i = 0; i < m_values.size(); i++)
+			if(m_present[i])
+				f(i, m_values[i]);
+	}
+
+	template<typename F>
+	void ForEach(F f) const
+	{
+		if(m_sparse)
+		{
+			for(typename std::map<uint32_t, T>::const_iterator iter = m_map.begin(); iter != m_map.end(); iter++)
+				f(iter->first, iter->second);
+			return;
+		}
+		for(uint32_t i = 0; i < m_values.size(); i++)
+			if(m_present[i])
+				f(i, m_values[i]);
+	}
+
+	/*
+	 * Remove all the ids, keeping the arrays of a dense table allocated
+	 */
+	void Clear()
+	{
+		m_map.clear();
+		std::fill(m_values.begin(), m_values.end(), T());
+		std::fill(m_present.begin(), m_present.end(), 0);
+	}
+
+private:
+	template<typename U> friend class DenseTable;
+
+	bool					m_sparse;
+	std::vector<T>			m_values;
+	std::vector<uint8_t>	m_present;
+	std::map<uint32_t, T>	m_map;		// Sparse storage
+};
+
 /*
  * This class provides access to four popularity parameters for calculating caching utility.
  */
@@ -55,12 +262,12 @@ protected:
 private:
 	Ptr<VideoStatistics> 					m_statptr;
 
-	std::unordered_map<uint32_t, uint64_t> 	m_file_stat;
-	std::unordered_map<uint32_t, uint64_t> 	m_chunk_stat;
-	std::map<std::string, uint64_t> 		m_bitrate_stat;
-	std::map<uint32_t, double> 				m_file_dis;
-	std::map<std::string, double> 			m_bitrate_dis;
-	std::map<std::string, std::pair<uint64_t,double> >			m_delay;
+	DenseTable<uint64_t> 	m_file_stat;		// Index: file ID
+	DenseTable<uint64_t> 	m_chunk_stat;		// Index: chunk ID
+	DenseTable<uint64_t> 	m_bitrate_stat;		// Index: bitrate rank
+	DenseTable<double> 		m_file_dis;			// Same ids as m_file_stat
+	DenseTable<double> 		m_bitrate_dis;
+	std::map<uint32_t, std::pair<uint64_t,double> >			m_delay;
 
 	bool 	IsEdge = true;
 	bool 	IsMarked = false;
@@ -76,7 +283,6 @@ private:
 	void AggregateToFile(const PopularitySummary&);
 	void AggregateToBitrate(const PopularitySummary&);
 
-	std::string RetrieveBitrate(const std:: string&);
 	void Print();
 private:
 	uint32_t				m_maxNumchunk;
@@ -71,35 +71,31 @@ void VideoCacheDecision::AggregateDecision(const VideoCacheDecision& other)
 			m_table[iter->first] = iter->second;
 	}
 }
-std::string VideoCacheDecision::RetrieveBitrate(const std::string& s)
-{
-	return s.substr(2);
-}
 void VideoCacheDecision::GreedyChoice()
 {
 	uint32_t sizelimit = m_cs->GetCapacity();
 	std::vector<ValuedVideoIndex>::reverse_iterator riter = m_stat_summary->UtilityRank().rbegin();
 	for(; riter != m_stat_summary->UtilityRank().rend(); riter++)
 	{
-		DecisionIndex d {riter->m_bitrate, riter->m_file};
+		DecisionIndex d {riter->m_rank, riter->m_file};
 		if(m_table.find(d) != m_table.end())
 		{
 			if(riter->m_chunk <= m_table[d])
 				continue;
 		}
-		if(sizelimit < static_cast<uint32_t>(m_node->GetObject<NDNBitRate>()->GetChunkSize(RetrieveBitrate(riter->m_bitrate)) * 1e3))
+		if(sizelimit < static_cast<uint32_t>(m_node->GetObject<NDNBitRate>()->GetChunkSizeFromRank(riter->m_rank) * 1e3))
 			break;
 		else
 		{
-			sizelimit -= static_cast<uint32_t>(m_node->GetObject<NDNBitRate>()->GetChunkSize(RetrieveBitrate(riter->m_bitrate)) * 1e3);
+			sizelimit -= static_cast<uint32_t>(m_node->GetObject<NDNBitRate>()->GetChunkSizeFromRank(riter->m_rank) * 1e3);
 			//Update Decision Table
-			NS_LOG_DEBUG("GreedyChoice on NodeID: "<<m_node->GetId()<<" [Bitrate:"<<d.m_bitrate<<" File:" << d.m_file
+			NS_LOG_DEBUG("GreedyChoice on NodeID: "<<m_node->GetId()<<" [Bitrate:"<<riter->GetBitRateComponent()<<" File:" << d.m_file
 					<<" Chunk:"<< riter->m_chunk << "]");
 			if(m_table[d] + 1 != riter->m_chunk)
 				NS_LOG_WARN("!!!!!!!!!!!!!!!!!!!CacheTableUpdate Error!!!!!!!!!!!!!!!!!");
 			m_table[d] = riter->m_chunk;
 			//Update Decision Input to CS
-			AddToDecision(riter->m_bitrate, riter->m_file, riter->m_chunk);
+			AddToDecision(riter->GetBitRateComponent(), riter->m_file, riter->m_chunk);
 		}
 	}
 	m_cs->InstallCacheEntity();
@@ -48,7 +48,6 @@ private:
 
 private:
 	void AddToDecision(const std::string&, uint32_t, uint32_t);
-	std::string RetrieveBitrate(const std:: string&);
 };
 
 
@@ -11,42 +11,32 @@
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 #include "ns3/name.h"
+#include "ns3/ndn-bitrate.h"
 
 namespace ns3{
 namespace ndn{
 
+/*
+ * Key of a video segment: bitrate rank (interned by NDNBitRate), file ID and chunk ID.
+ * Only integers are kept so that building, comparing and hashing an index on the
+ * forwarding path does not touch any string.
+ */
 class VideoIndex
 {
 public:
-	VideoIndex(){}
-	VideoIndex(const std::string s, uint32_t f, uint32_t k)
-	{
-		m_bitrate = s;
-		m_file = f;
-		m_chunk = k;
-	}
-	VideoIndex(const VideoIndex& vi)
-	{
-		m_bitrate = vi.m_bitrate;
-		m_file = vi.m_file;
-		m_chunk = vi.m_chunk;
-	}
+	VideoIndex()
+		:m_rank(0), m_file(0), m_chunk(0)
+	{}
+	VideoIndex(uint32_t rank, uint32_t f, uint32_t k)
+		:m_rank(rank), m_file(f), m_chunk(k)
+	{}
 	VideoIndex(const Name& requestName)
 	{
-		m_chunk = requestName.get(-1).toNumber();
-		m_file = requestName.get(-2).toNumber();
-		m_bitrate = requestName.get(-3).toUri();
-	}
-	VideoIndex& operator=(const VideoIndex& vi)
-	{
-		this->m_bitrate = vi.m_bitrate;
-		this->m_chunk = vi.m_chunk;
-		this->m_file = vi.m_file;
-		return (*this);
+		Set(requestName);
 	}
-	inline void Set(const std::string s, uint32_t f, uint32_t k)
+	inline void Set(uint32_t rank, uint32_t f, uint32_t k)
 	{
-		m_bitrate = s;
+		m_rank = rank;
 		m_file = f;
 		m_chunk = k;
 	}
@@ -54,20 +44,38 @@ public:
 	{
 		m_chunk = requestName.get(-1).toNumber();
 		m_file = requestName.get(-2).toNumber();
-		m_bitrate = requestName.get(-3).toUri();
+		m_rank = NDNBitRate::LookupRank(requestName.get(-3));
 	}
 	inline bool operator==(const VideoIndex& index) const{
-		return (m_bitrate == index.m_bitrate) &&
+		return (m_rank == index.m_rank) &&
 				(m_file == index.m_file) &&
 				(m_chunk == index.m_chunk);
 	}
 	bool operator<(const VideoIndex& index) const{
 		return (m_file < index.m_file) ||
-				(m_file ==  index.m_file && m_bitrate < index.m_bitrate) ||
-				(m_file ==  index.m_file && m_bitrate == index.m_bitrate && m_chunk < index.m_chunk);
+				(m_file ==  index.m_file && m_rank < index.m_rank) ||
+				(m_file ==  index.m_file && m_rank == index.m_rank && m_chunk < index.m_chunk);
+	}
+	/*
+	 * Pack the index into one 64-bit value: [rank: 8 bits][file: 32 bits][chunk: 24 bits]
+	 * Higher bits of rank and chunk are dropped, so the key is only fit for hashing
+	 */
+	inline uint64_t GetKey() const
+	{
+		return (static_cast<uint64_t>(m_rank & 0xff) << 56) |
+				(static_cast<uint64_t>(m_file) << 24) |
+				static_cast<uint64_t>(m_chunk & 0xffffff);
+	}
+	inline const std::string& GetBitRate() const
+	{
+		return NDNBitRate::GetInternedBitRate(m_rank);
+	}
+	inline const std::string& GetBitRateComponent() const
+	{
+		return NDNBitRate::GetInternedComponent(m_rank);
 	}
 
-	std::string m_bitrate;
+	uint32_t m_rank;
 	uint32_t m_file;
 	uint32_t m_chunk;
 };
@@ -75,8 +83,8 @@ public:
 class ValuedVideoIndex : public VideoIndex
 {
 public:
-	ValuedVideoIndex(uint32_t f, uint32_t k , std::string s, double u)
-		:VideoIndex(s, f, k)
+	ValuedVideoIndex(uint32_t f, uint32_t k , uint32_t rank, double u)
+		:VideoIndex(rank, f, k)
 	{
 		m_cacheutility = u;
 	}
@@ -96,8 +104,8 @@ public:
 class PartitionVideoIndex : public VideoIndex
 {
 public:
-	PartitionVideoIndex(uint32_t rank, uint32_t f, uint32_t k , std::string s)
-		:VideoIndex(s, f, k)
+	PartitionVideoIndex(uint32_t rank, uint32_t f, uint32_t k , uint32_t br)
+		:VideoIndex(br, f, k)
 	{
 		m_BRrank = rank;
 	}
@@ -112,16 +120,14 @@ public:
 	}
 	PartitionVideoIndex& operator=(const PartitionVideoIndex& vi)
 	{
-		this->m_bitrate = vi.m_bitrate;
+		this->m_rank = vi.m_rank;
 		this->m_chunk = vi.m_chunk;
 		this->m_file = vi.m_file;
 		this->m_BRrank = vi.m_BRrank;
 		return (*this);
 	}
 	inline bool operator==(const PartitionVideoIndex& index) const{
-		return (m_bitrate == index.m_bitrate) &&
-				(m_file == index.m_file) &&
-				(m_chunk == index.m_chunk) &&
+		return VideoIndex::operator==(index) &&
 				(m_BRrank == index.m_BRrank);
 	}
 	uint32_t m_BRrank;
@@ -130,17 +136,17 @@ public:
 class DecisionIndex
 {
 public:
-	DecisionIndex(const std::string s, uint32_t f)
+	DecisionIndex(uint32_t rank, uint32_t f)
 	{
-		m_bitrate = s;
+		m_rank = rank;
 		m_file = f;
 	}
 	inline bool operator==(const DecisionIndex& index) const{
-		return (m_bitrate == index.m_bitrate) &&
+		return (m_rank == index.m_rank) &&
 				(m_file == index.m_file);
 	}
 
-	std::string m_bitrate;
+	uint32_t m_rank;
 	uint32_t m_file;
 };
 
@@ -212,20 +218,20 @@ public:
 class DelayTableKey
 {
 public:
-	DelayTableKey(const std::string& br, uint32_t hop, uint32_t edgeid)
+	DelayTableKey(uint32_t rank, uint32_t hop, uint32_t edgeid)
 	{
 		m_edgeid = edgeid;
 		m_hop = hop;
-		m_br = br;
+		m_rank = rank;
 	}
 	inline bool operator==(const DelayTableKey& index) const{
 		return (m_edgeid == index.m_edgeid) &&
 				(m_hop == index.m_hop) &&
-				(m_br == index.m_br);
+				(m_rank == index.m_rank);
 	}
 	uint32_t 	m_edgeid;
 	uint32_t 	m_hop;
-	std::string	m_br;
+	uint32_t	m_rank;
 };
 
 }
@@ -238,7 +244,7 @@ namespace std {
 		std::size_t operator()(const ns3::ndn::DecisionIndex& index) const{
 			std::size_t seed = 0;
 			boost::hash_combine(seed, boost::hash_value(index.m_file));
-			boost::hash_combine(seed, boost::hash_value(index.m_bitrate));
+			boost::hash_combine(seed, boost::hash_value(index.m_rank));
 			return seed;
 			//return std::hash<uint32_t>()(cache.m_video_file) ^ std::hash<uint32_t>()(cache.m_video_chunk) ^ std::hash<uint32_t>()(cache.m_bitrate);
 		}
@@ -248,12 +254,7 @@ namespace std {
 	struct hash<ns3::ndn::VideoIndex>
 	{
 		std::size_t operator()(const ns3::ndn::VideoIndex& index) const{
-			std::size_t seed = 0;
-			boost::hash_combine(seed, boost::hash_value(index.m_chunk));
-			boost::hash_combine(seed, boost::hash_value(index.m_file));
-			boost::hash_combine(seed, boost::hash_value(index.m_bitrate));
-			return seed;
-			//return std::hash<uint32_t>()(cache.m_video_file) ^ std::hash<uint32_t>()(cache.m_video_chunk) ^ std::hash<uint32_t>()(cache.m_bitrate);
+			return std::hash<uint64_t>()(index.GetKey());
 		}
 	};
 
@@ -262,9 +263,7 @@ namespace std {
 	{
 		std::size_t operator()(const ns3::ndn::PartitionVideoIndex& index) const{
 			std::size_t seed = 0;
-			boost::hash_combine(seed, boost::hash_value(index.m_chunk));
-			boost::hash_combine(seed, boost::hash_value(index.m_file));
-			boost::hash_combine(seed, boost::hash_value(index.m_bitrate));
+			boost::hash_combine(seed, boost::hash_value(index.GetKey()));
 			boost::hash_combine(seed, boost::hash_value(index.m_BRrank));
 			return seed;
 			//return std::hash<uint32_t>()(cache.m_video_file) ^ std::hash<uint32_t>()(cache.m_video_chunk) ^ std::hash<uint32_t>()(cache.m_bitrate);
@@ -289,9 +288,7 @@ namespace std {
 		std::size_t operator()(const ns3::ndn::VarIndex& index) const{
 			std::size_t seed = 0;
 			boost::hash_combine(seed, boost::hash_value(index.m_id));
-			boost::hash_combine(seed, boost::hash_value(index.m_vi.m_file));
-			boost::hash_combine(seed, boost::hash_value(index.m_vi.m_chunk));
-			boost::hash_combine(seed, boost::hash_value(index.m_vi.m_bitrate));
+			boost::hash_combine(seed, boost::hash_value(index.m_vi.GetKey()));
 			return seed;
 		}
 	};
@@ -303,9 +300,7 @@ namespace std {
 			std::size_t seed = 0;
 			boost::hash_combine(seed, boost::hash_value(index.m_edgeid));
 			boost::hash_combine(seed, boost::hash_value(index.m_endid));
-			boost::hash_combine(seed, boost::hash_value(index.m_vi.m_file));
-			boost::hash_combine(seed, boost::hash_value(index.m_vi.m_chunk));
-			boost::hash_combine(seed, boost::hash_value(index.m_vi.m_bitrate));
+			boost::hash_combine(seed, boost::hash_value(index.m_vi.GetKey()));
 			return seed;
 		}
 	};
@@ -317,7 +312,7 @@ namespace std {
 			std::size_t seed = 0;
 			boost::hash_combine(seed, boost::hash_value(index.m_edgeid));
 			boost::hash_combine(seed, boost::hash_value(index.m_hop));
-			boost::hash_combine(seed, boost::hash_value(index.m_br));
+			boost::hash_combine(seed, boost::hash_value(index.m_rank));
 			return seed;
 		}
 	};
@@ -0,0 +1,169 @@
+/*
+ * Bounded-memory Interest counts: Count-Min sketch plus Space-Saving top-K list
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-videostat-sketch.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3{
+namespace ndn{
+
+/* Fixed seeds, so runs are reproducible */
+static uint64_t SplitMix64(uint64_t& state)
+{
+	uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+VideoStatSketch::VideoStatSketch(uint32_t width, uint32_t depth, uint32_t topK)
+	:m_widthBits(4)
+	,m_depth(std::max<uint32_t>(depth, 1))
+	,m_k(std::max<uint32_t>(topK, 1))
+{
+	while((1u << m_widthBits) < width && m_widthBits < 31)
+		m_widthBits++;
+	m_counters.assign(static_cast<std::size_t>(m_depth) << m_widthBits, 0);
+
+	uint64_t state = 0;
+	for(uint32_t row = 0; row < m_depth; row++)
+	{
+		uint64_t a = SplitMix64(state) | 1;
+		m_seeds.push_back(std::make_pair(a, SplitMix64(state)));
+	}
+	m_heap.reserve(m_k);
+}
+
+uint64_t VideoStatSketch::Estimate(uint64_t key) const
+{
+	uint64_t estimate = std::numeric_limits<uint64_t>::max();
+	for(uint32_t row = 0; row < m_depth; row++)
+	{
+		uint64_t column = (key * m_seeds[row].first + m_seeds[row].second) >> (64 - m_widthBits);
+		estimate = std::min(estimate, m_counters[(static_cast<std::size_t>(row) << m_widthBits) + column]);
+	}
+	return estimate;
+}
+
+void VideoStatSketch::Add(const VideoIndex& vi, uint64_t n)
+{
+	/* Conservative update: raise only the counters below the new estimate */
+	uint64_t key = vi.GetKey();
+	uint64_t estimate = Estimate(key) + n;
+	for(uint32_t row = 0; row < m_depth; row++)
+	{
+		uint64_t& counter = Counter(row, key);
+		if(counter < estimate)
+			counter = estimate;
+	}
+
+	auto pos = m_heapPos.find(vi);
+	if(pos != m_heapPos.end())
+	{
+		/* Both are upper bounds of the true count */
+		uint64_t& count = m_topK[vi];
+		count = std::min(count + n, estimate);
+		m_heap[pos->second].first = count;
+		SiftDown(pos->second);
+	}
+	else if(m_heap.size() < m_k)
+	{
+		/* Nothing evicted since the last Clear: the count is exact */
+		m_topK[vi] = n;
+		m_heapPos[vi] = m_heap.size();
+		m_heap.push_back(std::make_pair(n, vi));
+		SiftUp(m_heap.size() - 1);
+	}
+	else
+	{
+		/* Evict the least counted entry if the newcomer may have more requests */
+		if(estimate <= m_heap[0].first)
+			return;
+		const VideoIndex evicted = m_heap[0].second;
+		m_topK.erase(evicted);
+		m_heapPos.erase(evicted);
+		m_topK[vi] = estimate;
+		Place(0, std::make_pair(estimate, vi));
+		SiftDown(0);
+	}
+}
+
+uint64_t VideoStatSketch::GetHitNum(const VideoIndex& vi) const
+{
+	auto iter = m_topK.find(vi);
+	if(iter != m_topK.end())
+		return iter->second;
+	return Estimate(vi.GetKey());
+}
+
+void VideoStatSketch::ResetHitNum(const VideoIndex& vi)
+{
+	uint64_t key = vi.GetKey();
+	uint64_t estimate = Estimate(key);
+	for(uint32_t row = 0; row < m_depth; row++)
+	{
+		uint64_t& counter = Counter(row, key);
+		counter -= std::min(counter, estimate);
+	}
+
+	auto pos = m_heapPos.find(vi);
+	if(pos != m_heapPos.end())
+	{
+		m_topK[vi] = 0;
+		m_heap[pos->second].first = 0;
+		SiftUp(pos->second);
+	}
+}
+
+void VideoStatSketch::Clear()
+{
+	std::fill(m_counters.begin(), m_counters.end(), 0);
+	m_topK.clear();
+	m_heap.clear();
+	m_heapPos.clear();
+}
+
+void VideoStatSketch::Place(uint32_t pos, const std::pair<uint64_t, VideoIndex>& entry)
+{
+	m_heap[pos] = entry;
+	m_heapPos[entry.second] = pos;
+}
+
+void VideoStatSketch::SiftUp(uint32_t pos)
+{
+	std::pair<uint64_t, VideoIndex> entry = m_heap[pos];
+	while(pos > 0)
+	{
+		uint32_t parent = (pos - 1) / 2;
+		if(m_heap[parent].first <= entry.first)
+			break;
+		Place(pos, m_heap[parent]);
+		pos = parent;
+	}
+	Place(pos, entry);
+}
+
+void VideoStatSketch::SiftDown(uint32_t pos)
+{
+	std::pair<uint64_t, VideoIndex> entry = m_heap[pos];
+	uint32_t size = m_heap.size();
+	while(2 * pos + 1 < size)
+	{
+		uint32_t child = 2 * pos + 1;
+		if(child + 1 < size && m_heap[child + 1].first < m_heap[child].first)
+			child++;
+		if(entry.first <= m_heap[child].first)
+			break;
+		Place(pos, m_heap[child]);
+		pos = child;
+	}
+	Place(pos, entry);
+}
+
+}
+}
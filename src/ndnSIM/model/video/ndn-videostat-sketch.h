@@ -0,0 +1,77 @@
+/*
+ * Bounded-memory Interest counts: Count-Min sketch plus Space-Saving top-K list
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_VIDEOSTAT_SKETCH_H
+#define NDN_VIDEOSTAT_SKETCH_H
+
+#include "ndn-videocontent.h"
+
+#include <unordered_map>
+#include <vector>
+#include <utility>
+#include <stdint.h>
+
+namespace ns3{
+namespace ndn{
+
+/*
+ * Counts of the K most requested video chunks, and estimates of any other count.
+ *
+ * The sketch keeps depth rows of width counters (conservative update), so an
+ * estimate is never below the true count. The top-K list follows Space-Saving: a
+ * newcomer whose estimate exceeds the least counted entry replaces it, with that
+ * estimate as count, so the counts are upper bounds too. Memory is
+ * O(width * depth + K) whatever the catalogue.
+ */
+class VideoStatSketch
+{
+public:
+	VideoStatSketch(uint32_t width, uint32_t depth, uint32_t topK);
+
+	void Add(const VideoIndex& vi, uint64_t n);
+
+	/*
+	 * Count of a top-K entry, sketch estimate otherwise
+	 */
+	uint64_t GetHitNum(const VideoIndex& vi) const;
+
+	/*
+	 * Forget the count of vi. The sketch can only lower the counters it shares with
+	 * other chunks, whose estimates may then fall below their true counts.
+	 */
+	void ResetHitNum(const VideoIndex& vi);
+
+	void Clear();
+
+	inline const std::unordered_map<VideoIndex, uint64_t>& GetTopK() const {return m_topK;}
+
+private:
+	inline uint64_t& Counter(uint32_t row, uint64_t key)
+	{
+		return m_counters[(static_cast<std::size_t>(row) << m_widthBits) + ((key * m_seeds[row].first + m_seeds[row].second) >> (64 - m_widthBits))];
+	}
+
+	uint64_t Estimate(uint64_t key) const;
+
+	void SiftUp(uint32_t pos);
+	void SiftDown(uint32_t pos);
+	void Place(uint32_t pos, const std::pair<uint64_t, VideoIndex>& entry);
+
+	uint32_t 								m_widthBits;
+	uint32_t 								m_depth;
+	uint32_t 								m_k;
+	std::vector<std::pair<uint64_t, uint64_t> > m_seeds;	// Multiply-shift hash of each row
+	std::vector<uint64_t> 					m_counters;
+
+	std::unordered_map<VideoIndex, uint64_t> 	m_topK;
+	std::vector<std::pair<uint64_t, VideoIndex> > m_heap;	// Min-heap of the top-K counts
+	std::unordered_map<VideoIndex, uint32_t> 	m_heapPos;
+};
+
+}
+}
+
+#endif
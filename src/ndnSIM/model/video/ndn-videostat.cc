@@ -3,8 +3,11 @@
 #include "ns3/ndn-forwarding-strategy.h"
 #include "ns3/node.h"
 #include "ns3/log.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 
 NS_LOG_COMPONENT_DEFINE("ndn.VideoStatistics");
@@ -13,7 +16,52 @@ namespace ns3{
 namespace ndn{
 
 NS_OBJECT_ENSURE_REGISTERED (VideoStatistics);
+
+/*
+ * Slot of a thread counting Interests, which selects its shard: a thread takes the
+ * lowest free slot on its first Add and gives it back when it exits, so that the
+ * slots stay below the number of live counting threads
+ */
+class ThreadSlot
+{
+public:
+	ThreadSlot()
+	{
+		std::lock_guard<std::mutex> lock(GetMutex());
+		std::vector<bool>& used = GetUsed();
+		m_slot = std::find(used.begin(), used.end(), false) - used.begin();
+		if(m_slot == used.size())
+			used.push_back(true);
+		else
+			used[m_slot] = true;
+	}
+	~ThreadSlot()
+	{
+		std::lock_guard<std::mutex> lock(GetMutex());
+		GetUsed()[m_slot] = false;
+	}
+
+	uint32_t m_slot;
+
+private:
+	static std::mutex& GetMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+	static std::vector<bool>& GetUsed()
+	{
+		static std::vector<bool> used;
+		return used;
+	}
+};
+
+static thread_local ThreadSlot t_slot;
+
 VideoStatistics::VideoStatistics()
+	:m_topK(0)
+	,m_sketchWidth(4096)
+	,m_sketchDepth(4)
 {
 
 }
@@ -29,12 +77,41 @@ VideoStatistics::GetTypeId()
     .SetGroupName ("Ndn")
     .SetParent<Object> ()
 	.AddConstructor<VideoStatistics> ()
+
+	.AddAttribute("Shards",
+			"Number of per-thread shards counting Interests, merged when the table is read "
+			"(one per thread calling Add; further threads share a locked table). 0: count directly into the table",
+			UintegerValue(0),
+			MakeUintegerAccessor(&VideoStatistics::SetShards, &VideoStatistics::GetShards),
+			MakeUintegerChecker<uint32_t>())
+
+	.AddAttribute("TopK",
+			"Keep approximate counts in bounded memory: a Count-Min sketch, and the exact "
+			"list of the TopK most requested chunks. 0: exact counts of every chunk",
+			UintegerValue(0),
+			MakeUintegerAccessor(&VideoStatistics::m_topK),
+			MakeUintegerChecker<uint32_t>())
+
+	.AddAttribute("SketchWidth",
+			"Counters per row of the Count-Min sketch (rounded up to a power of 2)",
+			UintegerValue(4096),
+			MakeUintegerAccessor(&VideoStatistics::m_sketchWidth),
+			MakeUintegerChecker<uint32_t>(1))
+
+	.AddAttribute("SketchDepth",
+			"Rows of the Count-Min sketch",
+			UintegerValue(4),
+			MakeUintegerAccessor(&VideoStatistics::m_sketchDepth),
+			MakeUintegerChecker<uint32_t>(1))
     ;
   return tid;
 }
 void VideoStatistics::DoDispose()
 {
 	m_stat.clear();
+	m_shards.clear();
+	m_overflow.clear();
+	m_sketch.reset();
 	Object::DoDispose ();
 }
 
@@ -48,8 +125,98 @@ void VideoStatistics::NotifyNewAggregate ()
 void VideoStatistics::Add(VideoIndex&& index)
 {
 	NS_LOG_DEBUG("[VideoStatistics]:"<< " receive Interests on NodeID:" << m_node->GetId() <<" FileID:" <<
-			index.m_file << " ChunkID:" << index.m_chunk << " Bitrate:" << index.m_bitrate);
-	m_stat[index] += 1;
+			index.m_file << " ChunkID:" << index.m_chunk << " Bitrate:" << index.GetBitRate());
+	if(m_shards.empty())
+	{
+		Count(index, 1);
+		return;
+	}
+
+	uint32_t slot = t_slot.m_slot;
+	if(slot >= m_shards.size())
+	{
+		if(m_topK != 0)
+		{
+			/* The sketch is bounded, an overflow table would not be */
+			std::lock_guard<std::mutex> lock(m_mergeMutex);
+			Count(index, 1);
+			return;
+		}
+		std::lock_guard<std::mutex> lock(m_overflowMutex);
+		m_overflow[index] += 1;
+		return;
+	}
+
+	Shard& shard = *m_shards[slot];
+	shard.m_busy.store(true);
+	std::unordered_map<VideoIndex, uint64_t>& delta = shard.m_delta[shard.m_epoch.load() & 1];
+	delta[index] += 1;
+	bool full = m_topK != 0 && delta.size() >= m_sketchWidth;
+	shard.m_busy.store(false, std::memory_order_release);
+	shard.m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	if(full)
+		FlushShard(shard);
+}
+
+void VideoStatistics::FlushShard(Shard& shard)
+{
+	/* No merge runs meanwhile: the owner's buffer cannot flip, and the other one is empty */
+	std::lock_guard<std::mutex> lock(m_mergeMutex);
+	std::unordered_map<VideoIndex, uint64_t>& delta = shard.m_delta[shard.m_epoch.load() & 1];
+	for(auto iter = delta.begin(); iter != delta.end(); iter++)
+		Count(iter->first, iter->second);
+	delta.clear();
+}
+
+void VideoStatistics::MergeShards()
+{
+	std::lock_guard<std::mutex> lock(m_mergeMutex);
+	for(auto shard = m_shards.begin(); shard != m_shards.end(); shard++)
+	{
+		if((*shard)->m_pending.exchange(0, std::memory_order_relaxed) == 0)
+			continue;
+
+		/* Once the owner is out of Add, it only writes into the other buffer */
+		uint32_t epoch = (*shard)->m_epoch.fetch_add(1);
+		while((*shard)->m_busy.load())
+			std::this_thread::yield();
+
+		std::unordered_map<VideoIndex, uint64_t>& delta = (*shard)->m_delta[epoch & 1];
+		for(auto iter = delta.begin(); iter != delta.end(); iter++)
+			Count(iter->first, iter->second);
+		delta.clear();
+	}
+
+	std::lock_guard<std::mutex> overflowLock(m_overflowMutex);
+	for(auto iter = m_overflow.begin(); iter != m_overflow.end(); iter++)
+		Count(iter->first, iter->second);
+	m_overflow.clear();
+}
+
+void VideoStatistics::Count(const VideoIndex& index, uint64_t n)
+{
+	if(m_topK == 0)
+	{
+		m_stat[index] += n;
+		return;
+	}
+	if(!m_sketch)
+		m_sketch.reset(new VideoStatSketch(m_sketchWidth, m_sketchDepth, m_topK));
+	m_sketch->Add(index, n);
+}
+
+void VideoStatistics::SetShards(uint32_t shards)
+{
+	MergeShards();
+	m_shards.clear();
+	for(uint32_t i = 0; i < shards; i++)
+		m_shards.push_back(std::unique_ptr<Shard>(new Shard()));
+}
+
+uint32_t VideoStatistics::GetShards() const
+{
+	return m_shards.size();
 }
 
 }
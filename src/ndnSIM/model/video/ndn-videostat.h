@@ -7,17 +7,37 @@
 #define NDN_VIDEOSTAT_H
 
 #include "ndn-videocontent.h"
+#include "ndn-videostat-sketch.h"
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 
 #include <unordered_map>
 #include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace ns3{
 class Node;
 
 namespace ndn{
 
+/*
+ * Number of Interests received per video chunk on an edge router.
+ *
+ * With the Shards attribute set, each thread counts into its own shard and the
+ * shards are merged into the table whenever it is read. Writers never lock: a
+ * shard has two buffers, and a merge flips the buffer its owner writes into and
+ * drains the other one. Threads beyond the number of shards count into one
+ * table under a mutex instead. The table must be read from one thread at a time,
+ * at a point where its content is needed (e.g., a synchronization barrier).
+ *
+ * With the TopK attribute set, counts are approximate and take bounded memory (see
+ * VideoStatSketch): GetTable holds the K most requested chunks only, and GetHitNum
+ * estimates the others. A shard then folds its buffer into the sketch itself once the
+ * buffer holds SketchWidth chunks, and the threads without a shard count straight into
+ * the sketch, so that no buffer grows with the catalogue between merges.
+ */
 class VideoStatistics : public Object
 {
 public:
@@ -30,10 +50,16 @@ public:
 
 	inline void Clear()
 	{
+		Sync();
 		m_stat.clear();
+		if(m_sketch)
+			m_sketch->Clear();
 	}
 	inline uint64_t	GetHitNum(const VideoIndex& vi)
 	{
+		Sync();
+		if(m_sketch)
+			return m_sketch->GetHitNum(vi);
 		auto iter = m_stat.find(vi);
 		if(iter != m_stat.end())
 			return iter->second;
@@ -43,6 +69,9 @@ public:
 	
 	inline uint64_t GetHitNum(VideoIndex&& vi)
 	{
+		Sync();
+		if(m_sketch)
+			return m_sketch->GetHitNum(vi);
 		auto iter = m_stat.find(vi);
 		if(iter != m_stat.end())
 			return iter->second;
@@ -50,22 +79,85 @@ public:
 			return 0;
 	}
 
-	inline const std::unordered_map<VideoIndex, uint64_t>& GetTable() {return m_stat;}
+	inline const std::unordered_map<VideoIndex, uint64_t>& GetTable()
+	{
+		Sync();
+		return m_sketch ? m_sketch->GetTopK() : m_stat;
+	}
 
 	inline void ResetHitNum(const VideoIndex& vi)
 	{
+		Sync();
+		if(m_sketch)
+		{
+			m_sketch->ResetHitNum(vi);
+			return;
+		}
 		auto statiter = m_stat.find(vi);
 		if(statiter != m_stat.end())
 			statiter->second = 0;
 	}
 
+	/*
+	 * Counts are approximate (TopK mode)
+	 */
+	inline bool IsApproximate() const
+	{
+		return m_topK != 0;
+	}
+
+	/*
+	 * Fold the counts of all the shards into the table
+	 */
+	void MergeShards();
+
 protected:
   virtual void DoDispose (void); ///< @brief Do cleanup
 
   virtual void NotifyNewAggregate ();
 private:
+	struct Shard
+	{
+		Shard() : m_epoch(0), m_busy(false), m_pending(0) {}
+
+		std::atomic<uint32_t>	m_epoch;	// The owner writes into m_delta[m_epoch & 1]
+		std::atomic<bool>		m_busy;		// The owner is writing
+		std::atomic<uint64_t>	m_pending;	// Adds since the last merge
+		std::unordered_map<VideoIndex, uint64_t> m_delta[2];
+	};
+
+	/*
+	 * Count the buffer a shard's owner writes into, from the owner (TopK mode)
+	 */
+	void FlushShard(Shard& shard);
+
+	inline void Sync()
+	{
+		if(!m_shards.empty())
+			MergeShards();
+	}
+
+	/*
+	 * Add n Interests for index, exactly or into the sketch
+	 */
+	void Count(const VideoIndex& index, uint64_t n);
+
+	void SetShards(uint32_t);
+	uint32_t GetShards() const;
+
 	std::unordered_map<VideoIndex, uint64_t> m_stat;
 	Ptr<Node>								 m_node;
+
+	std::vector<std::unique_ptr<Shard> >	 m_shards;	// Empty: Add counts into m_stat
+	std::mutex								 m_mergeMutex;
+
+	std::unordered_map<VideoIndex, uint64_t> m_overflow;	// Counts of the threads without a shard
+	std::mutex								 m_overflowMutex;
+
+	uint32_t 								 m_topK;		// 0: exact counts
+	uint32_t 								 m_sketchWidth;
+	uint32_t 								 m_sketchDepth;
+	std::unique_ptr<VideoStatSketch>		 m_sketch;		// Created by the first Count
 };
 
 
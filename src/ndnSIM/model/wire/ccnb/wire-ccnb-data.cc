@@ -20,6 +20,7 @@
  */
 
 #include "../ccnb.h"
+#include "../pass-through.h"
 
 #include "wire-ccnb.h"
 
@@ -145,7 +146,7 @@ Data::ToWire (Ptr<const ndn::Data> data)
   static DataTrailer trailer;
 
   Ptr<const Packet> p = data->GetWire ();
-  if (!p)
+  if (!p || passThrough::IsPaddedWire (p))
     {
       Ptr<Packet> packet = Create<Packet> (*data->GetPayload ());
       Data wireEncoding (ConstCast<ndn::Data> (data));
@@ -20,6 +20,7 @@
  */
 
 #include "../ccnb.h"
+#include "../pass-through.h"
 
 #include "wire-ccnb.h"
 
@@ -83,7 +84,7 @@ Ptr<Packet>
 Interest::ToWire (Ptr<const ndn::Interest> interest)
 {
   Ptr<const Packet> p = interest->GetWire ();
-  if (!p)
+  if (!p || passThrough::IsPaddedWire (p))
     {
       Ptr<Packet> packet = Create<Packet> (*interest->GetPayload ());
       Interest wireEncoding (ConstCast<ndn::Interest> (interest));
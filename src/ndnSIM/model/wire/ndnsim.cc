@@ -9,6 +9,7 @@
  */
 
 #include "ndnsim.h"
+#include "pass-through.h"
 
 using namespace std;
 
@@ -70,7 +71,7 @@ Ptr<Packet>
 Interest::ToWire (Ptr<const ndn::Interest> interest)
 {
   Ptr<const Packet> p = interest->GetWire ();
-  if (!p)
+  if (!p || passThrough::IsPaddedWire (p))
     {
       Ptr<Packet> packet = Create<Packet> (*interest->GetPayload ());
       Interest wireEncoding (ConstCast<ndn::Interest> (interest));
@@ -98,6 +99,25 @@ Interest::FromWire (Ptr<Packet> packet)
   return interest;
 }
 
+Ptr<ndn::Interest>
+Interest::Replicate (Ptr<const ndn::Interest> interest, Ptr<Packet> payload)
+{
+  Ptr<ndn::Interest> copy = Create<ndn::Interest> (payload);
+
+  copy->SetNonce (interest->GetNonce ());
+  copy->SetScope (interest->GetScope ());
+  copy->SetNack (interest->GetNack ());
+  copy->SetInterestLifetime (Seconds (static_cast<uint16_t> (interest->GetInterestLifetime ().ToInteger (Time::S))));
+  copy->SetTSI (interest->GetTSI ());
+  copy->SetAcc (interest->GetAcc ());
+  copy->SetBRBoundary (interest->GetBRBoundary ());
+  copy->SetName (Create<Name> (interest->GetName ()));
+  if (interest->GetExclude () != 0)
+    copy->SetExclude (Create<Exclude> (*interest->GetExclude ()));
+
+  return copy;
+}
+
 uint32_t
 Interest::GetSerializedSize (void) const
 {
@@ -248,7 +268,7 @@ Ptr<Packet>
 Data::ToWire (Ptr<const ndn::Data> data)
 {
   Ptr<const Packet> p = data->GetWire ();
-  if (!p)
+  if (!p || passThrough::IsPaddedWire (p))
     {
       Ptr<Packet> packet = Create<Packet> (*data->GetPayload ());
       Data wireEncoding (ConstCast<ndn::Data> (data));
@@ -276,6 +296,32 @@ Data::FromWire (Ptr<Packet> packet)
   return data;
 }
 
+Ptr<ndn::Data>
+Data::Replicate (Ptr<const ndn::Data> data, Ptr<Packet> payload)
+{
+  Ptr<ndn::Data> copy = Create<ndn::Data> (payload);
+
+  copy->SetSignature (data->GetSignature ());
+  copy->SetTSI (data->GetTSI ());
+  copy->SetTSB (data->GetTSB ());
+  copy->SetAcc (data->GetAcc ());
+  copy->SetName (Create<Name> (data->GetName ()));
+  copy->SetReward (data->GetReward ());
+  copy->SetHops (data->GetHops ());
+  copy->SetTimestamp (MilliSeconds (static_cast<uint32_t> (data->GetTimestamp ().ToInteger (Time::MS))));
+  copy->SetFreshness (Seconds (static_cast<uint16_t> (data->GetFreshness ().ToInteger (Time::S))));
+
+  // On the wire, the most recent delay goes first and the last recorded one is dropped
+  if (data->GetHops () > 0)
+    {
+      copy->SetDelay (0, static_cast<uint32_t> (data->m_mostRecentDelay.ToInteger (Time::MS)));
+      for (int k = 1; k < static_cast<int> (data->GetHops ()); k++)
+        copy->SetDelay (k, data->GetDelay (k - 1));
+    }
+
+  return copy;
+}
+
 uint32_t
 Data::GetSerializedSize () const
 {
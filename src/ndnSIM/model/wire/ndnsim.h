@@ -85,6 +85,13 @@ public:
 
   static Ptr<ndn::Interest>
   FromWire (Ptr<Packet> packet);
+
+  /**
+   * @brief Same Interest as FromWire (ToWire (interest)) would give (with the same
+   *        rounding of the fields), without encoding it; payload becomes its payload
+   */
+  static Ptr<ndn::Interest>
+  Replicate (Ptr<const ndn::Interest> interest, Ptr<Packet> payload);
   
   // from Header
   static TypeId GetTypeId (void); 
@@ -146,6 +153,13 @@ public:
 
   static Ptr<ndn::Data>
   FromWire (Ptr<Packet> packet);
+
+  /**
+   * @brief Same Data as FromWire (ToWire (data)) would give (with the same rounding
+   *        of the fields), without encoding it; payload becomes its payload
+   */
+  static Ptr<ndn::Data>
+  Replicate (Ptr<const ndn::Data> data, Ptr<Packet> payload);
   
   // from Header
   static TypeId GetTypeId (void);
@@ -0,0 +1,290 @@
+/** -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Object pass-through over point-to-point links
+ *
+ * Date: 2026-10-17
+ */
+
+#include "pass-through.h"
+#include "ndnsim.h"
+
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.wire.PassThrough");
+
+NDN_NAMESPACE_BEGIN
+
+namespace wire {
+namespace passThrough {
+
+NS_OBJECT_ENSURE_REGISTERED (Tag);
+
+static
+GlobalValue g_passThrough ("ndn::WirePassThrough",
+                           "Send Interest/Data over point-to-point links by reference, with the size of "
+                           "their ndnSIM encoding but without encoding them (packets are not decodable). "
+                           "Read when a face is created",
+                           BooleanValue (false),
+                           MakeBooleanChecker ());
+
+// Objects of packets lost on the link (e.g., queue drops) are released after that long
+static const double MaxInFlightTime = 60.0; // seconds
+
+struct InFlight
+{
+  Ptr<const ndn::Interest> m_interest;
+  Ptr<const ndn::Data> m_data;
+  Time m_sent;
+};
+
+// Objects sent by reference in the current simulation
+struct InFlightTable
+{
+  InFlightTable () : m_lastId (0) {}
+
+  std::map<uint64_t, InFlight> m_objects;
+  uint64_t m_lastId;
+};
+
+static InFlightTable *g_inFlight = 0;
+
+static void
+DestroyInFlight ()
+{
+  delete g_inFlight;
+  g_inFlight = 0;
+}
+
+// The objects belong to the simulation: they go away with it, and the ids start over
+static InFlightTable &
+GetInFlight ()
+{
+  if (g_inFlight == 0)
+    {
+      g_inFlight = new InFlightTable ();
+      Simulator::ScheduleDestroy (&DestroyInFlight);
+    }
+  return *g_inFlight;
+}
+
+static uint64_t
+Register (Ptr<const ndn::Interest> interest, Ptr<const ndn::Data> data)
+{
+  InFlightTable &table = GetInFlight ();
+  std::map<uint64_t, InFlight> &inFlight = table.m_objects;
+
+  // Ids increase with time: the oldest objects come first
+  Time now = Simulator::Now ();
+  while (!inFlight.empty () && inFlight.begin ()->second.m_sent + Seconds (MaxInFlightTime) < now)
+    {
+      NS_LOG_DEBUG ("Object " << inFlight.begin ()->first << " never received, released");
+      inFlight.erase (inFlight.begin ());
+    }
+
+  InFlight &entry = inFlight[++table.m_lastId];
+  entry.m_interest = interest;
+  entry.m_data = data;
+  entry.m_sent = now;
+  return table.m_lastId;
+}
+
+// Object of a pass-through packet, none if the packet was already received or came too late
+static InFlight
+Take (uint64_t id)
+{
+  std::map<uint64_t, InFlight> &inFlight = GetInFlight ().m_objects;
+  std::map<uint64_t, InFlight>::iterator entry = inFlight.find (id);
+  if (entry == inFlight.end ())
+    {
+      NS_LOG_WARN ("Pass-through packet " << id << " refers to an unknown object, dropped");
+      return InFlight ();
+    }
+
+  InFlight object = entry->second;
+  inFlight.erase (entry);
+  return object;
+}
+
+// Padded packets cached as the "wire" of an object hold a tag with id 0
+static bool
+IsPadded (Ptr<const Packet> packet)
+{
+  Tag tag;
+  return packet->PeekPacketTag (tag) && tag.GetId () == 0;
+}
+
+static Ptr<Packet>
+Pad (Ptr<const Packet> payload, uint32_t wireSize, Tag::Type type)
+{
+  Ptr<Packet> packet = payload->Copy ();
+  packet->AddPaddingAtEnd (wireSize - payload->GetSize ());
+  Tag tag (0, type);
+  packet->ReplacePacketTag (tag);
+  return packet;
+}
+
+bool
+IsEnabled ()
+{
+  BooleanValue value;
+  g_passThrough.GetValue (value);
+  return value.Get ();
+}
+
+bool
+IsPaddedWire (Ptr<const Packet> wire)
+{
+  // Only objects sent by reference in this simulation have a padded wire
+  return g_inFlight != 0 && IsPadded (wire);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Tag::Tag ()
+  : m_id (0)
+  , m_type (INTEREST)
+{
+}
+
+Tag::Tag (uint64_t id, Type type)
+  : m_id (id)
+  , m_type (type)
+{
+}
+
+TypeId
+Tag::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::wire::passThrough::Tag")
+    .SetGroupName ("Ndn")
+    .SetParent<ns3::Tag> ()
+    .AddConstructor<Tag> ()
+    ;
+  return tid;
+}
+
+TypeId
+Tag::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+Tag::GetSerializedSize () const
+{
+  return sizeof (uint64_t) + sizeof (uint8_t);
+}
+
+void
+Tag::Serialize (TagBuffer i) const
+{
+  i.WriteU64 (m_id);
+  i.WriteU8 (m_type);
+}
+
+void
+Tag::Deserialize (TagBuffer i)
+{
+  m_id = i.ReadU64 ();
+  m_type = i.ReadU8 ();
+}
+
+void
+Tag::Print (std::ostream &os) const
+{
+  os << (m_type == INTEREST ? "Interest " : "Data ") << m_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Ptr<Packet>
+Interest::ToWire (Ptr<const ndn::Interest> interest)
+{
+  // Any cached wire, encoded or padded, has the size of the encoding
+  Ptr<const Packet> wire = interest->GetWire ();
+  if (wire == 0 || !IsPadded (wire))
+    {
+      uint32_t wireSize = (wire != 0) ? wire->GetSize () :
+        interest->GetPayload ()->GetSize () + ndnSIM::Interest (ConstCast<ndn::Interest> (interest)).GetSerializedSize ();
+      wire = Pad (interest->GetPayload (), wireSize, Tag::INTEREST);
+      interest->SetWire (wire);
+    }
+
+  Ptr<Packet> packet = wire->Copy ();
+  Tag tag (Register (interest, 0), Tag::INTEREST);
+  packet->ReplacePacketTag (tag);
+  return packet;
+}
+
+Ptr<ndn::Interest>
+Interest::FromWire (Ptr<Packet> packet, const Tag &tag)
+{
+  Ptr<const ndn::Interest> original = Take (tag.GetId ()).m_interest;
+  if (original == 0)
+    {
+      return 0;
+    }
+
+  Tag padding (0, Tag::INTEREST);
+  packet->ReplacePacketTag (padding);
+  Ptr<Packet> wire = packet->Copy ();
+
+  packet->RemoveAtEnd (packet->GetSize () - original->GetPayload ()->GetSize ());
+  Tag removed;
+  packet->RemovePacketTag (removed);
+
+  Ptr<ndn::Interest> interest = ndnSIM::Interest::Replicate (original, packet);
+  interest->SetWire (wire);
+  return interest;
+}
+
+Ptr<Packet>
+Data::ToWire (Ptr<const ndn::Data> data)
+{
+  Ptr<const Packet> wire = data->GetWire ();
+  if (wire == 0 || !IsPadded (wire))
+    {
+      uint32_t wireSize = (wire != 0) ? wire->GetSize () :
+        data->GetPayload ()->GetSize () + ndnSIM::Data (ConstCast<ndn::Data> (data)).GetSerializedSize ();
+      wire = Pad (data->GetPayload (), wireSize, Tag::DATA);
+      data->SetWire (wire);
+    }
+
+  Ptr<Packet> packet = wire->Copy ();
+  Tag tag (Register (0, data), Tag::DATA);
+  packet->ReplacePacketTag (tag);
+  return packet;
+}
+
+Ptr<ndn::Data>
+Data::FromWire (Ptr<Packet> packet, const Tag &tag)
+{
+  Ptr<const ndn::Data> original = Take (tag.GetId ()).m_data;
+  if (original == 0)
+    {
+      return 0;
+    }
+
+  Tag padding (0, Tag::DATA);
+  packet->ReplacePacketTag (padding);
+  Ptr<Packet> wire = packet->Copy ();
+
+  packet->RemoveAtEnd (packet->GetSize () - original->GetPayload ()->GetSize ());
+  Tag removed;
+  packet->RemovePacketTag (removed);
+
+  Ptr<ndn::Data> data = ndnSIM::Data::Replicate (original, packet);
+  data->SetWire (wire);
+  return data;
+}
+
+} // passThrough
+} // wire
+
+NDN_NAMESPACE_END
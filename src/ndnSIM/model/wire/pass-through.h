@@ -0,0 +1,118 @@
+/** -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Object pass-through over point-to-point links
+ *
+ * Instead of the encoded Interest/Data, the packet handed to the NetDevice holds the
+ * payload followed by as many padding bytes as the ndnSIM encoding would take (so
+ * links and queues see the same size), and a tag naming the object kept aside until
+ * the other end of the link picks it up. The receiver gets the same object
+ * wire::ndnSIM::FromWire would have decoded.
+ *
+ * Opt-in with the global value ndn::WirePassThrough; packets are not decodable
+ * (pcap shows padding), so leave it off when the real encoding is needed.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_WIRE_PASS_THROUGH_H
+#define NDN_WIRE_PASS_THROUGH_H
+
+#include "ns3/ndn-common.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-data.h"
+#include "ns3/tag.h"
+
+NDN_NAMESPACE_BEGIN
+
+namespace wire {
+
+/**
+ * @brief Namespace for the pass-through of Interest/Data objects over point-to-point links
+ */
+namespace passThrough {
+
+/**
+ * @brief Packet tag referring to the object carried by a pass-through packet
+ */
+class Tag : public ns3::Tag
+{
+public:
+  enum Type
+    {
+      INTEREST = 0,
+      DATA = 1
+    };
+
+  Tag ();
+  Tag (uint64_t id, Type type);
+
+  uint64_t
+  GetId () const { return m_id; }
+
+  Type
+  GetType () const { return static_cast<Type> (m_type); }
+
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer i) const;
+  virtual void Deserialize (TagBuffer i);
+  virtual void Print (std::ostream &os) const;
+
+private:
+  uint64_t m_id;
+  uint8_t m_type;
+};
+
+/**
+ * @brief Current value of the ndn::WirePassThrough global value
+ */
+bool
+IsEnabled ();
+
+/**
+ * @brief Whether wire, cached in an Interest/Data, is padding rather than a real encoding
+ */
+bool
+IsPaddedWire (Ptr<const Packet> wire);
+
+class Interest
+{
+public:
+  /**
+   * @brief Packet of the size of the ndnSIM encoding, carrying interest by reference
+   */
+  static Ptr<Packet>
+  ToWire (Ptr<const ndn::Interest> interest);
+
+  /**
+   * @brief Interest carried by a packet made by ToWire (the tag is removed),
+   * 0 if the object is unknown (packet received twice, or after it was released)
+   */
+  static Ptr<ndn::Interest>
+  FromWire (Ptr<Packet> packet, const Tag &tag);
+};
+
+class Data
+{
+public:
+  /**
+   * @brief Packet of the size of the ndnSIM encoding, carrying data by reference
+   */
+  static Ptr<Packet>
+  ToWire (Ptr<const ndn::Data> data);
+
+  /**
+   * @brief Data carried by a packet made by ToWire (the tag is removed),
+   * 0 if the object is unknown (packet received twice, or after it was released)
+   */
+  static Ptr<ndn::Data>
+  FromWire (Ptr<Packet> packet, const Tag &tag);
+};
+
+} // passThrough
+} // wire
+
+NDN_NAMESPACE_END
+
+#endif // NDN_WIRE_PASS_THROUGH_H
@@ -16,6 +16,7 @@
 #include "ns3/ndn-common.h"
 
 #include <vector>
+#include <utility>
 
 NDN_NAMESPACE_BEGIN
 
@@ -46,16 +47,22 @@ public:
    * @brief Creates an empty blob
    */
   Blob ()
+    : m_hash (0)
+    , m_hashValid (false)
   {
   }
 
   Blob (const std::string &data)
     : m_data (data.begin (), data.end ())
+    , m_hash (0)
+    , m_hashValid (false)
   {
   }
 
   Blob (const void *buf, size_t length)
     : m_data (reinterpret_cast<const char*> (buf), reinterpret_cast<const char*> (buf) + length)
+    , m_hash (0)
+    , m_hashValid (false)
   {
   }
   
@@ -65,6 +72,7 @@ public:
   inline char*
   buf ()
   {
+    m_hashValid = false;
     return &m_data.front ();
   }
 
@@ -77,26 +85,35 @@ public:
     return &m_data.front ();
   }
 
-  iterator begin () { return m_data.begin (); }
+  iterator begin () { m_hashValid = false; return m_data.begin (); }
   const_iterator begin () const { return m_data.begin (); }
-  iterator end () { return m_data.end (); }
+  iterator end () { m_hashValid = false; return m_data.end (); }
   const_iterator end () const { return m_data.end (); }
   size_t size () const { return m_data.size (); }
 
-  void swap (Blob &x) { m_data.swap (x.m_data); }
-  void push_back (value_type val) { m_data.push_back (val); }
+  void swap (Blob &x) { m_data.swap (x.m_data); std::swap (m_hash, x.m_hash); std::swap (m_hashValid, x.m_hashValid); }
+  void push_back (value_type val) { m_data.push_back (val); m_hashValid = false; }
 
   bool empty () const { return m_data.empty (); }
 
   Blob &
-  operator = (const Blob &other) { m_data = other.m_data; return *this; }
+  operator = (const Blob &other) { m_data = other.m_data; m_hash = other.m_hash; m_hashValid = other.m_hashValid; return *this; }
 
-  reference operator [] (size_type pos) { return m_data [pos]; }
+  reference operator [] (size_type pos) { m_hashValid = false; return m_data [pos]; }
   const_reference operator [] (size_type pos) const { return m_data [pos]; }
 
   char getItem (size_type pos) const { return m_data [pos]; }
 
-  void clear () { m_data.clear (); }
+  void clear () { m_data.clear (); m_hashValid = false; }
+
+  /**
+   * @brief Hash of the content (same as boost::hash_range over the bytes)
+   *
+   * Computed on first use and kept until the blob is modified (any non-const access
+   * drops it), so a name component shared by many names and tables is hashed once
+   */
+  inline std::size_t
+  hash () const;
 
 private:
   friend bool operator == (const Blob &a, const Blob &b);
@@ -107,6 +124,8 @@ private:
 
 private:
   std::vector< char > m_data;
+  mutable std::size_t m_hash;
+  mutable bool m_hashValid;
 };
 
 inline bool operator == (const Blob &a, const Blob &b)  { return a.m_data == b.m_data; }
@@ -118,12 +137,28 @@ inline bool operator >= (const Blob &a, const Blob &b)  { return a.m_data >= b.m
 NDN_NAMESPACE_END
 
 #include <boost/functional/hash.hpp>
+
+NDN_NAMESPACE_BEGIN
+
+inline std::size_t
+Blob::hash () const
+{
+  if (!m_hashValid)
+    {
+      m_hash = boost::hash_range (m_data.begin (), m_data.end ());
+      m_hashValid = true;
+    }
+  return m_hash;
+}
+
+NDN_NAMESPACE_END
+
 namespace boost
 {
 inline std::size_t
-hash_value (const ns3::ndn::Blob v)
+hash_value (const ns3::ndn::Blob &v)
 {
-  return boost::hash_range (v.begin(), v.end());
+  return v.hash ();
 }
 }
 
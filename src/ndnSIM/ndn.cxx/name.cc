@@ -28,10 +28,14 @@ ATTRIBUTE_HELPER_CPP (Name);
 ///////////////////////////////////////////////////////////////////////////////
 
 Name::Name ()
+  : m_begin (0)
+  , m_size (0)
 {
 }
 
 Name::Name (const string &uri)
+  : m_begin (0)
+  , m_size (0)
 { 
   string::const_iterator i = uri.begin ();
   string::const_iterator end = uri.end ();
@@ -100,17 +104,65 @@ Name::Name (const string &uri)
 }
 
 Name::Name (const Name &other)
+  : Name (other, 0, other.size ())
 {
-  m_comps = other.m_comps;
+}
+
+Name::Name (const Name &other, size_t pos, size_t len)
+  : m_begin (0)
+  , m_size (0)
+{
+  if (len == 0)
+    return;
+
+  m_buffer = other.m_buffer;
+  m_begin = other.m_begin + pos;
+  m_size = len;
 }
 
 Name &
 Name::operator= (const Name &other)
 {
-  m_comps = other.m_comps;
+  m_buffer = other.m_buffer;
+  m_begin = other.m_begin;
+  m_size = other.m_size;
   return *this;
 }
 
+std::vector<name::Component> &
+Name::detach ()
+{
+  if (m_buffer == 0)
+    {
+      m_buffer = Create<Buffer> ();
+    }
+  else if (m_buffer->GetReferenceCount () > 1)
+    {
+      Ptr<Buffer> buffer = Create<Buffer> ();
+      buffer->m_comps.reserve (m_size + 1);
+      buffer->m_comps.assign (m_buffer->m_comps.begin () + m_begin,
+                              m_buffer->m_comps.begin () + (m_begin + m_size));
+      m_buffer = buffer;
+      m_begin = 0;
+    }
+  else
+    {
+      // Private buffer: only drop the components outside of the view
+      std::vector<name::Component> &comps = m_buffer->m_comps;
+      comps.erase (comps.begin () + (m_begin + m_size), comps.end ());
+      comps.erase (comps.begin (), comps.begin () + m_begin);
+      m_begin = 0;
+    }
+  return m_buffer->m_comps;
+}
+
+std::vector<name::Component> &
+Name::emptyComps ()
+{
+  static std::vector<name::Component> comps;
+  return comps;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //                                SETTERS                                    //
 ///////////////////////////////////////////////////////////////////////////////
@@ -154,24 +206,7 @@ Name::get (int index) const
                              << error::msg ("Index out of range")
                              << error::pos (index));
     }
-  return m_comps [index];
-}
-
-name::Component &
-Name::get (int index)
-{
-  if (index < 0)
-    {
-      index = size () - (-index);
-    }
-
-  if (static_cast<unsigned int> (index) >= size())
-    {
-      BOOST_THROW_EXCEPTION (error::Name ()
-                             << error::msg ("Index out of range")
-                             << error::pos (index));
-    }
-  return m_comps [index];
+  return m_buffer->m_comps [m_begin + index];
 }
 
 
@@ -183,8 +218,6 @@ Name::get (int index)
 Name
 Name::getSubName (size_t pos/* = 0*/, size_t len/* = Name::npos*/) const
 {
-  Name retval;
-
   if (len == npos)
     {
       len = size () - pos;
@@ -198,12 +231,7 @@ Name::getSubName (size_t pos/* = 0*/, size_t len/* = Name::npos*/) const
                              << error::pos (len));
     }
 
-  for (size_t i = pos; i < pos + len; i++)
-    {
-      retval.append (get (i));
-    }
-
-  return retval;
+  return Name (*this, pos, len);
 }
 
 Name
@@ -25,16 +25,23 @@ NDN_NAMESPACE_BEGIN
 /**
  * @ingroup ndn-cxx
  * @brief Class for NDN Name
+ *
+ * The components are kept in a reference-counted buffer shared by the copies of the
+ * name and by the names returned by getSubName, getPrefix and getPostfix, which are
+ * views on a range of it.  The buffer is copied on the first change (append) of a
+ * name that shares it.  The components can only be read (get, [], begin, end... are
+ * const), so a change of one name is never seen by another.
  */
 class Name : public SimpleRefCount<Name>
 {
 public:
-  typedef std::vector<name::Component>::iterator iterator;
   typedef std::vector<name::Component>::const_iterator const_iterator;
-  typedef std::vector<name::Component>::reverse_iterator reverse_iterator;
   typedef std::vector<name::Component>::const_reverse_iterator const_reverse_iterator;
-  typedef std::vector<name::Component>::reference reference;
   typedef std::vector<name::Component>::const_reference const_reference;
+  // components are read-only, as in std::set
+  typedef const_iterator iterator;
+  typedef const_reverse_iterator reverse_iterator;
+  typedef const_reference reference;
 
   typedef name::Component partial_type;
   
@@ -233,43 +240,21 @@ public:
   const name::Component &
   get (int index) const;
 
-  /**
-   * @brief Get binary blob of name component
-   * @param index index of the name component.  If less than 0, then getting component from the back
-   * @returns reference to binary blob of the requested name component
-   *
-   * If index is out of range, an exception will be thrown
-   */
-  name::Component &
-  get (int index);
-
   /////
   ///// Iterator interface to name components
   /////
   inline Name::const_iterator
   begin () const;           ///< @brief Begin iterator (const)
 
-  inline Name::iterator
-  begin ();                 ///< @brief Begin iterator
-
   inline Name::const_iterator
   end () const;             ///< @brief End iterator (const)
 
-  inline Name::iterator
-  end ();                   ///< @brief End iterator
-
   inline Name::const_reverse_iterator
   rbegin () const;          ///< @brief Reverse begin iterator (const)
 
-  inline Name::reverse_iterator
-  rbegin ();                ///< @brief Reverse begin iterator
-
   inline Name::const_reverse_iterator
   rend () const;            ///< @brief Reverse end iterator (const)
 
-  inline Name::reverse_iterator
-  rend ();                  ///< @brief Reverse end iterator
-
 
   /////
   ///// Static helpers to convert name component to appropriate value
@@ -361,13 +346,6 @@ public:
   inline bool
   operator > (const Name &name) const;
 
-  /**
-   * @brief Operator [] to simplify access to name components
-   * @see get
-   */
-  inline name::Component &
-  operator [] (int index);
-
   /**
    * @brief Operator [] to simplify access to name components
    * @see get
@@ -395,7 +373,28 @@ public:
   const static uint64_t nversion = static_cast<uint64_t> (-1);
 
 private:
-  std::vector<name::Component> m_comps;
+  struct Buffer : public SimpleRefCount<Buffer>
+  {
+    std::vector<name::Component> m_comps;
+  };
+
+  /**
+   * @brief View on components [pos, pos + len) of other (no range check)
+   */
+  Name (const Name &other, size_t pos, size_t len);
+
+  /**
+   * @brief Make the buffer private to this name and exactly its components, ready for push_back
+   */
+  std::vector<name::Component> &
+  detach ();
+
+  static std::vector<name::Component> &
+  emptyComps ();
+
+  Ptr<Buffer> m_buffer; ///< @brief 0 for an empty name
+  uint32_t m_begin;
+  uint32_t m_size;
 };
 
 inline std::ostream &
@@ -421,6 +420,8 @@ operator >> (std::istream &is, Name &name)
 
 template<class Iterator>
 Name::Name (Iterator begin, Iterator end)
+  : m_begin (0)
+  , m_size (0)
 {
   append (begin, end);
 }
@@ -429,7 +430,10 @@ inline Name &
 Name::append (const name::Component &comp)
 {
   if (comp.size () != 0)
-    m_comps.push_back (comp);
+    {
+      detach ().push_back (comp);
+      m_size++;
+    }
   return *this;
 }
 
@@ -438,8 +442,10 @@ Name::appendBySwap (name::Component &comp)
 {
   if (comp.size () != 0)
     {
-      Name::iterator newComp = m_comps.insert (end (), name::Component ());
-      newComp->swap (comp);
+      std::vector<name::Component> &comps = detach ();
+      comps.push_back (name::Component ());
+      comps.back ().swap (comp);
+      m_size++;
     }
   return *this;
 }
@@ -515,7 +521,7 @@ Name::appendBlkId (uint64_t blkid)
 inline size_t
 Name::size () const
 {
-  return m_comps.size ();
+  return m_size;
 }
 
 /////
@@ -524,50 +530,29 @@ Name::size () const
 inline Name::const_iterator
 Name::begin () const
 {
-  return m_comps.begin ();
-}
-
-inline Name::iterator
-Name::begin ()
-{
-  return m_comps.begin ();
+  if (m_size == 0)
+    return emptyComps ().begin ();
+  return m_buffer->m_comps.begin () + m_begin;
 }
 
 inline Name::const_iterator
 Name::end () const
 {
-  return m_comps.end ();
-}
-
-inline Name::iterator
-Name::end ()
-{
-  return m_comps.end ();
+  if (m_size == 0)
+    return emptyComps ().end ();
+  return m_buffer->m_comps.begin () + (m_begin + m_size);
 }
 
 inline Name::const_reverse_iterator
 Name::rbegin () const
 {
-  return m_comps.rbegin ();
-}
-
-inline Name::reverse_iterator
-Name::rbegin ()
-{
-  return m_comps.rbegin ();
+  return Name::const_reverse_iterator (end ());
 }
 
 inline Name::const_reverse_iterator
 Name::rend () const
 {
-  return m_comps.rend ();
-}
-
-
-inline Name::reverse_iterator
-Name::rend ()
-{
-  return m_comps.rend ();
+  return Name::const_reverse_iterator (begin ());
 }
 
 
@@ -630,12 +615,6 @@ Name::operator > (const Name &name) const
   return (compare (name) > 0);
 }
 
-inline name::Component &
-Name::operator [] (int index)
-{
-  return get (index);
-}
-
 inline const name::Component &
 Name::operator [] (int index) const
 {
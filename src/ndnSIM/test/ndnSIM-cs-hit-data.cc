@@ -0,0 +1,77 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the Data answering cache hits
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-cs-hit-data.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndn-bitrate.h"
+
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.CsHitDataTest");
+
+namespace ns3
+{
+
+static bool
+HasTags (Ptr<const Packet> payload)
+{
+  PacketTagIterator tags = payload->GetPacketTagIterator ();
+  return tags.HasNext ();
+}
+
+void
+CsHitDataTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<ndn::NDNBitRate> bitrate = CreateObject<ndn::NDNBitRate> ();
+  bitrate->AddBitRate ("1000kbps");
+  node->AggregateObject (bitrate);
+  ObjectFactory factory ("ns3::ndn::cs::CE2::Lru");
+  factory.Set ("MaxSize", UintegerValue (10000));
+  Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore> ();
+  node->AggregateObject (cs);
+
+  Ptr<ndn::Data> data = Create<ndn::Data> (Create<Packet> (100));
+  data->SetName (Create<ndn::Name> ("/video/br1000kbps/3/7"));
+  NS_TEST_ASSERT_MSG_EQ (cs->Add (data), true, "Data not cached");
+  Ptr<const Packet> cached = cs->Begin ()->GetData ()->GetPayload ();
+
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> ("/video/br1000kbps/3/7"));
+
+  // The forwarding strategy counts the hops of the first hit
+  Ptr<ndn::Data> first = cs->Lookup (interest);
+  NS_TEST_ASSERT_MSG_EQ ((first != 0), true, "First lookup missed");
+  if (first == 0)
+    {
+      return;
+    }
+  NS_TEST_EXPECT_MSG_EQ (first->GetName (), data->GetName (), "Name of the first hit");
+  ndn::FwHopCountTag hopCount;
+  hopCount.Increment ();
+  first->AddPayloadTag (hopCount);
+  ndn::FwHopCountTag firstHopCount;
+  NS_TEST_EXPECT_MSG_EQ (first->GetPayload ()->PeekPacketTag (firstHopCount), true, "Tag of the first hit lost");
+  NS_TEST_EXPECT_MSG_EQ (firstHopCount.Get (), 1, "Hop count of the first hit");
+
+  NS_TEST_EXPECT_MSG_EQ (HasTags (cached), false, "Tag of the first hit in the cached payload");
+
+  Ptr<ndn::Data> second = cs->Lookup (interest);
+  NS_TEST_ASSERT_MSG_EQ ((second != 0), true, "Second lookup missed");
+  if (second == 0)
+    {
+      return;
+    }
+  NS_TEST_EXPECT_MSG_EQ (HasTags (second->GetPayload ()), false, "Tag of the first hit in the second hit");
+  NS_TEST_EXPECT_MSG_EQ (second->GetPayload ()->GetSize (), 100, "Payload of the second hit");
+  NS_TEST_EXPECT_MSG_EQ ((second->GetPayload () != first->GetPayload ()), true, "Tagged payload shared");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,29 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the Data answering cache hits
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_CS_HIT_DATA_H
+#define NDNSIM_TEST_CS_HIT_DATA_H
+
+#include "ns3/test.h"
+
+namespace ns3 {
+
+class CsHitDataTest : public TestCase
+{
+public:
+  CsHitDataTest ()
+    : TestCase ("Content store hit Data test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+}
+
+#endif // NDNSIM_TEST_CS_HIT_DATA_H
@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the multisection content store
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-cs-multisection.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndn-bitrate.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.MulSecLfuDaTest");
+
+namespace ns3
+{
+
+static const std::string bitrates[] = { "1000kbps", "2500kbps" };
+
+static std::string
+ChunkName (const std::string &bitrate, char file)
+{
+  return "/video/br" + bitrate + "/" + file + "/1";
+}
+
+static bool
+Add (Ptr<ndn::ContentStore> cs, const std::string &bitrate, char file, uint32_t size)
+{
+  Ptr<ndn::Data> data = Create<ndn::Data> (Create<Packet> (size));
+  data->SetName (Create<ndn::Name> (ChunkName (bitrate, file)));
+  // Admitted for sure by the probabilistic check of Add
+  data->SetAcc (1000000);
+  data->SetTSB (1);
+  data->SetTSI (1);
+  return cs->Add (data);
+}
+
+static bool
+Hit (Ptr<ndn::ContentStore> cs, const std::string &bitrate, char file)
+{
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> (ChunkName (bitrate, file)));
+  double reward = 0;
+  return cs->Lookup (interest, reward) != 0;
+}
+
+static std::set<std::string>
+Names (const std::string &bitrate, const std::string &files)
+{
+  std::set<std::string> names;
+  for (std::string::const_iterator file = files.begin (); file != files.end (); file++)
+    {
+      names.insert (ChunkName (bitrate, *file));
+    }
+  return names;
+}
+
+std::set<std::string>
+MulSecLfuDaTest::Cached (Ptr<ndn::ContentStore> cs)
+{
+  std::set<std::string> names;
+  for (Ptr<ndn::cs::Entry> entry = cs->Begin (); entry != cs->End (); entry = cs->Next (entry))
+    {
+      names.insert (entry->GetName ().toUri ());
+    }
+  return names;
+}
+
+void
+MulSecLfuDaTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<ndn::NDNBitRate> bitrate = CreateObject<ndn::NDNBitRate> ();
+  bitrate->AddBitRate (bitrates[0]);
+  bitrate->AddBitRate (bitrates[1]);
+  node->AggregateObject (bitrate);
+
+  ObjectFactory factory ("ns3::ndn::cs::multisection::LfuDA");
+  factory.Set ("MaxSize", UintegerValue (2000));
+  Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore> ();
+  node->AggregateObject (cs);
+  cs->InitContentStore (bitrates, 2);
+  NS_TEST_ASSERT_MSG_EQ (cs->GetCapacity (bitrates[0]), 1000, "Bytes of the first section");
+  NS_TEST_ASSERT_MSG_EQ (cs->GetCapacity (bitrates[1]), 1000, "Bytes of the second section");
+
+  std::set<std::string> expected = Names (bitrates[0], "abc");
+  expected.insert (ChunkName (bitrates[1], 'x'));
+  for (char file = 'a'; file <= 'c'; file++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (Add (cs, bitrates[0], file, 300), true, "Chunk " << file << " should fit");
+    }
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, bitrates[1], 'x', 900), true, "Chunk x should fit");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetCurrentSize (), 1800, "Bytes of both sections");
+
+  // a: 2 hits, b: 1, c: none. The least frequent one makes room
+  Hit (cs, bitrates[0], 'a');
+  Hit (cs, bitrates[0], 'a');
+  Hit (cs, bitrates[0], 'b');
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, bitrates[0], 'd', 300), true, "Chunk d should evict");
+  expected.erase (ChunkName (bitrates[0], 'c'));
+  expected.insert (ChunkName (bitrates[0], 'd'));
+  NS_TEST_EXPECT_MSG_EQ ((Cached (cs) == expected), true, "c is the least frequent");
+  NS_TEST_EXPECT_MSG_EQ (Hit (cs, bitrates[0], 'c'), false, "Evicted chunk c still found");
+
+  // b and d both have 1 hit, b the older one
+  Hit (cs, bitrates[0], 'd');
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, bitrates[0], 'e', 300), true, "Chunk e should evict");
+  expected.erase (ChunkName (bitrates[0], 'b'));
+  expected.insert (ChunkName (bitrates[0], 'e'));
+  NS_TEST_EXPECT_MSG_EQ ((Cached (cs) == expected), true, "b is the older of the least frequent");
+
+  // e starts at the age of the cache (1 hit), behind d
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, bitrates[0], 'f', 300), true, "Chunk f should evict");
+  expected.erase (ChunkName (bitrates[0], 'd'));
+  expected.insert (ChunkName (bitrates[0], 'f'));
+  NS_TEST_EXPECT_MSG_EQ ((Cached (cs) == expected), true, "d is older than the new chunk e");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetCurrentSize (), 1800, "Bytes after the evictions");
+
+  // Every section keeps its own budget: x is not evicted for the first section,
+  // and a chunk larger than its section is refused
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, bitrates[0], 'g', 400), true, "Chunk g should evict");
+  NS_TEST_EXPECT_MSG_EQ (Cached (cs).count (ChunkName (bitrates[1], 'x')), 1, "Chunk x evicted by another section");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetCurrentSize (), 900 + 1000, "Bytes after the chunk of 400 bytes");
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, bitrates[1], 'y', 1001), false, "Chunk larger than its section cached");
+  NS_TEST_EXPECT_MSG_EQ (Hit (cs, bitrates[1], 'x'), true, "Chunk x evicted by a refused chunk");
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, bitrates[1], 'z', 200), true, "Chunk z should evict");
+  NS_TEST_EXPECT_MSG_EQ (Cached (cs).count (ChunkName (bitrates[1], 'x')), 0, "Chunk x should make room for z");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetCurrentSize (), 200 + 1000, "Bytes of both sections at the end");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,41 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the multisection content store
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_CS_MULTISECTION_H
+#define NDNSIM_TEST_CS_MULTISECTION_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+#include <set>
+#include <string>
+
+namespace ns3 {
+
+namespace ndn {
+class ContentStore;
+}
+
+class MulSecLfuDaTest : public TestCase
+{
+public:
+  MulSecLfuDaTest ()
+    : TestCase ("Multisection LFU-DA content store test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  // Names of the cached chunks, walked without touching the policies
+  std::set<std::string>
+  Cached (Ptr<ndn::ContentStore> cs);
+};
+
+}
+
+#endif // NDNSIM_TEST_CS_MULTISECTION_H
@@ -0,0 +1,148 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the incremental route calculation of GlobalRoutingHelper
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-global-routing.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingTest");
+
+namespace ns3
+{
+
+// Node -> prefix -> face id -> routing cost, of the next hops that are not invalid
+typedef std::vector<std::map<std::string, std::map<uint32_t, int32_t> > > Fibs;
+
+static Fibs
+GetFibs (const NodeContainer &nodes)
+{
+  Fibs fibs (nodes.GetN ());
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<ndn::Fib> fib = nodes.Get (i)->GetObject<ndn::Fib> ();
+      for (Ptr<ndn::fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        {
+          BOOST_FOREACH (const ndn::fib::FaceMetric &metric, entry->GetFaces ())
+            {
+              if (metric.GetStatus () != ndn::fib::FaceMetric::NDN_FIB_RED)
+                fibs[i][entry->GetPrefix ().toUri ()][metric.GetFace ()->GetId ()] = metric.GetRoutingCost ();
+            }
+        }
+    }
+  return fibs;
+}
+
+static bool
+Uses (const Fibs &fibs, uint32_t node, Ptr<ndn::Face> face)
+{
+  for (std::map<std::string, std::map<uint32_t, int32_t> >::const_iterator prefix = fibs[node].begin ();
+       prefix != fibs[node].end (); prefix++)
+    {
+      if (prefix->second.count (face->GetId ()) != 0)
+        return true;
+    }
+  return false;
+}
+
+void
+GlobalRoutingTest::DoRun ()
+{
+  // A ring of 6 with 2 chords (the cheapest links). The metrics are powers of 2, so that
+  // every shortest path is unique
+  const uint32_t links[][2] = { {0, 3}, {1, 4}, {0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 0} };
+  const uint32_t nLinks = sizeof (links) / sizeof (links[0]);
+
+  NodeContainer nodes;
+  nodes.Create (6);
+  PointToPointHelper p2p;
+  std::vector<NetDeviceContainer> devices;
+  for (uint32_t l = 0; l < nLinks; l++)
+    {
+      devices.push_back (p2p.Install (nodes.Get (links[l][0]), nodes.Get (links[l][1])));
+    }
+
+  ndn::StackHelper ndn;
+  ndn.Install (nodes);
+
+  std::vector<std::pair<Ptr<ndn::Face>, Ptr<ndn::Face> > > faces;
+  for (uint32_t l = 0; l < nLinks; l++)
+    {
+      Ptr<ndn::Face> face0 = nodes.Get (links[l][0])->GetObject<ndn::L3Protocol> ()->GetFaceByNetDevice (devices[l].Get (0));
+      Ptr<ndn::Face> face1 = nodes.Get (links[l][1])->GetObject<ndn::L3Protocol> ()->GetFaceByNetDevice (devices[l].Get (1));
+      face0->SetMetric (1 << l);
+      face1->SetMetric (1 << l);
+      faces.push_back (std::make_pair (face0, face1));
+    }
+
+  ndn::GlobalRoutingHelper routing;
+  routing.InstallAll ();
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      routing.AddOrigin ("/node" + boost::lexical_cast<std::string> (i), nodes.Get (i));
+    }
+
+  ndn::GlobalRoutingHelper::CalculateRoutesParallel (2);
+  Fibs before = GetFibs (nodes);
+  NS_TEST_ASSERT_MSG_EQ (before[0].size (), 5, "node 0 has no route to every other node");
+  NS_TEST_ASSERT_MSG_EQ (Uses (before, 0, faces[0].first), true, "the chord 0-3 is not used");
+
+  // Link failure: the incremental update gives the routes of a full calculation
+  ndn::LinkControlHelper::FailLink (nodes.Get (0), nodes.Get (3));
+  ndn::GlobalRoutingHelper::UpdateRoutes (2);
+  Fibs updated = GetFibs (nodes);
+  NS_TEST_ASSERT_MSG_EQ (Uses (updated, 0, faces[0].first), false, "the failed link is still used by node 0");
+  NS_TEST_ASSERT_MSG_EQ (Uses (updated, 3, faces[0].second), false, "the failed link is still used by node 3");
+
+  ndn::GlobalRoutingHelper::CalculateRoutesParallel (1);
+  NS_TEST_ASSERT_MSG_EQ ((updated == GetFibs (nodes)), true, "routes after a link failure differ from a full calculation");
+
+  // Metric change and the link back up, on top of the full calculation
+  faces[1].first->SetMetric (1000);
+  faces[1].second->SetMetric (1000);
+  ndn::LinkControlHelper::UpLink (nodes.Get (0), nodes.Get (3));
+  ndn::GlobalRoutingHelper::UpdateRoutes (3);
+  updated = GetFibs (nodes);
+  NS_TEST_ASSERT_MSG_EQ (Uses (updated, 0, faces[0].first), true, "the link back up is not used");
+
+  ndn::GlobalRoutingHelper::CalculateRoutesParallel (1);
+  NS_TEST_ASSERT_MSG_EQ ((updated == GetFibs (nodes)), true, "routes after a link repair differ from a full calculation");
+
+  // All possible routes: one next hop per face, as the serial calculation gives
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes ();
+  Fibs serial = GetFibs (nodes);
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutesParallel (2);
+  Fibs multipath = GetFibs (nodes);
+  NS_TEST_ASSERT_MSG_EQ ((multipath == serial), true, "all possible routes differ from CalculateAllPossibleRoutes");
+  NS_TEST_ASSERT_MSG_EQ (multipath[0]["/node3"].size (), 3, "node 0 has not one route to node 3 per face");
+  NS_TEST_ASSERT_MSG_EQ (multipath[0]["/node3"][faces[0].first->GetId ()], 1, "the chord 0-3 is not the direct route");
+
+  // The update keeps the mode of the last calculation
+  ndn::LinkControlHelper::FailLink (nodes.Get (0), nodes.Get (3));
+  ndn::GlobalRoutingHelper::UpdateRoutes (2);
+  updated = GetFibs (nodes);
+  NS_TEST_ASSERT_MSG_EQ (Uses (updated, 0, faces[0].first), false, "the failed link is still used by node 0");
+  NS_TEST_ASSERT_MSG_EQ (updated[0]["/node3"].size (), 2, "node 0 has not one route to node 3 per face up");
+
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutesParallel (1);
+  NS_TEST_ASSERT_MSG_EQ ((updated == GetFibs (nodes)), true, "all possible routes after a link failure differ from a full calculation");
+
+  ndn::LinkControlHelper::UpLink (nodes.Get (0), nodes.Get (3));
+  ndn::GlobalRoutingHelper::UpdateRoutes (3);
+  NS_TEST_ASSERT_MSG_EQ ((GetFibs (nodes) == multipath), true, "all possible routes after a link repair differ from a full calculation");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,29 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the incremental route calculation of GlobalRoutingHelper
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_GLOBAL_ROUTING_H
+#define NDNSIM_TEST_GLOBAL_ROUTING_H
+
+#include "ns3/test.h"
+
+namespace ns3 {
+
+class GlobalRoutingTest : public TestCase
+{
+public:
+  GlobalRoutingTest ()
+    : TestCase ("GlobalRoutingHelper UpdateRoutes test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+}
+
+#endif // NDNSIM_TEST_GLOBAL_ROUTING_H
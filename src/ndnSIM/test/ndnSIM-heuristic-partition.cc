@@ -0,0 +1,149 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the heuristic cache partition on several threads
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-heuristic-partition.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.HeuristicPartitionTest");
+
+namespace ns3
+{
+
+static const std::string bitrates[] = { "1000kbps", "2500kbps", "5000kbps" };
+static const uint32_t nBitrates = sizeof (bitrates) / sizeof (bitrates[0]);
+
+std::map<uint32_t, std::vector<std::string> >
+HeuristicPartitionTest::Partition (const NodeContainer &nodes, const NodeContainer &edges,
+                                   uint32_t mode, uint32_t threads)
+{
+  {
+    ndn::HeuPartitionHelper partition ("/video", "1s", 1.0, nBitrates, 1, mode,
+                                       Create<ndn::FileTraceSink> (CreateTempDirFilename ("heuristic")), 0);
+    partition.SetThreads (threads);
+    partition.SetTopologicalOrder (edges);
+    partition.IterativeRun ();
+  }
+
+  std::map<uint32_t, std::vector<std::string> > cached;
+  for (uint32_t i = 1; i < nodes.GetN (); i++)
+    {
+      std::vector<ndn::Name> names;
+      nodes.Get (i)->GetObject<ndn::ContentStore> ()->FillinCacheRun (names);
+      std::vector<std::string> &uris = cached[nodes.Get (i)->GetId ()];
+      for (std::vector<ndn::Name>::const_iterator name = names.begin (); name != names.end (); name++)
+        {
+          uris.push_back (name->toUri ());
+        }
+      std::sort (uris.begin (), uris.end ());
+    }
+  return cached;
+}
+
+void
+HeuristicPartitionTest::DoRun ()
+{
+  // The server, then a tree of 3 routers above 4 edge routers. Every link is {upstream, downstream}
+  const uint32_t links[][2] = { {0, 1}, {1, 2}, {1, 3}, {2, 4}, {2, 5}, {3, 6}, {3, 7} };
+  const uint32_t nLinks = sizeof (links) / sizeof (links[0]);
+
+  NodeContainer nodes;
+  nodes.Create (8);
+  NodeContainer edges;
+  for (uint32_t i = 1; i < nodes.GetN (); i++)
+    {
+      Names::Add ((i < 4 ? "Intermediate" : "Edge") + boost::lexical_cast<std::string> (i), nodes.Get (i));
+      if (i >= 4)
+        edges.Add (nodes.Get (i));
+    }
+
+  PointToPointHelper p2p;
+  for (uint32_t l = 0; l < nLinks; l++)
+    {
+      p2p.Install (nodes.Get (links[l][0]), nodes.Get (links[l][1]));
+    }
+
+  ndn::StackHelper server;
+  server.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  server.SetContentStore ("ns3::ndn::cs::Nocache");
+  server.Install (nodes.Get (0), bitrates, nBitrates);
+
+  ndn::StackHelper edge;
+  edge.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  edge.SetContentStore ("ns3::ndn::cs::AdptiveVideo::Lru", "MaxSize", "12000000");
+  ndn::StackHelper intermediate;
+  intermediate.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  intermediate.SetContentStore ("ns3::ndn::cs::AdptiveVideo::Lru", "MaxSize", "20000000");
+  for (uint32_t i = 1; i < nodes.GetN (); i++)
+    {
+      (i < 4 ? intermediate : edge).Install (nodes.Get (i), bitrates, nBitrates);
+    }
+
+  ndn::AppHelper producer ("ns3::ndn::VideoProducer");
+  producer.SetPrefix ("/video");
+  producer.Install (nodes.Get (0));
+
+  // Static routes towards the server
+  for (uint32_t l = 0; l < nLinks; l++)
+    {
+      ndn::StackHelper::AddRoute (nodes.Get (links[l][1]), "/video", nodes.Get (links[l][0]), 1);
+    }
+
+  // Every edge router sees the chunks with its own popularity, which overlaps the others.
+  // Files and chunks count from 1, as in the names of the video consumers
+  for (uint32_t e = 0; e < edges.GetN (); e++)
+    {
+      Ptr<ndn::NDNBitRate> brinfo = edges.Get (e)->GetObject<ndn::NDNBitRate> ();
+      Ptr<ndn::VideoStatistics> stat = edges.Get (e)->GetObject<ndn::VideoStatistics> ();
+      NS_ABORT_MSG_IF (stat == 0, "Edge routers should have video statistics");
+      for (uint32_t b = 0; b < nBitrates; b++)
+        {
+          uint32_t rank = brinfo->GetRankFromBR (bitrates[b]);
+          for (uint32_t f = 1; f <= 20; f++)
+            {
+              for (uint32_t k = 1; k <= 2; k++)
+                {
+                  uint32_t requests = 1 + (f * 7 + e * 3 + b * 5 + k) % 23;
+                  for (uint32_t n = 0; n < requests; n++)
+                    {
+                      stat->Add (ndn::VideoIndex (rank, f, k));
+                    }
+                }
+            }
+        }
+    }
+
+  // The cache stack of every router depends on the stacks of the routers below it only:
+  // the routers of the two subtrees run in parallel, and must decide the same as in order
+  for (uint32_t mode = 0; mode <= 1; mode++)
+    {
+      std::map<uint32_t, std::vector<std::string> > one = Partition (nodes, edges, mode, 1);
+      std::map<uint32_t, std::vector<std::string> > many = Partition (nodes, edges, mode, 4);
+
+      size_t total = 0;
+      for (std::map<uint32_t, std::vector<std::string> >::const_iterator node = one.begin ();
+           node != one.end (); node++)
+        {
+          total += node->second.size ();
+          NS_TEST_EXPECT_MSG_EQ (node->second.size (), many[node->first].size (),
+                                 "Mode " << mode << ", node " << node->first << ": same number of cached chunks");
+          NS_TEST_EXPECT_MSG_EQ ((node->second == many[node->first]), true,
+                                 "Mode " << mode << ", node " << node->first << ": same cached chunks");
+        }
+      NS_TEST_EXPECT_MSG_GT (total, 0, "Mode " << mode << ": some chunks should be cached");
+    }
+
+  Simulator::Destroy ();
+  Names::Clear ();
+}
+
+}
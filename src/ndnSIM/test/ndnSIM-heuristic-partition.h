@@ -0,0 +1,38 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the heuristic cache partition on several threads
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_HEURISTIC_PARTITION_H
+#define NDNSIM_TEST_HEURISTIC_PARTITION_H
+
+#include "ns3/test.h"
+#include "ns3/node-container.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class HeuristicPartitionTest : public TestCase
+{
+public:
+  HeuristicPartitionTest ()
+    : TestCase ("Heuristic cache partition thread count test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  // Node id -> sorted names cached by the partition of the given mode
+  std::map<uint32_t, std::vector<std::string> >
+  Partition (const NodeContainer &nodes, const NodeContainer &edges, uint32_t mode, uint32_t threads);
+};
+
+}
+
+#endif // NDNSIM_TEST_HEURISTIC_PARTITION_H
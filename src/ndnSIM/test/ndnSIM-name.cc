@@ -0,0 +1,104 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the Name buffer shared by copies and prefixes
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-name.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <boost/functional/hash.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.NameTest");
+
+namespace ns3
+{
+
+void
+NameTest::DoRun ()
+{
+  typedef ndn::name::Component Component;
+
+  // Copy
+  ndn::Name name ("/a/b/c");
+  ndn::Name copy (name);
+  NS_TEST_ASSERT_MSG_EQ (copy, name, "copy differs");
+  copy.append ("d");
+  NS_TEST_ASSERT_MSG_EQ (copy.toUri (), "/a/b/c/d", "append to the copy");
+  NS_TEST_ASSERT_MSG_EQ (name.toUri (), "/a/b/c", "append to the copy changed the original");
+  name.append ("e");
+  NS_TEST_ASSERT_MSG_EQ (name.toUri (), "/a/b/c/e", "append to the original");
+  NS_TEST_ASSERT_MSG_EQ (copy.toUri (), "/a/b/c/d", "append to the original changed the copy");
+
+  ndn::Name assigned;
+  assigned = name;
+  NS_TEST_ASSERT_MSG_EQ (assigned, name, "assigned name differs");
+  assigned = ndn::Name ();
+  NS_TEST_ASSERT_MSG_EQ (assigned.size (), 0, "empty name assigned");
+  NS_TEST_ASSERT_MSG_EQ (assigned.toUri (), "/", "empty name assigned");
+  NS_TEST_ASSERT_MSG_EQ (name.size (), 4, "assignment changed the source");
+
+  // Prefix views
+  ndn::Name prefix = name.getPrefix (2);
+  ndn::Name postfix = name.getPostfix (1);
+  ndn::Name sub = name.getSubName (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (prefix.toUri (), "/a/b", "prefix");
+  NS_TEST_ASSERT_MSG_EQ (postfix.toUri (), "/e", "postfix");
+  NS_TEST_ASSERT_MSG_EQ (sub.toUri (), "/b/c", "subname");
+  NS_TEST_ASSERT_MSG_EQ (sub.getSubName (1).toUri (), "/c", "subname of a subname");
+  NS_TEST_ASSERT_MSG_EQ (name.getPrefix (0).size (), 0, "empty prefix");
+  NS_TEST_ASSERT_MSG_EQ (sub.get (-1), Component ("c"), "last component of a subname");
+  NS_TEST_ASSERT_MSG_EQ (sub [0], Component ("b"), "first component of a subname");
+  NS_TEST_ASSERT_MSG_EQ (sub.end () - sub.begin (), 2, "iterators of a subname");
+  NS_TEST_ASSERT_MSG_EQ (*sub.rbegin (), Component ("c"), "reverse iterators of a subname");
+  NS_TEST_ASSERT_MSG_EQ ((prefix < name), true, "prefix is before the name");
+
+  prefix.append ("x");
+  sub.append ("y");
+  NS_TEST_ASSERT_MSG_EQ (prefix.toUri (), "/a/b/x", "append to a prefix");
+  NS_TEST_ASSERT_MSG_EQ (sub.toUri (), "/b/c/y", "append to a subname");
+  NS_TEST_ASSERT_MSG_EQ (name.toUri (), "/a/b/c/e", "append to a view changed the name");
+  NS_TEST_ASSERT_MSG_EQ (postfix.toUri (), "/e", "append to a view changed another view");
+
+  // A view left alone on the buffer keeps only its components on append
+  ndn::Name view;
+  {
+    ndn::Name owner ("/x/y/z");
+    view = owner.getSubName (1, 1);
+  }
+  view.append ("w");
+  NS_TEST_ASSERT_MSG_EQ (view.toUri (), "/y/w", "append to the last view");
+  view.append (view);
+  NS_TEST_ASSERT_MSG_EQ (view.toUri (), "/y/w/y/w", "append of self");
+
+  // Hash
+  ndn::Name other ("/a/b/c/e");
+  for (size_t i = 0; i < name.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (boost::hash_value (name [i]), boost::hash_value (other [i]),
+                             "hash of equal components differs");
+      NS_TEST_ASSERT_MSG_EQ (boost::hash_value (name [i]), boost::hash_range (other [i].begin (), other [i].end ()),
+                             "hash differs from the hash of the bytes");
+    }
+  NS_TEST_ASSERT_MSG_EQ (boost::hash_value (name.getSubName (1) [0]), boost::hash_value (Component ("b")), "hash of a view");
+
+  // Mutation isolation: a component taken out of a name is a copy
+  std::size_t before = boost::hash_value (name [1]);
+  Component changed = name [1];
+  changed.push_back ('z');
+  NS_TEST_ASSERT_MSG_NE (boost::hash_value (changed), before, "hash of the changed component is stale");
+  NS_TEST_ASSERT_MSG_EQ (boost::hash_value (changed), boost::hash_value (Component ("bz")), "hash of the changed component");
+  NS_TEST_ASSERT_MSG_EQ (name [1], Component ("b"), "change of a component copy reached the name");
+  NS_TEST_ASSERT_MSG_EQ (copy [1], Component ("b"), "change of a component copy reached a copy");
+  NS_TEST_ASSERT_MSG_EQ (boost::hash_value (name [1]), before, "change of a component copy changed the hash");
+
+  Component swapped ("s");
+  copy.appendBySwap (swapped);
+  NS_TEST_ASSERT_MSG_EQ (swapped.size (), 0, "appendBySwap left the component");
+  NS_TEST_ASSERT_MSG_EQ (copy.toUri (), "/a/b/c/d/s", "appendBySwap");
+  NS_TEST_ASSERT_MSG_EQ (name.toUri (), "/a/b/c/e", "appendBySwap to a copy changed the original");
+}
+
+}
@@ -0,0 +1,29 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the Name buffer shared by copies and prefixes
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_NAME_H
+#define NDNSIM_TEST_NAME_H
+
+#include "ns3/test.h"
+
+namespace ns3 {
+
+class NameTest : public TestCase
+{
+public:
+  NameTest ()
+    : TestCase ("Name sharing test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+}
+
+#endif // NDNSIM_TEST_NAME_H
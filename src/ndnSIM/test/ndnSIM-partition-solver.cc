@@ -0,0 +1,188 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the greedy cache partition solver
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-partition-solver.h"
+#include "ns3/core-module.h"
+#include "ns3/ndn-partition-solver.h"
+
+#include <algorithm>
+#include <random>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GreedyPartitionSolverTest");
+
+namespace ns3
+{
+
+using ndn::PartitionProblem;
+using ndn::PartitionPlacement;
+using ndn::PartitionSolver;
+
+/*
+ * Routers 1..nodes and the producer 0. Every path goes from an edge router,
+ * through up to 2 other routers, to the gateway 1 and the producer. The
+ * reward decreases towards the producer.
+ */
+static PartitionProblem
+MakeProblem (std::minstd_rand &random)
+{
+  PartitionProblem problem;
+  problem.m_bitrates = 1 + random () % 3;
+  uint32_t items = 2 + random () % 12;
+  uint32_t nodes = 2 + random () % 5;
+
+  for (uint32_t v = 0; v < items; v++)
+    {
+      PartitionProblem::Item item;
+      item.m_bitrate = 1 + random () % problem.m_bitrates;
+      item.m_size = 1 + random () % 5;
+      problem.m_items.push_back (item);
+    }
+
+  problem.m_capacity.assign (nodes + 1, 0);
+  for (uint32_t n = 1; n <= nodes; n++)
+    {
+      problem.m_nodes.push_back (n);
+      problem.m_capacity[n] = random () % 12;
+    }
+
+  uint32_t paths = 1 + random () % 3;
+  for (uint32_t m = 0; m < paths; m++)
+    {
+      PartitionProblem::Path path;
+      uint32_t below = random () % 3;
+      for (uint32_t k = 0; k < below; k++)
+        {
+          uint32_t n = 2 + random () % (nodes - 1);
+          if (std::find (path.m_nodes.begin (), path.m_nodes.end (), n) == path.m_nodes.end ())
+            path.m_nodes.push_back (n);
+        }
+      path.m_nodes.push_back (1);
+      path.m_nodes.push_back (0);
+      path.m_edge = path.m_nodes[0];
+
+      path.m_reward.assign (problem.m_bitrates + 1, std::vector<double> (path.m_nodes.size ()));
+      for (uint32_t b = 1; b <= problem.m_bitrates; b++)
+        {
+          double reward = 10;
+          for (uint32_t pos = 0; pos < path.m_nodes.size (); pos++)
+            {
+              path.m_reward[b][pos] = reward;
+              reward -= 1 + random () % 3;
+            }
+        }
+
+      path.m_popularity.assign (items, 0);
+      std::vector<std::pair<double, uint32_t> > popular;
+      for (uint32_t v = 0; v < items; v++)
+        {
+          if (random () % 3 != 0)
+            {
+              path.m_popularity[v] = 1 + random () % 20;
+              popular.push_back (std::make_pair (-path.m_popularity[v], v));
+            }
+        }
+      std::sort (popular.begin (), popular.end ());
+      path.m_order.assign (problem.m_bitrates + 1, std::vector<uint32_t> ());
+      for (uint32_t i = 0; i < popular.size (); i++)
+        {
+          path.m_order[problem.m_items[popular[i].second].m_bitrate].push_back (popular[i].second);
+        }
+      problem.m_paths.push_back (path);
+    }
+  return problem;
+}
+
+void
+GreedyPartitionSolverTest::CheckFeasible (const PartitionProblem &problem,
+                                          const PartitionPlacement &placement,
+                                          uint32_t trial)
+{
+  // cached[node][item]
+  std::vector<std::vector<bool> > cached (problem.m_capacity.size (),
+                                          std::vector<bool> (problem.m_items.size (), false));
+  std::vector<double> used (problem.m_capacity.size (), 0);
+  for (PartitionPlacement::const_iterator entry = placement.begin (); entry != placement.end (); entry++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((std::find (problem.m_nodes.begin (), problem.m_nodes.end (), entry->first)
+                              != problem.m_nodes.end ()), true, "trial " << trial << ": not a router");
+      NS_TEST_ASSERT_MSG_EQ (cached[entry->first][entry->second], false, "trial " << trial << ": placed twice");
+      cached[entry->first][entry->second] = true;
+      used[entry->first] += problem.m_items[entry->second].m_size;
+    }
+  for (uint32_t n = 0; n < problem.m_capacity.size (); n++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((used[n] <= problem.m_capacity[n]), true, "trial " << trial << ": capacity of node " << n);
+    }
+
+  /*
+   * Order constraint, in the big-M form of the solver: below the gateway g, if item
+   * order[idx] is found up to position pos, every more popular item of its bitrate
+   * found up to g is found up to pos.
+   */
+  for (std::vector<PartitionProblem::Path>::const_iterator path = problem.m_paths.begin ();
+       path != problem.m_paths.end (); path++)
+    {
+      uint32_t last = path->m_nodes.size () - 1;
+      uint32_t gateway = path->GetGateway ();
+      // found[pos][item]: item is cached at a position up to pos, or pos is the producer
+      std::vector<std::vector<int> > found (path->m_nodes.size (), std::vector<int> (problem.m_items.size (), 0));
+      for (uint32_t pos = 0; pos <= last; pos++)
+        {
+          for (uint32_t v = 0; v < problem.m_items.size (); v++)
+            {
+              found[pos][v] = (pos == last || cached[path->m_nodes[pos]][v] || (pos > 0 && found[pos - 1][v])) ? 1 : 0;
+            }
+        }
+
+      for (uint32_t pos = 0; pos < gateway; pos++)
+        {
+          for (uint32_t b = 0; b < path->m_order.size (); b++)
+            {
+              const std::vector<uint32_t> &order = path->m_order[b];
+              int missing = 0;
+              for (uint32_t idx = 1; idx < order.size (); idx++)
+                {
+                  missing += found[gateway][order[idx - 1]] - found[pos][order[idx - 1]];
+                  NS_TEST_ASSERT_MSG_EQ ((found[pos][order[idx]] && missing > 0), false,
+                                         "trial " << trial << ": order of bitrate " << b << " violated at position " << pos);
+                }
+            }
+        }
+    }
+}
+
+void
+GreedyPartitionSolverTest::DoRun ()
+{
+  std::minstd_rand random (7);
+  for (uint32_t trial = 0; trial < 500; trial++)
+    {
+      PartitionProblem problem = MakeProblem (random);
+      Ptr<PartitionSolver> solver = PartitionSolver::Create ("Greedy");
+
+      PartitionPlacement cold;
+      NS_TEST_ASSERT_MSG_EQ (solver->Solve (problem, 0, cold), PartitionSolver::HEURISTIC, "trial " << trial);
+      CheckFeasible (problem, cold, trial);
+      double value = PartitionSolver::Evaluate (problem, cold);
+
+      // Warm start from the cold placement, and from half of it
+      PartitionPlacement warm;
+      NS_TEST_ASSERT_MSG_EQ (solver->Solve (problem, &cold, warm), PartitionSolver::HEURISTIC, "trial " << trial);
+      CheckFeasible (problem, warm, trial);
+      NS_TEST_ASSERT_MSG_EQ ((PartitionSolver::Evaluate (problem, warm) >= value), true,
+                             "trial " << trial << ": warm start lost value");
+
+      PartitionPlacement half (cold.begin (), cold.begin () + cold.size () / 2);
+      double halfValue = PartitionSolver::Evaluate (problem, half);
+      NS_TEST_ASSERT_MSG_EQ (solver->Solve (problem, &half, warm), PartitionSolver::HEURISTIC, "trial " << trial);
+      CheckFeasible (problem, warm, trial);
+      NS_TEST_ASSERT_MSG_EQ ((PartitionSolver::Evaluate (problem, warm) >= halfValue), true,
+                             "trial " << trial << ": partial warm start lost value");
+    }
+}
+
+}
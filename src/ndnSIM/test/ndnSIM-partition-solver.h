@@ -0,0 +1,41 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the greedy cache partition solver
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_PARTITION_SOLVER_H
+#define NDNSIM_TEST_PARTITION_SOLVER_H
+
+#include "ns3/test.h"
+
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+namespace ndn {
+struct PartitionProblem;
+}
+
+class GreedyPartitionSolverTest : public TestCase
+{
+public:
+  GreedyPartitionSolverTest ()
+    : TestCase ("Greedy cache partition solver test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  CheckFeasible (const ndn::PartitionProblem &problem,
+                 const std::vector<std::pair<uint32_t, uint32_t> > &placement,
+                 uint32_t trial);
+};
+
+}
+
+#endif // NDNSIM_TEST_PARTITION_SOLVER_H
@@ -0,0 +1,203 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the pass-through of Interest/Data objects over point-to-point links
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-pass-through.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndnSIM/model/wire/pass-through.h"
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
+
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PassThroughTest");
+
+namespace ns3
+{
+
+static const std::string bitrates[] = { "1000kbps" };
+
+static void
+ReceiveInterest (Ptr<const ndn::Interest> *received, Ptr<const ndn::Interest> interest, Ptr<const ndn::Face> face)
+{
+  *received = interest;
+}
+
+static void
+ReceiveData (Ptr<const ndn::Data> *received, Ptr<const ndn::Data> data, Ptr<const ndn::Face> face)
+{
+  *received = data;
+}
+
+static void
+Transmit (std::vector<uint32_t> *sizes, uint32_t *tagged, Ptr<const Packet> packet)
+{
+  sizes->push_back (packet->GetSize ());
+  ndn::wire::passThrough::Tag tag;
+  if (packet->PeekPacketTag (tag))
+    {
+      (*tagged)++;
+    }
+}
+
+static Ptr<Packet>
+HopCountPayload (uint32_t size)
+{
+  Ptr<Packet> payload = Create<Packet> (size);
+  ndn::FwHopCountTag hopCount;
+  hopCount.Increment ();
+  payload->AddPacketTag (hopCount);
+  return payload;
+}
+
+static uint32_t
+HopCount (Ptr<const Packet> payload)
+{
+  ndn::FwHopCountTag hopCount;
+  return payload->PeekPacketTag (hopCount) ? hopCount.Get () : 0;
+}
+
+PassThroughTest::Received
+PassThroughTest::Send (bool passThrough)
+{
+  // Faces read the global value when they are created
+  Config::SetGlobal ("ndn::WirePassThrough", BooleanValue (passThrough));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  PointToPointHelper p2p;
+  NetDeviceContainer devices = p2p.Install (nodes.Get (0), nodes.Get (1));
+  ndn::StackHelper ndn;
+  ndn.SetContentStore ("ns3::ndn::cs::Nocache");
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      ndn.Install (nodes.Get (i), bitrates, 1);
+    }
+
+  Received received;
+  received.m_tagged = 0;
+  Ptr<ndn::ForwardingStrategy> strategy = nodes.Get (1)->GetObject<ndn::ForwardingStrategy> ();
+  strategy->TraceConnectWithoutContext ("InInterests", MakeBoundCallback (&ReceiveInterest, &received.m_interest));
+  strategy->TraceConnectWithoutContext ("InData", MakeBoundCallback (&ReceiveData, &received.m_data));
+  devices.Get (0)->TraceConnectWithoutContext ("MacTx", MakeBoundCallback (&Transmit, &received.m_sizes, &received.m_tagged));
+
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> (HopCountPayload (0));
+  interest->SetName (Create<ndn::Name> ("/video/br1000kbps/3/7"));
+  interest->SetNonce (12345);
+  interest->SetScope (2);
+  interest->SetInterestLifetime (Seconds (4));
+  interest->SetTSI (3);
+  interest->SetAcc (42);
+  interest->SetBRBoundary (2500000);
+  Ptr<ndn::Exclude> exclude = Create<ndn::Exclude> ();
+  exclude->excludeAfter (ndn::name::Component ("a"));
+  interest->SetExclude (exclude);
+
+  Ptr<ndn::Data> data = Create<ndn::Data> (HopCountPayload (1024));
+  data->SetName (Create<ndn::Name> ("/video/br1000kbps/3/7"));
+  data->SetSignature (7);
+  data->SetTimestamp (MilliSeconds (1500));
+  data->SetFreshness (Seconds (10));
+  data->SetTSI (1);
+  data->SetTSB (2);
+  data->SetAcc (99);
+  data->SetReward (321);
+  data->SetHops (2);
+  data->SetDelay (0, 11);
+  data->SetDelay (1, 13);
+
+  Ptr<ndn::Face> face = nodes.Get (0)->GetObject<ndn::L3Protocol> ()->GetFaceByNetDevice (devices.Get (0));
+  Simulator::Schedule (Seconds (1), &ndn::Face::SendInterest, face, interest);
+  Simulator::Schedule (Seconds (2), &ndn::Face::SendData, face, data);
+  Simulator::Stop (Seconds (3));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return received;
+}
+
+void
+PassThroughTest::DoRun ()
+{
+  Received encoded = Send (false);
+  Received byReference = Send (true);
+
+  NS_TEST_ASSERT_MSG_EQ (encoded.m_tagged, 0, "Packets sent by reference with the mode off");
+  NS_TEST_ASSERT_MSG_EQ (byReference.m_tagged, 2, "The mode was set before the faces were created");
+
+  // The link and its queues see packets of the same size
+  NS_TEST_ASSERT_MSG_EQ (encoded.m_sizes.size (), 2, "One packet per object");
+  NS_TEST_ASSERT_MSG_EQ ((encoded.m_sizes == byReference.m_sizes), true, "Sizes differ from the encoding");
+
+  // The receiver gets what deserializing the encoding gives
+  Ptr<const ndn::Interest> i1 = encoded.m_interest;
+  Ptr<const ndn::Interest> i2 = byReference.m_interest;
+  NS_TEST_ASSERT_MSG_EQ ((i1 != 0), true, "Encoded Interest not received");
+  NS_TEST_ASSERT_MSG_EQ ((i2 != 0), true, "Interest not received by reference");
+  if (i1 == 0 || i2 == 0)
+    {
+      return;
+    }
+  NS_TEST_ASSERT_MSG_EQ (i1->GetName (), i2->GetName (), "Interest name");
+  NS_TEST_ASSERT_MSG_EQ (i1->GetNonce (), i2->GetNonce (), "Interest nonce");
+  NS_TEST_ASSERT_MSG_EQ (i1->GetScope (), i2->GetScope (), "Interest scope");
+  NS_TEST_ASSERT_MSG_EQ (i1->GetNack (), i2->GetNack (), "Interest NACK");
+  NS_TEST_ASSERT_MSG_EQ (i1->GetInterestLifetime (), i2->GetInterestLifetime (), "Interest lifetime");
+  NS_TEST_ASSERT_MSG_EQ (i1->GetTSI (), i2->GetTSI (), "Interest TSI");
+  NS_TEST_ASSERT_MSG_EQ (i1->GetAcc (), i2->GetAcc (), "Interest ACC");
+  NS_TEST_ASSERT_MSG_EQ (i1->GetBRBoundary (), i2->GetBRBoundary (), "Interest bitrate boundary");
+  NS_TEST_ASSERT_MSG_EQ ((i1->GetExclude () != 0 && i2->GetExclude () != 0), true, "Interest exclude");
+  if (i1->GetExclude () == 0 || i2->GetExclude () == 0)
+    {
+      return;
+    }
+  std::ostringstream exclude1, exclude2;
+  exclude1 << *i1->GetExclude ();
+  exclude2 << *i2->GetExclude ();
+  NS_TEST_ASSERT_MSG_EQ (exclude1.str (), exclude2.str (), "Interest exclude");
+  NS_TEST_ASSERT_MSG_EQ (i1->GetPayload ()->GetSize (), i2->GetPayload ()->GetSize (), "Interest payload");
+  NS_TEST_ASSERT_MSG_EQ (HopCount (i1->GetPayload ()), 2, "Hop count of the encoded Interest");
+  NS_TEST_ASSERT_MSG_EQ (HopCount (i2->GetPayload ()), 2, "Hop count of the Interest by reference");
+
+  Ptr<const ndn::Data> d1 = encoded.m_data;
+  Ptr<const ndn::Data> d2 = byReference.m_data;
+  NS_TEST_ASSERT_MSG_EQ ((d1 != 0), true, "Encoded Data not received");
+  NS_TEST_ASSERT_MSG_EQ ((d2 != 0), true, "Data not received by reference");
+  if (d1 == 0 || d2 == 0)
+    {
+      return;
+    }
+  NS_TEST_ASSERT_MSG_EQ (d1->GetName (), d2->GetName (), "Data name");
+  NS_TEST_ASSERT_MSG_EQ (d1->GetSignature (), d2->GetSignature (), "Data signature");
+  NS_TEST_ASSERT_MSG_EQ (d1->GetTimestamp (), d2->GetTimestamp (), "Data timestamp");
+  NS_TEST_ASSERT_MSG_EQ (d1->GetFreshness (), d2->GetFreshness (), "Data freshness");
+  NS_TEST_ASSERT_MSG_EQ (static_cast<int> (d1->GetTSI ()), static_cast<int> (d2->GetTSI ()), "Data TSI");
+  NS_TEST_ASSERT_MSG_EQ (static_cast<int> (d1->GetTSB ()), static_cast<int> (d2->GetTSB ()), "Data TSB");
+  NS_TEST_ASSERT_MSG_EQ (d1->GetAcc (), d2->GetAcc (), "Data ACC");
+  NS_TEST_ASSERT_MSG_EQ (d1->GetReward (), d2->GetReward (), "Data reward");
+  NS_TEST_ASSERT_MSG_EQ (static_cast<int> (d1->GetHops ()), static_cast<int> (d2->GetHops ()), "Data hops");
+  for (int k = 0; k < static_cast<int> (d1->GetHops ()); k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (d1->GetDelay (k), d2->GetDelay (k), "Data delay " << k);
+    }
+  NS_TEST_ASSERT_MSG_EQ (d1->GetPayload ()->GetSize (), d2->GetPayload ()->GetSize (), "Data payload");
+  NS_TEST_ASSERT_MSG_EQ (HopCount (d1->GetPayload ()), 2, "Hop count of the encoded Data");
+  NS_TEST_ASSERT_MSG_EQ (HopCount (d2->GetPayload ()), 2, "Hop count of the Data by reference");
+
+  // A packet whose object is unknown (received twice, or after it was released) is dropped
+  Ptr<Packet> stray = Create<Packet> (100);
+  using ndn::wire::passThrough::Tag;
+  NS_TEST_ASSERT_MSG_EQ ((ndn::wire::passThrough::Interest::FromWire (stray, Tag (1, Tag::INTEREST)) == 0), true,
+                         "Unknown Interest should be dropped");
+  NS_TEST_ASSERT_MSG_EQ ((ndn::wire::passThrough::Data::FromWire (stray, Tag (2, Tag::DATA)) == 0), true,
+                         "Unknown Data should be dropped");
+  Simulator::Destroy ();
+
+  Config::SetGlobal ("ndn::WirePassThrough", BooleanValue (false));
+}
+
+}
@@ -0,0 +1,49 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the pass-through of Interest/Data objects over point-to-point links
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_PASS_THROUGH_H
+#define NDNSIM_TEST_PASS_THROUGH_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+#include <vector>
+
+namespace ns3 {
+
+namespace ndn {
+class Interest;
+class Data;
+}
+
+class PassThroughTest : public TestCase
+{
+public:
+  PassThroughTest ()
+    : TestCase ("Wire pass-through test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  // What the other end of the link received, and the sizes of the packets sent on it
+  struct Received
+  {
+    Ptr<const ndn::Interest> m_interest;
+    Ptr<const ndn::Data> m_data;
+    std::vector<uint32_t> m_sizes;
+    uint32_t m_tagged;  // sent packets carrying an object by reference
+  };
+
+  Received
+  Send (bool passThrough);
+};
+
+}
+
+#endif // NDNSIM_TEST_PASS_THROUGH_H
@@ -25,6 +25,8 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE ("ndn.PitTest");
 
 namespace ns3
@@ -141,4 +143,278 @@ PitTest::DoRun ()
   Simulator::Destroy ();
 }
 
+/**
+ * Sends Interests of various lifetimes at irregular times, refreshing some of them
+ */
+class PitExpirationClient : public ndn::App
+{
+protected:
+  void
+  StartApplication ()
+  {
+    ndn::App::StartApplication ();
+
+    Ptr<ndn::fib::Entry> fibEntry = GetNode ()->GetObject<ndn::Fib> ()->Add (ndn::Name ("/"), m_face, 0);
+    fibEntry->UpdateStatus (m_face, ndn::fib::FaceMetric::NDN_FIB_GREEN);
+
+    Send (0.1,   "/a", 1, 0.5);
+    Send (0.137, "/b", 1, 0.333);
+    Send (0.25,  "/c", 1, 1.2345);
+    Send (0.4,   "/a", 2, 0.5);    // refresh
+    Send (0.61,  "/d", 1, 0.05);
+    Send (0.613, "/e", 1, 0.0001);
+    Send (0.7,   "/c", 2, 0.1);    // refresh ending earlier: expiration unchanged
+    Send (1.0,   "/f", 1, 2.0);
+    Send (1.3,   "/g", 1, 0.123456);
+  }
+
+private:
+  void
+  Send (double time, const std::string &prefix, uint32_t nonce, double lifetime)
+  {
+    Simulator::Schedule (Seconds (time), &PitExpirationClient::SendPacket, this, prefix, nonce, lifetime);
+  }
+
+  void
+  SendPacket (const std::string &prefix, uint32_t nonce, double lifetime)
+  {
+    Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+    interest->SetName (Create<ndn::Name> (prefix));
+    interest->SetNonce (nonce);
+    interest->SetInterestLifetime (Seconds (lifetime));
+
+    m_face->ReceiveInterest (interest);
+  }
+};
+
+void
+PitExpirationTest::TimedOut (Ptr<const ndn::pit::Entry> entry)
+{
+  m_timedOut[entry->GetPrefix ().toUri ()] = Simulator::Now ();
+}
+
+std::map<std::string, Time>
+PitExpirationTest::Run (const std::string &tick)
+{
+  m_timedOut.clear ();
+
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.SetPit ("ns3::ndn::pit::Persistent", "ExpirationTick", tick);
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  // Interests go to the sink, which never answers: the entries stay until they time out
+  ndn::StackHelper::AddRoute (node, "/", 0, 0);
+
+  node->GetObject<ndn::ForwardingStrategy> ()->TraceConnectWithoutContext
+    ("TimedOutInterests", MakeCallback (&PitExpirationTest::TimedOut, this));
+
+  Ptr<Application> app = CreateObject<PitExpirationClient> ();
+  app->SetStartTime (Seconds (0.0));
+  node->AddApplication (app);
+
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  return m_timedOut;
+}
+
+void
+PitExpirationTest::DoRun ()
+{
+  std::map<std::string, Time> exact = Run ("0s");
+  NS_TEST_ASSERT_MSG_EQ (exact.size (), 7, "Every PIT entry should time out");
+
+  const char *ticks[] = { "1us", "1ms", "7ms", "100ms" };
+  for (uint32_t i = 0; i < sizeof (ticks) / sizeof (ticks[0]); i++)
+    {
+      std::map<std::string, Time> wheel = Run (ticks[i]);
+      int64_t tick = Time (ticks[i]).GetTimeStep ();
+
+      NS_TEST_ASSERT_MSG_EQ (wheel.size (), exact.size (), "Tick " << ticks[i] << ": other entries timed out");
+      for (std::map<std::string, Time>::iterator entry = exact.begin (); entry != exact.end (); entry++)
+        {
+          // the first tick at or after the exact expiration
+          Time expected = TimeStep ((entry->second.GetTimeStep () + tick - 1) / tick * tick);
+          NS_TEST_ASSERT_MSG_EQ (wheel[entry->first], expected,
+                                 "Tick " << ticks[i] << ": " << entry->first << " timed out at the wrong time");
+        }
+    }
+}
+
+typedef ndn::pit::Entry::in_container InRecords;
+
+// Face ids of the records, in iteration order
+static std::vector<uint32_t>
+Ids (const InRecords &records)
+{
+  std::vector<uint32_t> ids;
+  for (InRecords::const_iterator record = records.begin (); record != records.end (); record++)
+    {
+      ids.push_back (record->m_face->GetId ());
+    }
+  return ids;
+}
+
+// Whether the records are kept inside the container, rather than allocated
+static bool
+IsInline (const InRecords &records)
+{
+  const char *data = reinterpret_cast<const char *> (records.begin ());
+  const char *object = reinterpret_cast<const char *> (&records);
+  return data >= object && data < object + sizeof (records);
+}
+
+void
+PitFaceRecordsTest::Records (const std::vector<Ptr<ndn::Face> > &faces, uint32_t n)
+{
+  // shuffled face ids; the records should come out sorted by face
+  const uint32_t order[] = { 5, 2, 7, 0, 3, 6, 1, 4 };
+
+  InRecords records;
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      std::pair<InRecords::iterator, bool> ret = records.insert (ndn::pit::IncomingFace (faces[order[i]], order[i]));
+      NS_TEST_ASSERT_MSG_EQ (ret.second, true, n << " faces: face " << order[i] << " should be inserted");
+      NS_TEST_ASSERT_MSG_EQ (ret.first->m_face, faces[order[i]], n << " faces: insert should return the new record");
+      expected.push_back (order[i]);
+    }
+  std::sort (expected.begin (), expected.end ());
+
+  NS_TEST_ASSERT_MSG_EQ (records.size (), n, n << " faces: wrong size");
+  NS_TEST_ASSERT_MSG_EQ (records.empty (), (n == 0), n << " faces: wrong emptiness");
+  NS_TEST_ASSERT_MSG_EQ ((Ids (records) == expected), true, n << " faces: records should be sorted by face");
+  NS_TEST_ASSERT_MSG_EQ (IsInline (records), (n <= 3), n << " faces: only more than 3 records should be allocated");
+  for (uint32_t id = 0; id < faces.size (); id++)
+    {
+      InRecords::const_iterator record = records.find (faces[id]);
+      bool present = std::find (expected.begin (), expected.end (), id) != expected.end ();
+      NS_TEST_ASSERT_MSG_EQ ((record != records.end ()), present, n << " faces: find of face " << id);
+      if (present)
+        {
+          NS_TEST_ASSERT_MSG_EQ (record->m_reward, id, n << " faces: record of face " << id << " has another reward");
+        }
+    }
+
+  // duplicates leave the records as they are
+  for (uint32_t i = 0; i < n; i++)
+    {
+      std::pair<InRecords::iterator, bool> ret = records.insert (ndn::pit::IncomingFace (faces[order[i]], 100));
+      NS_TEST_ASSERT_MSG_EQ (ret.second, false, n << " faces: face " << order[i] << " inserted twice");
+      NS_TEST_ASSERT_MSG_EQ (ret.first->m_reward, order[i], n << " faces: duplicate should return the first record");
+    }
+  NS_TEST_ASSERT_MSG_EQ (records.size (), n, n << " faces: duplicates changed the size");
+
+  // copies do not share the records, whether inline or not
+  InRecords copy (records);
+  InRecords assigned;
+  assigned.insert (ndn::pit::IncomingFace (faces[0]));
+  assigned.insert (ndn::pit::IncomingFace (faces[1]));
+  assigned.insert (ndn::pit::IncomingFace (faces[2]));
+  assigned.insert (ndn::pit::IncomingFace (faces[3]));
+  assigned = records;
+  NS_TEST_ASSERT_MSG_EQ ((Ids (copy) == expected), true, n << " faces: wrong copy");
+  NS_TEST_ASSERT_MSG_EQ ((Ids (assigned) == expected), true, n << " faces: wrong assignment");
+  NS_TEST_ASSERT_MSG_EQ ((n == 0 || copy.begin () != records.begin ()), true, n << " faces: copy shares the records");
+
+  // erase from the middle, then the ends, keeps the others sorted
+  while (!expected.empty ())
+    {
+      size_t at = (expected.size () % 3 == 0) ? 0 : (expected.size () % 3 == 1) ? expected.size () / 2 : expected.size () - 1;
+      uint32_t id = expected[at];
+      expected.erase (expected.begin () + at);
+      NS_TEST_ASSERT_MSG_EQ (records.erase (faces[id]), 1, n << " faces: face " << id << " should be erased");
+      NS_TEST_ASSERT_MSG_EQ (records.erase (faces[id]), 0, n << " faces: face " << id << " erased twice");
+      NS_TEST_ASSERT_MSG_EQ ((Ids (records) == expected), true, n << " faces: wrong records after erasing face " << id);
+    }
+  NS_TEST_ASSERT_MSG_EQ (records.empty (), true, n << " faces: records left");
+
+  // the copies keep their records
+  NS_TEST_ASSERT_MSG_EQ (copy.size (), n, n << " faces: erase changed the copy");
+  copy.clear ();
+  NS_TEST_ASSERT_MSG_EQ (copy.empty (), true, n << " faces: clear left records");
+  NS_TEST_ASSERT_MSG_EQ (assigned.size (), n, n << " faces: erase changed the assigned records");
+}
+
+void
+PitFaceRecordsTest::Entries (Ptr<Node> node, const std::vector<Ptr<ndn::Face> > &faces)
+{
+  Ptr<ndn::Pit> pit = node->GetObject<ndn::Pit> ();
+
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> ("/a"));
+  interest->SetInterestLifetime (Seconds (1.0));
+  Ptr<ndn::pit::Entry> entry = pit->Create (interest);
+  NS_TEST_ASSERT_MSG_NE (entry, 0, "The PIT entry should be created");
+
+  for (uint32_t i = 0; i < faces.size (); i++)
+    {
+      entry->AddIncoming (faces[i], i);
+      entry->AddOutgoing (faces[i]);
+    }
+  NS_TEST_ASSERT_MSG_EQ (entry->GetIncoming ().size (), faces.size (), "Every incoming face should be recorded");
+  NS_TEST_ASSERT_MSG_EQ (entry->GetOutgoing ().size (), faces.size (), "Every outgoing face should be recorded");
+
+  // the reward of aggregated Interests adds up
+  entry->AddIncoming (faces[5], 1);
+  NS_TEST_ASSERT_MSG_EQ (entry->GetIncoming ().size (), faces.size (), "Aggregated Interests should not add records");
+  NS_TEST_ASSERT_MSG_EQ (entry->GetReward (faces[5]->GetId ()), 6, "Rewards of face 5 should add up");
+  NS_TEST_ASSERT_MSG_EQ (entry->GetReward (faces[2]->GetId ()), 2, "Wrong reward of face 2");
+
+  entry->RemoveAllReferencesToFace (faces[2]);
+  NS_TEST_ASSERT_MSG_EQ (entry->GetIncoming ().size (), faces.size () - 1, "Face 2 should not be incoming");
+  NS_TEST_ASSERT_MSG_EQ (entry->GetOutgoing ().size (), faces.size () - 1, "Face 2 should not be outgoing");
+  NS_TEST_ASSERT_MSG_EQ (entry->GetReward (faces[2]->GetId ()), 0, "Face 2 should have no reward");
+
+  // entries come from an arena: the block of an erased entry goes to the next one
+  const ndn::pit::Entry *erased = PeekPointer (entry);
+  pit->MarkErased (entry);
+  entry = 0;
+  NS_TEST_ASSERT_MSG_EQ (pit->GetSize (), 0, "The PIT entry should be erased");
+
+  interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> ("/b"));
+  interest->SetInterestLifetime (Seconds (1.0));
+  entry = pit->Create (interest);
+  NS_TEST_ASSERT_MSG_EQ (PeekPointer (entry), erased, "The new entry should reuse the block of the erased one");
+  NS_TEST_ASSERT_MSG_EQ (entry->GetIncoming ().empty (), true, "The new entry should have no incoming face");
+  NS_TEST_ASSERT_MSG_EQ (entry->GetOutgoing ().empty (), true, "The new entry should have no outgoing face");
+  pit->MarkErased (entry);
+}
+
+void
+PitFaceRecordsTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  ndn::StackHelper ndn;
+  ndn.Install (node);
+
+  // faces get their ids from the stack, in order
+  Ptr<ndn::L3Protocol> l3 = node->GetObject<ndn::L3Protocol> ();
+  std::vector<Ptr<ndn::Face> > faces;
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      Ptr<ndn::Face> face = CreateObject<ndn::Face> (node);
+      l3->AddFace (face);
+      faces.push_back (face);
+    }
+  ndn::StackHelper::AddRoute (node, "/", faces[0], 0);
+
+  const uint32_t counts[] = { 0, 1, 3, 4, 8 };
+  for (uint32_t i = 0; i < sizeof (counts) / sizeof (counts[0]); i++)
+    {
+      Records (faces, counts[i]);
+    }
+  Entries (node, faces);
+
+  Simulator::Destroy ();
+}
+
 }
@@ -23,12 +23,23 @@
 
 #include "ns3/test.h"
 #include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+#include <map>
+#include <string>
+#include <vector>
 
 namespace ns3 {
 
+class Node;
+
 namespace ndn {
+class Face;
 class Fib;
 class Pit;
+namespace pit {
+class Entry;
+}
 }
   
 class PitTest : public TestCase
@@ -48,6 +59,48 @@ private:
   void Check2 (Ptr<ndn::Pit> pit);
   void Check3 (Ptr<ndn::Pit> pit);
 };
+
+/**
+ * Expiration times of PIT entries with and without the timing wheel
+ * (ExpirationTick attribute)
+ */
+class PitExpirationTest : public TestCase
+{
+public:
+  PitExpirationTest ()
+    : TestCase ("PIT expiration timing wheel test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  std::map<std::string, Time>
+  Run (const std::string &tick);
+
+  void TimedOut (Ptr<const ndn::pit::Entry> entry);
+
+  std::map<std::string, Time> m_timedOut;
+};
+
+/**
+ * Face records of PIT entries (FaceRecords), inline or spilled, and
+ * the PIT entries allocated from their arena
+ */
+class PitFaceRecordsTest : public TestCase
+{
+public:
+  PitFaceRecordsTest ()
+    : TestCase ("PIT face records test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void Records (const std::vector<Ptr<ndn::Face> > &faces, uint32_t n);
+  void Entries (Ptr<Node> node, const std::vector<Ptr<ndn::Face> > &faces);
+};
   
 }
 
@@ -0,0 +1,196 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the binary Q-table file of the MARL agents
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-qtable-file.h"
+#include "ns3/core-module.h"
+#include "ns3/ndn-marl-qtable-file.h"
+
+#include "ns3/ndnSIM/model/rl/ndn-marl-qtable.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.QTableFileTest");
+
+namespace ns3
+{
+
+using ndn::QTable;
+using ndn::QTableReader;
+using ndn::QTableWriter;
+using ndn::QValue;
+
+static const uint32_t numBitRates = 3;
+static const uint32_t stateLen = 4;
+static const uint32_t neighborLen = 3;
+
+/*
+ * Set two entries of each row r in [begin, end)
+ */
+static void
+Fill (QTable &table, uint32_t begin, uint32_t end, double offset, uint32_t epoch)
+{
+  for (uint32_t r = begin; r < end; r++)
+    {
+      int8_t key[stateLen + neighborLen] = {
+        static_cast<int8_t> (r), static_cast<int8_t> (r % 3), static_cast<int8_t> (1 - 2 * (r % 2)), 7,
+        static_cast<int8_t> (r % 3 - 1), 0, static_cast<int8_t> (1 - r % 3)
+      };
+      QValue *row = table.InsertRow (key, stateLen + neighborLen, stateLen);
+      uint32_t action = r % table.GetNumActions ();
+      table.Set (row[action], offset + r * 0.25, epoch);
+      table.Set (row[(action + 1 + r % 6) % table.GetNumActions ()], offset - r * 0.5, epoch);
+    }
+}
+
+/*
+ * What MARLnfaImpl::OutputQStatus writes for one node
+ */
+static void
+Dump (const QTable &table, uint32_t node, QTableWriter &writer, bool incremental, uint32_t epoch)
+{
+  bool begun = false;
+  table.ForEach ([&](const int8_t *state, uint32_t stateLen, const int8_t *action, uint32_t actionLen,
+                     const QValue &value)
+  {
+    if (incremental && value.m_epoch != epoch)
+      {
+        return;
+      }
+    if (!begun)
+      {
+        writer.BeginBlock (node, stateLen, actionLen);
+        begun = true;
+      }
+    writer.Write (state, action, value.m_value);
+  });
+}
+
+/*
+ * What MARLnfaImpl::InputQStatus reads for one node
+ */
+static void
+Load (const QTableReader &reader, uint32_t node, QTable &table)
+{
+  const std::vector<QTableReader::Block> &blocks = reader.GetBlocks (node);
+  for (std::vector<QTableReader::Block>::const_iterator block = blocks.begin (); block != blocks.end (); block++)
+    {
+      for (uint64_t i = 0; i < block->m_count; i++)
+        {
+          table.Insert (block->GetState (i), block->m_stateLen,
+                        block->GetAction (i), block->m_actionLen, QValue{block->GetValue (i), 0});
+        }
+    }
+}
+
+/*
+ * Copy of 'path' with 4 bytes replaced at 'offset'
+ */
+static void
+Corrupt (const std::string &path, const std::string &target, std::size_t offset, uint32_t word)
+{
+  std::ifstream in (path.c_str (), std::ios::binary);
+  std::vector<char> data ((std::istreambuf_iterator<char> (in)), std::istreambuf_iterator<char> ());
+  std::memcpy (data.data () + offset, &word, sizeof (word));
+  std::ofstream out (target.c_str (), std::ios::binary | std::ios::trunc);
+  out.write (data.data (), data.size ());
+}
+
+void
+QTableFileTest::CheckEqual (const QTable &table, const QTable &expected, const std::string &step)
+{
+  NS_TEST_EXPECT_MSG_EQ (table.GetSize (), expected.GetSize (), step << ": number of entries");
+  NS_TEST_EXPECT_MSG_EQ (table.GetNumRows (), expected.GetNumRows (), step << ": number of rows");
+
+  std::vector<int8_t> key;
+  expected.ForEach ([&](const int8_t *state, uint32_t stateLen, const int8_t *action, uint32_t actionLen,
+                        const QValue &value)
+  {
+    key.assign (state, state + stateLen);
+    key.insert (key.end (), action + numBitRates, action + actionLen);
+    const QValue *row = table.FindRow (key.data (), key.size ());
+    NS_TEST_EXPECT_MSG_EQ ((row != 0), true, step << ": missing row of state " << static_cast<int32_t> (state[0]));
+    if (row == 0)
+      {
+        return;
+      }
+    const QValue &entry = row[table.GetActionIndex (action)];
+    NS_TEST_EXPECT_MSG_EQ (QTable::IsSet (entry), true, step << ": missing entry of state " << static_cast<int32_t> (state[0]));
+    NS_TEST_EXPECT_MSG_EQ (entry.m_value, value.m_value, step << ": value of state " << static_cast<int32_t> (state[0]));
+  });
+}
+
+void
+QTableFileTest::DoRun ()
+{
+  std::string path = CreateTempDirFilename ("qtable.bin");
+  std::string badMagic = path + ".magic";
+  std::string badVersion = path + ".version";
+
+  // Two agents, as written by MARLHelper
+  QTable first;
+  QTable second;
+  first.SetNumBitRates (numBitRates);
+  second.SetNumBitRates (numBitRates);
+  Fill (first, 0, 40, 1.0, 0);
+  Fill (second, 0, 25, -3.0, 0);
+
+  // Full dump
+  QTableWriter full (false);
+  Dump (first, 3, full, false, 0);
+  Dump (second, 5, full, false, 0);
+  NS_TEST_ASSERT_MSG_EQ (full.Save (path), true, "Full dump cannot be written to " << path);
+  NS_TEST_EXPECT_MSG_EQ (full.GetNumRecords (), first.GetSize () + second.GetSize (), "Records of the full dump");
+
+  // The first agent updates 10 rows and learns 5 new ones; the checkpoint holds only those
+  std::size_t size = first.GetSize ();
+  Fill (first, 30, 45, 10.0, 1);
+  QTableWriter checkpoint (true);
+  Dump (first, 3, checkpoint, true, 1);
+  Dump (second, 5, checkpoint, true, 1);
+  NS_TEST_ASSERT_MSG_EQ (checkpoint.Save (path), true, "Checkpoint cannot be appended to " << path);
+  NS_TEST_EXPECT_MSG_EQ (first.GetSize (), size + 10, "Entries learnt");
+  NS_TEST_EXPECT_MSG_EQ (checkpoint.GetNumRecords (), 30, "Records of the checkpoint");
+
+  // Load
+  NS_TEST_EXPECT_MSG_EQ (QTableReader::IsQTableFile (path), true, "Magic of " << path);
+  QTableReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (path), true, "Cannot open " << path);
+  NS_TEST_EXPECT_MSG_EQ (reader.GetNumSegments (), 2, "Full dump and checkpoint");
+  NS_TEST_EXPECT_MSG_EQ (reader.GetBlocks (3).size (), 2, "Blocks of the first agent");
+  NS_TEST_EXPECT_MSG_EQ (reader.GetBlocks (5).size (), 1, "Blocks of the second agent");
+  NS_TEST_EXPECT_MSG_EQ (reader.GetBlocks (7).size (), 0, "Blocks of an unknown agent");
+
+  QTable firstLoaded;
+  QTable secondLoaded;
+  firstLoaded.SetNumBitRates (numBitRates);
+  secondLoaded.SetNumBitRates (numBitRates);
+  Load (reader, 3, firstLoaded);
+  Load (reader, 5, secondLoaded);
+  CheckEqual (firstLoaded, first, "First agent");
+  CheckEqual (secondLoaded, second, "Second agent");
+
+  // Files of another format or version are rejected
+  Corrupt (path, badMagic, 0, 0x4c42545a);
+  NS_TEST_EXPECT_MSG_EQ (QTableReader::IsQTableFile (badMagic), false, "Bad magic taken for a Q-table file");
+  NS_TEST_EXPECT_MSG_EQ (reader.Open (badMagic), false, "File with a bad magic opened");
+
+  Corrupt (path, badVersion, 8, QTableWriter::Version + 1);
+  NS_TEST_EXPECT_MSG_EQ (QTableReader::IsQTableFile (badVersion), true, "Magic of " << badVersion);
+  NS_TEST_EXPECT_MSG_EQ (reader.Open (badVersion), false, "File of another version opened");
+  NS_TEST_EXPECT_MSG_EQ (reader.GetNumSegments (), 0, "Segments left after a failed open");
+
+  reader.Close ();
+  std::remove (path.c_str ());
+  std::remove (badMagic.c_str ());
+  std::remove (badVersion.c_str ());
+}
+
+}
@@ -0,0 +1,39 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the binary Q-table file of the MARL agents
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_QTABLE_FILE_H
+#define NDNSIM_TEST_QTABLE_FILE_H
+
+#include "ns3/test.h"
+
+#include <string>
+
+namespace ns3 {
+
+namespace ndn {
+class QTable;
+}
+
+class QTableFileTest : public TestCase
+{
+public:
+  QTableFileTest ()
+    : TestCase ("MARL binary Q-table file test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  // Every entry of 'expected' is in 'table' with the same value, and nothing else
+  void
+  CheckEqual (const ndn::QTable &table, const ndn::QTable &expected, const std::string &step);
+};
+
+}
+
+#endif // NDNSIM_TEST_QTABLE_FILE_H
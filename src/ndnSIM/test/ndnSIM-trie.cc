@@ -23,123 +23,332 @@
 
 #include "ndnSIM-trie.h"
 
+#include "../utils/trie/trie.h"
+#include "../utils/trie/detail/node-arena.h"
 #include "../utils/trie/trie-with-policy.h"
 #include "../utils/trie/lru-policy.h"
-#include "../utils/trie/random-policy.h"
+#include "../utils/trie/lfu-policy.h"
+#include "../utils/trie/lfu-da-policy.h"
 #include "../utils/trie/fifo-policy.h"
+#include "../utils/trie/random-policy.h"
+#include "../utils/trie/fixed-policy.h"
 #include "../utils/trie/multi-policy.h"
 
-#include <boost/lexical_cast.hpp>
+#include <boost/intrusive/list_hook.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/tuple/tuple.hpp>
 
-using namespace std;
-using namespace ns3;
-using namespace ndn::ndnSIM;
-using namespace boost;
+#include <map>
+#include <set>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.Trie");
 
-// class Integer : public ns3::SimpleRefCount<Integer>
-// {
-// public:
-//   ::Integer (int value) : value_ (value) {}
+namespace ns3
+{
+
+using namespace ndn::ndnSIM;
 
-//   operator int () const { return value_; }
-// private:
-//   int value_;
-// };
+typedef trie<ndn::Name, non_pointer_traits<uint32_t>, boost::intrusive::list_member_hook<> > Trie;
 
-// std::ostream &
-// operator << (std::ostream &os, const ::Integer &i)
-// {
-//   os << (int)i;
-//   return os;
-// }
+// Chunk i of a video, one child of the same node for every i
+static ndn::Name
+Chunk (uint32_t i)
+{
+  ndn::Name name ("/video/br1000kbps");
+  name.appendNumber (i);
+  return name;
+}
+
+// Payload of the name, 0 if none
+static uint32_t
+Find (Trie &t, const ndn::Name &name)
+{
+  Trie::iterator found, last;
+  bool reachLast;
+  boost::tie (found, reachLast, last) = t.find (name);
+  return reachLast ? last->payload () : 0;
+}
+
+// Nodes below the root
+static std::set<const Trie *>
+Nodes (Trie &t)
+{
+  std::set<const Trie *> nodes;
+  Trie::recursive_iterator item (t), end (0);
+  for (item++; item != end; item++)
+    {
+      nodes.insert (&(*item));
+    }
+  return nodes;
+}
+
+struct Above
+{
+  Above (uint32_t value) : value_ (value) {}
+  bool operator() (const Trie &node) const { return node.payload () > value_; }
+  uint32_t value_;
+};
+
+void
+TrieTest::FanOut (uint32_t n)
+{
+  Trie t (ndn::name::Component (), 1, 1);
+  for (uint32_t i = 1; i <= n; i++)
+    {
+      std::pair<Trie::iterator, bool> item = t.insert (Chunk (i), i);
+      NS_TEST_ASSERT_MSG_EQ (item.second, true, n << " children: chunk " << i << " should be inserted");
+      item = t.insert (Chunk (i), i + 1);
+      NS_TEST_ASSERT_MSG_EQ (item.second, false, n << " children: chunk " << i << " inserted twice");
+      NS_TEST_ASSERT_MSG_EQ (item.first->payload (), i, n << " children: payload of chunk " << i << " replaced");
+    }
+  for (uint32_t i = 1; i <= n; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Find (t, Chunk (i)), i, n << " children: chunk " << i << " not found");
+    }
+  NS_TEST_ASSERT_MSG_EQ (Find (t, Chunk (n + 1)), 0, n << " children: chunk " << n + 1 << " found");
+  NS_TEST_ASSERT_MSG_EQ (Nodes (t).size (), (n == 0 ? 0 : n + 2), n << " children: wrong number of nodes");
+
+  // erasing a child leaves its siblings where they are
+  std::set<const Trie *> before = Nodes (t);
+  uint32_t left = n;
+  for (uint32_t i = 1; i <= n; i += 2)
+    {
+      Trie::iterator found, last;
+      bool reachLast;
+      boost::tie (found, reachLast, last) = t.find (Chunk (i));
+      last->erase ();
+      left--;
+    }
+  for (uint32_t i = 1; i <= n; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Find (t, Chunk (i)), (i % 2 == 0 ? i : 0), n << " children: chunk " << i << " after erase");
+    }
+  NS_TEST_ASSERT_MSG_EQ (Nodes (t).size (), (left == 0 ? 0 : left + 2), n << " children: erased nodes left");
+
+  // the erased nodes go back to the arena, and come back with the next inserts
+  for (uint32_t i = 1; i <= n; i += 2)
+    {
+      NS_TEST_ASSERT_MSG_EQ (t.insert (Chunk (i), i + 1000).second, true, n << " children: chunk " << i << " not reinserted");
+    }
+  NS_TEST_ASSERT_MSG_EQ ((Nodes (t) == before), true, n << " children: reinserted nodes should reuse the erased ones");
+  for (uint32_t i = 1; i <= n; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Find (t, Chunk (i)), (i % 2 == 0 ? i : i + 1000), n << " children: chunk " << i << " after reinsert");
+    }
+
+  // erasing while iterating over the children
+  t.clear_if (Above (1000));
+  for (uint32_t i = 1; i <= n; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Find (t, Chunk (i)), (i % 2 == 0 ? i : 0), n << " children: chunk " << i << " after clear_if");
+    }
+  NS_TEST_ASSERT_MSG_EQ (Nodes (t).size (), (left == 0 ? 0 : left + 2), n << " children: nodes left by clear_if");
+
+  t.clear ();
+  NS_TEST_ASSERT_MSG_EQ (Nodes (t).size (), 0, n << " children: nodes left by clear");
+  for (uint32_t i = 1; i <= n; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (t.insert (Chunk (i), i).second, true, n << " children: chunk " << i << " not inserted after clear");
+    }
+  NS_TEST_ASSERT_MSG_EQ (Nodes (t).size (), (n == 0 ? 0 : n + 2), n << " children: wrong number of nodes after clear");
+}
 
 void
 TrieTest::DoRun ()
 {
-  cerr << "TrieTest is temporarily broken" << endl;
-  // typedef trie_with_policy<
-  //   ns3::NdnName,
-  //   smart_pointer_payload_traits<Integer>,
-  //   multi_policy_traits<
-  //     mpl::vector2<lru_policy_traits,random_policy_traits>
-  //     > > trie;
-  
-  // trie x;
-  // x.getPolicy ().get<0> ().set_max_size (100);
-  // x.getPolicy ().get<1> ().set_max_size (3);
-  // // // x.getPolicy ().get<1> ().set_max_size (3);
-  // // // // x.getPolicy ().get1 ().set_max_size (10);
-  // // // // x.getPolicy ().get2 ().set_max_size (3);
-  
-  // // // // x.getTrie ().PrintStat (std::cout);
-  
-  // ns3::NdnName n1,n2,n3,n4;
-  // // // // n1("a")("b")("c");
-  // // // // n2("a")("b")("d");
-  // // // // n3("a")("b")("f");
-  // // // // n4("a")("b");
-
-  // n1("a");
-  // n2("b");
-  // n3("c");
-  // n4("d");
-
-  // x.insert (n1, ns3::Create<Integer> (1));
-  // x.insert (n2, ns3::Create<Integer> (2));
-  // // // // x.longest_prefix_match (n1);
-  // x.insert (n3, ns3::Create<Integer> (3));
-  // x.insert (n4, ns3::Create<Integer> (4));
-  // x.insert (n4, ns3::Create<Integer> (4));
-
-  // std::cout << "digraph trie {\n";
-  // std::cout << x.getTrie ();
-  // std::cout << "}\n";
-
-  // Ptr<Node> node = CreateObject<Node> ();
-  // Names::Add ("TestNode", node);
-  // Ptr<ndn::App> app = CreateObject<ndn::App> ();
-  // node->AddApplication (app);
-  
-  // ObjectFactory factory ("ns3::ndn::fib::Default");
-  
-  // Ptr<ndn::Fib> fib = factory.Create<ndn::Fib> ();
-  // node->AggregateObject (fib);
-  // Ptr<ndn::Face> face = CreateObject<ndn::AppFace> (app);
-
-  // fib->Add (lexical_cast<ndn::Name> ("/bla"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/1"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/2"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/3"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/1/1"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/1/2"), face, 1);
-  
-  // cout << *fib << endl;
-
-  // fib->RemoveFromAll (face);
-
-  // cout << *fib << endl;
-  // BOOST_FOREACH (const trie::parent_trie &item, x.getPolicy ())
-  //   {
-  //     std::cout << *item.payload () << " " << std::endl;
-  //   }
-
-  // ns3::NdnName n4;
-  // n4("a")("c");
-    
-  // // std::cout << *x->find (n4).get<0> ();
-
-  // x->prune ();
-  // // x->find (n5).get<0> ()->erase ();
-  // x->find (n1).get<0> ()->erase ();
-    
-  // std::cout << "digraph trie {\n";
-  // std::cout << *x;
-  // std::cout << "}\n";
-
-  // x->PrintStat (std::cout);
-
-  // delete x;
+  // inline up to 4 children; the table grows past 12 of 16 slots
+  const uint32_t counts[] = { 0, 1, 3, 4, 5, 12, 13, 40, 200 };
+  for (uint32_t i = 0; i < sizeof (counts) / sizeof (counts[0]); i++)
+    {
+      FanOut (counts[i]);
+    }
 }
 
+void
+NodeArenaTest::DoRun ()
+{
+  struct Block
+  {
+    char data[40];
+  };
+  detail::node_arena<Block> arena;
+
+  // the blocks of a chunk are handed out in address order
+  std::vector<char *> blocks;
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      blocks.push_back (static_cast<char *> (arena.allocate ()));
+      if (i > 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ (blocks[i] - blocks[i - 1], sizeof (Block), "Block " << i << " does not follow the one before");
+        }
+    }
+
+  // freed blocks are reused first, the last freed first
+  arena.deallocate (blocks[3]);
+  arena.deallocate (blocks[7]);
+  NS_TEST_ASSERT_MSG_EQ (arena.allocate (), blocks[7], "The last freed block should be reused first");
+  NS_TEST_ASSERT_MSG_EQ (arena.allocate (), blocks[3], "The freed block should be reused");
+
+  // past the first chunk, then all freed and taken again: no block is new
+  for (uint32_t i = 16; i < 100; i++)
+    {
+      blocks.push_back (static_cast<char *> (arena.allocate ()));
+    }
+  std::set<char *> distinct (blocks.begin (), blocks.end ());
+  NS_TEST_ASSERT_MSG_EQ (distinct.size (), blocks.size (), "A block was handed out twice");
+  for (uint32_t i = 0; i < blocks.size (); i++)
+    {
+      arena.deallocate (blocks[i]);
+    }
+  for (uint32_t i = 0; i < blocks.size (); i++)
+    {
+      char *block = static_cast<char *> (arena.allocate ());
+      NS_TEST_ASSERT_MSG_EQ (distinct.erase (block), 1, "Block " << i << " is not one of the freed blocks");
+    }
+
+  // blocks smaller than a pointer still hold the free list
+  detail::node_arena<char> small;
+  char *first = static_cast<char *> (small.allocate ());
+  char *second = static_cast<char *> (small.allocate ());
+  NS_TEST_ASSERT_MSG_EQ (second - first, sizeof (void *), "Small blocks should be pointer-sized");
+}
+
+struct CachedItem : public SimpleRefCount<CachedItem>
+{
+};
+
+typedef multi_policy_traits<boost::mpl::vector2<lru_policy_traits, lfu_policy_traits> > LruLfu;
+
+template<class Cache>
+void
+TriePolicySizeTest::Check (Cache &cache, const std::map<uint32_t, uint32_t> &inserted, const std::string &what)
+{
+  size_t bytes = 0;
+  size_t entries = 0;
+  for (std::map<uint32_t, uint32_t>::const_iterator chunk = inserted.begin (); chunk != inserted.end (); chunk++)
+    {
+      if (cache.find_exact (Chunk (chunk->first)) != cache.end ())
+        {
+          bytes += chunk->second;
+          entries++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), bytes, what << ": bytes of the cached chunks");
+  NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().size (), entries, what << ": number of cached chunks");
+}
+
+template<class Policy>
+void
+TriePolicySizeTest::Sizes (const std::string &policy, bool evicts, bool random)
+{
+  typedef trie_with_policy<ndn::Name, smart_pointer_payload_traits<CachedItem>, Policy> Cache;
+  Cache cache;
+  cache.getPolicy ().set_max_size (1000);
+  Ptr<CachedItem> payload = Create<CachedItem> ();
+  std::map<uint32_t, uint32_t> inserted;
+
+  // below the budget every chunk fits
+  const uint32_t sizes[] = { 400, 300, 200 };
+  for (uint32_t i = 1; i <= 3; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cache.insert (Chunk (i), payload, sizes[i - 1]).second, true, policy << ": chunk " << i << " should fit");
+      inserted[i] = sizes[i - 1];
+      Check (cache, inserted, policy + ": sized insert");
+    }
+
+  // an insert without a size adds an entry, not bytes
+  NS_TEST_ASSERT_MSG_EQ (cache.insert (Chunk (4), payload).second, true, policy << ": unsized chunk should be inserted");
+  inserted[4] = 0;
+  Check (cache, inserted, policy + ": unsized insert");
+  NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), 900, policy << ": bytes after the unsized insert");
+
+  // past the budget the policy evicts until the chunk fits; a fixed configuration keeps everything
+  bool fits = cache.insert (Chunk (5), payload, 300).second;
+  inserted[5] = 300;
+  Check (cache, inserted, policy + ": insert past the budget");
+  if (!evicts)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), 1200, policy << ": nothing should be evicted");
+    }
+  else if (!random)
+    {
+      NS_TEST_ASSERT_MSG_EQ (fits, true, policy << ": chunk 5 should be inserted");
+      NS_TEST_ASSERT_MSG_EQ ((cache.find_exact (Chunk (1)) == cache.end ()), true, policy << ": chunk 1 should be evicted");
+      NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), 800, policy << ": bytes after the eviction");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_LT (cache.getPolicy ().get_current_size (), 1001, policy << ": bytes over the budget");
+    }
+
+  // a chunk larger than the budget is refused and evicts nothing
+  size_t bytes = cache.getPolicy ().get_current_size ();
+  std::pair<typename Cache::iterator, bool> big = cache.insert (Chunk (6), payload, 1001);
+  inserted[6] = 1001;
+  Check (cache, inserted, policy + ": insert larger than the budget");
+  NS_TEST_ASSERT_MSG_EQ (big.second, !evicts, policy << ": chunk larger than the budget");
+  if (evicts)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((big.first == cache.end ()), true, policy << ": refused chunk should not be returned");
+      NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), bytes, policy << ": refused chunk evicted others");
+    }
+
+  // erasing gives the bytes back, nothing for an unsized chunk
+  cache.erase (Chunk (2));
+  Check (cache, inserted, policy + ": erase");
+  bytes = cache.getPolicy ().get_current_size ();
+  cache.erase (Chunk (4));
+  Check (cache, inserted, policy + ": unsized erase");
+  NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), bytes, policy << ": bytes after the unsized erase");
+
+  cache.clear ();
+  NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), 0, policy << ": bytes after clear");
+  NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().size (), 0, policy << ": chunks after clear");
+
+  // after clear the whole budget is free again
+  NS_TEST_ASSERT_MSG_EQ (cache.insert (Chunk (7), payload, 1000).second, true, policy << ": chunk of the whole budget");
+  inserted[7] = 1000;
+  NS_TEST_ASSERT_MSG_EQ (cache.insert (Chunk (8), payload).second, true, policy << ": unsized chunk after clear");
+  inserted[8] = 0;
+  Check (cache, inserted, policy + ": inserts after clear");
+  NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), 1000, policy << ": bytes after the inserts after clear");
+
+  // one more byte evicts the full chunk, and the unsized one before it
+  cache.insert (Chunk (9), payload, 1);
+  inserted[9] = 1;
+  Check (cache, inserted, policy + ": insert into a full budget");
+  if (evicts && !random)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cache.getPolicy ().get_current_size (), 1, policy << ": bytes after evicting the full chunk");
+    }
+}
+
+void
+TriePolicySizeTest::DoRun ()
+{
+  Sizes<lru_policy_traits> ("lru", true, false);
+  Sizes<lfu_policy_traits> ("lfu", true, false);
+  Sizes<lfu_da_policy_traits> ("lfu-da", true, false);
+  Sizes<fifo_policy_traits> ("fifo", true, false);
+  Sizes<random_policy_traits> ("random", true, true);
+  Sizes<fixed_policy_traits> ("fixed", false, false);
+  Sizes<LruLfu> ("multi", true, false);
+
+  // every policy of a multi policy counts the same entries and bytes
+  trie_with_policy<ndn::Name, smart_pointer_payload_traits<CachedItem>, LruLfu> multi;
+  multi.getPolicy ().set_max_size (1000);
+  Ptr<CachedItem> payload = Create<CachedItem> ();
+  for (uint32_t i = 1; i <= 5; i++)
+    {
+      multi.insert (Chunk (i), payload, 300);
+    }
+  multi.insert (Chunk (6), payload);
+  NS_TEST_ASSERT_MSG_EQ (multi.getPolicy ().get<0> ().get_current_size (), 900, "lru of multi: bytes");
+  NS_TEST_ASSERT_MSG_EQ (multi.getPolicy ().get<1> ().get_current_size (), 900, "lfu of multi: bytes");
+  NS_TEST_ASSERT_MSG_EQ (multi.getPolicy ().get<0> ().size (), 4, "lru of multi: chunks");
+  NS_TEST_ASSERT_MSG_EQ (multi.getPolicy ().get<1> ().size (), 4, "lfu of multi: chunks");
+}
+
+}
@@ -24,9 +24,15 @@
 
 #include "ns3/test.h"
 
+#include <map>
+#include <string>
+
 namespace ns3
 {
 
+/**
+ * Children of trie nodes, inline or in a table, through inserts and erases
+ */
 class TrieTest : public TestCase
 {
 public:
@@ -37,6 +43,45 @@ public:
     
 private:
   virtual void DoRun ();
+
+  void FanOut (uint32_t n);
+};
+
+/**
+ * Block allocator of the trie nodes (detail/node_arena)
+ */
+class NodeArenaTest : public TestCase
+{
+public:
+  NodeArenaTest ()
+    : TestCase ("Trie node arena test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+/**
+ * Entries and bytes counted by the replacement policies of a trie_with_policy
+ */
+class TriePolicySizeTest : public TestCase
+{
+public:
+  TriePolicySizeTest ()
+    : TestCase ("Trie policy size test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  template<class Policy>
+  void Sizes (const std::string &policy, bool evicts, bool random);
+
+  // Chunk -> bytes of the chunks inserted so far (0 when inserted without a size)
+  template<class Cache>
+  void Check (Cache &cache, const std::map<uint32_t, uint32_t> &inserted, const std::string &what);
 };
 
 }
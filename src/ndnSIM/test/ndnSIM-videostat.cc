@@ -0,0 +1,188 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the sharded and the approximate VideoStatistics
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-videostat.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <map>
+#include <thread>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.VideoStatTest");
+
+namespace ns3
+{
+
+// Takes a raw pointer: the reference count of Ptr is not thread-safe
+static void
+CountInterests (ndn::VideoStatistics *stat, uint32_t file, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      stat->Add (ndn::VideoIndex (1, file, i % 10));
+      stat->Add (ndn::VideoIndex (1, 0, 0));
+    }
+}
+
+void
+VideoStatTest::DoRun ()
+{
+  const uint32_t threads = 6;
+  const uint32_t adds = 1000;
+
+  Ptr<ndn::VideoStatistics> stat = CreateObject<ndn::VideoStatistics> ();
+  stat->SetAttribute ("Shards", UintegerValue (2));
+
+  // More threads than shards, all counting at the same time
+  std::vector<std::thread> workers;
+  for (uint32_t t = 1; t <= threads; t++)
+    {
+      workers.push_back (std::thread (CountInterests, PeekPointer (stat), t, adds));
+    }
+  for (uint32_t t = 0; t < workers.size (); t++)
+    {
+      workers[t].join ();
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (stat->GetHitNum (ndn::VideoIndex (1, 0, 0)), threads * adds, "Shared chunk miscounted");
+  for (uint32_t t = 1; t <= threads; t++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (stat->GetHitNum (ndn::VideoIndex (1, t, 3)), adds / 10, "Chunk of thread " << t << " miscounted");
+    }
+  NS_TEST_ASSERT_MSG_EQ (stat->GetTable ().size (), threads * 10 + 1, "Wrong number of chunks");
+
+  // Threads that come and go, more of them in total than shards
+  stat->Clear ();
+  for (uint32_t t = 1; t <= threads * 4; t++)
+    {
+      std::thread worker (CountInterests, PeekPointer (stat), t, 10);
+      worker.join ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (stat->GetHitNum (ndn::VideoIndex (1, 0, 0)), threads * 4 * 10, "Shared chunk miscounted");
+  NS_TEST_ASSERT_MSG_EQ (stat->GetHitNum (ndn::VideoIndex (1, threads * 4, 9)), 1, "Chunk of the last thread miscounted");
+
+  stat->Dispose ();
+}
+
+// A few heavy chunks of files 1 to 5, then many light chunks of files from 1000 on.
+// The light files are far apart, as in a large catalogue
+static void
+CountStream (ndn::VideoStatistics *stat, std::map<ndn::VideoIndex, uint64_t> *truth)
+{
+  for (uint32_t round = 0; round < 20; round++)
+    {
+      for (uint32_t file = 1; file <= 5; file++)
+        {
+          for (uint32_t n = 0; n < 10 * file; n++)
+            {
+              stat->Add (ndn::VideoIndex (1, file, 1));
+            }
+          if (truth != 0)
+            {
+              (*truth)[ndn::VideoIndex (1, file, 1)] += 10 * file;
+            }
+        }
+      for (uint32_t light = 0; light < 200; light++)
+        {
+          uint32_t file = 1000 + (round * 200 + light) * 100000;
+          stat->Add (ndn::VideoIndex (1, file, 1 + light % 3));
+          if (truth != 0)
+            {
+              (*truth)[ndn::VideoIndex (1, file, 1 + light % 3)] += 1;
+            }
+        }
+    }
+}
+
+void
+VideoStatSketchTest::DoRun ()
+{
+  const uint32_t topK = 8;
+  const uint32_t threads = 3;
+
+  // Two shards for three threads: the third one counts straight into the sketch. The
+  // shards fold their buffers into the sketch every 1024 chunks, several times per merge
+  Ptr<ndn::VideoStatistics> stat = CreateObject<ndn::VideoStatistics> ();
+  stat->SetAttribute ("TopK", UintegerValue (topK));
+  stat->SetAttribute ("SketchWidth", UintegerValue (1024));
+  stat->SetAttribute ("Shards", UintegerValue (2));
+  NS_TEST_ASSERT_MSG_EQ (stat->IsApproximate (), true, "TopK should make the counts approximate");
+
+  std::map<ndn::VideoIndex, uint64_t> truth;
+  CountStream (PeekPointer (stat), &truth);
+  std::vector<std::thread> workers;
+  for (uint32_t t = 1; t < threads; t++)
+    {
+      workers.push_back (std::thread (CountStream, PeekPointer (stat), static_cast<std::map<ndn::VideoIndex, uint64_t> *> (0)));
+    }
+  for (uint32_t t = 0; t < workers.size (); t++)
+    {
+      workers[t].join ();
+    }
+
+  // Every estimate is an upper bound of the true count
+  for (std::map<ndn::VideoIndex, uint64_t>::const_iterator chunk = truth.begin (); chunk != truth.end (); chunk++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((stat->GetHitNum (chunk->first) >= threads * chunk->second), true,
+                             "File " << chunk->first.m_file << ", chunk " << chunk->first.m_chunk << " underestimated");
+    }
+
+  // The table holds at most K chunks, the heavy ones among them, with the counts of GetHitNum
+  const std::unordered_map<ndn::VideoIndex, uint64_t> &table = stat->GetTable ();
+  NS_TEST_ASSERT_MSG_LT (table.size (), topK + 1, "The table should hold the top-K chunks only");
+  for (uint32_t file = 1; file <= 5; file++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (table.count (ndn::VideoIndex (1, file, 1)), 1, "Heavy file " << file << " should be in the top-K");
+    }
+  for (std::unordered_map<ndn::VideoIndex, uint64_t>::const_iterator chunk = table.begin (); chunk != table.end (); chunk++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (stat->GetHitNum (chunk->first), chunk->second,
+                             "File " << chunk->first.m_file << ": the table and GetHitNum disagree");
+    }
+
+  stat->ResetHitNum (ndn::VideoIndex (1, 5, 1));
+  NS_TEST_ASSERT_MSG_EQ (stat->GetHitNum (ndn::VideoIndex (1, 5, 1)), 0, "Reset count of a top-K chunk");
+  stat->Clear ();
+  NS_TEST_ASSERT_MSG_EQ (stat->GetTable ().size (), 0, "Chunks left by Clear");
+  NS_TEST_ASSERT_MSG_EQ (stat->GetHitNum (ndn::VideoIndex (1, 1, 1)), 0, "Count left by Clear");
+  stat->Dispose ();
+
+  // The summary of an edge keeps the files of the top-K chunks only: a file id in the
+  // billions would not fit in arrays indexed by file
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<ndn::NDNBitRate> bitrate = CreateObject<ndn::NDNBitRate> ();
+  bitrate->AddBitRate ("1000kbps");
+  node->AggregateObject (bitrate);
+  stat = CreateObject<ndn::VideoStatistics> ();
+  stat->SetAttribute ("TopK", UintegerValue (topK));
+  node->AggregateObject (stat);
+  Ptr<ndn::PopularitySummary> summary = CreateObject<ndn::PopularitySummary> ();
+  summary->SetAttribute ("NumberofChunks", UintegerValue (2));
+  node->AggregateObject (summary);
+
+  uint32_t rank = bitrate->GetRankFromBR ("1000kbps");
+  const uint32_t files[] = { 7, 4000000000u, 123456789 };
+  for (uint32_t f = 0; f < 3; f++)
+    {
+      for (uint32_t n = 0; n < 10 * (f + 1); n++)
+        {
+          stat->Add (ndn::VideoIndex (rank, files[f], 1));
+          stat->Add (ndn::VideoIndex (rank, files[f], 2));
+        }
+    }
+  summary->Summarize ();
+  summary->CalculateUtility ();
+  std::vector<ndn::ValuedVideoIndex> &utilities = summary->UtilityRank ();
+  NS_TEST_ASSERT_MSG_EQ (utilities.size (), 3 * 2, "One utility per file and chunk");
+  NS_TEST_ASSERT_MSG_EQ (utilities.back ().m_file, files[2], "The most requested file should rank first");
+  NS_TEST_ASSERT_MSG_EQ (utilities.back ().m_chunk, 1, "The first chunk should rank first");
+
+  Simulator::Destroy ();
+}
+
+}
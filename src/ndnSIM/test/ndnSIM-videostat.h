@@ -0,0 +1,44 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the sharded and the approximate VideoStatistics
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_VIDEOSTAT_H
+#define NDNSIM_TEST_VIDEOSTAT_H
+
+#include "ns3/test.h"
+
+namespace ns3 {
+
+class VideoStatTest : public TestCase
+{
+public:
+  VideoStatTest ()
+    : TestCase ("VideoStatistics shards test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+/**
+ * Count-Min sketch and top-K list of the TopK mode, and the popularity summary over it
+ */
+class VideoStatSketchTest : public TestCase
+{
+public:
+  VideoStatSketchTest ()
+    : TestCase ("VideoStatistics top-K sketch test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+}
+
+#endif // NDNSIM_TEST_VIDEOSTAT_H
@@ -0,0 +1,99 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the shared Zipf-Mandelbrot sampler
+ *
+ * Date: 2026-10-18
+ */
+
+#include "ndnSIM-zipf-sampler.h"
+#include "ns3/core-module.h"
+#include "ns3/ndn-zipf-sampler.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ZipfSamplerTest");
+
+namespace ns3
+{
+
+using ndn::ZipfSampler;
+
+static const uint32_t N = 6;
+static const double q = 0.7;
+static const double s = 0.9;
+static const uint32_t draws = 200000;
+
+/*
+ * Rank the former linear scan of ConsumerZipfMandelbrot::m_Pcum returned for u
+ */
+static uint32_t
+Scan (const std::vector<double> &pcum, double u)
+{
+  uint32_t content_index = 1;
+  for (uint32_t i = 1; i < pcum.size (); i++)
+    {
+      if (u <= pcum[i])
+        {
+          content_index = i;
+          break;
+        }
+    }
+  return content_index;
+}
+
+void
+ZipfSamplerTest::DoRun ()
+{
+  // Cumulative table as ConsumerZipfMandelbrot::SetNumberOfContents built it
+  std::vector<double> pcum (N + 1, 0.0);
+  for (uint32_t i = 1; i <= N; i++)
+    {
+      pcum[i] = pcum[i - 1] + 1.0 / std::pow (i + q, s);
+    }
+  for (uint32_t i = 1; i <= N; i++)
+    {
+      pcum[i] = pcum[i] / pcum[N];
+    }
+
+  Ptr<const ZipfSampler> binary = ZipfSampler::Get (N, q, s, ZipfSampler::BINARY_SEARCH);
+  Ptr<const ZipfSampler> alias = ZipfSampler::Get (N, q, s, ZipfSampler::ALIAS);
+  NS_TEST_EXPECT_MSG_EQ ((ZipfSampler::Get (N, q, s, ZipfSampler::BINARY_SEARCH) == binary), true,
+                         "Sampler of the same distribution not shared");
+  NS_TEST_EXPECT_MSG_EQ ((alias != binary), true, "Methods share a sampler");
+
+  std::minstd_rand random (1);
+  std::uniform_real_distribution<double> uniform (0.0, 1.0);
+  std::vector<uint32_t> binaryCount (N + 1, 0);
+  std::vector<uint32_t> aliasCount (N + 1, 0);
+  uint32_t mismatches = 0;
+  for (uint32_t i = 0; i < draws; i++)
+    {
+      double u = uniform (random);
+      uint32_t rank = binary->Sample (u);
+      if (rank != Scan (pcum, u))
+        {
+          mismatches++;
+        }
+      binaryCount[rank]++;
+      rank = alias->Sample (u);
+      NS_TEST_ASSERT_MSG_EQ ((rank >= 1 && rank <= N), true, "Alias rank " << rank << " out of [1, N]");
+      aliasCount[rank]++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (mismatches, 0, "Binary search differs from the cumulative scan");
+  NS_TEST_EXPECT_MSG_EQ (binary->Sample (1.5), Scan (pcum, 1.5), "Rank past the last cumulative value");
+
+  // About 5 standard deviations of the frequency of a rank
+  double tolerance = 5 * std::sqrt (0.25 / draws);
+  for (uint32_t k = 1; k <= N; k++)
+    {
+      double p = pcum[k] - pcum[k - 1];
+      NS_TEST_EXPECT_MSG_EQ_TOL (binaryCount[k] / static_cast<double> (draws), p, tolerance,
+                                 "Binary search frequency of rank " << k);
+      NS_TEST_EXPECT_MSG_EQ_TOL (aliasCount[k] / static_cast<double> (draws), p, tolerance,
+                                 "Alias frequency of rank " << k);
+    }
+}
+
+}
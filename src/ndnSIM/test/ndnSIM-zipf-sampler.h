@@ -0,0 +1,29 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Tests of the shared Zipf-Mandelbrot sampler
+ *
+ * Date: 2026-10-18
+ */
+
+#ifndef NDNSIM_TEST_ZIPF_SAMPLER_H
+#define NDNSIM_TEST_ZIPF_SAMPLER_H
+
+#include "ns3/test.h"
+
+namespace ns3 {
+
+class ZipfSamplerTest : public TestCase
+{
+public:
+  ZipfSamplerTest ()
+    : TestCase ("Zipf-Mandelbrot sampler test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+}
+
+#endif // NDNSIM_TEST_ZIPF_SAMPLER_H
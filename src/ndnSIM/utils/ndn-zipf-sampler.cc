@@ -0,0 +1,146 @@
+/*
+ * Sampler of the Zipf-Mandelbrot distribution
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-zipf-sampler.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ZipfSampler");
+
+namespace ns3 {
+namespace ndn {
+
+typedef std::tuple<uint32_t, double, double, int> ZipfKey;
+
+static std::map<ZipfKey, Ptr<ZipfSampler> >&
+GetRegistry()
+{
+	static std::map<ZipfKey, Ptr<ZipfSampler> > registry;
+	return registry;
+}
+
+Ptr<const ZipfSampler>
+ZipfSampler::Get(uint32_t n, double q, double s, Method method)
+{
+	std::map<ZipfKey, Ptr<ZipfSampler> >& registry = GetRegistry();
+
+	for(auto iter = registry.begin(); iter != registry.end(); )
+	{
+		if(iter->second->GetReferenceCount() == 1)
+			iter = registry.erase(iter);
+		else
+			iter++;
+	}
+
+	Ptr<ZipfSampler>& sampler = registry[ZipfKey(n, q, s, method)];
+	if(sampler == 0)
+		sampler = Create<ZipfSampler>(n, q, s, method);
+	return sampler;
+}
+
+bool
+ZipfSampler::ParseMethod(const std::string& name, Method& method)
+{
+	if(name == "BinarySearch")
+		method = BINARY_SEARCH;
+	else if(name == "Alias")
+		method = ALIAS;
+	else
+		return false;
+	return true;
+}
+
+ZipfSampler::ZipfSampler(uint32_t n, double q, double s, Method method)
+	:m_n(n)
+	,m_method(method)
+{
+	NS_ASSERT_MSG(n > 0, "Zipf distribution over an empty catalogue");
+	NS_LOG_DEBUG("N=" << n << " q=" << q << " s=" << s << " method=" << method);
+
+	// Same summation order as the former cumulative table
+	std::vector<double> weight(n);
+	double total = 0;
+	for(uint32_t k = 1; k <= n; k++)
+	{
+		weight[k - 1] = 1.0 / std::pow(k + q, s);
+		total += weight[k - 1];
+	}
+
+	if(method == BINARY_SEARCH)
+	{
+		m_cum.resize(n);
+		double sum = 0;
+		for(uint32_t k = 0; k < n; k++)
+		{
+			sum += weight[k];
+			m_cum[k] = sum;
+		}
+		for(uint32_t k = 0; k < n; k++)
+			m_cum[k] = m_cum[k] / sum;
+		return;
+	}
+
+	// Vose's alias method: scale to mean 1, then pair every short column with a long one
+	m_prob.resize(n);
+	m_alias.resize(n);
+	std::vector<uint32_t> small, large;
+	for(uint32_t k = 0; k < n; k++)
+	{
+		m_prob[k] = weight[k] * n / total;
+		m_alias[k] = k + 1;
+		if(m_prob[k] < 1.0)
+			small.push_back(k);
+		else
+			large.push_back(k);
+	}
+	while(!small.empty() && !large.empty())
+	{
+		uint32_t l = small.back();
+		uint32_t g = large.back();
+		small.pop_back();
+		m_alias[l] = g + 1;
+		m_prob[g] = (m_prob[g] + m_prob[l]) - 1.0;
+		if(m_prob[g] < 1.0)
+		{
+			large.pop_back();
+			small.push_back(g);
+		}
+	}
+	// Columns left over only differ from 1 by rounding errors
+	for(auto iter = large.begin(); iter != large.end(); iter++)
+		m_prob[*iter] = 1.0;
+	for(auto iter = small.begin(); iter != small.end(); iter++)
+		m_prob[*iter] = 1.0;
+}
+
+uint32_t
+ZipfSampler::Sample(double u) const
+{
+	if(m_method == BINARY_SEARCH)
+	{
+		// First rank whose cumulative probability reaches u
+		auto iter = std::lower_bound(m_cum.begin(), m_cum.end(), u);
+		if(iter == m_cum.end())
+			return 1;	// The former scan kept its initial rank when u passed the last value
+		return static_cast<uint32_t>(iter - m_cum.begin()) + 1;
+	}
+
+	// One uniform number gives both the column (integer part) and the coin (fraction)
+	double x = u * m_n;
+	uint32_t column = static_cast<uint32_t>(x);
+	if(column >= m_n)
+		column = m_n - 1;
+	return (x - column < m_prob[column]) ? column + 1 : m_alias[column];
+}
+
+} // namespace ndn
+} // namespace ns3
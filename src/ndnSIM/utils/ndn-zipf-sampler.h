@@ -0,0 +1,69 @@
+/*
+ * Sampler of the Zipf-Mandelbrot distribution p(k) ~ 1 / (k + q)^s, k in [1, N]
+ *
+ * The tables are built once per (N, q, s, method) and shared by every consumer
+ * asking for the same distribution:
+ *  - BINARY_SEARCH: cumulative table, O(log N) per sample. Returns exactly what
+ *    the former linear scan returned for the same random number.
+ *  - ALIAS: Walker/Vose alias table, O(1) per sample.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_ZIPF_SAMPLER_H
+#define NDN_ZIPF_SAMPLER_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class ZipfSampler : public SimpleRefCount<ZipfSampler>
+{
+public:
+	enum Method
+	{
+		BINARY_SEARCH,
+		ALIAS
+	};
+
+	/*
+	 * Shared sampler of the distribution. Tables nobody holds any more are
+	 * released on the next call.
+	 */
+	static Ptr<const ZipfSampler> Get(uint32_t n, double q, double s, Method method = BINARY_SEARCH);
+
+	/*
+	 * "BinarySearch" or "Alias"; false if 'name' is neither
+	 */
+	static bool ParseMethod(const std::string& name, Method& method);
+
+	ZipfSampler(uint32_t n, double q, double s, Method method);
+
+	/*
+	 * Map a uniform random number in [0, 1) to a rank in [1, N]
+	 */
+	uint32_t Sample(double u) const;
+
+	inline uint32_t GetN() const
+	{
+		return m_n;
+	}
+
+private:
+	uint32_t	m_n;
+	Method		m_method;
+
+	std::vector<double>		m_cum;		// BINARY_SEARCH: m_cum[k - 1] = P(rank <= k)
+	std::vector<double>		m_prob;		// ALIAS: probability of keeping column k - 1
+	std::vector<uint32_t>	m_alias;	// ALIAS: rank taken otherwise
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -13,6 +13,7 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 #include "ns3/ndn-data.h"
+#include "ns3/ndn-trace-sink.h"
 
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
@@ -23,10 +24,11 @@
 #include <utility>
 #include <tuple>
 
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/exception.h>
-#include <cppconn/statement.h>
+#ifdef HAVE_MYSQL
+namespace sql {
+class Driver;
+}
+#endif
 
 namespace ns3 {
 
@@ -51,6 +53,15 @@ public:
   static void
   InstallAll (const std::string &file, bool needHeader);
 
+  /*
+   * Record traces for all nodes into the tables of a trace sink;
+   * an empty table name disables the corresponding trace
+   */
+  static void
+  InstallAll (Ptr<TraceSink> sink, const std::string& tableRequest, const std::string& tableSwitch,
+		  	  const std::string& tableDelay, const int expidx);
+
+#ifdef HAVE_MYSQL
   /*
    * Record traces for all nodes on MySQL database;
    */
@@ -59,6 +70,7 @@ public:
 		  	  	 const std::string& database, const std::string& tableRequest, const std::string& tableSwitch,
 				 const std::string& tableDelay,
 		  	  	 const std::string& user, const std::string& password, const int expidx);
+#endif
 
 
   static Ptr<VideoTracer>
@@ -66,9 +78,7 @@ public:
 
 
   static Ptr<VideoTracer>
-  InstallSql (Ptr<Node>, boost::shared_ptr<std::ostringstream>,
-		  	  	  	  	 boost::shared_ptr<std::ostringstream>,
-						 boost::shared_ptr<std::ostringstream>);
+  InstallSql (Ptr<Node>, Ptr<TraceSink>);
 
 
   static void
@@ -81,10 +91,7 @@ public:
    */
   VideoTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node);
 
-  VideoTracer (boost::shared_ptr<std::ostringstream>,
-		  	   boost::shared_ptr<std::ostringstream>,
-			   boost::shared_ptr<std::ostringstream>,
-			   Ptr<Node>);
+  VideoTracer (Ptr<TraceSink>, Ptr<Node>);
 
   /**
    * @brief Trace constructor that attaches to all applications on the node using node's name
@@ -106,12 +113,6 @@ public:
   void
   PrintHeader (std::ostream &os) const;
 
-  static sql::Statement 	*stmt;
-  static sql::Driver 		*driver;
-  static sql::Connection 	*con;
-
-
-
 private:
   void
   Connect ();
@@ -138,27 +139,16 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
   boost::shared_ptr<std::ostream> m_os;
-  boost::shared_ptr<std::ostringstream> m_ss;
-
-  boost::shared_ptr<std::ostringstream> m_ss_switch;
-  boost::shared_ptr<std::ostringstream> m_ss_delay;
+  Ptr<TraceSink> m_sink;
 
   static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<VideoTracer> > > > g_tracers;
-  static std::list< boost::tuple< boost::shared_ptr<std::ostringstream>,
-  	  	  	  	  	  	  	  	  boost::shared_ptr<std::ostringstream>,
-								  boost::shared_ptr<std::ostringstream>,
-  	  	  	  	  	  	  	  	  std::list<Ptr<VideoTracer> > > > g_tracers_ss;
+  static std::list< boost::tuple< Ptr<TraceSink>, std::list<Ptr<VideoTracer> > > > g_tracers_ss;
 
   static std::string		tablename_Request;
-  static int				insertitem_Request;
   static std::string		tablename_Switch;
-  static int				insertitem_Switch;
   static std::string		tablename_Delay;
-  static int				insertitem_Delay;
-  static std::string		DatabaseName;
 
   static int				tableid;
-  static bool				usedfordestruction;
 
 };
 
@@ -33,9 +33,13 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#ifdef HAVE_MYSQL
+#include "ns3/ndn-mysql-trace-sink.h"
+#endif
 
 #include <boost/lexical_cast.hpp>
 
+#include <cstdlib>
 #include <fstream>
 #include <string>
 #include <exception>
@@ -48,16 +52,11 @@ using namespace std;
 namespace ns3 {
 namespace ndn {
 
-sql::Driver* CsTracer::driver = nullptr;
-sql::Connection* CsTracer::con = nullptr;
-sql::Statement* CsTracer::stmt = nullptr;
-int CsTracer::insertitem;
 std::string CsTracer::tablename;
 int CsTracer::tableid;
-bool CsTracer::usedfordestruction(false);
 
 std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<CsTracer> > > > CsTracer::g_tracers;
-std::list< boost::tuple< boost::shared_ptr<std::ostringstream>, std::list<Ptr<CsTracer> > > > CsTracer::g_tracers_ss;
+std::list< boost::tuple< Ptr<TraceSink>, std::list<Ptr<CsTracer> > > > CsTracer::g_tracers_ss;
 
 template<class T>
 static inline void
@@ -65,6 +64,13 @@ NullDeleter (T *ptr)
 {
 }
 
+// bitrate of the chunk in Kbps, 0 if the name is not the one of a video chunk
+static inline long
+GetKbps (const VideoIndex &index)
+{
+  return std::strtol (index.GetBitRate ().c_str (), 0, 10);
+}
+
 void
 CsTracer::Destroy ()
 {
@@ -200,50 +206,35 @@ CsTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod
 }
 
 void
-CsTracer::InstallAllSql (sql::Driver* d, const std::string& ip, const std::string& database,
-		                 const std::string& table,
-						 const std::string& user,
-						 const std::string& password,
-						 const int expidx,
-						 Time averagingPeriod)
+CsTracer::InstallAll (Ptr<TraceSink> sink, const std::string& table, const int expidx, Time averagingPeriod)
 {
-	using namespace boost;
-	using namespace std;
-
-	try{
-		CsTracer::usedfordestruction = true;
-		driver = d;
-		/*Horus*/
-		con = driver->connect("tcp://"+ip+":3306", user, password);
-		con->setSchema(database);
-		stmt = con->createStatement();
-
-		tablename = table;
-		tableid = expidx;
-		stmt->execute("CREATE TABLE IF NOT EXISTS " + tablename + " (Time DECIMAL(12,6), Node SMALLINT, FileID SMALLINT, ChunkID SMALLINT, " +
-				"`BitRate(Kbps)` VARCHAR(4), Packets SMALLINT, ExpID SMALLINT);");
-		insertitem = 0;
-
-	}
-	catch (sql::SQLException &e) {
-		cout << "# ERR: SQLException in " << __FILE__;
-		cout << "(" << __FUNCTION__ << ") on line "
-		     << __LINE__ << endl;
-		cout << "# ERR: " << e.what();
-		cout << " (MySQL error code: " << e.getErrorCode();
-		cout << ", SQLState: " << e.getSQLState() << " )" << endl;
-	}
+	tablename = table;
+	tableid = expidx;
+	sink->CreateTable(tablename, {{"Time", "DECIMAL(12,6)"}, {"Node", "SMALLINT"}, {"FileID", "SMALLINT"}, {"ChunkID", "SMALLINT"},
+								  {"BitRate(Kbps)", "VARCHAR(4)"}, {"Packets", "SMALLINT"}, {"ExpID", "SMALLINT"}});
 
 	std::list<Ptr<CsTracer> > tracers;
-	boost::shared_ptr<std::ostringstream> outputStream (new std::ostringstream());
-
 	for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
 	{
-		Ptr<CsTracer> trace = InstallSql(*node, outputStream, averagingPeriod);
+		Ptr<CsTracer> trace = InstallSql(*node, sink, averagingPeriod);
 		tracers.push_back (trace);
 	}
-	g_tracers_ss.push_back (boost::make_tuple (outputStream, tracers));
+	g_tracers_ss.push_back (boost::make_tuple (sink, tracers));
+}
+
+#ifdef HAVE_MYSQL
+void
+CsTracer::InstallAllSql (sql::Driver* d, const std::string& ip, const std::string& database,
+		                 const std::string& table,
+						 const std::string& user,
+						 const std::string& password,
+						 const int expidx,
+						 Time averagingPeriod)
+{
+	Ptr<MySqlTraceSink> sink = Create<MySqlTraceSink> (d, ip, 3306, database, user, password);
+	InstallAll(sink, table, expidx, averagingPeriod);
 }
+#endif
 
 
 Ptr<CsTracer>
@@ -261,11 +252,11 @@ CsTracer::Install (Ptr<Node> node,
 
 Ptr<CsTracer>
 CsTracer::InstallSql (Ptr<Node> node,
-                   boost::shared_ptr<std::ostringstream> outputStream,
+                   Ptr<TraceSink> sink,
                    Time averagingPeriod/* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG ("Node: " << node->GetId ());
-  Ptr<CsTracer> trace = Create<CsTracer> (outputStream, node);
+  Ptr<CsTracer> trace = Create<CsTracer> (sink, node);
   trace->SetAveragingPeriod (averagingPeriod);
 
   return trace;
@@ -277,7 +268,6 @@ CsTracer::InstallSql (Ptr<Node> node,
 CsTracer::CsTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
 : m_nodePtr (node)
 , m_os (os)
-, m_ss (nullptr)
 {
   m_node = boost::lexical_cast<string> (m_nodePtr->GetId ());
   Connect ();
@@ -288,10 +278,10 @@ CsTracer::CsTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
     }
 }
 
-CsTracer::CsTracer (boost::shared_ptr<std::ostringstream> os, Ptr<Node> node)
+CsTracer::CsTracer (Ptr<TraceSink> sink, Ptr<Node> node)
 : m_nodePtr (node)
 , m_os (nullptr)
-, m_ss (os)
+, m_sink (sink)
 {
   m_node = boost::lexical_cast<string> (m_nodePtr->GetId ());
   Connect ();
@@ -312,30 +302,6 @@ CsTracer::CsTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
 
 CsTracer::~CsTracer ()
 {
-	if(insertitem != 0)
-	{
-		insertitem = 0;
-		try{
-			*m_ss << ";";
-
-			stmt->execute(m_ss->str());
-		} catch (sql::SQLException &e) {
-			std::cout << "# ERR: SQLException in " << __FILE__;
-			std::cout << "(" << __FUNCTION__ << ") on line "
-			     << __LINE__ << endl;
-			std::cout << "# ERR: " << e.what();
-			std::cout << " (MySQL error code: " << e.getErrorCode();
-			std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-		}
-		m_ss->clear();
-		m_ss->str("");
-	}
-	if(CsTracer::usedfordestruction)
-	{
-		CsTracer::usedfordestruction = false;
-		delete CsTracer::stmt;
-		delete CsTracer::con;
-	}
 };
 
 
@@ -361,7 +327,10 @@ CsTracer::SetAveragingPeriod (const Time &period)
 void
 CsTracer::PeriodicPrinter ()
 {
-  Print (*m_os);
+  if (m_sink != nullptr)
+    Print (*m_sink);
+  else
+    Print (*m_os);
   Reset ();
   
   m_printEvent = Simulator::Schedule (m_period, &CsTracer::PeriodicPrinter, this);
@@ -397,7 +366,6 @@ void
 CsTracer::Print (std::ostream &os) const
 {
   Time time = Simulator::Now ();
-  std::string tail = "kbps";
 
 /*
   os << time.ToDouble (Time::S) << ","
@@ -416,62 +384,30 @@ CsTracer::Print (std::ostream &os) const
 
   for(auto iter = m_hits_detail.begin(); iter != m_hits_detail.end(); iter++)
   {
-	  if(m_os != nullptr)
-	  {
-		  std::size_t found = iter->first.m_bitrate.find(tail);
-		  os << time.ToDouble (Time::S) << ","
-			 << m_nodePtr->GetId() << ","
-			 << iter->first.m_file << ","
-			 << iter->first.m_chunk << ","
-			 << std::stoi(iter->first.m_bitrate.substr(2, found - 2)) << ","
-			 << iter->second << "\n";
-	  }
-	  else if(m_ss != nullptr)
-	  {
-		  std::size_t found = iter->first.m_bitrate.find(tail);
-		  if(insertitem == 0)
-			{
-				*m_ss << "INSERT INTO " << tablename //<< " (Time,AppId,FileId,ChunkId,`BitRate(Kbps)`,`Throughput(Kbps)`,HopCount,Buffer,TableID)"
-						<<" VALUES(" << std::setprecision(6) << Simulator::Now ().ToDouble (Time::S) << ","
-				        << m_nodePtr->GetId() << ","
-				        << iter->first.m_file << ","
-						<< iter->first.m_chunk <<","
-				        << std::stoi(iter->first.m_bitrate.substr(2, found - 2)) << ","
-						<< iter->second << ","
-						<< CsTracer::tableid << ")";
-			}
-		  else
-			{
-				*m_ss << ",(" << std::setprecision(6) << Simulator::Now ().ToDouble (Time::S) << ","
-				        << m_nodePtr->GetId() << ","
-				        << iter->first.m_file << ","
-						<< iter->first.m_chunk <<","
-				        << std::stoi(iter->first.m_bitrate.substr(2, found - 2)) << ","
-						<< iter->second << ","
-						<< CsTracer::tableid << ")";
-			}
-			insertitem++;
-			if(insertitem == 50)
-			{
-				insertitem = 0;
-				try{
-					*m_ss << ";";
-
-					stmt->execute(m_ss->str());
-				} catch (sql::SQLException &e) {
-					std::cout << "# ERR: SQLException in " << __FILE__;
-					std::cout << "(" << __FUNCTION__ << ") on line "
-					     << __LINE__ << endl;
-					std::cout << "# ERR: " << e.what();
-					std::cout << " (MySQL error code: " << e.getErrorCode();
-					std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-				}
-				m_ss->clear();
-				m_ss->str("");
-			}
-	  }
-	  else
-		  NS_LOG_WARN("Log error in CS Tracer !");
+	  os << time.ToDouble (Time::S) << ","
+		 << m_nodePtr->GetId() << ","
+		 << iter->first.m_file << ","
+		 << iter->first.m_chunk << ","
+		 << GetKbps(iter->first) << ","
+		 << iter->second << "\n";
+  }
+}
+
+void
+CsTracer::Print (TraceSink &sink) const
+{
+  double time = Simulator::Now ().ToDouble (Time::S);
+  for(auto iter = m_hits_detail.begin(); iter != m_hits_detail.end(); iter++)
+  {
+	  TraceRow row;
+	  row.Add(time, 6)
+		 .Add(m_nodePtr->GetId())
+		 .Add(iter->first.m_file)
+		 .Add(iter->first.m_chunk)
+		 .Add(GetKbps(iter->first))
+		 .Add(iter->second)
+		 .Add(CsTracer::tableid);
+	  sink.Append(tablename, row);
   }
 }
 
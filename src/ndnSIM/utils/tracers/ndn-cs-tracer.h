@@ -28,6 +28,7 @@
 #include <ns3/nstime.h>
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
+#include "ns3/ndn-trace-sink.h"
 
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
@@ -35,11 +36,11 @@
 #include <list>
 #include <sstream>
 
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/exception.h>
-#include <cppconn/statement.h>
-
+#ifdef HAVE_MYSQL
+namespace sql {
+class Driver;
+}
+#endif
 
 namespace ns3 {
 
@@ -92,6 +93,14 @@ public:
   InstallAll (const std::string &file, Time averagingPeriod = Seconds (0.5));
 
 
+  /*
+   * Record traces for all nodes into a table of a trace sink;
+   */
+  static void
+  InstallAll (Ptr<TraceSink> sink, const std::string& table, const int expidx,
+		  	  Time averagingPeriod = Seconds (0.5));
+
+#ifdef HAVE_MYSQL
   /*
    * Record traces for all nodes on MySQL database;
    */
@@ -99,6 +108,7 @@ public:
   InstallAllSql (sql::Driver* d, const std::string& ip, const std::string& database, const std::string& table,
 		  	  	  const std::string& user, const std::string& password, const int expidx,
 				  Time averagingPeriod = Seconds (0.5));
+#endif
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -142,7 +152,7 @@ public:
   Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time averagingPeriod = Seconds (0.5));
 
   static Ptr<CsTracer>
-  InstallSql (Ptr<Node> node, boost::shared_ptr<std::ostringstream> outputStream, Time averagingPeriod = Seconds (0.5));
+  InstallSql (Ptr<Node> node, Ptr<TraceSink> sink, Time averagingPeriod = Seconds (0.5));
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -160,7 +170,7 @@ public:
    */
   CsTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node);
 
-  CsTracer (boost::shared_ptr<std::ostringstream> os, Ptr<Node> node);
+  CsTracer (Ptr<TraceSink> sink, Ptr<Node> node);
 
   /**
    * @brief Trace constructor that attaches to the node using node name
@@ -189,10 +199,12 @@ public:
    */
   void
   Print (std::ostream &os) const;
-  
-  static sql::Statement 	*stmt;
-  static sql::Driver 		*driver;
-  static sql::Connection 	*con;
+
+  /**
+   * @brief Append current trace data to the trace sink
+   */
+  void
+  Print (TraceSink &sink) const;
 
 private:
   void
@@ -218,7 +230,7 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
   boost::shared_ptr<std::ostream> m_os;
-  boost::shared_ptr<std::ostringstream> m_ss;
+  Ptr<TraceSink> m_sink;
 
   Time m_period;
   EventId m_printEvent;
@@ -227,12 +239,10 @@ private:
   std::map<VideoIndex, uint32_t> m_hits_detail;
 
   static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<CsTracer> > > > g_tracers;
-  static std::list< boost::tuple< boost::shared_ptr<std::ostringstream>, std::list<Ptr<CsTracer> > > > g_tracers_ss;
+  static std::list< boost::tuple< Ptr<TraceSink>, std::list<Ptr<CsTracer> > > > g_tracers_ss;
 
   static std::string		tablename;
   static int				tableid;
-  static int				insertitem;
-  static bool				usedfordestruction;
 };
 
 /**
@@ -0,0 +1,152 @@
+/*
+ * MySQL backend of the simulation traces
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-mysql-trace-sink.h"
+
+#ifdef HAVE_MYSQL
+
+#include "ns3/log.h"
+
+#include <iostream>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.MySqlTraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+MySqlTraceSink::MySqlTraceSink(sql::Driver* driver, const std::string& ip, int port,
+							   const std::string& database,
+							   const std::string& user, const std::string& password)
+	:m_driver(driver)
+	,m_database(database)
+	,m_con(nullptr)
+	,m_stmt(nullptr)
+{
+	m_properties["hostName"] = "tcp://" + ip;
+	m_properties["userName"] = user;
+	m_properties["password"] = password;
+	m_properties["port"] = port;
+	m_properties["schema"] = database;
+	m_properties["OPT_RECONNECT"] = true;
+}
+
+MySqlTraceSink::~MySqlTraceSink()
+{
+	Close();
+}
+
+void
+MySqlTraceSink::WriterStart()
+{
+	// Connector/C++ needs every thread using a connection to be registered
+	m_driver->threadInit();
+	try{
+		m_con = m_driver->connect(m_properties);
+		m_stmt = m_con->createStatement();
+	}
+	catch (sql::SQLException &e) {
+		std::cout << "# ERR: SQLException in " << __FILE__;
+		std::cout << "(" << __FUNCTION__ << ") on line "
+		     << __LINE__ << std::endl;
+		std::cout << "# ERR: " << e.what();
+		std::cout << " (MySQL error code: " << e.getErrorCode();
+		std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
+	}
+}
+
+void
+MySqlTraceSink::WriterStop()
+{
+	delete m_stmt;
+	m_stmt = nullptr;
+	delete m_con;
+	m_con = nullptr;
+	m_driver->threadEnd();
+}
+
+void
+MySqlTraceSink::Execute(const std::string& query)
+{
+	if(m_con == nullptr)
+	{
+		NS_LOG_WARN("No connection to " << m_database << ", statement dropped");
+		return;
+	}
+	try{
+		if(!m_con->isValid())
+		{
+			delete m_stmt;
+			m_stmt = nullptr;
+			m_con->reconnect();
+			m_con->setSchema(m_database);
+			m_stmt = m_con->createStatement();
+		}
+		m_stmt->execute(query);
+	}
+	catch (sql::SQLException &e) {
+		std::cout << "# ERR: SQLException in " << __FILE__;
+		std::cout << "(" << __FUNCTION__ << ") on line "
+		     << __LINE__ << std::endl;
+		std::cout << "# ERR: " << e.what();
+		std::cout << " (MySQL error code: " << e.getErrorCode();
+		std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
+	}
+}
+
+void
+MySqlTraceSink::WriteSchema(const std::string& table, const std::vector<TraceColumn>& columns)
+{
+	Execute(CreateStatement(table, columns));
+}
+
+void
+MySqlTraceSink::WriteRows(const std::string& table, const std::vector<TraceRow>& rows)
+{
+	if(rows.empty())
+		return;
+
+	std::ostringstream ss;
+	ss << "INSERT INTO " << table << " VALUES";
+	for(auto row = rows.begin(); row != rows.end(); row++)
+	{
+		ss << (row == rows.begin() ? "(" : ",(");
+		for(std::size_t i = 0; i < row->GetSize(); i++)
+		{
+			if(i != 0)
+				ss << ",";
+			switch(row->GetType(i))
+			{
+			case TraceRow::NUMBER:
+				ss << row->GetValue(i);
+				break;
+			case TraceRow::TEXT:
+			{
+				const std::string& value = row->GetValue(i);
+				ss << "'";
+				for(std::size_t c = 0; c < value.size(); c++)
+				{
+					if(value[c] == '\'' || value[c] == '\\')
+						ss << '\\';
+					ss << value[c];
+				}
+				ss << "'";
+				break;
+			}
+			default:
+				ss << "NULL";
+			}
+		}
+		ss << ")";
+	}
+	ss << ";";
+	Execute(ss.str());
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // HAVE_MYSQL
@@ -0,0 +1,56 @@
+/*
+ * MySQL backend of the simulation traces
+ *
+ * Rows of one batch are sent as a single multi-row INSERT from the writer
+ * thread of AsyncTraceSink. Only compiled when the MySQL connector is found
+ * (HAVE_MYSQL).
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_MYSQL_TRACE_SINK_H
+#define NDN_MYSQL_TRACE_SINK_H
+
+#ifdef HAVE_MYSQL
+
+#include "ndn-trace-sink.h"
+
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include <cppconn/statement.h>
+
+namespace ns3 {
+namespace ndn {
+
+class MySqlTraceSink : public AsyncTraceSink
+{
+public:
+	MySqlTraceSink(sql::Driver* driver, const std::string& ip, int port,
+				   const std::string& database,
+				   const std::string& user, const std::string& password);
+	virtual ~MySqlTraceSink();
+
+protected:
+	virtual void WriteSchema(const std::string& table, const std::vector<TraceColumn>& columns);
+	virtual void WriteRows(const std::string& table, const std::vector<TraceRow>& rows);
+	virtual void WriterStart();
+	virtual void WriterStop();
+
+private:
+	void Execute(const std::string& query);
+
+	sql::Driver*			m_driver;
+	sql::ConnectOptionsMap	m_properties;
+	std::string				m_database;
+
+	sql::Connection*		m_con;
+	sql::Statement*			m_stmt;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // HAVE_MYSQL
+
+#endif
@@ -19,6 +19,9 @@
 #include "ns3/node-list.h"
 #include "ns3/ndn-bitrate.h"
 #include "ns3/log.h"
+#ifdef HAVE_MYSQL
+#include "ns3/ndn-mysql-trace-sink.h"
+#endif
 
 #include <boost/lexical_cast.hpp>
 
@@ -35,24 +38,11 @@ using namespace std;
 namespace ns3 {
 namespace ndn {
 
-sql::Driver* RewardTracer::driver = nullptr;
-sql::Connection* RewardTracer::con = nullptr;
-sql::Statement* RewardTracer::stmt = nullptr;
-
 std::string RewardTracer::RewardTable;
-int RewardTracer::TableId;
-int RewardTracer::RewardTableItem;
-
 std::string RewardTracer::PartitionTable;
-int RewardTracer::PartitionTableItem;
-
-std::string RewardTracer::DatabaseName;
-
-bool RewardTracer::usedfordestruction = false;
+int RewardTracer::TableId;
 
-std::list< boost::tuple< boost::shared_ptr<std::ostringstream>,
-						 boost::shared_ptr<std::ostringstream>,
-						 std::list<Ptr<RewardTracer> > > > RewardTracer::g_tracers_reward;
+std::list< boost::tuple< Ptr<TraceSink>, std::list<Ptr<RewardTracer> > > > RewardTracer::g_tracers_reward;
 
 template<class T>
 static inline void
@@ -68,74 +58,64 @@ RewardTracer::Destroy ()
 
 
 void
-RewardTracer::InstallAllSql (sql::Driver* d, const std::string& ip, const std::string& database,
-							 const std::string& rtable,
-							 const std::string& ptable,
-		  	  	  	  	  	 const std::string& user,
-							 const std::string& password,
-							 const int expidx,
-							 const std::string BitRates[],
-							 uint32_t TotalBitrate)
+RewardTracer::InstallAll (Ptr<TraceSink> sink,
+						  const std::string& rtable,
+						  const std::string& ptable,
+						  const int expidx,
+						  const std::string BitRates[],
+						  uint32_t TotalBitrate)
 {
-	using namespace boost;
-	using namespace std;
-
-	try{
-		DatabaseName = database;
-		RewardTracer::usedfordestruction = true;
-		driver = d;
-		con = driver->connect("tcp://"+ip+":3306", user, password);
-		con->setSchema(DatabaseName);
-		stmt = con->createStatement();
-
-		RewardTable = rtable;
-		PartitionTable = ptable;
-
-		TableId = expidx;
-
-		// The RequestReward in Table(Reward) is the reward per request
-		/*stmt->execute("CREATE TABLE IF NOT EXISTS " + RewardTable + " (Node SMALLINT, Transition SMALLINT, " +
-				"`BitRate(Kbps)` VARCHAR(6), RequestReward DOUBLE, ExpID SMALLINT);"); */
-		std::ostringstream partitionss;
-		// The CacheReward in Table(Partition) is the accumulated reward on router (and its upstream routers)
-		partitionss << "CREATE TABLE IF NOT EXISTS " + PartitionTable + " (Node SMALLINT, Transition INT, " ;
-		for(uint32_t i = 0; i < TotalBitrate; i++)
-			partitionss << "`" << BitRates[i] << "` DECIMAL(4,3), ";
-		partitionss << "CacheReward DOUBLE, ExpID SMALLINT);";
-		stmt->execute(partitionss.str());
-		RewardTableItem = 0;
-		PartitionTableItem = 0;
+	RewardTable = rtable;
+	PartitionTable = ptable;
+	TableId = expidx;
 
-	}
-	catch (sql::SQLException &e) {
-		cout << "# ERR: SQLException in " << __FILE__;
-		cout << "(" << __FUNCTION__ << ") on line "
-		     << __LINE__ << endl;
-		cout << "# ERR: " << e.what();
-		cout << " (MySQL error code: " << e.getErrorCode();
-		cout << ", SQLState: " << e.getSQLState() << " )" << endl;
+	// The RequestReward in Table(Reward) is the reward per request
+	if(!RewardTable.empty())
+		sink->CreateTable(RewardTable, {{"Node", "SMALLINT"}, {"Transition", "SMALLINT"}, {"BitRate(Kbps)", "VARCHAR(6)"},
+										{"RequestReward", "DOUBLE"}, {"ExpID", "SMALLINT"}});
+
+	// The CacheReward in Table(Partition) is the accumulated reward on router (and its upstream routers)
+	if(!PartitionTable.empty())
+	{
+		std::vector<TraceColumn> columns {{"Node", "SMALLINT"}, {"Transition", "INT"}};
+		for(uint32_t i = 0; i < TotalBitrate; i++)
+			columns.push_back(TraceColumn {BitRates[i], "DECIMAL(4,3)"});
+		columns.push_back(TraceColumn {"CacheReward", "DOUBLE"});
+		columns.push_back(TraceColumn {"ExpID", "SMALLINT"});
+		sink->CreateTable(PartitionTable, columns);
 	}
 
 	std::list<Ptr<RewardTracer> > tracers;
-	boost::shared_ptr<std::ostringstream> OS_reward (new std::ostringstream());
-	boost::shared_ptr<std::ostringstream> OS_partition (new std::ostringstream());
-
 	for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
 	{
-		Ptr<RewardTracer> trace = InstallSql(*node, OS_reward, OS_partition);
+		Ptr<RewardTracer> trace = InstallSql(*node, sink);
 		tracers.push_back (trace);
 	}
-	g_tracers_reward.push_back (boost::make_tuple (OS_reward, OS_partition , tracers));
+	g_tracers_reward.push_back (boost::make_tuple (sink, tracers));
+}
+
+#ifdef HAVE_MYSQL
+void
+RewardTracer::InstallAllSql (sql::Driver* d, const std::string& ip, const std::string& database,
+							 const std::string& rtable,
+							 const std::string& ptable,
+		  	  	  	  	  	 const std::string& user,
+							 const std::string& password,
+							 const int expidx,
+							 const std::string BitRates[],
+							 uint32_t TotalBitrate)
+{
+	Ptr<MySqlTraceSink> sink = Create<MySqlTraceSink> (d, ip, 3306, database, user, password);
+	InstallAll(sink, rtable, ptable, expidx, BitRates, TotalBitrate);
 }
+#endif
 
 
 Ptr<RewardTracer>
-RewardTracer::InstallSql (Ptr<Node> node,
-                   boost::shared_ptr<std::ostringstream> OS_r,
-				   boost::shared_ptr<std::ostringstream> OS_p)
+RewardTracer::InstallSql (Ptr<Node> node, Ptr<TraceSink> sink)
 {
   NS_LOG_DEBUG ("Node: " << node->GetId ());
-  Ptr<RewardTracer> trace = Create<RewardTracer> (OS_r, OS_p, node);
+  Ptr<RewardTracer> trace = Create<RewardTracer> (sink, node);
 
   return trace;
 }
@@ -143,12 +123,9 @@ RewardTracer::InstallSql (Ptr<Node> node,
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-RewardTracer::RewardTracer (boost::shared_ptr<std::ostringstream> os_r,
-							boost::shared_ptr<std::ostringstream> os_p,
-							Ptr<Node> node)
+RewardTracer::RewardTracer (Ptr<TraceSink> sink, Ptr<Node> node)
 	: m_nodePtr (node)
-	, m_rewardStream (os_r)
-	, m_partitionStream(os_p)
+	, m_sink (sink)
 {
   m_transition = 0;
   m_node = boost::lexical_cast<string> (m_nodePtr->GetId ());
@@ -163,80 +140,8 @@ RewardTracer::RewardTracer (boost::shared_ptr<std::ostringstream> os_r,
 
 RewardTracer::~RewardTracer ()
 {
-	ClearRewardTable();
-	ClearPartitionTable();
-
-	if(RewardTracer::usedfordestruction)
-	{
-		RewardTracer::usedfordestruction = false;
-		delete RewardTracer::stmt;
-		delete RewardTracer::con;
-
-		stmt = nullptr;
-		con = nullptr;
-	}
 }
 
-void
-RewardTracer::ClearRewardTable()
-{
-	if(m_rewardStream != nullptr && RewardTableItem != 0)
-	{
-		RewardTableItem = 0;
-		try{
-			*m_rewardStream << ";";
-			if(!con->isValid())
-			{
-				delete RewardTracer::stmt;
-				stmt = nullptr;
-				con->reconnect();
-				con->setSchema(DatabaseName);
-				stmt = con->createStatement();
-			}
-			stmt->execute(m_rewardStream->str());
-		} catch (sql::SQLException &e) {
-			std::cout << "# ERR: SQLException in " << __FILE__;
-			std::cout << "(" << __FUNCTION__ << ") on line "
-			     << __LINE__ << endl;
-			std::cout << "# ERR: " << e.what();
-			std::cout << " (MySQL error code: " << e.getErrorCode();
-			std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-		}
-		m_rewardStream->clear();
-		m_rewardStream->str("");
-	}
-}
-
-void
-RewardTracer::ClearPartitionTable()
-{
-	if(m_partitionStream != nullptr && PartitionTableItem != 0)
-	{
-		PartitionTableItem = 0;
-		try{
-			*m_partitionStream << ";";
-
-			if(!con->isValid())
-			{
-				delete RewardTracer::stmt;
-				stmt = nullptr;
-				con->reconnect();
-				con->setSchema(DatabaseName);
-				stmt = con->createStatement();
-			}
-			stmt->execute(m_partitionStream->str());
-		} catch (sql::SQLException &e) {
-			std::cout << "# ERR: SQLException in " << __FILE__;
-			std::cout << "(" << __FUNCTION__ << ") on line "
-			     << __LINE__ << endl;
-			std::cout << "# ERR: " << e.what();
-			std::cout << " (MySQL error code: " << e.getErrorCode();
-			std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-		}
-		m_partitionStream->clear();
-		m_partitionStream->str("");
-	}
-}
 void
 RewardTracer::Connect ()
 {
@@ -259,125 +164,47 @@ RewardTracer::Reset ()
 void
 RewardTracer::PrintReward() const
 {
+  if(m_sink == nullptr || RewardTable.empty())
+  {
+	  NS_LOG_WARN("Log error in Reward Tracer !");
+	  return;
+  }
+
   std::string tail = "kbps";
   for(auto iter = m_stats.begin(); iter != m_stats.end(); iter++)
   {
 	  if(static_cast<int>(iter->second) == 0)
 		  continue;
-	  if(m_rewardStream != nullptr)
-	  {
-		  std::size_t found = iter->first.find(tail);
-		  if(RewardTableItem == 0)
-			{
-				*m_rewardStream << "INSERT INTO " << RewardTable
-						<<" VALUES("
-				        << m_nodePtr->GetId() << ","
-						<< m_transition << ","
-				        << std::stoi(iter->first.substr(0, found)) << ","
-						<< fixed << setprecision(5) << iter->second << ","
-						<< RewardTracer::TableId << ")";
-			}
-		  else
-			{
-				*m_rewardStream << ",("
-				        << m_nodePtr->GetId() << ","
-						<< m_transition << ","
-				        << std::stoi(iter->first.substr(0, found)) << ","
-						<< fixed << setprecision(5) << iter->second << ","
-						<< RewardTracer::TableId << ")";
-			}
-		  RewardTableItem++;
-	  }
-	  else
-		  NS_LOG_WARN("Log error in CS Tracer !");
+	  std::size_t found = iter->first.find(tail);
+	  TraceRow row;
+	  row.Add(m_nodePtr->GetId())
+		 .Add(m_transition)
+		 .Add(std::stoi(iter->first.substr(0, found)))
+		 .Add(iter->second, 5, true)
+		 .Add(RewardTracer::TableId);
+	  m_sink->Append(RewardTable, row);
   }
-  if(m_rewardStream != nullptr && RewardTableItem >= 3000)
-  {
-	  RewardTableItem = 0;
-	  try{
-		  *m_rewardStream << ";";
-			if(!con->isValid())
-			{
-				delete RewardTracer::stmt;
-				stmt = nullptr;
-				con->reconnect();
-				con->setSchema(DatabaseName);
-				stmt = con->createStatement();
-			}
-		  stmt->execute(m_rewardStream->str());
-	  } catch (sql::SQLException &e) {
-			  std::cout << "# ERR: SQLException in " << __FILE__;
-			  std::cout << "(" << __FUNCTION__ << ") on line "
-				     << __LINE__ << endl;
-			  std::cout << "# ERR: " << e.what();
-			  std::cout << " (MySQL error code: " << e.getErrorCode();
-			  std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-		  }
-		  m_rewardStream->clear();
-		  m_rewardStream->str("");
-	}
 }
 
 void
 RewardTracer::PrintPartition(uint32_t episode, double aggreward, std::shared_ptr<double> arrpar)
 {
-	//The sequence in partition array (arrpar) must be consistent with the table names in schema.
-	uint32_t limit = m_BRinfo->GetTableSize();
-	if(m_partitionStream != nullptr)
+	if(m_sink == nullptr || PartitionTable.empty())
 	{
-		  if(PartitionTableItem == 0)
-			{
-				*m_partitionStream << "INSERT INTO " << PartitionTable
-						<<" VALUES("
-				        << m_nodePtr->GetId() << ","
-						<< episode << ",";
-				for(uint32_t i = 0; i < limit; i++)
-					*m_partitionStream << arrpar.get()[i] << ",";
-				*m_partitionStream << fixed << setprecision(6) << aggreward << ","
-						<< RewardTracer::TableId << ")";
-			}
-		  else
-			{
-				*m_partitionStream << ",("
-				        << m_nodePtr->GetId() << ","
-						<< episode << ",";
-				for(uint32_t i = 0; i < limit; i++)
-					*m_partitionStream << arrpar.get()[i] << ",";
-				*m_partitionStream << fixed << setprecision(6) << aggreward << ","
-						<< RewardTracer::TableId << ")";
-			}
-		  PartitionTableItem++;
-	  }
-	else
-		NS_LOG_WARN("Log error in CS Tracer !");
-
-	  if(m_partitionStream != nullptr && PartitionTableItem >= 1)
-	  {
-		  PartitionTableItem = 0;
-		  try{
-			  *m_partitionStream << ";";
-				if(!con->isValid())
-				{
-					delete RewardTracer::stmt;
-					stmt = nullptr;
-					con->reconnect();
-					con->setSchema(DatabaseName);
-					stmt = con->createStatement();
-				}
-			  stmt->execute(m_partitionStream->str());
-		  } catch (sql::SQLException &e) {
-				  std::cout << "# ERR: SQLException in " << __FILE__;
-				  std::cout << "(" << __FUNCTION__ << ") on line "
-					     << __LINE__ << endl;
-				  std::cout << "# ERR: " << e.what();
-				  std::cout << " (MySQL error code: " << e.getErrorCode();
-				  std::cout << ", SQLState: " << e.getSQLState() << " )" << std::endl;
-			  }
-		  m_partitionStream->clear();
-		  m_partitionStream->str("");
-		}
-
+		NS_LOG_WARN("Log error in Reward Tracer !");
+		return;
+	}
 
+	//The sequence in partition array (arrpar) must be consistent with the table names in schema.
+	uint32_t limit = m_BRinfo->GetTableSize();
+	TraceRow row;
+	row.Add(m_nodePtr->GetId())
+	   .Add(episode);
+	for(uint32_t i = 0; i < limit; i++)
+		row.Add(arrpar.get()[i]);
+	row.Add(aggreward, 6, true)
+	   .Add(RewardTracer::TableId);
+	m_sink->Append(PartitionTable, row);
 }
 
 void
@@ -14,6 +14,7 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 #include "ns3/ndn-bitrate.h"
+#include "ns3/ndn-trace-sink.h"
 
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
@@ -22,11 +23,11 @@
 #include <sstream>
 #include <memory>
 
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/exception.h>
-#include <cppconn/statement.h>
-
+#ifdef HAVE_MYSQL
+namespace sql {
+class Driver;
+}
+#endif
 
 namespace ns3 {
 
@@ -46,6 +47,15 @@ class RewardTracer : public SimpleRefCount<RewardTracer>
 {
 public:
 
+  /*
+   * Record traces for all nodes into the tables of a trace sink;
+   * an empty table name disables the corresponding trace
+   */
+  static void
+  InstallAll (Ptr<TraceSink> sink, const std::string& rtable, const std::string& ptable, const int expidx,
+		  	  const std::string BitRates[], uint32_t TotalBitrate);
+
+#ifdef HAVE_MYSQL
   /*
    * Record traces for all nodes on MySQL database;
    */
@@ -53,15 +63,16 @@ public:
   InstallAllSql (sql::Driver* d, const std::string& ip, const std::string& database, const std::string& rtable, const std::string& ptable,
 		  	  	  const std::string& user, const std::string& password, const int expidx,
 				  const std::string BitRates[], uint32_t TotalBitrate);
+#endif
 
   static Ptr<RewardTracer>
-  InstallSql (Ptr<Node>, boost::shared_ptr<std::ostringstream>, boost::shared_ptr<std::ostringstream>);
+  InstallSql (Ptr<Node>, Ptr<TraceSink>);
 
   static void
   Destroy ();
 
 
-  RewardTracer (boost::shared_ptr<std::ostringstream>,boost::shared_ptr<std::ostringstream>, Ptr<Node> node);
+  RewardTracer (Ptr<TraceSink>, Ptr<Node> node);
 
   /**
    * @brief Destructor
@@ -80,10 +91,6 @@ public:
   void
   PrintPartition (uint32_t, double, std::shared_ptr<double>);
 
-  static sql::Statement 	*stmt;
-  static sql::Driver 		*driver;
-  static sql::Connection 	*con;
-
 private:
   void
   Connect ();
@@ -99,37 +106,22 @@ private:
   void
   Reset ();
 
-  void
-  ClearRewardTable();
-
-  void
-  ClearPartitionTable();
-
 private:
   std::string 	m_node;
   Ptr<Node> 	m_nodePtr;
   Ptr<NDNBitRate> m_BRinfo;
 
-  boost::shared_ptr<std::ostringstream> m_rewardStream;
-  boost::shared_ptr<std::ostringstream> m_partitionStream;
+  Ptr<TraceSink> m_sink;
 
   std::map<std::string, double> m_stats;
   uint32_t 		m_transition;
 
-  static std::list< boost::tuple< boost::shared_ptr<std::ostringstream>,
-  	  	  	  	  	  	  	  	  boost::shared_ptr<std::ostringstream>,
-  	  	  	  	  	  	  	  	  std::list<Ptr<RewardTracer> > > > 	g_tracers_reward;
+  static std::list< boost::tuple< Ptr<TraceSink>, std::list<Ptr<RewardTracer> > > > 	g_tracers_reward;
 
   static std::string		RewardTable;
-  static int				RewardTableItem;
-
   static std::string		PartitionTable;
-  static int				PartitionTableItem;
-
-  static std::string		DatabaseName;
 
   static int				TableId;
-  static bool				usedfordestruction;
 
 };
 
@@ -0,0 +1,561 @@
+/*
+ * Storage backends for the simulation traces
+ *
+ * Date: 2026-10-17
+ */
+
+#include "ndn-trace-sink.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+// Upper bound of batches waiting for the writer before Append blocks
+static const std::size_t MaxQueuedBatches = 64;
+
+TraceRow&
+TraceRow::Add(int32_t value)
+{
+	m_fields.push_back(Field {std::to_string(value), NUMBER});
+	return *this;
+}
+
+TraceRow&
+TraceRow::Add(uint32_t value)
+{
+	m_fields.push_back(Field {std::to_string(value), NUMBER});
+	return *this;
+}
+
+TraceRow&
+TraceRow::Add(int64_t value)
+{
+	m_fields.push_back(Field {std::to_string(value), NUMBER});
+	return *this;
+}
+
+TraceRow&
+TraceRow::Add(uint64_t value)
+{
+	m_fields.push_back(Field {std::to_string(value), NUMBER});
+	return *this;
+}
+
+TraceRow&
+TraceRow::Add(double value)
+{
+	std::ostringstream os;
+	os << value;
+	m_fields.push_back(Field {os.str(), NUMBER});
+	return *this;
+}
+
+TraceRow&
+TraceRow::Add(double value, int precision, bool fixed)
+{
+	std::ostringstream os;
+	if(fixed)
+		os << std::fixed;
+	os << std::setprecision(precision) << value;
+	m_fields.push_back(Field {os.str(), NUMBER});
+	return *this;
+}
+
+TraceRow&
+TraceRow::AddText(const std::string& value)
+{
+	m_fields.push_back(Field {value, TEXT});
+	return *this;
+}
+
+TraceRow&
+TraceRow::AddNull()
+{
+	m_fields.push_back(Field {std::string(), NONE});
+	return *this;
+}
+
+void
+TraceRow::Set(std::size_t i, uint32_t value)
+{
+	m_fields[i] = Field {std::to_string(value), NUMBER};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+TraceSink::~TraceSink()
+{
+
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncTraceSink::AsyncTraceSink()
+	:m_batchSize(1000)
+	,m_closed(false)
+	,m_setExpID(false)
+	,m_expid(0)
+	,m_busy(false)
+	,m_stop(false)
+{
+
+}
+
+AsyncTraceSink::~AsyncTraceSink()
+{
+	NS_ASSERT_MSG(!m_writer.joinable(), "Trace sink destroyed without Close()");
+}
+
+void
+AsyncTraceSink::SetBatchSize(uint32_t rows)
+{
+	m_batchSize = (rows == 0) ? 1 : rows;
+}
+
+void
+AsyncTraceSink::CreateTable(const std::string& table, const std::vector<TraceColumn>& columns)
+{
+	if(m_closed)
+	{
+		NS_LOG_WARN("Table " << table << " declared on a closed trace sink");
+		return;
+	}
+	for(uint32_t i = 0; i < columns.size(); i++)
+		if(columns[i].m_name == "ExpID")
+			m_expidColumn[table] = i;
+	Job job {table, true, columns, std::vector<TraceRow>()};
+	Submit(job);
+}
+
+void
+AsyncTraceSink::Append(const std::string& table, const TraceRow& row)
+{
+	if(m_closed)
+	{
+		NS_LOG_WARN("Row of " << table << " dropped: trace sink closed");
+		return;
+	}
+	std::vector<TraceRow>& rows = m_pending[table];
+	rows.push_back(row);
+	if(m_setExpID)
+	{
+		auto column = m_expidColumn.find(table);
+		if(column != m_expidColumn.end() && column->second < row.GetSize())
+			rows.back().Set(column->second, m_expid);
+	}
+	if(rows.size() >= m_batchSize)
+		HandOver(table, rows);
+}
+
+void
+AsyncTraceSink::HandOver(const std::string& table, std::vector<TraceRow>& rows)
+{
+	Job job {table, false, std::vector<TraceColumn>(), std::vector<TraceRow>()};
+	job.m_rows.swap(rows);
+	rows.reserve(m_batchSize);
+	Submit(job);
+}
+
+void
+AsyncTraceSink::Submit(Job& job)
+{
+	if(!m_writer.joinable())
+		m_writer = std::thread(&AsyncTraceSink::WriterLoop, this);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this]{ return m_queue.size() < MaxQueuedBatches; });
+	m_queue.push_back(std::move(job));
+	lock.unlock();
+	m_wake.notify_one();
+}
+
+void
+AsyncTraceSink::Flush()
+{
+	for(auto iter = m_pending.begin(); iter != m_pending.end(); iter++)
+	{
+		if(!iter->second.empty())
+			HandOver(iter->first, iter->second);
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this]{ return m_queue.empty() && !m_busy; });
+}
+
+void
+AsyncTraceSink::Close()
+{
+	if(m_closed)
+		return;
+	Detach();
+	m_closed = true;
+}
+
+void
+AsyncTraceSink::Detach()
+{
+	Flush();
+
+	if(m_writer.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_one();
+		m_writer.join();
+		m_stop = false;
+	}
+}
+
+void
+AsyncTraceSink::SetExpID(uint32_t id)
+{
+	m_setExpID = true;
+	m_expid = id;
+}
+
+void
+AsyncTraceSink::WriterLoop()
+{
+	WriterStart();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while(true)
+	{
+		m_wake.wait(lock, [this]{ return m_stop || !m_queue.empty(); });
+		if(m_queue.empty())
+			break;
+
+		Job job = std::move(m_queue.front());
+		m_queue.pop_front();
+		m_busy = true;
+		lock.unlock();
+		m_idle.notify_all();
+
+		if(job.m_schema)
+			WriteSchema(job.m_table, job.m_columns);
+		else
+			WriteRows(job.m_table, job.m_rows);
+
+		lock.lock();
+		m_busy = false;
+		m_idle.notify_all();
+	}
+	lock.unlock();
+
+	WriterStop();
+}
+
+void
+AsyncTraceSink::WriterStart()
+{
+
+}
+
+void
+AsyncTraceSink::WriterStop()
+{
+
+}
+
+std::string
+AsyncTraceSink::CreateStatement(const std::string& table, const std::vector<TraceColumn>& columns)
+{
+	std::ostringstream ss;
+	ss << "CREATE TABLE IF NOT EXISTS " << table << " (";
+	for(uint32_t i = 0; i < columns.size(); i++)
+	{
+		if(i != 0)
+			ss << ", ";
+		ss << "`" << columns[i].m_name << "` " << columns[i].m_type;
+	}
+	ss << ");";
+	return ss.str();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// mkdir -p
+static void
+MakeDirectory(const std::string& dir)
+{
+	for(std::size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1))
+	{
+		std::string parent = dir.substr(0, pos);
+		if(mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST)
+		{
+			NS_LOG_ERROR("Cannot create trace directory " << parent << ": " << std::strerror(errno));
+			break;
+		}
+		if(pos == std::string::npos)
+			break;
+	}
+}
+
+static void
+CopyFile(const std::string& from, const std::string& to)
+{
+	std::ifstream in(from.c_str(), std::ios_base::binary);
+	std::ofstream out(to.c_str(), std::ios_base::binary | std::ios_base::trunc);
+	if(in.is_open() && out.is_open())
+		out << in.rdbuf();
+	else
+		NS_LOG_ERROR("Cannot copy " << from << " to " << to);
+}
+
+// One CSV record: a line, or several if a quoted field holds a newline
+static bool
+ReadRecord(std::istream& in, std::string& record)
+{
+	record.clear();
+	bool quoted = false;
+	char c;
+	while(in.get(c))
+	{
+		if(c == '\n' && !quoted)
+			return true;
+		if(c == '"')
+			quoted = !quoted;
+		record += c;
+	}
+	return !record.empty();
+}
+
+// Fields of a record, quotes kept
+static std::vector<std::string>
+SplitRecord(const std::string& record)
+{
+	std::vector<std::string> fields(1);
+	bool quoted = false;
+	for(std::size_t i = 0; i < record.size(); i++)
+	{
+		if(record[i] == '"')
+			quoted = !quoted;
+		if(record[i] == ',' && !quoted)
+			fields.push_back(std::string());
+		else
+			fields.back() += record[i];
+	}
+	return fields;
+}
+
+static std::string
+JoinRecord(const std::vector<std::string>& fields)
+{
+	std::string record;
+	for(std::size_t i = 0; i < fields.size(); i++)
+		record += (i == 0 ? "" : ",") + fields[i];
+	return record;
+}
+
+uint32_t
+FileTraceSink::Merge(const std::vector<std::pair<uint32_t, std::string> >& runs, const std::string& dir)
+{
+	static const std::string create = "CREATE TABLE IF NOT EXISTS ";
+
+	// Tables in the order they were first declared, with the statement of the first run declaring them
+	std::vector<std::string> tables;
+	std::map<std::string, std::string> statements;
+	for(auto run = runs.begin(); run != runs.end(); run++)
+	{
+		std::ifstream schema((run->second + "/schema.sql").c_str());
+		std::string line;
+		while(std::getline(schema, line))
+		{
+			if(line.compare(0, create.size(), create) != 0)
+				continue;
+			std::string table = line.substr(create.size(), line.find(' ', create.size()) - create.size());
+			if(statements.insert(std::make_pair(table, line)).second)
+				tables.push_back(table);
+		}
+	}
+	if(tables.empty())
+		return 0;
+
+	MakeDirectory(dir);
+	std::ofstream schema((dir + "/schema.sql").c_str(), std::ios_base::trunc);
+	uint32_t merged = 0;
+	for(auto table = tables.begin(); table != tables.end(); table++)
+	{
+		std::ofstream out((dir + "/" + *table + ".csv").c_str(), std::ios_base::trunc);
+		if(!out.is_open())
+		{
+			NS_LOG_ERROR("File " << dir << "/" << *table << ".csv cannot be opened for writing");
+			continue;
+		}
+
+		std::string header;
+		std::size_t expid = 0;
+		bool added = false;
+		for(auto run = runs.begin(); run != runs.end(); run++)
+		{
+			std::ifstream in((run->second + "/" + *table + ".csv").c_str());
+			std::string record;
+			if(!ReadRecord(in, record))
+				continue;
+
+			if(header.empty())
+			{
+				header = record;
+				std::vector<std::string> columns = SplitRecord(header);
+				expid = std::find(columns.begin(), columns.end(), "ExpID") - columns.begin();
+				added = (expid == columns.size());
+				out << header << (added ? ",ExpID" : "") << "\n";
+			}
+			else if(record != header)
+			{
+				NS_LOG_WARN("Table " << *table << " of " << run->second << " has other columns, not merged");
+				continue;
+			}
+
+			std::string id = std::to_string(run->first);
+			while(ReadRecord(in, record))
+			{
+				std::vector<std::string> fields = SplitRecord(record);
+				if(added)
+					fields.push_back(id);
+				else if(expid < fields.size())
+					fields[expid] = id;
+				out << JoinRecord(fields) << "\n";
+			}
+		}
+
+		std::string statement = statements[*table];
+		if(added && statement.size() >= 2)
+			statement.insert(statement.size() - 2, ", `ExpID` SMALLINT");
+		schema << statement << std::endl;
+		merged++;
+	}
+	NS_LOG_INFO(merged << " table(s) of " << runs.size() << " run(s) merged into " << dir);
+	return merged;
+}
+
+FileTraceSink::FileTraceSink(const std::string& dir)
+	:m_dir(dir)
+{
+	MakeDirectory(m_dir);
+
+	m_schema.open((m_dir + "/schema.sql").c_str(), std::ios_base::out | std::ios_base::trunc);
+	if(!m_schema.is_open())
+		NS_LOG_ERROR("File " << m_dir << "/schema.sql cannot be opened for writing");
+}
+
+FileTraceSink::~FileTraceSink()
+{
+	Close();
+}
+
+void
+FileTraceSink::Relocate(const std::string& dir)
+{
+	// No writer thread from here on, until the next row
+	Detach();
+	if(dir == m_dir)
+		return;
+
+	MakeDirectory(dir);
+	m_schema.close();
+	CopyFile(m_dir + "/schema.sql", dir + "/schema.sql");
+	std::vector<std::string> tables;
+	for(auto iter = m_tables.begin(); iter != m_tables.end(); iter++)
+	{
+		if(!iter->second->is_open())
+			continue;	// Disabled table, stays so
+		iter->second->close();
+		CopyFile(m_dir + "/" + iter->first + ".csv", dir + "/" + iter->first + ".csv");
+		tables.push_back(iter->first);
+	}
+
+	m_dir = dir;
+	m_schema.open((m_dir + "/schema.sql").c_str(), std::ios_base::out | std::ios_base::app);
+	if(!m_schema.is_open())
+		NS_LOG_ERROR("File " << m_dir << "/schema.sql cannot be opened for writing");
+	for(auto iter = tables.begin(); iter != tables.end(); iter++)
+	{
+		m_tables.erase(*iter);
+		OpenTable(*iter, std::ios_base::app);
+	}
+}
+
+std::ofstream*
+FileTraceSink::OpenTable(const std::string& table, std::ios_base::openmode mode)
+{
+	std::unique_ptr<std::ofstream>& os = m_tables[table];
+	if(os == nullptr)
+	{
+		os.reset(new std::ofstream());
+		os->open((m_dir + "/" + table + ".csv").c_str(), std::ios_base::out | mode);
+		if(!os->is_open())
+			NS_LOG_ERROR("File " << m_dir << "/" << table << ".csv cannot be opened for writing. Table disabled");
+	}
+	return os->is_open() ? os.get() : nullptr;
+}
+
+void
+FileTraceSink::WriteSchema(const std::string& table, const std::vector<TraceColumn>& columns)
+{
+	if(m_tables.find(table) != m_tables.end())
+		return;
+
+	std::ofstream* os = OpenTable(table);
+	if(os == nullptr)
+		return;
+	for(uint32_t i = 0; i < columns.size(); i++)
+		*os << (i == 0 ? "" : ",") << columns[i].m_name;
+	*os << "\n";
+
+	os->flush();
+
+	if(m_schema.is_open())
+		m_schema << CreateStatement(table, columns) << std::endl;
+}
+
+void
+FileTraceSink::WriteRows(const std::string& table, const std::vector<TraceRow>& rows)
+{
+	auto iter = m_tables.find(table);
+	if(iter == m_tables.end())
+		NS_LOG_WARN("Table " << table << " was not declared, writing rows without header");
+	std::ofstream* os = (iter == m_tables.end()) ? OpenTable(table)
+						: (iter->second->is_open() ? iter->second.get() : nullptr);
+	if(os == nullptr)
+		return;
+
+	for(auto row = rows.begin(); row != rows.end(); row++)
+	{
+		for(std::size_t i = 0; i < row->GetSize(); i++)
+		{
+			if(i != 0)
+				*os << ",";
+			const std::string& value = row->GetValue(i);
+			if(row->GetType(i) == TraceRow::TEXT && value.find_first_of(",\"\n") != std::string::npos)
+			{
+				*os << "\"";
+				for(std::size_t c = 0; c < value.size(); c++)
+					*os << (value[c] == '"' ? "\"\"" : std::string(1, value[c]));
+				*os << "\"";
+			}
+			else
+				*os << value;
+		}
+		*os << "\n";
+	}
+	os->flush();
+}
+
+} // namespace ndn
+} // namespace ns3
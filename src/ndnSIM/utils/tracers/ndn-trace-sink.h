@@ -0,0 +1,252 @@
+/*
+ * Storage backends for the simulation traces (SimIndex, UserRequest, BRSwitch,
+ * Partition, CacheStatus, ...)
+ *
+ * Tracers describe their tables once with CreateTable and then Append rows.
+ * AsyncTraceSink groups the rows of every table into batches which are written
+ * by a background thread, so the simulation never waits for the disk or the
+ * database server.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NDN_TRACE_SINK_H
+#define NDN_TRACE_SINK_H
+
+#include "ns3/simple-ref-count.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace ns3 {
+namespace ndn {
+
+/*
+ * One column of a table: name and SQL type, e.g. {"BitRate(Kbps)", "VARCHAR(4)"}
+ */
+struct TraceColumn
+{
+	std::string		m_name;
+	std::string		m_type;
+};
+
+/*
+ * Values of one row, already formatted. Fields are appended in column order.
+ */
+class TraceRow
+{
+public:
+	enum FieldType
+	{
+		NUMBER,
+		TEXT,
+		NONE	// SQL NULL
+	};
+
+	TraceRow& Add(int32_t value);
+	TraceRow& Add(uint32_t value);
+	TraceRow& Add(int64_t value);
+	TraceRow& Add(uint64_t value);
+	TraceRow& Add(double value);
+
+	/*
+	 * precision: same meaning as std::setprecision; fixed: use std::fixed notation
+	 */
+	TraceRow& Add(double value, int precision, bool fixed = false);
+
+	TraceRow& AddText(const std::string& value);
+	TraceRow& AddNull();
+
+	/*
+	 * Replace field i by a number
+	 */
+	void Set(std::size_t i, uint32_t value);
+
+	inline std::size_t GetSize() const
+	{
+		return m_fields.size();
+	}
+
+	inline const std::string& GetValue(std::size_t i) const
+	{
+		return m_fields[i].m_value;
+	}
+
+	inline FieldType GetType(std::size_t i) const
+	{
+		return m_fields[i].m_type;
+	}
+
+private:
+	struct Field
+	{
+		std::string		m_value;
+		FieldType		m_type;
+	};
+
+	std::vector<Field>	m_fields;
+};
+
+class TraceSink : public SimpleRefCount<TraceSink>
+{
+public:
+	virtual ~TraceSink();
+
+	/*
+	 * Declare a table. Must be called before the first row of the table is appended.
+	 * Existing tables are kept (CREATE TABLE IF NOT EXISTS semantics).
+	 */
+	virtual void CreateTable(const std::string& table, const std::vector<TraceColumn>& columns) = 0;
+
+	virtual void Append(const std::string& table, const TraceRow& row) = 0;
+
+	/*
+	 * Block until every row appended so far has been stored
+	 */
+	virtual void Flush() = 0;
+
+	/*
+	 * Flush and release the backend. Rows appended afterwards are dropped.
+	 */
+	virtual void Close() = 0;
+
+	/*
+	 * Flush and release what a forked process cannot share (threads, connections).
+	 * They are acquired again with the next table or row.
+	 */
+	virtual void Detach() = 0;
+
+	/*
+	 * Rows appended afterwards to a table with an "ExpID" column get 'id' there,
+	 * e.g. for the runs forked from one warmed-up simulation (SweepHelper::RunFromSnapshot)
+	 */
+	virtual void SetExpID(uint32_t id) = 0;
+};
+
+/*
+ * Base of the batched backends. Append only touches the simulation thread's
+ * pending batch; full batches are handed to a writer thread, which calls
+ * WriteSchema/WriteRows in the order the tables and rows were submitted.
+ *
+ * Derived classes must call Close() in their destructor, as the writer thread
+ * calls back into them.
+ */
+class AsyncTraceSink : public TraceSink
+{
+public:
+	AsyncTraceSink();
+	virtual ~AsyncTraceSink();
+
+	/*
+	 * Number of rows of one table that are written together (default 1000)
+	 */
+	void SetBatchSize(uint32_t rows);
+
+	virtual void CreateTable(const std::string& table, const std::vector<TraceColumn>& columns);
+	virtual void Append(const std::string& table, const TraceRow& row);
+	virtual void Flush();
+	virtual void Close();
+	virtual void Detach();
+	virtual void SetExpID(uint32_t id);
+
+protected:
+	/*
+	 * Called on the writer thread
+	 */
+	virtual void WriteSchema(const std::string& table, const std::vector<TraceColumn>& columns) = 0;
+	virtual void WriteRows(const std::string& table, const std::vector<TraceRow>& rows) = 0;
+	virtual void WriterStart();
+	virtual void WriterStop();
+
+	static std::string CreateStatement(const std::string& table, const std::vector<TraceColumn>& columns);
+
+private:
+	struct Job
+	{
+		std::string					m_table;
+		bool						m_schema;
+		std::vector<TraceColumn>	m_columns;
+		std::vector<TraceRow>		m_rows;
+	};
+
+	void Submit(Job& job);
+	void HandOver(const std::string& table, std::vector<TraceRow>& rows);
+	void WriterLoop();
+
+	std::map<std::string, std::vector<TraceRow> >	m_pending;	// Simulation thread only
+	uint32_t		m_batchSize;
+	bool			m_closed;
+
+	std::map<std::string, std::size_t>	m_expidColumn;	// Tables with an ExpID column
+	bool			m_setExpID;
+	uint32_t		m_expid;
+
+	std::deque<Job>				m_queue;
+	bool						m_busy;
+	bool						m_stop;
+	std::mutex					m_mutex;
+	std::condition_variable		m_wake;		// Writer waits for jobs
+	std::condition_variable		m_idle;		// Simulation waits for a free slot or an empty queue
+	std::thread					m_writer;
+};
+
+/*
+ * Embedded backend without any server: every table is written to <dir>/<table>.csv
+ * (header row first, NULL as an empty field), and the CREATE TABLE statements are
+ * collected in <dir>/schema.sql so the traces can be imported into SQLite or MySQL
+ * with the original schemas.
+ */
+class FileTraceSink : public AsyncTraceSink
+{
+public:
+	/*
+	 * The directory (and its parents) is created if it does not exist
+	 */
+	FileTraceSink(const std::string& dir);
+	virtual ~FileTraceSink();
+
+	inline const std::string& GetDirectory() const
+	{
+		return m_dir;
+	}
+
+	/*
+	 * Continue the trace in 'dir'. The tables written so far are copied there first,
+	 * so a run forked from a snapshot keeps the rows of the shared warm-up.
+	 */
+	void Relocate(const std::string& dir);
+
+	/*
+	 * Merge the directories of several runs into 'dir': every table declared in their
+	 * schema.sql gets one <table>.csv, with the header once and the rows of all runs in
+	 * the order of 'runs', and schema.sql its CREATE TABLE statement. The ExpID column of
+	 * the rows read from runs[i].second is set to runs[i].first; tables without one get it
+	 * as last column. Missing directories are skipped.
+	 *
+	 * Return the number of tables written
+	 */
+	static uint32_t Merge(const std::vector<std::pair<uint32_t, std::string> >& runs, const std::string& dir);
+
+protected:
+	virtual void WriteSchema(const std::string& table, const std::vector<TraceColumn>& columns);
+	virtual void WriteRows(const std::string& table, const std::vector<TraceRow>& rows);
+
+private:
+	std::ofstream* OpenTable(const std::string& table, std::ios_base::openmode mode = std::ios_base::trunc);
+
+	std::string		m_dir;
+	std::ofstream	m_schema;
+	std::map<std::string, std::unique_ptr<std::ofstream> >	m_tables;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -83,6 +83,7 @@ struct aggregate_stats_policy_traits
       inline bool
       insert (typename parent_trie::iterator item, uint32_t s)
       {
+        m_inserts ++;
         return true;
       }
 
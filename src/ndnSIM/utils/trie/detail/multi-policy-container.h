@@ -64,6 +64,22 @@ struct inherit_with_base : Super, Value
     return true;
   }
 
+  bool
+  insert (typename Base::iterator item, uint32_t size)
+  {
+    bool ok = Value::value_.insert (item, size);
+    if (!ok)
+      return false;
+
+    ok = Super::insert (item, size);
+    if (!ok)
+      {
+        Value::value_.erase (item);
+        return false;
+      }
+    return true;
+  }
+
   void
   lookup (typename Base::iterator item)
   {
@@ -93,6 +109,7 @@ struct empty_policy_wrap
 
   void update (typename Base::iterator item) {}
   bool insert (typename Base::iterator item) { return true; }
+  bool insert (typename Base::iterator item, uint32_t size) { return true; }
   void lookup (typename Base::iterator item) {}
   void erase (typename Base::iterator item) {}
   void clear () {}
@@ -0,0 +1,96 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Fixed-size block allocator for the nodes of one trie
+ *
+ * Blocks are carved out of chunks that double in size (up to max_chunk blocks)
+ * and recycled through a free list; the chunks are only released with the arena,
+ * i.e., with the whole table.
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef NODE_ARENA_H_
+#define NODE_ARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+template<class T>
+class node_arena
+{
+public:
+  node_arena ()
+    : free_ (0)
+    , next_chunk_ (first_chunk)
+  {
+  }
+
+  ~node_arena ()
+  {
+    for (size_t i = 0; i < chunks_.size (); i++)
+      ::operator delete (chunks_[i]);
+  }
+
+  void *
+  allocate ()
+  {
+    if (free_ == 0)
+      grow ();
+
+    free_block *block = free_;
+    free_ = block->next_;
+    return block;
+  }
+
+  void
+  deallocate (void *p)
+  {
+    free_block *block = static_cast<free_block*> (p);
+    block->next_ = free_;
+    free_ = block;
+  }
+
+private:
+  node_arena (const node_arena &);
+  node_arena &operator= (const node_arena &);
+
+  struct free_block
+  {
+    free_block *next_;
+  };
+
+  static const size_t first_chunk = 16;
+  static const size_t max_chunk = 4096;
+  static const size_t block_size = sizeof (T) < sizeof (free_block) ? sizeof (free_block) : sizeof (T);
+
+  void
+  grow ()
+  {
+    char *chunk = static_cast<char*> (::operator new (next_chunk_ * block_size));
+    chunks_.push_back (chunk);
+
+    // Thread the new blocks backwards, so they are handed out in address order
+    for (size_t i = next_chunk_; i > 0; i--)
+      deallocate (chunk + (i - 1) * block_size);
+
+    if (next_chunk_ < max_chunk)
+      next_chunk_ *= 2;
+  }
+
+  free_block *free_;
+  size_t next_chunk_;
+  std::vector<char*> chunks_;
+};
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // NODE_ARENA_H_
@@ -36,7 +36,7 @@ struct fifo_policy_traits
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
   static std::string GetName () { return "Fifo"; }
 
-  struct policy_hook_type : public boost::intrusive::list_member_hook<> {};
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { uint32_t size; };
 
   template<class Container>
   struct container_hook
@@ -53,6 +53,12 @@ struct fifo_policy_traits
   struct policy 
   {
     typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    static uint32_t& get_size (typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->size;
+    }
     
     // could be just typedef
     class type : public policy_container
@@ -63,6 +69,7 @@ struct fifo_policy_traits
       type (Base &base)
         : base_ (base)
         , max_size_ (100)
+        , now_size_ (0)
       {
       }
 
@@ -75,6 +82,7 @@ struct fifo_policy_traits
       inline bool
       insert (typename parent_trie::iterator item)
       {
+        get_size (item) = 0;
         if (max_size_ != 0 && policy_container::size () >= max_size_)
           {
             base_.erase (&(*policy_container::begin ()));
@@ -83,9 +91,24 @@ struct fifo_policy_traits
         policy_container::push_back (*item);
         return true;
       }
+      /**
+       * @brief Insert item of s bytes, evicting the oldest items until the
+       * bytes fit in max_size_ (a byte budget on this path)
+       */
       inline bool
       insert (typename parent_trie::iterator item, uint32_t s)
       {
+        if (s > max_size_)
+          return false;
+
+        while (now_size_ + s > max_size_)
+          {
+            base_.erase (&(*policy_container::begin ()));
+          }
+
+        get_size (item) = s;
+        now_size_ += s;
+        policy_container::push_back (*item);
         return true;
       }
   
@@ -98,12 +121,14 @@ struct fifo_policy_traits
       inline void
       erase (typename parent_trie::iterator item)
       {
+        now_size_ -= get_size (item);
         policy_container::erase (policy_container::s_iterator_to (*item));
       }
 
       inline void
       clear ()
       {
+        now_size_ = 0;
         policy_container::clear ();
       }
 
@@ -118,10 +143,11 @@ struct fifo_policy_traits
       {
         return max_size_;
       }
+      /// @brief Bytes of the items inserted with their size
       inline size_t
-	  get_current_size() const
+      get_current_size () const
       {
-    	  return 0;
+        return now_size_;
       }
 
     private:
@@ -130,6 +156,7 @@ struct fifo_policy_traits
     private:
       Base &base_;
       size_t max_size_;
+      size_t now_size_;
     };
   };
 };
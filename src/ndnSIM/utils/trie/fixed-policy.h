@@ -19,7 +19,7 @@ struct fixed_policy_traits
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
   static std::string GetName () { return "DASCache"; }
 
-  struct policy_hook_type : public boost::intrusive::list_member_hook<> {};
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { uint32_t size; };
 
   template<class Container>
   struct container_hook
@@ -36,6 +36,12 @@ struct fixed_policy_traits
   {
     typedef typename boost::intrusive::list< Container, Hook > policy_container;
 
+    static uint32_t& get_size (typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->size;
+    }
+
     // could be just typedef
     class type : public policy_container
     {
@@ -59,13 +65,18 @@ struct fixed_policy_traits
       inline bool
       insert (typename parent_trie::iterator item)
       {
+    	  get_size (item) = 0;
     	  policy_container::push_back (*item);
     	  return true;
       }
 
+      /// @brief Insert item of s bytes; nothing is evicted from a fixed configuration
       inline bool
       insert (typename parent_trie::iterator item, uint32_t s)
       {
+        get_size (item) = s;
+        current_size_ += s;
+        policy_container::push_back (*item);
         return true;
       }
 
@@ -79,12 +90,14 @@ struct fixed_policy_traits
       inline void
       erase (typename parent_trie::iterator item)
       {
+        current_size_ -= get_size (item);
         policy_container::erase (policy_container::s_iterator_to (*item));
       }
 
       inline void
       clear ()
       {
+        current_size_ = 0;
         policy_container::clear ();
       }
 
@@ -0,0 +1,332 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * LFU replacement policy with dynamic aging, in O(1) per operation
+ *
+ * The items are kept in one list, ordered by frequency and then by last
+ * access, so that the front is the next victim. Every frequency in use has a
+ * bucket pointing to its last item: a hit moves the item behind the last item
+ * of the next frequency, without any search. New items start at the frequency
+ * of the last victim (the age of the cache) rather than 0, so that items only
+ * popular long ago end up being evicted (LFU-DA).
+ *
+ * Date: 2026-10-17
+ */
+
+#ifndef LFU_DA_POLICY_H_
+#define LFU_DA_POLICY_H_
+
+#include "detail/node-arena.h"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <new>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for LFU replacement policy with dynamic aging
+ *
+ * Insert, lookup and erase are O(1). The policy can also serve as a section
+ * of trie_with_policy_multisection.
+ */
+struct lfu_da_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "LfuDA"; }
+
+  struct bucket_base : public boost::intrusive::list_base_hook<>
+  {
+    uint64_t frequency;
+    uint32_t count;
+  };
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { bucket_base *bucket; uint32_t size; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    /// @brief Items of one frequency, which are consecutive in the policy list
+    struct bucket : public bucket_base
+    {
+      typename Container::iterator last;
+    };
+
+    static bucket_base*& get_bucket (typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->bucket;
+    }
+
+    static uint32_t& get_size (typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->size;
+    }
+
+    static uint64_t get_frequency (typename Container::const_iterator item)
+    {
+      return static_cast<const policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->bucket->frequency;
+    }
+
+    // could be just typedef
+    class type : public policy_container
+    {
+    public:
+      typedef policy policy_base; // to get access to get_frequency methods from outside
+      typedef Container parent_trie;
+
+      type (Base &base, uint32_t rank = 0)
+        : base_ (base)
+        , rank_ (rank)
+        , max_size_ (100)
+        , now_size_ (0)
+        , age_ (0)
+      {
+      }
+
+      ~type ()
+      {
+        clear ();
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        touch (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        if (max_size_ != 0 && policy_container::size () >= max_size_)
+          {
+            evict ();
+          }
+
+        link (item, 0);
+        return true;
+      }
+
+      /**
+       * @brief Insert item of s bytes, evicting least frequently used items
+       * until the bytes fit in max_size_ (a byte budget on this path)
+       */
+      inline bool
+      insert (typename parent_trie::iterator item, uint32_t s)
+      {
+        if (s > max_size_)
+          return false;
+
+        while (now_size_ + s > max_size_)
+          {
+            evict ();
+          }
+
+        link (item, s);
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        touch (item);
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        unlink (item);
+        now_size_ -= get_size (item);
+        policy_container::erase (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        while (!buckets_.empty ())
+          {
+            bucket *b = static_cast<bucket*> (&buckets_.front ());
+            buckets_.pop_front ();
+            release (b);
+          }
+        now_size_ = 0;
+        age_ = 0;
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+      /// @brief Bytes of the items inserted with their size
+      inline size_t
+      get_current_size () const
+      {
+        return now_size_;
+      }
+
+      /// @brief Frequency new items start at: the one of the last victim
+      inline uint64_t
+      get_age () const
+      {
+        return age_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+      // trie_with_policy_multisection takes the rank of the section from which to erase
+      template<class B>
+      static auto
+      erase_from (B &base, typename parent_trie::iterator item, uint32_t rank, int) -> decltype (base.erase (item, rank))
+      {
+        base.erase (item, rank);
+      }
+
+      template<class B>
+      static void
+      erase_from (B &base, typename parent_trie::iterator item, uint32_t rank, long)
+      {
+        base.erase (item);
+      }
+
+      inline void
+      evict ()
+      {
+        typename parent_trie::iterator victim = &(*policy_container::begin ());
+        age_ = get_bucket (victim)->frequency;
+        erase_from (base_, victim, rank_, 0);
+      }
+
+      inline bucket *
+      create (uint64_t frequency)
+      {
+        bucket *b = new (arena_.allocate ()) bucket;
+        b->frequency = frequency;
+        b->count = 0;
+        b->last = 0;
+        return b;
+      }
+
+      inline void
+      release (bucket *b)
+      {
+        b->~bucket ();
+        arena_.deallocate (b);
+      }
+
+      inline void
+      add (bucket *b, typename parent_trie::iterator item)
+      {
+        get_bucket (item) = b;
+        b->last = item;
+        b->count ++;
+      }
+
+      // take item out of its bucket, before it moves in the policy list
+      inline void
+      unlink (typename parent_trie::iterator item)
+      {
+        bucket *b = static_cast<bucket*> (get_bucket (item));
+        if (-- b->count == 0)
+          {
+            buckets_.erase (buckets_.iterator_to (*b));
+            release (b);
+          }
+        else if (b->last == item)
+          {
+            b->last = &(*-- policy_container::s_iterator_to (*item));
+          }
+      }
+
+      inline void
+      link (typename parent_trie::iterator item, uint32_t s)
+      {
+        get_size (item) = s;
+        now_size_ += s;
+
+        // all the items are at least as frequent as the age
+        bucket *first = buckets_.empty () ? 0 : static_cast<bucket*> (&buckets_.front ());
+        if (first != 0 && first->frequency == age_)
+          {
+            policy_container::insert (++ policy_container::s_iterator_to (*first->last), *item);
+          }
+        else
+          {
+            first = create (age_);
+            buckets_.push_front (*first);
+            policy_container::push_front (*item);
+          }
+        add (first, item);
+      }
+
+      inline void
+      touch (typename parent_trie::iterator item)
+      {
+        bucket *b = static_cast<bucket*> (get_bucket (item));
+        typename bucket_list::iterator next = ++ buckets_.iterator_to (*b);
+
+        bucket *to;
+        typename policy_container::iterator position;
+        if (next != buckets_.end () && next->frequency == b->frequency + 1)
+          {
+            to = static_cast<bucket*> (&(*next));
+            position = ++ policy_container::s_iterator_to (*to->last);
+          }
+        else
+          {
+            to = create (b->frequency + 1);
+            buckets_.insert (next, *to);
+            position = ++ policy_container::s_iterator_to (*b->last);
+          }
+
+        unlink (item);
+        policy_container::splice (position, *this, policy_container::s_iterator_to (*item));
+        add (to, item);
+      }
+
+    private:
+      typedef boost::intrusive::list<bucket_base> bucket_list;
+
+      Base &base_;
+      uint32_t rank_; // section served by this list in trie_with_policy_multisection
+      size_t max_size_;
+      size_t now_size_;
+      uint64_t age_;
+
+      detail::node_arena<bucket> arena_;
+      bucket_list buckets_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // LFU_DA_POLICY_H_
@@ -26,7 +26,6 @@
 #include "ns3/name.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
-#include <map>
 #include <string>
 
 namespace ns3 {
@@ -41,7 +40,7 @@ struct lru_policy_traits
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
   static std::string GetName () { return "Lru"; }
   
-  struct policy_hook_type : public boost::intrusive::list_member_hook<> {};
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { uint32_t size; };
 
   template<class Container>
   struct container_hook
@@ -57,6 +56,12 @@ struct lru_policy_traits
   struct policy 
   {
     typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    static uint32_t& get_size (typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->size;
+    }
     
     // could be just typedef
     class type : public policy_container
@@ -83,6 +88,7 @@ struct lru_policy_traits
       inline bool
       insert (typename parent_trie::iterator item)
       {
+        get_size (item) = 0;
         if (max_size_ != 0 && policy_container::size () >= max_size_)
           {
             base_.erase (&(*policy_container::begin ()));
@@ -91,51 +97,25 @@ struct lru_policy_traits
         policy_container::push_back (*item);
         return true;
       }
+      /**
+       * @brief Insert item of s bytes, evicting least recently used items
+       * until the bytes fit in max_size_ (a byte budget on this path)
+       */
       inline bool
       insert (typename parent_trie::iterator item, uint32_t s)
       {
-    	  while(max_size_ < s + now_size_)
-    	  {
-    		  //The size of the single chunk (item) exceeds the cache capacity
-			  if(now_size_ == 0)
-				  return false;
-
-	        	typename parent_trie::iterator musttry = &(*policy_container::begin ());
-	            std::string replace_piece;
-	            while(musttry != 0)
-	            {
-	            	replace_piece = musttry->key().toUri() + replace_piece;
-	            	musttry = musttry->Getparent();
-	            }
-	            std::map<std::string, size_t>::iterator iter = track_itemsize_.find(replace_piece);
-	            if(iter != track_itemsize_.end())
-	            {
-	                now_size_ -= iter->second;
-	                track_itemsize_.erase(iter);
-	            }
-	            else
-	            {
-	            	std::cout << "WTFFFFFFFFFFFFFFFFFF!!!!"<<std::endl;
-	            }
-	            typename parent_trie::iterator todelete = &(*policy_container::begin ());
-	            //if(todelete != 0)
-	            //{
-	            	//erase(Base::s_iterator_to(todelete));
-		        	base_.erase (todelete);
-	            //}
-    	  }
-	        typename parent_trie::iterator whatname = item;
-	        std::string piece;
-	        while(whatname != 0)
-	        {
-	        	piece = whatname->key().toUri() + piece;
-	        	whatname = whatname->Getparent();
-	        }
-
-	        now_size_ += s;
-	        policy_container::push_back (*item);
-	        track_itemsize_[piece] = s;
-	        return true;
+        if (s > max_size_)
+          return false;
+
+        while (now_size_ + s > max_size_)
+          {
+            base_.erase (&(*policy_container::begin ()));
+          }
+
+        get_size (item) = s;
+        now_size_ += s;
+        policy_container::push_back (*item);
+        return true;
       }
   
       inline void
@@ -150,14 +130,14 @@ struct lru_policy_traits
       inline void
       erase (typename parent_trie::iterator item)
       {
+        now_size_ -= get_size (item);
         policy_container::erase (policy_container::s_iterator_to (*item));
       }
 
       inline void
       clear ()
       {
-    	  now_size_ = 0;
-    	  track_itemsize_.clear();
+        now_size_ = 0;
         policy_container::clear ();
       }
 
@@ -172,10 +152,11 @@ struct lru_policy_traits
       {
         return max_size_;
       }
+      /// @brief Bytes of the items inserted with their size
       inline size_t
-	  get_current_size() const
+      get_current_size () const
       {
-    	  return now_size_;
+        return now_size_;
       }
     private:
       type () : base_(*((Base*)0)) { };
@@ -184,7 +165,6 @@ struct lru_policy_traits
       Base &base_;
       size_t max_size_;
       size_t now_size_;
-      std::map<std::string, size_t> track_itemsize_;
     };
   };
 };
@@ -35,6 +35,8 @@
 
 #include <boost/intrusive/options.hpp>
 
+#include <algorithm>
+
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
@@ -110,7 +112,7 @@ struct multi_policy_traits
       inline bool
       insert (typename parent_trie::iterator item, uint32_t s)
       {
-        return true;
+        return policy_container::insert (item, s);
       }
   
       inline void
@@ -158,10 +160,28 @@ struct multi_policy_traits
         // as max size should be the same everywhere, get the value from the first available policy
         return policy_container::template get<0> ().get_max_size ();
       }
+      struct current_size_getter
+      {
+        current_size_getter (const policy_container &container, size_t &size) : m_container (container), m_size (size) { }
+
+        template< typename U > void operator() (U index)
+        {
+          m_size = std::max (m_size, m_container.template get<U::value> ().get_current_size ());
+        }
+
+      private:
+        const policy_container &m_container;
+        size_t &m_size;
+      };
+
       inline size_t
-	  get_current_size() const
+      get_current_size () const
       {
-    	  return 0;
+        // bytes are accounted by the policy which enforces the budget, the others give 0
+        size_t size = 0;
+        boost::mpl::for_each< boost::mpl::range_c<int, 0, boost::mpl::size<policy_traits>::type::value> >
+          (current_size_getter (*this, size));
+        return size;
       }
       
     };
@@ -38,7 +38,7 @@ struct random_policy_traits
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
   static std::string GetName () { return "Random"; }
 
-  struct policy_hook_type : public boost::intrusive::set_member_hook<> { uint32_t randomOrder; };
+  struct policy_hook_type : public boost::intrusive::set_member_hook<> { uint32_t randomOrder; uint32_t size; };
 
   template<class Container>
   struct container_hook
@@ -64,6 +64,12 @@ struct random_policy_traits
       return static_cast<const typename policy_container::value_traits::hook_type*>
         (policy_container::value_traits::to_node_ptr(*item))->randomOrder;
     }
+
+    static uint32_t& get_size (typename Container::iterator item)
+    {
+      return static_cast<typename policy_container::value_traits::hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->size;
+    }
     
     template<class Key>
     struct MemberHookLess
@@ -89,6 +95,7 @@ struct random_policy_traits
         : base_ (base)
         , u_rand (0, std::numeric_limits<uint32_t>::max ())
         , max_size_ (100)
+        , now_size_ (0)
       {
       }
 
@@ -102,6 +109,7 @@ struct random_policy_traits
       insert (typename parent_trie::iterator item)
       {
         get_order (item) = u_rand.GetValue ();
+        get_size (item) = 0;
 
         if (max_size_ != 0 && policy_container::size () >= max_size_)
           {
@@ -121,9 +129,28 @@ struct random_policy_traits
         policy_container::insert (*item);
         return true;
       }
+      /**
+       * @brief Insert item of s bytes, evicting random items until the bytes
+       * fit in max_size_ (a byte budget on this path). Fails if the item
+       * itself would be the next one evicted.
+       */
       inline bool
       insert (typename parent_trie::iterator item, uint32_t s)
       {
+        if (s > max_size_)
+          return false;
+
+        get_order (item) = u_rand.GetValue ();
+        while (now_size_ + s > max_size_)
+          {
+            if (MemberHookLess<Container>() (*item, *policy_container::begin ()))
+              return false;
+            base_.erase (&(*policy_container::begin ()));
+          }
+
+        get_size (item) = s;
+        now_size_ += s;
+        policy_container::insert (*item);
         return true;
       }
   
@@ -136,12 +163,14 @@ struct random_policy_traits
       inline void
       erase (typename parent_trie::iterator item)
       {
+        now_size_ -= get_size (item);
         policy_container::erase (policy_container::s_iterator_to (*item));
       }
 
       inline void
       clear ()
       {
+        now_size_ = 0;
         policy_container::clear ();
       }
 
@@ -156,10 +185,11 @@ struct random_policy_traits
       {
         return max_size_;
       }
+      /// @brief Bytes of the items inserted with their size
       inline size_t
-	  get_current_size() const
+      get_current_size () const
       {
-    	  return 0;
+        return now_size_;
       }
 
     private:
@@ -169,6 +199,7 @@ struct random_policy_traits
       Base &base_;
       ns3::UniformVariable u_rand;
       size_t max_size_;
+      size_t now_size_;
     };
   };
 };
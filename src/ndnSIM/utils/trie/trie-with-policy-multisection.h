@@ -3,6 +3,7 @@
  * Create a policy class to handle cache multisection for adaptive video bitrates.
  * Contents with different bitrates are managed by multiple intrusive lists.
  * Each list has its own size limit
+ * Lists are kept in a dense array indexed by the bitrate rank (see NDNBitRate::InternBitRate)
  *
  * Created date: 2016-07-12
  */
@@ -11,8 +12,8 @@
 #define TRIE_WITH_POLICY_MULTISECTION_H
 
 #include "trie-with-policy.h"
-#include <string>
-#include <map>
+#include <vector>
+#include <memory>
 
 namespace ns3 {
 namespace ndn {
@@ -46,26 +47,29 @@ public:
 	}
 
 	inline void
-	initMaintenanceLists (const std::string BR[], size_t numBitrates)
+	initMaintenanceLists (const uint32_t ranks[], size_t numBitrates)
 	{
 		for(uint32_t i = 0; i < numBitrates; i++)
 		{
-			policys_.insert(std::make_pair(BR[i], std::move(*new policy_container(*this, BR[i]))));
+			if(ranks[i] >= policys_.size())
+				policys_.resize(ranks[i] + 1);
+			if(!policys_[ranks[i]])
+				policys_[ranks[i]].reset(new policy_container(*this, ranks[i]));
 		}
 	}
 
 	inline std::pair< iterator, bool >
-	insert (const FullKey &key, typename PayloadTraits::insert_type payload, std::string br, uint32_t len)
+	insert (const FullKey &key, typename PayloadTraits::insert_type payload, uint32_t rank, uint32_t len)
 	{
 		std::pair<iterator, bool> item =
 			this->trie_.insert (key, payload);
 
 		if (item.second) // real insert
 		{
-			typename std::map<std::string, policy_container>::iterator it = policys_.find(br);
-			if(it != policys_.end())
+			policy_container* policy = findPolicy(rank);
+			if(policy != 0)
 			{
-				bool ok = it->second.insert(s_iterator_to (item.first), len);
+				bool ok = policy->insert(s_iterator_to (item.first), len);
 				if (!ok)
 				{
 					item.first->erase (); // cannot insert
@@ -102,12 +106,12 @@ public:
 	}
 
 	inline void
-	erase (iterator node, const std::string& name)
+	erase (iterator node, uint32_t rank)
 	{
 		if (node == this->end()) return;
-		auto iter = policys_.find(name);
-		if(iter != policys_.end())
-			iter->second.erase(s_iterator_to (node));
+		policy_container* policy = findPolicy(rank);
+		if(policy != 0)
+			policy->erase(s_iterator_to (node));
 		node->erase ();
 	}
 
@@ -115,7 +119,8 @@ public:
 	clear ()
 	{
 		for(auto iter = policys_.begin(); iter != policys_.end(); iter++)
-			iter->second.clear();
+			if(*iter)
+				(*iter)->clear();
 		this->trie_.clear ();
 	}
 
@@ -135,7 +140,7 @@ public:
    * @brief Find a node that has prefix at least as the key (cache lookup)
    */
 	inline iterator
-	deepest_prefix_match (const FullKey &key, std::string br)
+	deepest_prefix_match (const FullKey &key, uint32_t rank)
 	{
 		iterator foundItem, lastItem;
 		bool reachLast;
@@ -151,9 +156,9 @@ public:
 			{
 				foundItem = lastItem->find (); // should be something
 			}
-			typename std::map<std::string, policy_container>::iterator it = policys_.find(br);
-			if(it != policys_.end())
-				it->second.lookup(s_iterator_to (foundItem));
+			policy_container* policy = findPolicy(rank);
+			if(policy != 0)
+				policy->lookup(s_iterator_to (foundItem));
 			return foundItem;
 		}
 		else
@@ -172,7 +177,7 @@ public:
    */
   template<class Predicate>
   inline iterator
-  deepest_prefix_match_if_next_level (const FullKey &key, Predicate pred, std::string br)
+  deepest_prefix_match_if_next_level (const FullKey &key, Predicate pred, uint32_t rank)
   {
     iterator foundItem, lastItem;
     bool reachLast;
@@ -189,9 +194,9 @@ public:
           {
             return this->trie_.end ();
           }
-		typename std::map<std::string, policy_container>::iterator it = policys_.find(br);
-		if(it != policys_.end())
-			it->second.lookup(s_iterator_to (foundItem));
+		policy_container* policy = findPolicy(rank);
+		if(policy != 0)
+			policy->lookup(s_iterator_to (foundItem));
         return foundItem;
       }
     else
@@ -201,11 +206,40 @@ public:
   }
 
   const policy_container&
-  getPolicy (std::string br) const { return policys_.at(br); }
+  getPolicy (uint32_t rank) const { return *policys_.at(rank); }
 
 
   policy_container&
-  getPolicy (std::string br) {return policys_.at(br); }
+  getPolicy (uint32_t rank) {return *policys_.at(rank); }
+
+  /// @brief Maintenance list of the rank, 0 if the rank has none
+  inline policy_container*
+  findPolicy (uint32_t rank) const
+  {
+    return rank < policys_.size() ? policys_[rank].get() : 0;
+  }
+
+  /// @brief Number of entries of all the maintenance lists
+  inline size_t
+  size () const
+  {
+    size_t n = 0;
+    for (auto iter = policys_.begin(); iter != policys_.end(); iter++)
+      if (*iter)
+        n += (*iter)->size();
+    return n;
+  }
+
+  /// @brief Bytes of the entries of all the maintenance lists
+  inline size_t
+  get_current_size () const
+  {
+    size_t n = 0;
+    for (auto iter = policys_.begin(); iter != policys_.end(); iter++)
+      if (*iter)
+        n += (*iter)->get_current_size();
+    return n;
+  }
 
 
   iterator end () const
@@ -232,7 +266,7 @@ public:
 
 private:
   parent_trie      trie_;
-  std::map<std::string, policy_container> policys_;
+  std::vector<std::unique_ptr<policy_container> > policys_; // Indexed by bitrate rank, slot 0 unused
 
 };
 
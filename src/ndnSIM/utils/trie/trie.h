@@ -23,14 +23,16 @@
 
 #include "ns3/ptr.h"
 
-#include <boost/intrusive/unordered_set.hpp>
+#include "detail/node-arena.h"
+
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/foreach.hpp>
-#include <boost/mpl/if.hpp>
+
+#include <stdint.h>
+#include <cstring>
 
 namespace ns3 {
 namespace ndn {
@@ -150,16 +152,24 @@ public:
 
   typedef PayloadTraits payload_traits;
 
-  inline
+  /**
+   * @brief Create the root of a trie
+   *
+   * All the nodes below the root are taken from an arena owned by the root.
+   * bucketSize and bucketIncrement are not used any more (children are kept in
+   * an inline array, then in an open-addressing table) and only kept for
+   * compatibility.
+   */
+  inline explicit
   trie (const Key &key, size_t bucketSize = 1, size_t bucketIncrement = 1)
     : key_ (key)
-    , initialBucketSize_ (bucketSize)
-    , bucketIncrement_ (bucketIncrement)
-    , bucketSize_ (initialBucketSize_)
-    , buckets_ (new bucket_type [bucketSize_]) //cannot use normal pointer, because lifetime of buckets should be larger than lifetime of the container
-    , children_ (bucket_traits (buckets_.get (), bucketSize_))
+    , hash_ (boost::hash_value (key))
+    , size_ (0)
+    , used_ (0)
+    , mask_ (0)
     , payload_ (PayloadTraits::empty_payload)
     , parent_ (0)
+    , arena_ (new arena_type)
   {
   }
 
@@ -167,13 +177,29 @@ public:
   ~trie ()
   {
     payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
-    children_.clear_and_dispose (trie_delete_disposer ());
+    clear ();
+    if (parent_ == 0) // only the root owns the arena
+      delete arena_;
   }
 
   void
   clear ()
   {
-    children_.clear_and_dispose (trie_delete_disposer ());
+    if (mask_ == 0)
+      {
+        for (uint32_t i = 0; i < size_; i++)
+          destroy_node (children_.inline_[i]);
+      }
+    else
+      {
+        for (size_t slot = 0; slot <= mask_; slot++)
+          if (is_child (children_.table_[slot]))
+            destroy_node (children_.table_[slot]);
+        delete [] children_.table_;
+      }
+    size_ = 0;
+    used_ = 0;
+    mask_ = 0;
   }
 
   template<class Predicate>
@@ -209,30 +235,15 @@ public:
 
     BOOST_FOREACH (const Key &subkey, key)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
-        if (item == trieNode->children_.end ())
+        size_t hash = boost::hash_value (subkey);
+        trie *child = trieNode->find_child (subkey, hash);
+        if (child == 0)
           {
-            trie *newNode = new trie (subkey, initialBucketSize_, bucketIncrement_);
-            // std::cout << "new " << newNode << "\n";
-            newNode->parent_ = trieNode;
-
-            if (trieNode->children_.size () >= trieNode->bucketSize_)
-              {
-                trieNode->bucketSize_ += trieNode->bucketIncrement_;
-                trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-                buckets_array newBuckets (new bucket_type [trieNode->bucketSize_]);
-                trieNode->children_.rehash (bucket_traits (newBuckets.get (), trieNode->bucketSize_));
-                trieNode->buckets_.swap (newBuckets);
-              }
-
-            std::pair< typename unordered_set::iterator, bool > ret =
-              trieNode->children_.insert (*newNode);
-
-            trieNode = &(*ret.first);
+            child = new (arena_->allocate ()) trie (subkey, hash, arena_);
+            child->parent_ = trieNode;
+            trieNode->insert_child (child);
           }
-        else
-          trieNode = &(*item);
+        trieNode = child;
       }
 
     /*
@@ -265,12 +276,13 @@ public:
   prune ()
   {
     if (payload_ == PayloadTraits::empty_payload &&
-        children_.size () == 0)
+        size_ == 0)
       {
         if (parent_ == 0) return this;
 
         trie *parent = parent_;
-        parent->children_.erase_and_dispose (*this, trie_delete_disposer ()); // delete this; basically, committing a suicide
+        parent->erase_child (this);
+        destroy_node (this); // basically, committing a suicide
 
         return parent->prune ();
       }
@@ -284,12 +296,13 @@ public:
   prune_node ()
   {
     if (payload_ == PayloadTraits::empty_payload &&
-        children_.size () == 0)
+        size_ == 0)
       {
         if (parent_ == 0) return;
 
         trie *parent = parent_;
-        parent->children_.erase_and_dispose (*this, trie_delete_disposer ()); // delete this; basically, committing a suicide
+        parent->erase_child (this);
+        destroy_node (this); // basically, committing a suicide
       }
   }
 
@@ -314,15 +327,15 @@ public:
 
     BOOST_FOREACH (const Key &subkey, key)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
-        if (item == trieNode->children_.end ())
+        trie *child = trieNode->find_child (subkey, boost::hash_value (subkey));
+        if (child == 0)
           {
             reachLast = false;
             break;
           }
         else
           {
-            trieNode = &(*item);
+            trieNode = child;
 
             if (trieNode->payload_ != PayloadTraits::empty_payload)
               foundNode = trieNode;
@@ -337,8 +350,7 @@ public:
   {
 	  if(this->payload() != PayloadTraits::empty_payload)
 		  result.push_back(*name);
-	  typename unordered_set::iterator item = this->children_.begin();
-	  for(; item != this->children_.end(); item++)
+	  for(trie *item = first_child(); item != 0; item = next_child(item))
 	  {
 		  Ptr<FullKey> currentName = Create<FullKey>(*name);
 		  currentName->append(item->key());
@@ -363,15 +375,15 @@ public:
 
     BOOST_FOREACH (const Key &subkey, key)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
-        if (item == trieNode->children_.end ())
+        trie *child = trieNode->find_child (subkey, boost::hash_value (subkey));
+        if (child == 0)
           {
             reachLast = false;
             break;
           }
         else
           {
-            trieNode = &(*item);
+            trieNode = child;
 
             if (trieNode->payload_ != PayloadTraits::empty_payload &&
                 pred (trieNode->payload_))
@@ -394,11 +406,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload)
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin ();
-         subnode != children_.end ();
-         subnode++ )
-      // BOOST_FOREACH (trie &subnode, children_)
+    for (trie *subnode = first_child (); subnode != 0; subnode = next_child (subnode))
       {
         iterator value = subnode->find ();
         if (value != 0)
@@ -420,11 +428,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload && pred (payload_))
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin ();
-         subnode != children_.end ();
-         subnode++ )
-      // BOOST_FOREACH (const trie &subnode, children_)
+    for (trie *subnode = first_child (); subnode != 0; subnode = next_child (subnode))
       {
         iterator value = subnode->find_if (pred);
         if (value != 0)
@@ -446,10 +450,7 @@ public:
   inline const iterator
   find_if_next_level (Predicate pred)
   {
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin ();
-         subnode != children_.end ();
-         subnode++ )
+    for (trie *subnode = first_child (); subnode != 0; subnode = next_child (subnode))
       {
         if (pred (subnode->key ()))
           {
@@ -501,23 +502,195 @@ public:
   PrintStat (std::ostream &os) const;
 
 private:
-  //The disposer object function
-  struct trie_delete_disposer
+  typedef detail::node_arena<trie> arena_type;
+
+  // Children kept inline up to this fan-out, in an open-addressing table beyond
+  static const uint32_t inline_children = 4;
+  static const size_t min_table_size = 16;
+
+  inline
+  trie (const Key &key, size_t hash, arena_type *arena)
+    : key_ (key)
+    , hash_ (hash)
+    , size_ (0)
+    , used_ (0)
+    , mask_ (0)
+    , payload_ (PayloadTraits::empty_payload)
+    , parent_ (0)
+    , arena_ (arena)
   {
-    void operator() (trie *delete_this)
-    {
-      delete delete_this;
-    }
-  };
+  }
+
+  trie (const trie &);
+  trie &operator= (const trie &);
 
-  template<class D>
-  struct array_disposer
+  static void
+  destroy_node (trie *node)
   {
-    void operator() (D *array)
-    {
-      delete [] array;
-    }
-  };
+    arena_type *arena = node->arena_;
+    node->~trie ();
+    arena->deallocate (node);
+  }
+
+  // Slot of an erased child: keeps the probe sequences, and the slots of the other
+  // children, unchanged until the next rehash, so erasing never moves a sibling
+  static trie *
+  tombstone ()
+  {
+    return reinterpret_cast<trie*> (uintptr_t (1));
+  }
+
+  static bool
+  is_child (const trie *slot)
+  {
+    return slot != 0 && slot != tombstone ();
+  }
+
+  inline trie *
+  find_child (const Key &key, size_t hash) const
+  {
+    if (mask_ == 0)
+      {
+        // sorted by hash
+        for (uint32_t i = 0; i < size_; i++)
+          {
+            trie *child = children_.inline_[i];
+            if (child->hash_ > hash)
+              break;
+            if (child->hash_ == hash && child->key_ == key)
+              return child;
+          }
+        return 0;
+      }
+
+    for (size_t slot = hash & mask_; ; slot = (slot + 1) & mask_)
+      {
+        trie *child = children_.table_[slot];
+        if (child == 0)
+          return 0;
+        if (child != tombstone () && child->hash_ == hash && child->key_ == key)
+          return child;
+      }
+  }
+
+  // The key of 'child' must not be among the children yet
+  void
+  insert_child (trie *child)
+  {
+    if (mask_ == 0 && size_ < inline_children)
+      {
+        uint32_t pos = size_;
+        while (pos > 0 && children_.inline_[pos - 1]->hash_ > child->hash_)
+          {
+            children_.inline_[pos] = children_.inline_[pos - 1];
+            pos--;
+          }
+        children_.inline_[pos] = child;
+        size_++;
+        return;
+      }
+
+    if (mask_ == 0 || (used_ + 1) * 4 > (mask_ + 1) * 3)
+      rehash_children (size_ + 1);
+
+    size_t slot = child->hash_ & mask_;
+    while (is_child (children_.table_[slot]))
+      slot = (slot + 1) & mask_;
+    if (children_.table_[slot] == 0)
+      used_++;
+    children_.table_[slot] = child;
+    size_++;
+  }
+
+  void
+  erase_child (trie *child)
+  {
+    if (mask_ == 0)
+      {
+        uint32_t pos = 0;
+        while (children_.inline_[pos] != child)
+          pos++;
+        for (size_--; pos < size_; pos++)
+          children_.inline_[pos] = children_.inline_[pos + 1];
+        return;
+      }
+
+    size_t slot = child->hash_ & mask_;
+    while (children_.table_[slot] != child)
+      slot = (slot + 1) & mask_;
+    children_.table_[slot] = tombstone ();
+    size_--;
+
+    if (size_ == 0)
+      {
+        delete [] children_.table_;
+        used_ = 0;
+        mask_ = 0;
+      }
+  }
+
+  // Move the children to a table large enough for 'count' of them (drops the tombstones)
+  void
+  rehash_children (size_t count)
+  {
+    size_t tableSize = min_table_size;
+    while (count * 4 > tableSize * 3)
+      tableSize *= 2;
+
+    trie **table = new trie* [tableSize];
+    std::memset (table, 0, tableSize * sizeof (trie*));
+
+    for (trie *child = first_child (); child != 0; child = next_child (child))
+      {
+        size_t slot = child->hash_ & (tableSize - 1);
+        while (table[slot] != 0)
+          slot = (slot + 1) & (tableSize - 1);
+        table[slot] = child;
+      }
+
+    if (mask_ != 0)
+      delete [] children_.table_;
+    children_.table_ = table;
+    mask_ = tableSize - 1;
+    used_ = size_;
+  }
+
+  trie *
+  first_child () const
+  {
+    if (mask_ == 0)
+      return size_ > 0 ? children_.inline_[0] : 0;
+
+    for (size_t slot = 0; slot <= mask_; slot++)
+      if (is_child (children_.table_[slot]))
+        return children_.table_[slot];
+    return 0;
+  }
+
+  // Sibling following 'child' in the (unspecified) order of the children
+  trie *
+  next_child (const trie *child) const
+  {
+    if (mask_ == 0)
+      {
+        for (uint32_t i = 0; i + 1 < size_; i++)
+          if (children_.inline_[i] == child)
+            return children_.inline_[i + 1];
+        return 0;
+      }
+
+    size_t slot = child->hash_ & mask_;
+    while (children_.table_[slot] != child)
+      {
+        if (children_.table_[slot] == 0)
+          return 0;
+        slot = (slot + 1) & mask_;
+      }
+    for (slot++; slot <= mask_; slot++)
+      if (is_child (children_.table_[slot]))
+        return children_.table_[slot];
+    return 0;
+  }
 
   friend
   std::ostream&
@@ -527,18 +700,6 @@ public:
   PolicyHook policy_hook_;
 
 private:
-  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
-
-  // necessary typedefs
-  typedef trie self_type;
-  typedef boost::intrusive::member_hook< trie,
-                                         boost::intrusive::unordered_set_member_hook< >,
-                                         &trie::unordered_set_member_hook_ > member_hook;
-
-  typedef boost::intrusive::unordered_set< trie, member_hook > unordered_set;
-  typedef typename unordered_set::bucket_type   bucket_type;
-  typedef typename unordered_set::bucket_traits bucket_traits;
-
   template<class T, class NonConstT>
   friend class trie_iterator;
 
@@ -550,17 +711,20 @@ private:
   ////////////////////////////////////////////////
 
   Key key_; ///< name component
+  size_t hash_; ///< hash of key_
 
-  size_t initialBucketSize_;
-  size_t bucketIncrement_;
-
-  size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr< bucket_type, array_disposer<bucket_type> > buckets_array;
-  buckets_array buckets_;
-  unordered_set children_;
+  uint32_t size_; ///< number of children
+  uint32_t used_; ///< table slots holding a child or a tombstone
+  size_t mask_;   ///< table size - 1, 0 while the children are inline
+  union
+  {
+    trie *inline_[inline_children];
+    trie **table_;
+  } children_;
 
   typename PayloadTraits::storage_type payload_;
   trie *parent_; // to make cleaning effective
+  arena_type *arena_;
 };
 
 
@@ -573,10 +737,7 @@ operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook> &t
   os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << std::endl;
   typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
 
-  for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin ();
-       subnode != trie_node.children_.end ();
-       subnode++ )
-  // BOOST_FOREACH (const trie &subnode, trie_node.children_)
+  for (const trie *subnode = trie_node.first_child (); subnode != 0; subnode = trie_node.next_child (subnode))
     {
       os << "\"" << &trie_node << "\"" << " [label=\"" << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << "\"]\n";
       os << "\"" << &(*subnode) << "\"" << " [label=\"" << subnode->key_ << ((subnode->payload_ != PayloadTraits::empty_payload)?"*":"") << "\"]""\n";
@@ -593,20 +754,12 @@ inline void
 trie<FullKey, PayloadTraits, PolicyHook>
 ::PrintStat (std::ostream &os) const
 {
-  os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload)?"*":"") << ": " << children_.size() << " children" << std::endl;
-  for (size_t bucket = 0, maxbucket = children_.bucket_count ();
-       bucket < maxbucket;
-       bucket++)
-    {
-      os << " " << children_.bucket_size (bucket);
-    }
-  os << "\n";
+  os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload)?"*":"") << ": " << size_ << " children";
+  if (mask_ != 0)
+    os << " in " << (mask_ + 1) << " slots (" << (used_ - size_) << " erased)";
+  os << std::endl;
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-  for (typename trie::unordered_set::const_iterator subnode = children_.begin ();
-       subnode != children_.end ();
-       subnode++ )
-  // BOOST_FOREACH (const trie &subnode, children_)
+  for (const trie *subnode = first_child (); subnode != 0; subnode = next_child (subnode))
     {
       subnode->PrintStat (os);
     }
@@ -625,7 +778,7 @@ template<typename FullKey, typename PayloadTraits, typename PolicyHook>
 inline std::size_t
 hash_value (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
 {
-  return boost::hash_value (trie_node.key_);
+  return trie_node.hash_;
 }
 
 
@@ -650,8 +803,8 @@ public:
   trie_iterator<Trie,NonConstTrie> &
   operator++ (int)
   {
-    if (trie_->children_.size () > 0)
-      trie_ = &(*trie_->children_.begin ());
+    if (trie_->size_ > 0)
+      trie_ = trie_->first_child ();
     else
       trie_ = goUp ();
     return *this;
@@ -665,20 +818,14 @@ public:
   }
 
 private:
-  typedef typename boost::mpl::if_< boost::is_same<Trie, NonConstTrie>,
-                                    typename Trie::unordered_set::iterator,
-                                    typename Trie::unordered_set::const_iterator>::type set_iterator;
-
   Trie* goUp ()
   {
     if (trie_->parent_ != 0)
       {
-        // typename Trie::unordered_set::iterator item =
-        set_iterator item = const_cast<NonConstTrie*>(trie_)->parent_->children_.iterator_to (const_cast<NonConstTrie&> (*trie_));
-        item++;
-        if (item != trie_->parent_->children_.end ())
+        Trie *item = trie_->parent_->next_child (trie_);
+        if (item != 0)
           {
-            return &(*item);
+            return item;
           }
         else
           {
@@ -697,20 +844,12 @@ private:
 template<class Trie>
 class trie_point_iterator
 {
-private:
-  typedef typename boost::mpl::if_< boost::is_same<Trie, const Trie>,
-                                    typename Trie::unordered_set::const_iterator,
-                                    typename Trie::unordered_set::iterator>::type set_iterator;
-
 public:
   trie_point_iterator () : trie_ (0) {}
   trie_point_iterator (typename Trie::iterator item) : trie_ (item) {}
   trie_point_iterator (Trie &item)
   {
-    if (item.children_.size () != 0)
-      trie_ = &*item.children_.begin ();
-    else
-      trie_ = 0;
+    trie_ = item.first_child ();
   }
 
   Trie & operator* () { return *trie_; }
@@ -727,12 +866,7 @@ public:
   {
     if (trie_->parent_ != 0)
       {
-        set_iterator item = trie_->parent_->children_.iterator_to (*trie_);
-        item ++;
-        if (item == trie_->parent_->children_.end ())
-          trie_ = 0;
-        else
-          trie_ = &*item;
+        trie_ = trie_->parent_->next_child (trie_);
       }
     else
       {
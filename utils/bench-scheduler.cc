@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Benchmark of the event schedulers, on recorded or periodic event traces
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Date: 2026-10-17
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+#define LOG(x)   std::cout << x << std::endl
+
+struct Op
+{
+  char type;                    // 'i' Insert, 'r' RemoveNext, 'x' Remove
+  Scheduler::EventKey key;
+};
+
+std::vector<Op>
+ReadTrace (const std::string &filename)
+{
+  std::vector<Op> ops;
+  std::ifstream input (filename.c_str ());
+  if (!input.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open " << filename);
+    }
+
+  std::string line;
+  while (std::getline (input, line))
+    {
+      std::istringstream is (line);
+      Op op;
+      op.key.m_context = 0;
+      if (!(is >> op.type >> op.key.m_ts >> op.key.m_uid))
+        {
+          continue;
+        }
+      if (op.type == 'i')
+        {
+          is >> op.key.m_context;
+        }
+      ops.push_back (op);
+    }
+  return ops;
+}
+
+/* Replay ops; returns the number of RemoveNext which did not give the recorded event */
+uint64_t
+Replay (Ptr<Scheduler> scheduler, const std::vector<Op> &ops)
+{
+  uint64_t errors = 0;
+  Scheduler::Event ev;
+  ev.impl = 0;
+  for (std::vector<Op>::const_iterator op = ops.begin (); op != ops.end (); op++)
+    {
+      switch (op->type)
+        {
+        case 'i':
+          ev.key = op->key;
+          scheduler->Insert (ev);
+          break;
+        case 'r':
+          ev = scheduler->RemoveNext ();
+          if (ev.key.m_ts != op->key.m_ts || ev.key.m_uid != op->key.m_uid)
+            {
+              errors++;
+            }
+          break;
+        case 'x':
+          ev.key = op->key;
+          scheduler->Remove (ev);
+          break;
+        }
+    }
+  while (!scheduler->IsEmpty ())
+    {
+      scheduler->RemoveNext ();
+    }
+  return errors;
+}
+
+/*
+ * Hold model of a video scenario: every flow has one event of each period
+ * pending, which schedules itself again one period later when it runs.
+ */
+uint64_t
+Hold (Ptr<Scheduler> scheduler, const std::vector<uint64_t> &periods, uint32_t flows, uint64_t total)
+{
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_context = 0;
+  uint32_t uid = 0;
+  for (uint32_t f = 0; f < flows; f++)
+    {
+      for (uint32_t p = 0; p < periods.size (); p++)
+        {
+          // spread the flows over one period
+          ev.key.m_ts = periods[p] * f / flows;
+          ev.key.m_uid = uid++;
+          ev.key.m_context = p;
+          scheduler->Insert (ev);
+        }
+    }
+
+  for (uint64_t n = 0; n < total; n++)
+    {
+      ev = scheduler->RemoveNext ();
+      ev.key.m_ts += periods[ev.key.m_context];
+      ev.key.m_uid = uid++;
+      scheduler->Insert (ev);
+    }
+  while (!scheduler->IsEmpty ())
+    {
+      scheduler->RemoveNext ();
+    }
+  return total;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string trace = "";
+  std::string schedulers = "ns3::MapScheduler,ns3::HeapScheduler,ns3::CalendarScheduler,ns3::TimingWheelScheduler";
+  std::string periodList = "2,0.05,2,0.0008";
+  uint32_t flows = 1000;
+  uint64_t total = 10000000;
+  uint32_t runs = 3;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the event schedulers.\n"
+             "\n"
+             "With --trace, replay the operations recorded by ns3::RecordingScheduler\n"
+             "in a scenario (--SchedulerType=ns3::RecordingScheduler), checking that\n"
+             "every scheduler gives the events in the recorded order. Otherwise run\n"
+             "a hold model: every flow has one pending event per period (by default\n"
+             "video chunk, retransmission check, PIT expiration and link transmit\n"
+             "complete), which schedules itself again when it runs.");
+  cmd.AddValue ("trace", "file of operations recorded by ns3::RecordingScheduler", trace);
+  cmd.AddValue ("schedulers", "comma separated scheduler types (ns3::HeapScheduler is skipped on a trace with Remove operations)", schedulers);
+  cmd.AddValue ("periods", "comma separated event periods (s) of the hold model", periodList);
+  cmd.AddValue ("flows", "number of flows of the hold model", flows);
+  cmd.AddValue ("total", "number of events run by the hold model", total);
+  cmd.AddValue ("runs", "number of runs per scheduler", runs);
+  cmd.Parse (argc, argv);
+
+  std::vector<Op> ops;
+  std::vector<uint64_t> periods;
+  bool removes = false;
+  if (trace != "")
+    {
+      ops = ReadTrace (trace);
+      for (std::vector<Op>::const_iterator op = ops.begin (); op != ops.end () && !removes; op++)
+        {
+          removes = (op->type == 'x');
+        }
+      LOG ("trace: " << trace << ", " << ops.size () << " operations");
+    }
+  else
+    {
+      std::istringstream is (periodList);
+      std::string period;
+      while (std::getline (is, period, ','))
+        {
+          periods.push_back (Time (period + "s").GetTimeStep ());
+        }
+      NS_ABORT_MSG_IF (periods.empty (), "No period");
+      LOG ("hold model: " << flows << " flows, " << periods.size () << " periods, " << total << " events");
+    }
+
+  LOG (std::left << std::setw (32) << "Scheduler" << std::setw (8) << "Run"
+                 << std::setw (12) << "Time (s)" << std::setw (12) << "Per (ns/op)");
+
+  std::istringstream is (schedulers);
+  std::string type;
+  while (std::getline (is, type, ','))
+    {
+      // HeapScheduler::Remove only sifts the moved event down, so the heap can give
+      // events out of order afterwards, and a later Remove of the trace asserts
+      if (removes && type == "ns3::HeapScheduler")
+        {
+          LOG (std::left << std::setw (32) << type << "skipped: the trace has Remove operations");
+          continue;
+        }
+
+      ObjectFactory factory (type);
+      for (uint32_t run = 0; run < runs; run++)
+        {
+          Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+          SystemWallClockMs time;
+          uint64_t count, errors = 0;
+
+          time.Start ();
+          if (trace != "")
+            {
+              errors = Replay (scheduler, ops);
+              count = ops.size ();
+            }
+          else
+            {
+              count = Hold (scheduler, periods, flows, total);
+            }
+          double seconds = time.End () / 1000.0;
+          scheduler->Dispose ();
+
+          LOG (std::left << std::setw (32) << type << std::setw (8) << run
+                         << std::setw (12) << seconds << std::setw (12) << (seconds * 1e9 / count));
+          if (errors > 0)
+            {
+              LOG ("  " << errors << " events out of the recorded order");
+            }
+        }
+    }
+  return 0;
+}